@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <SDL.h>
+
+#include "fractal_kernel.h"
+
+// Renders the fractal with every CPU implementation of the kernel, without a
+// window, and reports how fast each one is. The kernel runs through the
+// software renderer exactly like it does in sdlrenderer-hlsl, so this also
+// measures the tiling and threading done by SDL.
+//
+// Usage: fractal-benchmark [frames per run]
+
+struct resolution {
+  const char* name;
+  int width;
+  int height;
+};
+
+const static resolution resolutions[] = {
+  { "640x480", 640, 480 },
+  { "1080p", 1920, 1080 },
+  { "4K", 3840, 2160 },
+};
+
+const static int default_frame_count = 30;
+const static int warmup_frame_count = 2;
+
+// Everything needed to draw the fractal into a surface in memory
+struct fractal_target {
+  SDL_Surface* surface;
+  SDL_Renderer* renderer;
+  SDL_Texture* texture;
+  SDL_RenderKernel* kernel;
+};
+
+bool create_target(fractal_target* target, const resolution& size, SDL_RenderKernelFunction function) {
+  target->surface = SDL_CreateRGBSurfaceWithFormat(0, size.width, size.height, 32, SDL_PIXELFORMAT_ARGB8888);
+  target->renderer = target->surface ? SDL_CreateSoftwareRenderer(target->surface) : nullptr;
+  target->texture = target->renderer ? SDL_CreateTexture(target->renderer,
+                                                         SDL_PIXELFORMAT_RGBA8888,
+                                                         SDL_TEXTUREACCESS_STATIC,
+                                                         1, 1) : nullptr;
+  target->kernel = target->texture ? SDL_CreateRenderKernel(target->renderer, function, nullptr, nullptr, 0) : nullptr;
+
+  return target->kernel && SDL_RenderSetKernel(target->renderer, target->kernel) == 0;
+}
+
+void destroy_target(fractal_target* target) {
+  if (target->kernel) SDL_DestroyRenderKernel(target->kernel);
+  if (target->texture) SDL_DestroyTexture(target->texture);
+  if (target->renderer) SDL_DestroyRenderer(target->renderer);
+  if (target->surface) SDL_FreeSurface(target->surface);
+}
+
+// Same as send_frame_using_constants() in sdlrenderer-hlsl.cpp
+void set_frame(SDL_Renderer* renderer, Uint8 frame) {
+  const float constants[] = { frame/255.0f };
+
+  SDL_RenderSetKernelConstants(renderer, constants, SDL_arraysize(constants));
+}
+
+// Draws one frame and returns how long it took, in milliseconds
+double draw_frame(fractal_target* target, Uint8 frame) {
+  const Uint64 start = SDL_GetPerformanceCounter();
+
+  set_frame(target->renderer, frame);
+  SDL_RenderCopy(target->renderer, target->texture, nullptr, nullptr);
+  SDL_RenderFlush(target->renderer);
+
+  const Uint64 end = SDL_GetPerformanceCounter();
+
+  return (end - start)*1000.0/SDL_GetPerformanceFrequency();
+}
+
+// Nearest-rank percentile of sorted samples
+double percentile(const std::vector<double>& sorted, int p) {
+  const size_t rank = (sorted.size()*p + 99)/100;
+  return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+bool same_pixels(const SDL_Surface* a, const SDL_Surface* b) {
+  for (int y = 0; y < a->h; y++) {
+    if (std::memcmp(static_cast<const Uint8*>(a->pixels) + y*a->pitch,
+                    static_cast<const Uint8*>(b->pixels) + y*b->pitch,
+                    a->w*4)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int main(int arg_count, char** arg_vector) {
+  const int frame_count = arg_count > 1 ? std::max(1, std::atoi(arg_vector[1])) : default_frame_count;
+  bool all_match = true;
+
+  SDL_Init(0);
+
+  std::printf("%d CPUs, %d frames per run\n\n", SDL_GetCPUCount(), frame_count);
+  std::printf("%-10s %-8s %10s %9s %9s %9s %9s\n", "resolution", "kernel", "Mpixels/s", "p50 ms", "p90 ms", "p99 ms", "max ms");
+
+  for (const resolution& size : resolutions) {
+    // Every implementation must draw exactly what the scalar one does
+    fractal_target reference = {};
+    bool have_reference = false;
+
+    for (int isa = FRACTAL_KERNEL_SCALAR; isa < FRACTAL_KERNEL_ISA_COUNT; isa++) {
+      const fractal_kernel_isa kernel_isa = static_cast<fractal_kernel_isa>(isa);
+      const SDL_RenderKernelFunction function = fractal_kernel_function(kernel_isa);
+      fractal_target target = {};
+
+      if (!function) continue;
+
+      if (!create_target(&target, size, function)) {
+        std::fprintf(stderr, "%s: %s\n", fractal_kernel_isa_name(kernel_isa), SDL_GetError());
+        destroy_target(&target);
+        return 1;
+      }
+
+      for (int frame = 0; frame < warmup_frame_count; frame++) {
+        draw_frame(&target, static_cast<Uint8>(frame));
+      }
+
+      std::vector<double> latencies;
+      double total = 0;
+
+      for (int frame = 0; frame < frame_count; frame++) {
+        latencies.push_back(draw_frame(&target, static_cast<Uint8>(frame)));
+        total += latencies.back();
+      }
+
+      std::sort(latencies.begin(), latencies.end());
+
+      const double pixels = static_cast<double>(size.width)*size.height*frame_count;
+      std::printf("%-10s %-8s %10.1f %9.2f %9.2f %9.2f %9.2f\n",
+                  size.name, fractal_kernel_isa_name(kernel_isa),
+                  pixels/(total*1000.0),
+                  percentile(latencies, 50), percentile(latencies, 90),
+                  percentile(latencies, 99), latencies.back());
+
+      // Compare the last frame with what the reference drew for it
+      if (!have_reference) {
+        reference = target;
+        have_reference = true;
+        continue;
+      }
+
+      if (!same_pixels(reference.surface, target.surface)) {
+        std::fprintf(stderr, "%s: pixels differ from %s\n",
+                     fractal_kernel_isa_name(kernel_isa),
+                     fractal_kernel_isa_name(FRACTAL_KERNEL_SCALAR));
+        all_match = false;
+      }
+
+      destroy_target(&target);
+    }
+
+    destroy_target(&reference);
+  }
+
+  SDL_Quit();
+
+  return all_match ? 0 : 1;
+}
@@ -1,817 +0,0 @@
-#if 0
-//
-// Generated by Microsoft (R) HLSL Shader Compiler 9.22.949.2248
-//
-//   fxc /O3 /T ps_2_a fractal.hlsl /Fh fractal.h
-//
-//
-// Parameters:
-//
-//   sampler2D tex;
-//
-//
-// Registers:
-//
-//   Name         Reg   Size
-//   ------------ ----- ----
-//   tex          s0       1
-//
-
-    ps_2_x
-    def c0, -0.699999988, -0.5, 4, 0
-    def c1, 0, 1, 2, 3
-    def c2, 14, 0.0714285746, 0.0178571437, 1
-    def c3, 12, 0.0833333358, -12, -0.0833333358
-    def c4, 1, -2.79999995, -2, 5
-    def c5, 6, 7, 8, 9
-    def c6, 10, 11, 12, 13
-    def c7, 12, 8, 4, 0
-    dcl t0.xy
-    dcl_2d s0
-    mov r0.zw, c0
-    mad r0.xyz, t0.xxyw, r0.wzzw, c4
-    add r1.xy, t0, c0
-    mul r1.zw, r1.xyxy, c0.z
-    mul r0.w, r1.w, r1.w
-    mad r2.x, r1.z, r1.z, -r0.w
-    dp2add r2.y, r1.z, r1.w, c0.w
-    dp2add r0.w, r1.zwzw, -r1.zwzw, c0.z
-    mad r2.yz, r1.xxyw, c0.z, r2.xxyw
-    dp2add r2.w, r2.yzzw, -r2.yzzw, c0.z
-    cmp r3.xyz, r2.w, c1.xyyw, c1.yzxw
-    mov r2.x, r3.y
-    cmp r1.zw, r0.w, c1.xyxy, c1.xyyx
-    mad r2.w, r1.w, r1.z, r1.z
-    cmp r4.xyz, -r2.w, r2, r0
-    cmp r0.xyz, r0.w, r4, r0
-    mul r2.x, r0.z, r0.z
-    mad r3.y, r0.y, r0.y, -r2.x
-    dp2add r3.w, r0.y, r0.z, c0.w
-    mad r4.yz, r1.xxyw, c0.z, r3.xyww
-    dp2add r4.w, r4.yzzw, -r4.yzzw, c0.z
-    cmp r3.yw, r4.w, c1.xxzy, c1.xyzx
-    cmp r4.x, r4.w, r0.x, c1.w
-    mad r4.w, r3.w, r3.y, r3.y
-    cmp r4.w, -r4.w, c1.x, c1.y
-    mad r2.x, r3.z, r3.x, r3.x
-    cmp r3.xy, r0.w, r3.x, c1
-    mul r3.xy, r1.w, r3
-    cmp r2.x, -r2.x, c1.x, c1.y
-    cmp r2.x, -r2.w, r2.x, c1.y
-    cmp r3.zw, -r2.w, c1.xyxy, c1.xyyx
-    mad r3.w, r3.w, r2.x, r3.z
-    cmp r3.w, -r3.w, c1.x, c1.y
-    cmp r2.x, r0.w, r3.w, c1.y
-    cmp r0.w, r0.w, r3.w, r3.z
-    cmp r2.w, -r2.x, c1.y, c1.x
-    cmp r3.z, -r0.w, c1.y, c1.x
-    mul r2.w, r2.w, r3.z
-    cmp r4.w, -r2.w, c1.y, r4.w
-    mul r4.w, r2.w, r4.w
-    cmp r4.xyz, -r2.w, r0, r4
-    add r2.x, r2.x, r4.w
-    add r2.w, r0.w, r4.w
-    cmp r2.w, -r2.w, c1.x, c1.y
-    cmp r4.w, -r2.x, c1.x, c1.y
-    add r1.z, r1.z, r3.y
-    cmp r2.x, -r3.x, c1.y, c1.x
-    cmp r3.xy, -r1.z, c1, c1.yxzw
-    mul r2.x, r2.x, r3.y
-    mul r1.w, r1.w, r2.x
-    cmp r4.w, -r1.w, c1.y, r4.w
-    cmp r2.x, -r4.w, c1.y, c1.x
-    cmp r0.w, -r1.w, r0.w, r2.w
-    cmp r2.w, -r0.w, c1.y, c1.x
-    mul r2.x, r2.x, r2.w
-    cmp r0.xyz, -r1.w, r0, r4
-    mul r2.w, r0.z, r0.z
-    mad r3.z, r0.y, r0.y, -r2.w
-    dp2add r3.w, r0.y, r0.z, c0.w
-    mad r4.yz, r1.xxyw, c0.z, r3.xzww
-    dp2add r2.w, r4.yzzw, -r4.yzzw, c0.z
-    cmp r3.zw, r2.w, c1.xyxy, c1.xyyx
-    cmp r4.x, r2.w, r0.x, c0.z
-    cmp r4.xyz, -r2.x, r0, r4
-    mad r2.w, r3.w, r3.z, r3.z
-    cmp r2.w, -r2.w, c1.x, c1.y
-    cmp r2.w, -r2.x, c1.y, r2.w
-    mul r2.x, r2.x, r2.w
-    add r2.w, r4.w, r2.x
-    add r4.w, r0.w, r2.x
-    cmp r4.w, -r4.w, c1.x, c1.y
-    cmp r2.x, -r2.w, c1.x, c1.y
-    mul r2.w, r2.z, r2.z
-    mad r3.z, r2.y, r2.y, -r2.w
-    dp2add r3.w, r2.y, r2.z, c0.w
-    mad r2.yz, r1.xxyw, c0.z, r3.xzww
-    dp2add r2.w, r2.yzzw, -r2.yzzw, c0.z
-    cmp r2.w, r2.w, c1.x, c1.y
-    cmp r3.zw, -r1.z, r2.w, c1.xyxy
-    mul r3.yz, r3.y, r3.xzww
-    add r2.w, r3.x, r3.z
-    cmp r1.z, -r3.y, c1.y, c1.x
-    cmp r3.xy, -r2.w, c1, c1.yxzw
-    mul r1.z, r1.z, r3.y
-    mul r1.z, r1.w, r1.z
-    cmp r1.w, -r1.z, c1.y, r2.x
-    cmp r2.x, -r1.w, c1.y, c1.x
-    cmp r0.w, -r1.z, r0.w, r4.w
-    cmp r4.w, -r0.w, c1.y, c1.x
-    mul r4.w, r2.x, r4.w
-    cmp r0.xyz, -r1.z, r0, r4
-    mul r2.x, r0.z, r0.z
-    mad r3.z, r0.y, r0.y, -r2.x
-    dp2add r3.w, r0.y, r0.z, c0.w
-    mad r4.yz, r1.xxyw, c0.z, r3.xzww
-    dp2add r2.x, r4.yzzw, -r4.yzzw, c0.z
-    cmp r3.zw, r2.x, c1.xyxy, c1.xyyx
-    cmp r4.x, r2.x, r0.x, c4.w
-    cmp r4.xyz, -r4.w, r0, r4
-    mad r2.x, r3.w, r3.z, r3.z
-    cmp r2.x, -r2.x, c1.x, c1.y
-    cmp r2.x, -r4.w, c1.y, r2.x
-    mul r4.w, r4.w, r2.x
-    add r1.w, r1.w, r4.w
-    add r4.w, r0.w, r4.w
-    cmp r4.w, -r4.w, c1.x, c1.y
-    cmp r1.w, -r1.w, c1.x, c1.y
-    mul r2.x, r2.z, r2.z
-    mad r3.z, r2.y, r2.y, -r2.x
-    dp2add r3.w, r2.y, r2.z, c0.w
-    mad r2.xy, r1, c0.z, r3.zwzw
-    dp2add r2.z, r2, -r2, c0.z
-    cmp r2.z, r2.z, c1.x, c1.y
-    cmp r2.zw, -r2.w, r2.z, c1.xyxy
-    mul r2.zw, r3.y, r2
-    add r2.w, r3.x, r2.w
-    cmp r2.z, -r2.z, c1.y, c1.x
-    cmp r3.xy, -r2.w, c1, c1.yxzw
-    mul r2.z, r2.z, r3.y
-    mul r1.z, r1.z, r2.z
-    cmp r1.w, -r1.z, c1.y, r1.w
-    cmp r2.z, -r1.w, c1.y, c1.x
-    cmp r0.w, -r1.z, r0.w, r4.w
-    cmp r4.w, -r0.w, c1.y, c1.x
-    mul r4.w, r2.z, r4.w
-    cmp r0.xyz, -r1.z, r0, r4
-    mul r2.z, r0.z, r0.z
-    mad r3.z, r0.y, r0.y, -r2.z
-    dp2add r3.w, r0.y, r0.z, c0.w
-    mad r4.yz, r1.xxyw, c0.z, r3.xzww
-    dp2add r2.z, r4.yzzw, -r4.yzzw, c0.z
-    cmp r3.zw, r2.z, c1.xyxy, c1.xyyx
-    cmp r4.x, r2.z, r0.x, c5.x
-    cmp r4.xyz, -r4.w, r0, r4
-    mad r2.z, r3.w, r3.z, r3.z
-    cmp r2.z, -r2.z, c1.x, c1.y
-    cmp r2.z, -r4.w, c1.y, r2.z
-    mul r4.w, r4.w, r2.z
-    add r1.w, r1.w, r4.w
-    add r4.w, r0.w, r4.w
-    cmp r4.w, -r4.w, c1.x, c1.y
-    cmp r1.w, -r1.w, c1.x, c1.y
-    mul r2.z, r2.y, r2.y
-    mad r3.z, r2.x, r2.x, -r2.z
-    dp2add r3.w, r2.x, r2.y, c0.w
-    mad r2.xy, r1, c0.z, r3.zwzw
-    dp2add r2.z, r2, -r2, c0.z
-    cmp r2.z, r2.z, c1.x, c1.y
-    cmp r2.zw, -r2.w, r2.z, c1.xyxy
-    mul r2.zw, r3.y, r2
-    add r2.w, r3.x, r2.w
-    cmp r2.z, -r2.z, c1.y, c1.x
-    cmp r3.xy, -r2.w, c1, c1.yxzw
-    mul r2.z, r2.z, r3.y
-    mul r1.z, r1.z, r2.z
-    cmp r1.w, -r1.z, c1.y, r1.w
-    cmp r2.z, -r1.w, c1.y, c1.x
-    cmp r0.w, -r1.z, r0.w, r4.w
-    cmp r4.w, -r0.w, c1.y, c1.x
-    mul r4.w, r2.z, r4.w
-    cmp r0.xyz, -r1.z, r0, r4
-    mul r2.z, r0.z, r0.z
-    mad r3.z, r0.y, r0.y, -r2.z
-    dp2add r3.w, r0.y, r0.z, c0.w
-    mad r4.yz, r1.xxyw, c0.z, r3.xzww
-    dp2add r2.z, r4.yzzw, -r4.yzzw, c0.z
-    cmp r3.zw, r2.z, c1.xyxy, c1.xyyx
-    cmp r4.x, r2.z, r0.x, c5.y
-    cmp r4.xyz, -r4.w, r0, r4
-    mad r2.z, r3.w, r3.z, r3.z
-    cmp r2.z, -r2.z, c1.x, c1.y
-    cmp r2.z, -r4.w, c1.y, r2.z
-    mul r4.w, r4.w, r2.z
-    add r1.w, r1.w, r4.w
-    add r4.w, r0.w, r4.w
-    cmp r4.w, -r4.w, c1.x, c1.y
-    cmp r1.w, -r1.w, c1.x, c1.y
-    mul r2.z, r2.y, r2.y
-    mad r3.z, r2.x, r2.x, -r2.z
-    dp2add r3.w, r2.x, r2.y, c0.w
-    mad r2.xy, r1, c0.z, r3.zwzw
-    dp2add r2.z, r2, -r2, c0.z
-    cmp r2.z, r2.z, c1.x, c1.y
-    cmp r2.zw, -r2.w, r2.z, c1.xyxy
-    mul r2.zw, r3.y, r2
-    add r2.w, r3.x, r2.w
-    cmp r2.z, -r2.z, c1.y, c1.x
-    cmp r3.xy, -r2.w, c1, c1.yxzw
-    mul r2.z, r2.z, r3.y
-    mul r1.z, r1.z, r2.z
-    cmp r1.w, -r1.z, c1.y, r1.w
-    cmp r2.z, -r1.w, c1.y, c1.x
-    cmp r0.w, -r1.z, r0.w, r4.w
-    cmp r4.w, -r0.w, c1.y, c1.x
-    mul r4.w, r2.z, r4.w
-    cmp r0.xyz, -r1.z, r0, r4
-    mul r2.z, r0.z, r0.z
-    mad r3.z, r0.y, r0.y, -r2.z
-    dp2add r3.w, r0.y, r0.z, c0.w
-    mad r4.yz, r1.xxyw, c0.z, r3.xzww
-    dp2add r2.z, r4.yzzw, -r4.yzzw, c0.z
-    cmp r3.zw, r2.z, c1.xyxy, c1.xyyx
-    cmp r4.x, r2.z, r0.x, c5.z
-    cmp r4.xyz, -r4.w, r0, r4
-    mad r2.z, r3.w, r3.z, r3.z
-    cmp r2.z, -r2.z, c1.x, c1.y
-    cmp r2.z, -r4.w, c1.y, r2.z
-    mul r4.w, r4.w, r2.z
-    add r1.w, r1.w, r4.w
-    add r4.w, r0.w, r4.w
-    cmp r4.w, -r4.w, c1.x, c1.y
-    cmp r1.w, -r1.w, c1.x, c1.y
-    mul r2.z, r2.y, r2.y
-    mad r3.z, r2.x, r2.x, -r2.z
-    dp2add r3.w, r2.x, r2.y, c0.w
-    mad r2.xy, r1, c0.z, r3.zwzw
-    dp2add r2.z, r2, -r2, c0.z
-    cmp r2.z, r2.z, c1.x, c1.y
-    cmp r2.zw, -r2.w, r2.z, c1.xyxy
-    mul r2.zw, r3.y, r2
-    add r2.w, r3.x, r2.w
-    cmp r2.z, -r2.z, c1.y, c1.x
-    cmp r3.xy, -r2.w, c1, c1.yxzw
-    mul r2.z, r2.z, r3.y
-    mul r1.z, r1.z, r2.z
-    cmp r1.w, -r1.z, c1.y, r1.w
-    cmp r2.z, -r1.w, c1.y, c1.x
-    cmp r0.w, -r1.z, r0.w, r4.w
-    cmp r4.w, -r0.w, c1.y, c1.x
-    mul r4.w, r2.z, r4.w
-    cmp r0.xyz, -r1.z, r0, r4
-    mul r2.z, r0.z, r0.z
-    mad r3.z, r0.y, r0.y, -r2.z
-    dp2add r3.w, r0.y, r0.z, c0.w
-    mad r4.yz, r1.xxyw, c0.z, r3.xzww
-    dp2add r2.z, r4.yzzw, -r4.yzzw, c0.z
-    cmp r3.zw, r2.z, c1.xyxy, c1.xyyx
-    cmp r4.x, r2.z, r0.x, c5.w
-    cmp r4.xyz, -r4.w, r0, r4
-    mad r2.z, r3.w, r3.z, r3.z
-    cmp r2.z, -r2.z, c1.x, c1.y
-    cmp r2.z, -r4.w, c1.y, r2.z
-    mul r4.w, r4.w, r2.z
-    add r1.w, r1.w, r4.w
-    add r4.w, r0.w, r4.w
-    cmp r4.w, -r4.w, c1.x, c1.y
-    cmp r1.w, -r1.w, c1.x, c1.y
-    mul r2.z, r2.y, r2.y
-    mad r3.z, r2.x, r2.x, -r2.z
-    dp2add r3.w, r2.x, r2.y, c0.w
-    mad r2.xy, r1, c0.z, r3.zwzw
-    dp2add r2.z, r2, -r2, c0.z
-    cmp r2.z, r2.z, c1.x, c1.y
-    cmp r2.zw, -r2.w, r2.z, c1.xyxy
-    mul r2.zw, r3.y, r2
-    add r2.w, r3.x, r2.w
-    cmp r2.z, -r2.z, c1.y, c1.x
-    cmp r3.xy, -r2.w, c1, c1.yxzw
-    mul r2.z, r2.z, r3.y
-    mul r1.z, r1.z, r2.z
-    cmp r1.w, -r1.z, c1.y, r1.w
-    cmp r2.z, -r1.w, c1.y, c1.x
-    cmp r0.w, -r1.z, r0.w, r4.w
-    cmp r4.w, -r0.w, c1.y, c1.x
-    mul r4.w, r2.z, r4.w
-    cmp r0.xyz, -r1.z, r0, r4
-    mul r2.z, r0.z, r0.z
-    mad r3.z, r0.y, r0.y, -r2.z
-    dp2add r3.w, r0.y, r0.z, c0.w
-    mad r4.yz, r1.xxyw, c0.z, r3.xzww
-    dp2add r2.z, r4.yzzw, -r4.yzzw, c0.z
-    cmp r3.zw, r2.z, c1.xyxy, c1.xyyx
-    cmp r4.x, r2.z, r0.x, c6.x
-    cmp r4.xyz, -r4.w, r0, r4
-    mad r2.z, r3.w, r3.z, r3.z
-    cmp r2.z, -r2.z, c1.x, c1.y
-    cmp r2.z, -r4.w, c1.y, r2.z
-    mul r4.w, r4.w, r2.z
-    add r1.w, r1.w, r4.w
-    add r4.w, r0.w, r4.w
-    cmp r4.w, -r4.w, c1.x, c1.y
-    cmp r1.w, -r1.w, c1.x, c1.y
-    mul r2.z, r2.y, r2.y
-    mad r3.z, r2.x, r2.x, -r2.z
-    dp2add r3.w, r2.x, r2.y, c0.w
-    mad r2.xy, r1, c0.z, r3.zwzw
-    dp2add r2.z, r2, -r2, c0.z
-    cmp r2.z, r2.z, c1.x, c1.y
-    cmp r2.zw, -r2.w, r2.z, c1.xyxy
-    mul r2.zw, r3.y, r2
-    add r2.w, r3.x, r2.w
-    cmp r2.z, -r2.z, c1.y, c1.x
-    cmp r3.xy, -r2.w, c1, c1.yxzw
-    mul r2.z, r2.z, r3.y
-    mul r1.z, r1.z, r2.z
-    cmp r1.w, -r1.z, c1.y, r1.w
-    cmp r2.z, -r1.w, c1.y, c1.x
-    cmp r0.w, -r1.z, r0.w, r4.w
-    cmp r4.w, -r0.w, c1.y, c1.x
-    mul r4.w, r2.z, r4.w
-    cmp r0.xyz, -r1.z, r0, r4
-    mul r2.z, r0.z, r0.z
-    mad r3.z, r0.y, r0.y, -r2.z
-    dp2add r3.w, r0.y, r0.z, c0.w
-    mad r4.yz, r1.xxyw, c0.z, r3.xzww
-    dp2add r2.z, r4.yzzw, -r4.yzzw, c0.z
-    cmp r3.zw, r2.z, c1.xyxy, c1.xyyx
-    cmp r4.x, r2.z, r0.x, c6.y
-    cmp r4.xyz, -r4.w, r0, r4
-    mad r2.z, r3.w, r3.z, r3.z
-    cmp r2.z, -r2.z, c1.x, c1.y
-    cmp r2.z, -r4.w, c1.y, r2.z
-    mul r4.w, r4.w, r2.z
-    add r1.w, r1.w, r4.w
-    add r4.w, r0.w, r4.w
-    cmp r4.w, -r4.w, c1.x, c1.y
-    cmp r1.w, -r1.w, c1.x, c1.y
-    mul r2.z, r2.y, r2.y
-    mad r3.z, r2.x, r2.x, -r2.z
-    dp2add r3.w, r2.x, r2.y, c0.w
-    mad r2.xy, r1, c0.z, r3.zwzw
-    dp2add r2.z, r2, -r2, c0.z
-    cmp r2.z, r2.z, c1.x, c1.y
-    cmp r2.zw, -r2.w, r2.z, c1.xyxy
-    mul r2.zw, r3.y, r2
-    add r2.w, r3.x, r2.w
-    cmp r2.z, -r2.z, c1.y, c1.x
-    cmp r3.xy, -r2.w, c1, c1.yxzw
-    mul r2.z, r2.z, r3.y
-    mul r1.z, r1.z, r2.z
-    cmp r1.w, -r1.z, c1.y, r1.w
-    cmp r2.z, -r1.w, c1.y, c1.x
-    cmp r0.w, -r1.z, r0.w, r4.w
-    cmp r4.w, -r0.w, c1.y, c1.x
-    mul r4.w, r2.z, r4.w
-    cmp r0.xyz, -r1.z, r0, r4
-    mul r2.z, r0.z, r0.z
-    mad r3.z, r0.y, r0.y, -r2.z
-    dp2add r3.w, r0.y, r0.z, c0.w
-    mad r4.yz, r1.xxyw, c0.z, r3.xzww
-    dp2add r2.z, r4.yzzw, -r4.yzzw, c0.z
-    cmp r3.zw, r2.z, c1.xyxy, c1.xyyx
-    cmp r4.x, r2.z, r0.x, c6.z
-    cmp r4.xyz, -r4.w, r0, r4
-    mad r2.z, r3.w, r3.z, r3.z
-    cmp r2.z, -r2.z, c1.x, c1.y
-    cmp r2.z, -r4.w, c1.y, r2.z
-    mul r4.w, r4.w, r2.z
-    add r1.w, r1.w, r4.w
-    add r4.w, r0.w, r4.w
-    cmp r4.w, -r4.w, c1.x, c1.y
-    cmp r1.w, -r1.w, c1.x, c1.y
-    mul r2.z, r2.y, r2.y
-    mad r3.z, r2.x, r2.x, -r2.z
-    dp2add r3.w, r2.x, r2.y, c0.w
-    mad r2.xy, r1, c0.z, r3.zwzw
-    dp2add r2.z, r2, -r2, c0.z
-    cmp r2.z, r2.z, c1.x, c1.y
-    cmp r2.zw, -r2.w, r2.z, c1.xyxy
-    mul r2.zw, r3.y, r2
-    add r2.w, r3.x, r2.w
-    cmp r2.z, -r2.z, c1.y, c1.x
-    cmp r3.xy, -r2.w, c1, c1.yxzw
-    mul r2.z, r2.z, r3.y
-    mul r1.z, r1.z, r2.z
-    cmp r1.w, -r1.z, c1.y, r1.w
-    cmp r1.w, -r1.w, c1.y, c1.x
-    cmp r0.w, -r1.z, r0.w, r4.w
-    cmp r4.w, -r0.w, c1.y, c1.x
-    mul r1.w, r1.w, r4.w
-    cmp r0.xyz, -r1.z, r0, r4
-    mul r2.z, r0.z, r0.z
-    mad r3.z, r0.y, r0.y, -r2.z
-    dp2add r3.w, r0.y, r0.z, c0.w
-    mad r0.yz, r1.xxyw, c0.z, r3.xzww
-    dp2add r0.y, r0.yzzw, -r0.yzzw, c0.z
-    cmp r3.zw, r0.y, c1.xyxy, c1.xyyx
-    cmp r0.y, r0.y, r0.x, c6.w
-    cmp r0.y, -r1.w, r0.x, r0.y
-    mad r0.z, r3.w, r3.z, r3.z
-    cmp r0.z, -r0.z, c1.x, c1.y
-    cmp r0.z, -r1.w, c1.y, r0.z
-    mad r1.w, r1.w, r0.z, r0.w
-    cmp r1.w, -r1.w, c1.x, c1.y
-    mul r0.z, r2.y, r2.y
-    mad r3.z, r2.x, r2.x, -r0.z
-    dp2add r3.w, r2.x, r2.y, c0.w
-    mad r1.xy, r1, c0.z, r3.zwzw
-    dp2add r0.z, r1, -r1, c0.z
-    cmp r0.z, r0.z, c1.x, c1.y
-    cmp r1.xy, -r2.w, r0.z, c1
-    mul r1.xy, r3.y, r1
-    add r0.z, r3.x, r1.y
-    cmp r1.x, -r1.x, c1.y, c1.x
-    cmp r0.z, -r0.z, c1.y, c1.x
-    mul r0.z, r1.x, r0.z
-    mul r0.z, r1.z, r0.z
-    cmp r0.w, -r0.z, r0.w, r1.w
-    cmp r0.x, -r0.z, r0.x, r0.y
-    cmp r0.x, -r0.w, c2.x, r0.x
-    texld r1, t0, s0
-    mad r0.y, r0.x, c2.y, r1.w
-    mad r0.z, r0.x, -c2.y, c2.w
-    mul r0.xw, r0.x, c2.yyzz
-    min r1.x, r0.z, r0.x
-    mul r0.y, r0.y, r1.x
-    mad r0.z, r1.w, c0.z, r0.w
-    mul r0.w, r0.z, c6.z
-    cmp r1.xy, r0.z, c3, c3.zwzw
-    mad r2, r0.z, c7.x, c7.yyzz
-    mul r0.z, r0.w, r1.y
-    frc r0.z, r0.z
-    mad r0.w, r1.x, -r0.z, c5.w
-    mad r0.z, r1.x, r0.z, -c1.w
-    min r1.x, c1.y, r0.w
-    min r3.x, r1.x, r0.z
-    max r0.z, -c1.y, r3.x
-    mad r1.x, r0.y, -r0.z, r0.x
-    cmp r3, r2.yyww, c3.xyxy, c3.zwzw
-    mul r2, r2, r3.yyww
-    frc r2, r2
-    mad r4, r3.xxzz, -r2, c5.wzwz
-    mad r0.zw, r3.xyxz, r2.xyyw, -c1.w
-    cmp r2.xy, r4.ywzw, c1.y, r4.xzzw
-    min r3.xy, r2, r0.zwzw
-    max r0.zw, -c1.y, r3.xyxy
-    mad r1.yz, r0.y, -r0.xzww, r0.x
-    mov r1.w, c1.y
-    mov oC0, r1
-
-// approximately 474 instruction slots used (1 texture, 473 arithmetic)
-#endif
-
-const DWORD g_ps21_main[] =
-{
-    0xffff0201, 0x0020fffe, 0x42415443, 0x0000001c, 0x0000004b, 0xffff0201, 
-    0x00000001, 0x0000001c, 0x20008100, 0x00000044, 0x00000030, 0x00000003, 
-    0x00020001, 0x00000034, 0x00000000, 0x00786574, 0x000c0004, 0x00010001, 
-    0x00000001, 0x00000000, 0x325f7370, 0x4d00615f, 0x6f726369, 0x74666f73, 
-    0x29522820, 0x534c4820, 0x6853204c, 0x72656461, 0x6d6f4320, 0x656c6970, 
-    0x2e392072, 0x392e3232, 0x322e3934, 0x00383432, 0x05000051, 0xa00f0000, 
-    0xbf333333, 0xbf000000, 0x40800000, 0x00000000, 0x05000051, 0xa00f0001, 
-    0x00000000, 0x3f800000, 0x40000000, 0x40400000, 0x05000051, 0xa00f0002, 
-    0x41600000, 0x3d924925, 0x3c924925, 0x3f800000, 0x05000051, 0xa00f0003, 
-    0x41400000, 0x3daaaaab, 0xc1400000, 0xbdaaaaab, 0x05000051, 0xa00f0004, 
-    0x3f800000, 0xc0333333, 0xc0000000, 0x40a00000, 0x05000051, 0xa00f0005, 
-    0x40c00000, 0x40e00000, 0x41000000, 0x41100000, 0x05000051, 0xa00f0006, 
-    0x41200000, 0x41300000, 0x41400000, 0x41500000, 0x05000051, 0xa00f0007, 
-    0x41400000, 0x41000000, 0x40800000, 0x00000000, 0x0200001f, 0x80000000, 
-    0xb0030000, 0x0200001f, 0x90000000, 0xa00f0800, 0x02000001, 0x800c0000, 
-    0xa0e40000, 0x04000004, 0x80070000, 0xb0d00000, 0x80eb0000, 0xa0e40004, 
-    0x03000002, 0x80030001, 0xb0e40000, 0xa0e40000, 0x03000005, 0x800c0001, 
-    0x80440001, 0xa0aa0000, 0x03000005, 0x80080000, 0x80ff0001, 0x80ff0001, 
-    0x04000004, 0x80010002, 0x80aa0001, 0x80aa0001, 0x81ff0000, 0x0400005a, 
-    0x80020002, 0x80aa0001, 0x80ff0001, 0xa0ff0000, 0x0400005a, 0x80080000, 
-    0x80ee0001, 0x81ee0001, 0xa0aa0000, 0x04000004, 0x80060002, 0x80d00001, 
-    0xa0aa0000, 0x80d00002, 0x0400005a, 0x80080002, 0x80e90002, 0x81e90002, 
-    0xa0aa0000, 0x04000058, 0x80070003, 0x80ff0002, 0xa0d40001, 0xa0c90001, 
-    0x02000001, 0x80010002, 0x80550003, 0x04000058, 0x800c0001, 0x80ff0000, 
-    0xa0440001, 0xa0140001, 0x04000004, 0x80080002, 0x80ff0001, 0x80aa0001, 
-    0x80aa0001, 0x04000058, 0x80070004, 0x81ff0002, 0x80e40002, 0x80e40000, 
-    0x04000058, 0x80070000, 0x80ff0000, 0x80e40004, 0x80e40000, 0x03000005, 
-    0x80010002, 0x80aa0000, 0x80aa0000, 0x04000004, 0x80020003, 0x80550000, 
-    0x80550000, 0x81000002, 0x0400005a, 0x80080003, 0x80550000, 0x80aa0000, 
-    0xa0ff0000, 0x04000004, 0x80060004, 0x80d00001, 0xa0aa0000, 0x80f40003, 
-    0x0400005a, 0x80080004, 0x80e90004, 0x81e90004, 0xa0aa0000, 0x04000058, 
-    0x800a0003, 0x80ff0004, 0xa0600001, 0xa0240001, 0x04000058, 0x80010004, 
-    0x80ff0004, 0x80000000, 0xa0ff0001, 0x04000004, 0x80080004, 0x80ff0003, 
-    0x80550003, 0x80550003, 0x04000058, 0x80080004, 0x81ff0004, 0xa0000001, 
-    0xa0550001, 0x04000004, 0x80010002, 0x80aa0003, 0x80000003, 0x80000003, 
-    0x04000058, 0x80030003, 0x80ff0000, 0x80000003, 0xa0e40001, 0x03000005, 
-    0x80030003, 0x80ff0001, 0x80e40003, 0x04000058, 0x80010002, 0x81000002, 
-    0xa0000001, 0xa0550001, 0x04000058, 0x80010002, 0x81ff0002, 0x80000002, 
-    0xa0550001, 0x04000058, 0x800c0003, 0x81ff0002, 0xa0440001, 0xa0140001, 
-    0x04000004, 0x80080003, 0x80ff0003, 0x80000002, 0x80aa0003, 0x04000058, 
-    0x80080003, 0x81ff0003, 0xa0000001, 0xa0550001, 0x04000058, 0x80010002, 
-    0x80ff0000, 0x80ff0003, 0xa0550001, 0x04000058, 0x80080000, 0x80ff0000, 
-    0x80ff0003, 0x80aa0003, 0x04000058, 0x80080002, 0x81000002, 0xa0550001, 
-    0xa0000001, 0x04000058, 0x80040003, 0x81ff0000, 0xa0550001, 0xa0000001, 
-    0x03000005, 0x80080002, 0x80ff0002, 0x80aa0003, 0x04000058, 0x80080004, 
-    0x81ff0002, 0xa0550001, 0x80ff0004, 0x03000005, 0x80080004, 0x80ff0002, 
-    0x80ff0004, 0x04000058, 0x80070004, 0x81ff0002, 0x80e40000, 0x80e40004, 
-    0x03000002, 0x80010002, 0x80000002, 0x80ff0004, 0x03000002, 0x80080002, 
-    0x80ff0000, 0x80ff0004, 0x04000058, 0x80080002, 0x81ff0002, 0xa0000001, 
-    0xa0550001, 0x04000058, 0x80080004, 0x81000002, 0xa0000001, 0xa0550001, 
-    0x03000002, 0x80040001, 0x80aa0001, 0x80550003, 0x04000058, 0x80010002, 
-    0x81000003, 0xa0550001, 0xa0000001, 0x04000058, 0x80030003, 0x81aa0001, 
-    0xa0e40001, 0xa0e10001, 0x03000005, 0x80010002, 0x80000002, 0x80550003, 
-    0x03000005, 0x80080001, 0x80ff0001, 0x80000002, 0x04000058, 0x80080004, 
-    0x81ff0001, 0xa0550001, 0x80ff0004, 0x04000058, 0x80010002, 0x81ff0004, 
-    0xa0550001, 0xa0000001, 0x04000058, 0x80080000, 0x81ff0001, 0x80ff0000, 
-    0x80ff0002, 0x04000058, 0x80080002, 0x81ff0000, 0xa0550001, 0xa0000001, 
-    0x03000005, 0x80010002, 0x80000002, 0x80ff0002, 0x04000058, 0x80070000, 
-    0x81ff0001, 0x80e40000, 0x80e40004, 0x03000005, 0x80080002, 0x80aa0000, 
-    0x80aa0000, 0x04000004, 0x80040003, 0x80550000, 0x80550000, 0x81ff0002, 
-    0x0400005a, 0x80080003, 0x80550000, 0x80aa0000, 0xa0ff0000, 0x04000004, 
-    0x80060004, 0x80d00001, 0xa0aa0000, 0x80f80003, 0x0400005a, 0x80080002, 
-    0x80e90004, 0x81e90004, 0xa0aa0000, 0x04000058, 0x800c0003, 0x80ff0002, 
-    0xa0440001, 0xa0140001, 0x04000058, 0x80010004, 0x80ff0002, 0x80000000, 
-    0xa0aa0000, 0x04000058, 0x80070004, 0x81000002, 0x80e40000, 0x80e40004, 
-    0x04000004, 0x80080002, 0x80ff0003, 0x80aa0003, 0x80aa0003, 0x04000058, 
-    0x80080002, 0x81ff0002, 0xa0000001, 0xa0550001, 0x04000058, 0x80080002, 
-    0x81000002, 0xa0550001, 0x80ff0002, 0x03000005, 0x80010002, 0x80000002, 
-    0x80ff0002, 0x03000002, 0x80080002, 0x80ff0004, 0x80000002, 0x03000002, 
-    0x80080004, 0x80ff0000, 0x80000002, 0x04000058, 0x80080004, 0x81ff0004, 
-    0xa0000001, 0xa0550001, 0x04000058, 0x80010002, 0x81ff0002, 0xa0000001, 
-    0xa0550001, 0x03000005, 0x80080002, 0x80aa0002, 0x80aa0002, 0x04000004, 
-    0x80040003, 0x80550002, 0x80550002, 0x81ff0002, 0x0400005a, 0x80080003, 
-    0x80550002, 0x80aa0002, 0xa0ff0000, 0x04000004, 0x80060002, 0x80d00001, 
-    0xa0aa0000, 0x80f80003, 0x0400005a, 0x80080002, 0x80e90002, 0x81e90002, 
-    0xa0aa0000, 0x04000058, 0x80080002, 0x80ff0002, 0xa0000001, 0xa0550001, 
-    0x04000058, 0x800c0003, 0x81aa0001, 0x80ff0002, 0xa0440001, 0x03000005, 
-    0x80060003, 0x80550003, 0x80f80003, 0x03000002, 0x80080002, 0x80000003, 
-    0x80aa0003, 0x04000058, 0x80040001, 0x81550003, 0xa0550001, 0xa0000001, 
-    0x04000058, 0x80030003, 0x81ff0002, 0xa0e40001, 0xa0e10001, 0x03000005, 
-    0x80040001, 0x80aa0001, 0x80550003, 0x03000005, 0x80040001, 0x80ff0001, 
-    0x80aa0001, 0x04000058, 0x80080001, 0x81aa0001, 0xa0550001, 0x80000002, 
-    0x04000058, 0x80010002, 0x81ff0001, 0xa0550001, 0xa0000001, 0x04000058, 
-    0x80080000, 0x81aa0001, 0x80ff0000, 0x80ff0004, 0x04000058, 0x80080004, 
-    0x81ff0000, 0xa0550001, 0xa0000001, 0x03000005, 0x80080004, 0x80000002, 
-    0x80ff0004, 0x04000058, 0x80070000, 0x81aa0001, 0x80e40000, 0x80e40004, 
-    0x03000005, 0x80010002, 0x80aa0000, 0x80aa0000, 0x04000004, 0x80040003, 
-    0x80550000, 0x80550000, 0x81000002, 0x0400005a, 0x80080003, 0x80550000, 
-    0x80aa0000, 0xa0ff0000, 0x04000004, 0x80060004, 0x80d00001, 0xa0aa0000, 
-    0x80f80003, 0x0400005a, 0x80010002, 0x80e90004, 0x81e90004, 0xa0aa0000, 
-    0x04000058, 0x800c0003, 0x80000002, 0xa0440001, 0xa0140001, 0x04000058, 
-    0x80010004, 0x80000002, 0x80000000, 0xa0ff0004, 0x04000058, 0x80070004, 
-    0x81ff0004, 0x80e40000, 0x80e40004, 0x04000004, 0x80010002, 0x80ff0003, 
-    0x80aa0003, 0x80aa0003, 0x04000058, 0x80010002, 0x81000002, 0xa0000001, 
-    0xa0550001, 0x04000058, 0x80010002, 0x81ff0004, 0xa0550001, 0x80000002, 
-    0x03000005, 0x80080004, 0x80ff0004, 0x80000002, 0x03000002, 0x80080001, 
-    0x80ff0001, 0x80ff0004, 0x03000002, 0x80080004, 0x80ff0000, 0x80ff0004, 
-    0x04000058, 0x80080004, 0x81ff0004, 0xa0000001, 0xa0550001, 0x04000058, 
-    0x80080001, 0x81ff0001, 0xa0000001, 0xa0550001, 0x03000005, 0x80010002, 
-    0x80aa0002, 0x80aa0002, 0x04000004, 0x80040003, 0x80550002, 0x80550002, 
-    0x81000002, 0x0400005a, 0x80080003, 0x80550002, 0x80aa0002, 0xa0ff0000, 
-    0x04000004, 0x80030002, 0x80e40001, 0xa0aa0000, 0x80ee0003, 0x0400005a, 
-    0x80040002, 0x80e40002, 0x81e40002, 0xa0aa0000, 0x04000058, 0x80040002, 
-    0x80aa0002, 0xa0000001, 0xa0550001, 0x04000058, 0x800c0002, 0x81ff0002, 
-    0x80aa0002, 0xa0440001, 0x03000005, 0x800c0002, 0x80550003, 0x80e40002, 
-    0x03000002, 0x80080002, 0x80000003, 0x80ff0002, 0x04000058, 0x80040002, 
-    0x81aa0002, 0xa0550001, 0xa0000001, 0x04000058, 0x80030003, 0x81ff0002, 
-    0xa0e40001, 0xa0e10001, 0x03000005, 0x80040002, 0x80aa0002, 0x80550003, 
-    0x03000005, 0x80040001, 0x80aa0001, 0x80aa0002, 0x04000058, 0x80080001, 
-    0x81aa0001, 0xa0550001, 0x80ff0001, 0x04000058, 0x80040002, 0x81ff0001, 
-    0xa0550001, 0xa0000001, 0x04000058, 0x80080000, 0x81aa0001, 0x80ff0000, 
-    0x80ff0004, 0x04000058, 0x80080004, 0x81ff0000, 0xa0550001, 0xa0000001, 
-    0x03000005, 0x80080004, 0x80aa0002, 0x80ff0004, 0x04000058, 0x80070000, 
-    0x81aa0001, 0x80e40000, 0x80e40004, 0x03000005, 0x80040002, 0x80aa0000, 
-    0x80aa0000, 0x04000004, 0x80040003, 0x80550000, 0x80550000, 0x81aa0002, 
-    0x0400005a, 0x80080003, 0x80550000, 0x80aa0000, 0xa0ff0000, 0x04000004, 
-    0x80060004, 0x80d00001, 0xa0aa0000, 0x80f80003, 0x0400005a, 0x80040002, 
-    0x80e90004, 0x81e90004, 0xa0aa0000, 0x04000058, 0x800c0003, 0x80aa0002, 
-    0xa0440001, 0xa0140001, 0x04000058, 0x80010004, 0x80aa0002, 0x80000000, 
-    0xa0000005, 0x04000058, 0x80070004, 0x81ff0004, 0x80e40000, 0x80e40004, 
-    0x04000004, 0x80040002, 0x80ff0003, 0x80aa0003, 0x80aa0003, 0x04000058, 
-    0x80040002, 0x81aa0002, 0xa0000001, 0xa0550001, 0x04000058, 0x80040002, 
-    0x81ff0004, 0xa0550001, 0x80aa0002, 0x03000005, 0x80080004, 0x80ff0004, 
-    0x80aa0002, 0x03000002, 0x80080001, 0x80ff0001, 0x80ff0004, 0x03000002, 
-    0x80080004, 0x80ff0000, 0x80ff0004, 0x04000058, 0x80080004, 0x81ff0004, 
-    0xa0000001, 0xa0550001, 0x04000058, 0x80080001, 0x81ff0001, 0xa0000001, 
-    0xa0550001, 0x03000005, 0x80040002, 0x80550002, 0x80550002, 0x04000004, 
-    0x80040003, 0x80000002, 0x80000002, 0x81aa0002, 0x0400005a, 0x80080003, 
-    0x80000002, 0x80550002, 0xa0ff0000, 0x04000004, 0x80030002, 0x80e40001, 
-    0xa0aa0000, 0x80ee0003, 0x0400005a, 0x80040002, 0x80e40002, 0x81e40002, 
-    0xa0aa0000, 0x04000058, 0x80040002, 0x80aa0002, 0xa0000001, 0xa0550001, 
-    0x04000058, 0x800c0002, 0x81ff0002, 0x80aa0002, 0xa0440001, 0x03000005, 
-    0x800c0002, 0x80550003, 0x80e40002, 0x03000002, 0x80080002, 0x80000003, 
-    0x80ff0002, 0x04000058, 0x80040002, 0x81aa0002, 0xa0550001, 0xa0000001, 
-    0x04000058, 0x80030003, 0x81ff0002, 0xa0e40001, 0xa0e10001, 0x03000005, 
-    0x80040002, 0x80aa0002, 0x80550003, 0x03000005, 0x80040001, 0x80aa0001, 
-    0x80aa0002, 0x04000058, 0x80080001, 0x81aa0001, 0xa0550001, 0x80ff0001, 
-    0x04000058, 0x80040002, 0x81ff0001, 0xa0550001, 0xa0000001, 0x04000058, 
-    0x80080000, 0x81aa0001, 0x80ff0000, 0x80ff0004, 0x04000058, 0x80080004, 
-    0x81ff0000, 0xa0550001, 0xa0000001, 0x03000005, 0x80080004, 0x80aa0002, 
-    0x80ff0004, 0x04000058, 0x80070000, 0x81aa0001, 0x80e40000, 0x80e40004, 
-    0x03000005, 0x80040002, 0x80aa0000, 0x80aa0000, 0x04000004, 0x80040003, 
-    0x80550000, 0x80550000, 0x81aa0002, 0x0400005a, 0x80080003, 0x80550000, 
-    0x80aa0000, 0xa0ff0000, 0x04000004, 0x80060004, 0x80d00001, 0xa0aa0000, 
-    0x80f80003, 0x0400005a, 0x80040002, 0x80e90004, 0x81e90004, 0xa0aa0000, 
-    0x04000058, 0x800c0003, 0x80aa0002, 0xa0440001, 0xa0140001, 0x04000058, 
-    0x80010004, 0x80aa0002, 0x80000000, 0xa0550005, 0x04000058, 0x80070004, 
-    0x81ff0004, 0x80e40000, 0x80e40004, 0x04000004, 0x80040002, 0x80ff0003, 
-    0x80aa0003, 0x80aa0003, 0x04000058, 0x80040002, 0x81aa0002, 0xa0000001, 
-    0xa0550001, 0x04000058, 0x80040002, 0x81ff0004, 0xa0550001, 0x80aa0002, 
-    0x03000005, 0x80080004, 0x80ff0004, 0x80aa0002, 0x03000002, 0x80080001, 
-    0x80ff0001, 0x80ff0004, 0x03000002, 0x80080004, 0x80ff0000, 0x80ff0004, 
-    0x04000058, 0x80080004, 0x81ff0004, 0xa0000001, 0xa0550001, 0x04000058, 
-    0x80080001, 0x81ff0001, 0xa0000001, 0xa0550001, 0x03000005, 0x80040002, 
-    0x80550002, 0x80550002, 0x04000004, 0x80040003, 0x80000002, 0x80000002, 
-    0x81aa0002, 0x0400005a, 0x80080003, 0x80000002, 0x80550002, 0xa0ff0000, 
-    0x04000004, 0x80030002, 0x80e40001, 0xa0aa0000, 0x80ee0003, 0x0400005a, 
-    0x80040002, 0x80e40002, 0x81e40002, 0xa0aa0000, 0x04000058, 0x80040002, 
-    0x80aa0002, 0xa0000001, 0xa0550001, 0x04000058, 0x800c0002, 0x81ff0002, 
-    0x80aa0002, 0xa0440001, 0x03000005, 0x800c0002, 0x80550003, 0x80e40002, 
-    0x03000002, 0x80080002, 0x80000003, 0x80ff0002, 0x04000058, 0x80040002, 
-    0x81aa0002, 0xa0550001, 0xa0000001, 0x04000058, 0x80030003, 0x81ff0002, 
-    0xa0e40001, 0xa0e10001, 0x03000005, 0x80040002, 0x80aa0002, 0x80550003, 
-    0x03000005, 0x80040001, 0x80aa0001, 0x80aa0002, 0x04000058, 0x80080001, 
-    0x81aa0001, 0xa0550001, 0x80ff0001, 0x04000058, 0x80040002, 0x81ff0001, 
-    0xa0550001, 0xa0000001, 0x04000058, 0x80080000, 0x81aa0001, 0x80ff0000, 
-    0x80ff0004, 0x04000058, 0x80080004, 0x81ff0000, 0xa0550001, 0xa0000001, 
-    0x03000005, 0x80080004, 0x80aa0002, 0x80ff0004, 0x04000058, 0x80070000, 
-    0x81aa0001, 0x80e40000, 0x80e40004, 0x03000005, 0x80040002, 0x80aa0000, 
-    0x80aa0000, 0x04000004, 0x80040003, 0x80550000, 0x80550000, 0x81aa0002, 
-    0x0400005a, 0x80080003, 0x80550000, 0x80aa0000, 0xa0ff0000, 0x04000004, 
-    0x80060004, 0x80d00001, 0xa0aa0000, 0x80f80003, 0x0400005a, 0x80040002, 
-    0x80e90004, 0x81e90004, 0xa0aa0000, 0x04000058, 0x800c0003, 0x80aa0002, 
-    0xa0440001, 0xa0140001, 0x04000058, 0x80010004, 0x80aa0002, 0x80000000, 
-    0xa0aa0005, 0x04000058, 0x80070004, 0x81ff0004, 0x80e40000, 0x80e40004, 
-    0x04000004, 0x80040002, 0x80ff0003, 0x80aa0003, 0x80aa0003, 0x04000058, 
-    0x80040002, 0x81aa0002, 0xa0000001, 0xa0550001, 0x04000058, 0x80040002, 
-    0x81ff0004, 0xa0550001, 0x80aa0002, 0x03000005, 0x80080004, 0x80ff0004, 
-    0x80aa0002, 0x03000002, 0x80080001, 0x80ff0001, 0x80ff0004, 0x03000002, 
-    0x80080004, 0x80ff0000, 0x80ff0004, 0x04000058, 0x80080004, 0x81ff0004, 
-    0xa0000001, 0xa0550001, 0x04000058, 0x80080001, 0x81ff0001, 0xa0000001, 
-    0xa0550001, 0x03000005, 0x80040002, 0x80550002, 0x80550002, 0x04000004, 
-    0x80040003, 0x80000002, 0x80000002, 0x81aa0002, 0x0400005a, 0x80080003, 
-    0x80000002, 0x80550002, 0xa0ff0000, 0x04000004, 0x80030002, 0x80e40001, 
-    0xa0aa0000, 0x80ee0003, 0x0400005a, 0x80040002, 0x80e40002, 0x81e40002, 
-    0xa0aa0000, 0x04000058, 0x80040002, 0x80aa0002, 0xa0000001, 0xa0550001, 
-    0x04000058, 0x800c0002, 0x81ff0002, 0x80aa0002, 0xa0440001, 0x03000005, 
-    0x800c0002, 0x80550003, 0x80e40002, 0x03000002, 0x80080002, 0x80000003, 
-    0x80ff0002, 0x04000058, 0x80040002, 0x81aa0002, 0xa0550001, 0xa0000001, 
-    0x04000058, 0x80030003, 0x81ff0002, 0xa0e40001, 0xa0e10001, 0x03000005, 
-    0x80040002, 0x80aa0002, 0x80550003, 0x03000005, 0x80040001, 0x80aa0001, 
-    0x80aa0002, 0x04000058, 0x80080001, 0x81aa0001, 0xa0550001, 0x80ff0001, 
-    0x04000058, 0x80040002, 0x81ff0001, 0xa0550001, 0xa0000001, 0x04000058, 
-    0x80080000, 0x81aa0001, 0x80ff0000, 0x80ff0004, 0x04000058, 0x80080004, 
-    0x81ff0000, 0xa0550001, 0xa0000001, 0x03000005, 0x80080004, 0x80aa0002, 
-    0x80ff0004, 0x04000058, 0x80070000, 0x81aa0001, 0x80e40000, 0x80e40004, 
-    0x03000005, 0x80040002, 0x80aa0000, 0x80aa0000, 0x04000004, 0x80040003, 
-    0x80550000, 0x80550000, 0x81aa0002, 0x0400005a, 0x80080003, 0x80550000, 
-    0x80aa0000, 0xa0ff0000, 0x04000004, 0x80060004, 0x80d00001, 0xa0aa0000, 
-    0x80f80003, 0x0400005a, 0x80040002, 0x80e90004, 0x81e90004, 0xa0aa0000, 
-    0x04000058, 0x800c0003, 0x80aa0002, 0xa0440001, 0xa0140001, 0x04000058, 
-    0x80010004, 0x80aa0002, 0x80000000, 0xa0ff0005, 0x04000058, 0x80070004, 
-    0x81ff0004, 0x80e40000, 0x80e40004, 0x04000004, 0x80040002, 0x80ff0003, 
-    0x80aa0003, 0x80aa0003, 0x04000058, 0x80040002, 0x81aa0002, 0xa0000001, 
-    0xa0550001, 0x04000058, 0x80040002, 0x81ff0004, 0xa0550001, 0x80aa0002, 
-    0x03000005, 0x80080004, 0x80ff0004, 0x80aa0002, 0x03000002, 0x80080001, 
-    0x80ff0001, 0x80ff0004, 0x03000002, 0x80080004, 0x80ff0000, 0x80ff0004, 
-    0x04000058, 0x80080004, 0x81ff0004, 0xa0000001, 0xa0550001, 0x04000058, 
-    0x80080001, 0x81ff0001, 0xa0000001, 0xa0550001, 0x03000005, 0x80040002, 
-    0x80550002, 0x80550002, 0x04000004, 0x80040003, 0x80000002, 0x80000002, 
-    0x81aa0002, 0x0400005a, 0x80080003, 0x80000002, 0x80550002, 0xa0ff0000, 
-    0x04000004, 0x80030002, 0x80e40001, 0xa0aa0000, 0x80ee0003, 0x0400005a, 
-    0x80040002, 0x80e40002, 0x81e40002, 0xa0aa0000, 0x04000058, 0x80040002, 
-    0x80aa0002, 0xa0000001, 0xa0550001, 0x04000058, 0x800c0002, 0x81ff0002, 
-    0x80aa0002, 0xa0440001, 0x03000005, 0x800c0002, 0x80550003, 0x80e40002, 
-    0x03000002, 0x80080002, 0x80000003, 0x80ff0002, 0x04000058, 0x80040002, 
-    0x81aa0002, 0xa0550001, 0xa0000001, 0x04000058, 0x80030003, 0x81ff0002, 
-    0xa0e40001, 0xa0e10001, 0x03000005, 0x80040002, 0x80aa0002, 0x80550003, 
-    0x03000005, 0x80040001, 0x80aa0001, 0x80aa0002, 0x04000058, 0x80080001, 
-    0x81aa0001, 0xa0550001, 0x80ff0001, 0x04000058, 0x80040002, 0x81ff0001, 
-    0xa0550001, 0xa0000001, 0x04000058, 0x80080000, 0x81aa0001, 0x80ff0000, 
-    0x80ff0004, 0x04000058, 0x80080004, 0x81ff0000, 0xa0550001, 0xa0000001, 
-    0x03000005, 0x80080004, 0x80aa0002, 0x80ff0004, 0x04000058, 0x80070000, 
-    0x81aa0001, 0x80e40000, 0x80e40004, 0x03000005, 0x80040002, 0x80aa0000, 
-    0x80aa0000, 0x04000004, 0x80040003, 0x80550000, 0x80550000, 0x81aa0002, 
-    0x0400005a, 0x80080003, 0x80550000, 0x80aa0000, 0xa0ff0000, 0x04000004, 
-    0x80060004, 0x80d00001, 0xa0aa0000, 0x80f80003, 0x0400005a, 0x80040002, 
-    0x80e90004, 0x81e90004, 0xa0aa0000, 0x04000058, 0x800c0003, 0x80aa0002, 
-    0xa0440001, 0xa0140001, 0x04000058, 0x80010004, 0x80aa0002, 0x80000000, 
-    0xa0000006, 0x04000058, 0x80070004, 0x81ff0004, 0x80e40000, 0x80e40004, 
-    0x04000004, 0x80040002, 0x80ff0003, 0x80aa0003, 0x80aa0003, 0x04000058, 
-    0x80040002, 0x81aa0002, 0xa0000001, 0xa0550001, 0x04000058, 0x80040002, 
-    0x81ff0004, 0xa0550001, 0x80aa0002, 0x03000005, 0x80080004, 0x80ff0004, 
-    0x80aa0002, 0x03000002, 0x80080001, 0x80ff0001, 0x80ff0004, 0x03000002, 
-    0x80080004, 0x80ff0000, 0x80ff0004, 0x04000058, 0x80080004, 0x81ff0004, 
-    0xa0000001, 0xa0550001, 0x04000058, 0x80080001, 0x81ff0001, 0xa0000001, 
-    0xa0550001, 0x03000005, 0x80040002, 0x80550002, 0x80550002, 0x04000004, 
-    0x80040003, 0x80000002, 0x80000002, 0x81aa0002, 0x0400005a, 0x80080003, 
-    0x80000002, 0x80550002, 0xa0ff0000, 0x04000004, 0x80030002, 0x80e40001, 
-    0xa0aa0000, 0x80ee0003, 0x0400005a, 0x80040002, 0x80e40002, 0x81e40002, 
-    0xa0aa0000, 0x04000058, 0x80040002, 0x80aa0002, 0xa0000001, 0xa0550001, 
-    0x04000058, 0x800c0002, 0x81ff0002, 0x80aa0002, 0xa0440001, 0x03000005, 
-    0x800c0002, 0x80550003, 0x80e40002, 0x03000002, 0x80080002, 0x80000003, 
-    0x80ff0002, 0x04000058, 0x80040002, 0x81aa0002, 0xa0550001, 0xa0000001, 
-    0x04000058, 0x80030003, 0x81ff0002, 0xa0e40001, 0xa0e10001, 0x03000005, 
-    0x80040002, 0x80aa0002, 0x80550003, 0x03000005, 0x80040001, 0x80aa0001, 
-    0x80aa0002, 0x04000058, 0x80080001, 0x81aa0001, 0xa0550001, 0x80ff0001, 
-    0x04000058, 0x80040002, 0x81ff0001, 0xa0550001, 0xa0000001, 0x04000058, 
-    0x80080000, 0x81aa0001, 0x80ff0000, 0x80ff0004, 0x04000058, 0x80080004, 
-    0x81ff0000, 0xa0550001, 0xa0000001, 0x03000005, 0x80080004, 0x80aa0002, 
-    0x80ff0004, 0x04000058, 0x80070000, 0x81aa0001, 0x80e40000, 0x80e40004, 
-    0x03000005, 0x80040002, 0x80aa0000, 0x80aa0000, 0x04000004, 0x80040003, 
-    0x80550000, 0x80550000, 0x81aa0002, 0x0400005a, 0x80080003, 0x80550000, 
-    0x80aa0000, 0xa0ff0000, 0x04000004, 0x80060004, 0x80d00001, 0xa0aa0000, 
-    0x80f80003, 0x0400005a, 0x80040002, 0x80e90004, 0x81e90004, 0xa0aa0000, 
-    0x04000058, 0x800c0003, 0x80aa0002, 0xa0440001, 0xa0140001, 0x04000058, 
-    0x80010004, 0x80aa0002, 0x80000000, 0xa0550006, 0x04000058, 0x80070004, 
-    0x81ff0004, 0x80e40000, 0x80e40004, 0x04000004, 0x80040002, 0x80ff0003, 
-    0x80aa0003, 0x80aa0003, 0x04000058, 0x80040002, 0x81aa0002, 0xa0000001, 
-    0xa0550001, 0x04000058, 0x80040002, 0x81ff0004, 0xa0550001, 0x80aa0002, 
-    0x03000005, 0x80080004, 0x80ff0004, 0x80aa0002, 0x03000002, 0x80080001, 
-    0x80ff0001, 0x80ff0004, 0x03000002, 0x80080004, 0x80ff0000, 0x80ff0004, 
-    0x04000058, 0x80080004, 0x81ff0004, 0xa0000001, 0xa0550001, 0x04000058, 
-    0x80080001, 0x81ff0001, 0xa0000001, 0xa0550001, 0x03000005, 0x80040002, 
-    0x80550002, 0x80550002, 0x04000004, 0x80040003, 0x80000002, 0x80000002, 
-    0x81aa0002, 0x0400005a, 0x80080003, 0x80000002, 0x80550002, 0xa0ff0000, 
-    0x04000004, 0x80030002, 0x80e40001, 0xa0aa0000, 0x80ee0003, 0x0400005a, 
-    0x80040002, 0x80e40002, 0x81e40002, 0xa0aa0000, 0x04000058, 0x80040002, 
-    0x80aa0002, 0xa0000001, 0xa0550001, 0x04000058, 0x800c0002, 0x81ff0002, 
-    0x80aa0002, 0xa0440001, 0x03000005, 0x800c0002, 0x80550003, 0x80e40002, 
-    0x03000002, 0x80080002, 0x80000003, 0x80ff0002, 0x04000058, 0x80040002, 
-    0x81aa0002, 0xa0550001, 0xa0000001, 0x04000058, 0x80030003, 0x81ff0002, 
-    0xa0e40001, 0xa0e10001, 0x03000005, 0x80040002, 0x80aa0002, 0x80550003, 
-    0x03000005, 0x80040001, 0x80aa0001, 0x80aa0002, 0x04000058, 0x80080001, 
-    0x81aa0001, 0xa0550001, 0x80ff0001, 0x04000058, 0x80040002, 0x81ff0001, 
-    0xa0550001, 0xa0000001, 0x04000058, 0x80080000, 0x81aa0001, 0x80ff0000, 
-    0x80ff0004, 0x04000058, 0x80080004, 0x81ff0000, 0xa0550001, 0xa0000001, 
-    0x03000005, 0x80080004, 0x80aa0002, 0x80ff0004, 0x04000058, 0x80070000, 
-    0x81aa0001, 0x80e40000, 0x80e40004, 0x03000005, 0x80040002, 0x80aa0000, 
-    0x80aa0000, 0x04000004, 0x80040003, 0x80550000, 0x80550000, 0x81aa0002, 
-    0x0400005a, 0x80080003, 0x80550000, 0x80aa0000, 0xa0ff0000, 0x04000004, 
-    0x80060004, 0x80d00001, 0xa0aa0000, 0x80f80003, 0x0400005a, 0x80040002, 
-    0x80e90004, 0x81e90004, 0xa0aa0000, 0x04000058, 0x800c0003, 0x80aa0002, 
-    0xa0440001, 0xa0140001, 0x04000058, 0x80010004, 0x80aa0002, 0x80000000, 
-    0xa0aa0006, 0x04000058, 0x80070004, 0x81ff0004, 0x80e40000, 0x80e40004, 
-    0x04000004, 0x80040002, 0x80ff0003, 0x80aa0003, 0x80aa0003, 0x04000058, 
-    0x80040002, 0x81aa0002, 0xa0000001, 0xa0550001, 0x04000058, 0x80040002, 
-    0x81ff0004, 0xa0550001, 0x80aa0002, 0x03000005, 0x80080004, 0x80ff0004, 
-    0x80aa0002, 0x03000002, 0x80080001, 0x80ff0001, 0x80ff0004, 0x03000002, 
-    0x80080004, 0x80ff0000, 0x80ff0004, 0x04000058, 0x80080004, 0x81ff0004, 
-    0xa0000001, 0xa0550001, 0x04000058, 0x80080001, 0x81ff0001, 0xa0000001, 
-    0xa0550001, 0x03000005, 0x80040002, 0x80550002, 0x80550002, 0x04000004, 
-    0x80040003, 0x80000002, 0x80000002, 0x81aa0002, 0x0400005a, 0x80080003, 
-    0x80000002, 0x80550002, 0xa0ff0000, 0x04000004, 0x80030002, 0x80e40001, 
-    0xa0aa0000, 0x80ee0003, 0x0400005a, 0x80040002, 0x80e40002, 0x81e40002, 
-    0xa0aa0000, 0x04000058, 0x80040002, 0x80aa0002, 0xa0000001, 0xa0550001, 
-    0x04000058, 0x800c0002, 0x81ff0002, 0x80aa0002, 0xa0440001, 0x03000005, 
-    0x800c0002, 0x80550003, 0x80e40002, 0x03000002, 0x80080002, 0x80000003, 
-    0x80ff0002, 0x04000058, 0x80040002, 0x81aa0002, 0xa0550001, 0xa0000001, 
-    0x04000058, 0x80030003, 0x81ff0002, 0xa0e40001, 0xa0e10001, 0x03000005, 
-    0x80040002, 0x80aa0002, 0x80550003, 0x03000005, 0x80040001, 0x80aa0001, 
-    0x80aa0002, 0x04000058, 0x80080001, 0x81aa0001, 0xa0550001, 0x80ff0001, 
-    0x04000058, 0x80080001, 0x81ff0001, 0xa0550001, 0xa0000001, 0x04000058, 
-    0x80080000, 0x81aa0001, 0x80ff0000, 0x80ff0004, 0x04000058, 0x80080004, 
-    0x81ff0000, 0xa0550001, 0xa0000001, 0x03000005, 0x80080001, 0x80ff0001, 
-    0x80ff0004, 0x04000058, 0x80070000, 0x81aa0001, 0x80e40000, 0x80e40004, 
-    0x03000005, 0x80040002, 0x80aa0000, 0x80aa0000, 0x04000004, 0x80040003, 
-    0x80550000, 0x80550000, 0x81aa0002, 0x0400005a, 0x80080003, 0x80550000, 
-    0x80aa0000, 0xa0ff0000, 0x04000004, 0x80060000, 0x80d00001, 0xa0aa0000, 
-    0x80f80003, 0x0400005a, 0x80020000, 0x80e90000, 0x81e90000, 0xa0aa0000, 
-    0x04000058, 0x800c0003, 0x80550000, 0xa0440001, 0xa0140001, 0x04000058, 
-    0x80020000, 0x80550000, 0x80000000, 0xa0ff0006, 0x04000058, 0x80020000, 
-    0x81ff0001, 0x80000000, 0x80550000, 0x04000004, 0x80040000, 0x80ff0003, 
-    0x80aa0003, 0x80aa0003, 0x04000058, 0x80040000, 0x81aa0000, 0xa0000001, 
-    0xa0550001, 0x04000058, 0x80040000, 0x81ff0001, 0xa0550001, 0x80aa0000, 
-    0x04000004, 0x80080001, 0x80ff0001, 0x80aa0000, 0x80ff0000, 0x04000058, 
-    0x80080001, 0x81ff0001, 0xa0000001, 0xa0550001, 0x03000005, 0x80040000, 
-    0x80550002, 0x80550002, 0x04000004, 0x80040003, 0x80000002, 0x80000002, 
-    0x81aa0000, 0x0400005a, 0x80080003, 0x80000002, 0x80550002, 0xa0ff0000, 
-    0x04000004, 0x80030001, 0x80e40001, 0xa0aa0000, 0x80ee0003, 0x0400005a, 
-    0x80040000, 0x80e40001, 0x81e40001, 0xa0aa0000, 0x04000058, 0x80040000, 
-    0x80aa0000, 0xa0000001, 0xa0550001, 0x04000058, 0x80030001, 0x81ff0002, 
-    0x80aa0000, 0xa0e40001, 0x03000005, 0x80030001, 0x80550003, 0x80e40001, 
-    0x03000002, 0x80040000, 0x80000003, 0x80550001, 0x04000058, 0x80010001, 
-    0x81000001, 0xa0550001, 0xa0000001, 0x04000058, 0x80040000, 0x81aa0000, 
-    0xa0550001, 0xa0000001, 0x03000005, 0x80040000, 0x80000001, 0x80aa0000, 
-    0x03000005, 0x80040000, 0x80aa0001, 0x80aa0000, 0x04000058, 0x80080000, 
-    0x81aa0000, 0x80ff0000, 0x80ff0001, 0x04000058, 0x80010000, 0x81aa0000, 
-    0x80000000, 0x80550000, 0x04000058, 0x80010000, 0x81ff0000, 0xa0000002, 
-    0x80000000, 0x03000042, 0x800f0001, 0xb0e40000, 0xa0e40800, 0x04000004, 
-    0x80020000, 0x80000000, 0xa0550002, 0x80ff0001, 0x04000004, 0x80040000, 
-    0x80000000, 0xa1550002, 0xa0ff0002, 0x03000005, 0x80090000, 0x80000000, 
-    0xa0a50002, 0x0300000a, 0x80010001, 0x80aa0000, 0x80000000, 0x03000005, 
-    0x80020000, 0x80550000, 0x80000001, 0x04000004, 0x80040000, 0x80ff0001, 
-    0xa0aa0000, 0x80ff0000, 0x03000005, 0x80080000, 0x80aa0000, 0xa0aa0006, 
-    0x04000058, 0x80030001, 0x80aa0000, 0xa0e40003, 0xa0ee0003, 0x04000004, 
-    0x800f0002, 0x80aa0000, 0xa0000007, 0xa0a50007, 0x03000005, 0x80040000, 
-    0x80ff0000, 0x80550001, 0x02000013, 0x80040000, 0x80aa0000, 0x04000004, 
-    0x80080000, 0x80000001, 0x81aa0000, 0xa0ff0005, 0x04000004, 0x80040000, 
-    0x80000001, 0x80aa0000, 0xa1ff0001, 0x0300000a, 0x80010001, 0xa0550001, 
-    0x80ff0000, 0x0300000a, 0x80010003, 0x80000001, 0x80aa0000, 0x0300000b, 
-    0x80040000, 0xa1550001, 0x80000003, 0x04000004, 0x80010001, 0x80550000, 
-    0x81aa0000, 0x80000000, 0x04000058, 0x800f0003, 0x80f50002, 0xa0440003, 
-    0xa0ee0003, 0x03000005, 0x800f0002, 0x80e40002, 0x80f50003, 0x02000013, 
-    0x800f0002, 0x80e40002, 0x04000004, 0x800f0004, 0x80a00003, 0x81e40002, 
-    0xa0bb0005, 0x04000004, 0x800c0000, 0x80840003, 0x80d40002, 0xa1ff0001, 
-    0x04000058, 0x80030002, 0x80ed0004, 0xa0550001, 0x80e80004, 0x0300000a, 
-    0x80030003, 0x80e40002, 0x80ee0000, 0x0300000b, 0x800c0000, 0xa1550001, 
-    0x80440003, 0x04000004, 0x80060001, 0x80550000, 0x81f80000, 0x80000000, 
-    0x02000001, 0x80080001, 0xa0550001, 0x02000001, 0x800f0800, 0x80e40001, 
-    0x0000ffff
-};
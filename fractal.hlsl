@@ -1,4 +1,5 @@
-sampler2D tex: register(S0);
+// x: animation frame, from SDL_RenderSetKernelConstants()
+float4 constants: register(c0);
 
 #define csq(a) float2((a).x*(a).x-(a).y*(a).y, (a).x*(a).y*2)
 
@@ -29,7 +30,7 @@ float4 rgba(float4 hsla) {
 float4 main(float2 uv: TEXCOORD): SV_Target {
 	float mandelbrot_color = mandelbrot((uv-float2(0.70, 0.5))*4)/14.0;
 
-	float frame = tex2D(tex, uv).a;
+	float frame = constants.x;
 
 	return rgba(float4(mandelbrot_color*0.25+frame*4, mandelbrot_color+frame, mandelbrot_color, 1.0));
 }
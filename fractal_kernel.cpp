@@ -0,0 +1,328 @@
+#include "fractal_kernel.h"
+
+#include <algorithm>
+#include <cmath>
+
+// The vector implementations only exist on x86. They are compiled with a
+// target attribute instead of compiler flags, so that the rest of the program
+// still runs on CPUs without AVX2 and we choose at runtime (MSVC doesn't need
+// anything to use the intrinsics).
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define FRACTAL_HAVE_X86 1
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define FRACTAL_TARGET(isa) __attribute__((target(isa)))
+#else
+#define FRACTAL_TARGET(isa)
+#endif
+#endif
+
+namespace {
+
+// Same as mandelbrot() in fractal.hlsl
+int mandelbrot(float cx, float cy) {
+  float zx = 0.0f, zy = 0.0f;
+
+  for (int i = 1; i < 14; i++) {
+    const float x = zx*zx - zy*zy + cx;
+    const float y = zx*zy*2 + cy;
+    zx = x;
+    zy = y;
+
+    if (zx*zx + zy*zy > 4.0f) {
+      return i;
+    }
+  }
+
+  return 14;
+}
+
+// Same as sup() in fractal.hlsl. HLSL's % truncates the quotient like fmod,
+// but we compute it the way the GPU (and the vector code below) does, so every
+// implementation gives the same result.
+float sup(float n, float h, float s, float l) {
+  const float x = n + h*12.0f;
+  const float k = x - std::trunc(x/12.0f)*12.0f;
+  const float a = s*std::min(l, 1 - l);
+  return l - a*std::max(-1.0f, std::min(k - 3, std::min(9 - k, 1.0f)));
+}
+
+// Render targets saturate shader output, so we do the same.
+Uint32 to_channel(float value) {
+  return static_cast<Uint32>(std::min(std::max(value, 0.0f), 1.0f)*255.0f + 0.5f);
+}
+
+// Same as rgba() in fractal.hlsl, packed as ARGB8888 with alpha = 1
+Uint32 rgba(float h, float s, float l) {
+  return 0xFF000000 |
+         to_channel(sup(0.0f, h, s, l)) << 16 |
+         to_channel(sup(8.0f, h, s, l)) << 8 |
+         to_channel(sup(4.0f, h, s, l));
+}
+
+// Same as main() in fractal.hlsl
+Uint32 shade(float u, float v, float frame) {
+  const float mandelbrot_color = mandelbrot((u - 0.70f)*4, (v - 0.5f)*4)/14.0f;
+
+  return rgba(mandelbrot_color*0.25f + frame*4, mandelbrot_color + frame, mandelbrot_color);
+}
+
+// constants.x, as set by SDL_RenderSetKernelConstants()
+float frame_from_constants(const SDL_RenderKernelTile* tile) {
+  return tile->num_constants > 0 ? tile->constants[0] : 0.0f;
+}
+
+Uint32* tile_row(const SDL_RenderKernelTile* tile, int y) {
+  return reinterpret_cast<Uint32*>(reinterpret_cast<Uint8*>(tile->pixels) + y*tile->pitch);
+}
+
+// Sample at the pixel center, like the rasterizer does
+float tile_u(const SDL_RenderKernelTile* tile, int x) {
+  return (tile->x + x + 0.5f)/tile->dst_w;
+}
+
+float tile_v(const SDL_RenderKernelTile* tile, int y) {
+  return (tile->y + y + 0.5f)/tile->dst_h;
+}
+
+void SDLCALL fractal_kernel_scalar(void*, const SDL_RenderKernelTile* tile) {
+  const float frame = frame_from_constants(tile);
+
+  for (int y = 0; y < tile->h; y++) {
+    Uint32* row = tile_row(tile, y);
+    const float v = tile_v(tile, y);
+
+    for (int x = 0; x < tile->w; x++) {
+      row[x] = shade(tile_u(tile, x), v, frame);
+    }
+  }
+}
+
+#ifdef FRACTAL_HAVE_X86
+
+// The vector versions are line by line translations of the functions above,
+// doing the floating point operations in the same order so the results are
+// bit-identical. Lanes that escaped keep iterating (their result is already
+// recorded) until every lane in the vector has escaped.
+
+FRACTAL_TARGET("sse2")
+__m128 mandelbrot_sse2(__m128 cx, __m128 cy) {
+  const __m128 four = _mm_set1_ps(4.0f);
+  __m128 zx = _mm_setzero_ps(), zy = _mm_setzero_ps();
+  __m128 result = _mm_set1_ps(14.0f);
+  __m128 active = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+  for (int i = 1; i < 14; i++) {
+    const __m128 x = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(zx, zx), _mm_mul_ps(zy, zy)), cx);
+    const __m128 y = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(zx, zy), _mm_set1_ps(2.0f)), cy);
+    zx = x;
+    zy = y;
+
+    const __m128 magnitude = _mm_add_ps(_mm_mul_ps(zx, zx), _mm_mul_ps(zy, zy));
+    const __m128 escaped = _mm_and_ps(_mm_cmpgt_ps(magnitude, four), active);
+    result = _mm_or_ps(_mm_andnot_ps(escaped, result),
+                       _mm_and_ps(escaped, _mm_set1_ps(static_cast<float>(i))));
+    active = _mm_andnot_ps(escaped, active);
+
+    if (!_mm_movemask_ps(active)) {
+      break;
+    }
+  }
+
+  return result;
+}
+
+FRACTAL_TARGET("sse2")
+__m128i to_channel_sse2(__m128 value) {
+  value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+  return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+}
+
+// Our arguments are never negative and way below 2^31, so truncating through
+// an integer is exact.
+FRACTAL_TARGET("sse2")
+__m128i sup_sse2(float n, __m128 h, __m128 s, __m128 l) {
+  const __m128 twelve = _mm_set1_ps(12.0f);
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 x = _mm_add_ps(_mm_set1_ps(n), _mm_mul_ps(h, twelve));
+  const __m128 k = _mm_sub_ps(x, _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_div_ps(x, twelve))), twelve));
+  const __m128 a = _mm_mul_ps(s, _mm_min_ps(l, _mm_sub_ps(one, l)));
+  const __m128 m = _mm_max_ps(_mm_set1_ps(-1.0f),
+                              _mm_min_ps(_mm_sub_ps(k, _mm_set1_ps(3.0f)),
+                                         _mm_min_ps(_mm_sub_ps(_mm_set1_ps(9.0f), k), one)));
+  return to_channel_sse2(_mm_sub_ps(l, _mm_mul_ps(a, m)));
+}
+
+FRACTAL_TARGET("sse2")
+void SDLCALL fractal_kernel_sse2(void*, const SDL_RenderKernelTile* tile) {
+  const float frame = frame_from_constants(tile);
+  const __m128 frame4 = _mm_set1_ps(frame*4);
+  const __m128 frame1 = _mm_set1_ps(frame);
+  const __m128 dst_w = _mm_set1_ps(static_cast<float>(tile->dst_w));
+  const __m128i lanes = _mm_setr_epi32(0, 1, 2, 3);
+
+  for (int y = 0; y < tile->h; y++) {
+    Uint32* row = tile_row(tile, y);
+    const float v = tile_v(tile, y);
+    const __m128 cy = _mm_set1_ps((v - 0.5f)*4);
+    int x = 0;
+
+    for (; x + 4 <= tile->w; x += 4) {
+      const __m128i column = _mm_add_epi32(_mm_set1_epi32(tile->x + x), lanes);
+      const __m128 u = _mm_div_ps(_mm_add_ps(_mm_cvtepi32_ps(column), _mm_set1_ps(0.5f)), dst_w);
+      const __m128 cx = _mm_mul_ps(_mm_sub_ps(u, _mm_set1_ps(0.70f)), _mm_set1_ps(4.0f));
+      const __m128 color = _mm_div_ps(mandelbrot_sse2(cx, cy), _mm_set1_ps(14.0f));
+
+      const __m128 h = _mm_add_ps(_mm_mul_ps(color, _mm_set1_ps(0.25f)), frame4);
+      const __m128 s = _mm_add_ps(color, frame1);
+      const __m128i r = sup_sse2(0.0f, h, s, color);
+      const __m128i g = sup_sse2(8.0f, h, s, color);
+      const __m128i b = sup_sse2(4.0f, h, s, color);
+
+      __m128i pixels = _mm_set1_epi32(static_cast<int>(0xFF000000));
+      pixels = _mm_or_si128(pixels, _mm_slli_epi32(r, 16));
+      pixels = _mm_or_si128(pixels, _mm_slli_epi32(g, 8));
+      pixels = _mm_or_si128(pixels, b);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x), pixels);
+    }
+
+    for (; x < tile->w; x++) {
+      row[x] = shade(tile_u(tile, x), v, frame);
+    }
+  }
+}
+
+FRACTAL_TARGET("avx2")
+__m256 mandelbrot_avx2(__m256 cx, __m256 cy) {
+  const __m256 four = _mm256_set1_ps(4.0f);
+  __m256 zx = _mm256_setzero_ps(), zy = _mm256_setzero_ps();
+  __m256 result = _mm256_set1_ps(14.0f);
+  __m256 active = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+  for (int i = 1; i < 14; i++) {
+    const __m256 x = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(zx, zx), _mm256_mul_ps(zy, zy)), cx);
+    const __m256 y = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(zx, zy), _mm256_set1_ps(2.0f)), cy);
+    zx = x;
+    zy = y;
+
+    const __m256 magnitude = _mm256_add_ps(_mm256_mul_ps(zx, zx), _mm256_mul_ps(zy, zy));
+    const __m256 escaped = _mm256_and_ps(_mm256_cmp_ps(magnitude, four, _CMP_GT_OQ), active);
+    result = _mm256_blendv_ps(result, _mm256_set1_ps(static_cast<float>(i)), escaped);
+    active = _mm256_andnot_ps(escaped, active);
+
+    if (!_mm256_movemask_ps(active)) {
+      break;
+    }
+  }
+
+  return result;
+}
+
+FRACTAL_TARGET("avx2")
+__m256i to_channel_avx2(__m256 value) {
+  value = _mm256_min_ps(_mm256_max_ps(value, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+  return _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(value, _mm256_set1_ps(255.0f)),
+                                           _mm256_set1_ps(0.5f)));
+}
+
+FRACTAL_TARGET("avx2")
+__m256i sup_avx2(float n, __m256 h, __m256 s, __m256 l) {
+  const __m256 twelve = _mm256_set1_ps(12.0f);
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 x = _mm256_add_ps(_mm256_set1_ps(n), _mm256_mul_ps(h, twelve));
+  const __m256 quotient = _mm256_round_ps(_mm256_div_ps(x, twelve), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+  const __m256 k = _mm256_sub_ps(x, _mm256_mul_ps(quotient, twelve));
+  const __m256 a = _mm256_mul_ps(s, _mm256_min_ps(l, _mm256_sub_ps(one, l)));
+  const __m256 m = _mm256_max_ps(_mm256_set1_ps(-1.0f),
+                                 _mm256_min_ps(_mm256_sub_ps(k, _mm256_set1_ps(3.0f)),
+                                               _mm256_min_ps(_mm256_sub_ps(_mm256_set1_ps(9.0f), k), one)));
+  return to_channel_avx2(_mm256_sub_ps(l, _mm256_mul_ps(a, m)));
+}
+
+FRACTAL_TARGET("avx2")
+void SDLCALL fractal_kernel_avx2(void*, const SDL_RenderKernelTile* tile) {
+  const float frame = frame_from_constants(tile);
+  const __m256 frame4 = _mm256_set1_ps(frame*4);
+  const __m256 frame1 = _mm256_set1_ps(frame);
+  const __m256 dst_w = _mm256_set1_ps(static_cast<float>(tile->dst_w));
+  const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+  for (int y = 0; y < tile->h; y++) {
+    Uint32* row = tile_row(tile, y);
+    const float v = tile_v(tile, y);
+    const __m256 cy = _mm256_set1_ps((v - 0.5f)*4);
+    int x = 0;
+
+    for (; x + 8 <= tile->w; x += 8) {
+      const __m256i column = _mm256_add_epi32(_mm256_set1_epi32(tile->x + x), lanes);
+      const __m256 u = _mm256_div_ps(_mm256_add_ps(_mm256_cvtepi32_ps(column), _mm256_set1_ps(0.5f)), dst_w);
+      const __m256 cx = _mm256_mul_ps(_mm256_sub_ps(u, _mm256_set1_ps(0.70f)), _mm256_set1_ps(4.0f));
+      const __m256 color = _mm256_div_ps(mandelbrot_avx2(cx, cy), _mm256_set1_ps(14.0f));
+
+      const __m256 h = _mm256_add_ps(_mm256_mul_ps(color, _mm256_set1_ps(0.25f)), frame4);
+      const __m256 s = _mm256_add_ps(color, frame1);
+      const __m256i r = sup_avx2(0.0f, h, s, color);
+      const __m256i g = sup_avx2(8.0f, h, s, color);
+      const __m256i b = sup_avx2(4.0f, h, s, color);
+
+      __m256i pixels = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+      pixels = _mm256_or_si256(pixels, _mm256_slli_epi32(r, 16));
+      pixels = _mm256_or_si256(pixels, _mm256_slli_epi32(g, 8));
+      pixels = _mm256_or_si256(pixels, b);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + x), pixels);
+    }
+
+    for (; x < tile->w; x++) {
+      row[x] = shade(tile_u(tile, x), v, frame);
+    }
+  }
+}
+
+#endif // FRACTAL_HAVE_X86
+
+SDL_RenderKernelFunction best_fractal_kernel() {
+  for (int isa = FRACTAL_KERNEL_ISA_COUNT - 1; isa > FRACTAL_KERNEL_SCALAR; isa--) {
+    if (SDL_RenderKernelFunction function = fractal_kernel_function(static_cast<fractal_kernel_isa>(isa))) {
+      return function;
+    }
+  }
+
+  return fractal_kernel_scalar;
+}
+
+} // namespace
+
+void SDLCALL fractal_kernel(void* userdata, const SDL_RenderKernelTile* tile) {
+  // Tiles are shaded from many threads, but C++ initializes this only once.
+  static const SDL_RenderKernelFunction best = best_fractal_kernel();
+
+  best(userdata, tile);
+}
+
+SDL_RenderKernelFunction fractal_kernel_function(fractal_kernel_isa isa) {
+  switch (isa) {
+  case FRACTAL_KERNEL_SCALAR:
+    return fractal_kernel_scalar;
+#ifdef FRACTAL_HAVE_X86
+  case FRACTAL_KERNEL_SSE2:
+    return SDL_HasSSE2() ? fractal_kernel_sse2 : nullptr;
+  case FRACTAL_KERNEL_AVX2:
+    return SDL_HasAVX2() ? fractal_kernel_avx2 : nullptr;
+#endif
+  default:
+    return nullptr;
+  }
+}
+
+const char* fractal_kernel_isa_name(fractal_kernel_isa isa) {
+  switch (isa) {
+  case FRACTAL_KERNEL_SCALAR:
+    return "scalar";
+  case FRACTAL_KERNEL_SSE2:
+    return "sse2";
+  case FRACTAL_KERNEL_AVX2:
+    return "avx2";
+  default:
+    return "unknown";
+  }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <SDL.h>
+
+// CPU port of fractal.hlsl.
+//
+// It has the signature of an SDL_RenderKernelFunction, so it can be handed to
+// SDL_CreateRenderKernel() and run by renderers that have no pixel shaders
+// (the software renderer, on Linux for example). Like the shader, it reads the
+// animation frame from the first kernel constant.
+//
+// It uses the fastest of the implementations below that the CPU supports.
+void SDLCALL fractal_kernel(void* userdata, const SDL_RenderKernelTile* tile);
+
+// The implementations of fractal_kernel(), slowest to fastest. All of them
+// produce exactly the same pixels.
+enum fractal_kernel_isa {
+  FRACTAL_KERNEL_SCALAR,
+  FRACTAL_KERNEL_SSE2,  // 4 pixels at a time
+  FRACTAL_KERNEL_AVX2,  // 8 pixels at a time
+  FRACTAL_KERNEL_ISA_COUNT
+};
+
+// Returns the given implementation, or nullptr if it was not compiled in or
+// the CPU can't run it.
+SDL_RenderKernelFunction fractal_kernel_function(fractal_kernel_isa isa);
+
+// Name of the implementation, for printing.
+const char* fractal_kernel_isa_name(fractal_kernel_isa isa);
@@ -1161,12 +1161,14 @@ extern "C" {
  *  but it can cause problems for apps that expect to render on top of the
  *  render API's output. As such, SDL will disable batching if a specific
  *  render backend is requested (since this might indicate that the app is
- *  planning to use the underlying graphics API directly). This hint can
- *  be used to explicitly request batching in this instance. It is a contract
- *  that you will either never use the underlying graphics API directly, or
- *  if you do, you will call SDL_RenderFlush() before you do so any current
- *  batch goes to the GPU before your work begins. Not following this contract
- *  will result in undefined behavior.
+ *  planning to use the underlying graphics API directly), and for renderers
+ *  made with SDL_CreateSoftwareRenderer() (since the app may read the surface
+ *  between draws). This hint can be used to explicitly request batching in
+ *  those instances. It is a contract that you will either never use the
+ *  underlying graphics API (or surface) directly, or if you do, you will call
+ *  SDL_RenderFlush() before you do so any current batch goes to the GPU before
+ *  your work begins. Not following this contract will result in undefined
+ *  behavior.
  */
 #define SDL_HINT_RENDER_BATCHING  "SDL_RENDER_BATCHING"
 
@@ -1272,6 +1274,66 @@ extern "C" {
  */
 #define SDL_HINT_DISPLAY_USABLE_BOUNDS "SDL_DISPLAY_USABLE_BOUNDS"
 
+/**
+ *  \brief  A variable controlling how many threads SDL uses for CPU-bound work
+ *
+ *  Some internal operations, like running per-pixel render kernels on the
+ *  software renderer, are split across a pool of worker threads. This
+ *  variable sets the total number of threads doing that work, including the
+ *  thread that requested it. It is read when the pool is first needed.
+ *
+ *  By default SDL uses one thread per CPU core. "1" disables the worker pool.
+ */
+#define SDL_HINT_WORKER_THREADS "SDL_WORKER_THREADS"
+
+/**
+ *  \brief  A variable controlling whether the software renderer splits its target into horizontal bands drawn in parallel.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Draw commands are replayed on the thread that flushes them (default)
+ *    "1"       - Each band of the target replays all the draw commands on the worker pool
+ *
+ *  The result is exactly the same pixels either way. Batches that contain lines,
+ *  rotated or flipped copies, scaled copies or RLE accelerated textures (static
+ *  textures without alpha) are still replayed on a single thread, as are
+ *  palettized targets.
+ *
+ *  This hint is read when the renderer is created. See SDL_HINT_WORKER_THREADS.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_BANDS "SDL_RENDER_SOFTWARE_BANDS"
+
+/**
+ *  \brief  A variable controlling whether the software renderer draws minified textures from mipmaps.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Scaled copies always read the full size texture (default)
+ *    "1"       - Copies at half the texture size or less read a box filtered mip level
+ *
+ *  Copies read the smallest level that is still at least as large as the
+ *  destination, which aliases less and touches far less memory. The levels of
+ *  a texture are created the first time it is drawn minified, and filtered
+ *  again when it is next drawn minified after it was updated, locked or
+ *  rendered to. Only 32-bit textures with 8-bit channels get mip levels.
+ *
+ *  This hint is read when the renderer is created.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_MIPMAPS "SDL_RENDER_SOFTWARE_MIPMAPS"
+
+/**
+ *  \brief  A variable controlling whether large surface blits are split into row stripes blitted in parallel.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Blits run on the calling thread (default)
+ *    "1"       - Blits of at least 256x256 pixels are spread across the worker pool
+ *
+ *  The result is exactly the same pixels either way. Scaled blits, RLE accelerated
+ *  surfaces, palettized surfaces and blits between overlapping pixels always run
+ *  on the calling thread.
+ *
+ *  This hint is checked on every large blit. See SDL_HINT_WORKER_THREADS.
+ */
+#define SDL_HINT_PARALLEL_BLITS "SDL_PARALLEL_BLITS"
+
 /**
  *  \brief  An enumeration of hint priorities
  */
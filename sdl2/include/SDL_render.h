@@ -137,6 +137,79 @@ typedef struct SDL_Renderer SDL_Renderer;
 struct SDL_Texture;
 typedef struct SDL_Texture SDL_Texture;
 
+/**
+ *  \brief A per-pixel program run in place of texture sampling by SDL_RenderCopy()
+ */
+struct SDL_RenderKernel;
+typedef struct SDL_RenderKernel SDL_RenderKernel;
+
+/**
+ *  \brief A block of destination pixels to be produced by a CPU render kernel.
+ *
+ *  The kernel writes tile->w by tile->h ARGB8888 pixels, starting at
+ *  tile->pixels. x and y give the tile position inside the destination
+ *  rectangle of the copy, whose full size is dst_w by dst_h, so the kernel
+ *  can compute texture coordinates the way a pixel shader would.
+ */
+typedef struct SDL_RenderKernelTile
+{
+    Uint32 *pixels;         /**< Output pixels, ARGB8888 */
+    int pitch;              /**< Bytes between output rows */
+    int x, y;               /**< Position of the tile inside the destination rectangle */
+    int w, h;               /**< Size of the tile in pixels */
+    int dst_w, dst_h;       /**< Size of the whole destination rectangle */
+    const void *src_pixels; /**< Source rectangle of the copy (read only) */
+    int src_pitch;          /**< Bytes between source rows */
+    Uint32 src_format;      /**< Pixel format of the source texels */
+    int src_w, src_h;       /**< Size of the source rectangle */
+    const float *constants; /**< Constants set with SDL_RenderSetKernelConstants() */
+    int num_constants;      /**< Number of floats in constants */
+} SDL_RenderKernelTile;
+
+/**
+ *  \brief The maximum number of floats that can be passed to a kernel with
+ *         SDL_RenderSetKernelConstants().
+ */
+#define SDL_RENDER_KERNEL_MAX_CONSTANTS 64
+
+/**
+ *  \brief A CPU render kernel, called once per tile.
+ *
+ *  Tiles may be processed concurrently on several threads, so the kernel must
+ *  not modify shared state without its own synchronization.
+ */
+typedef void (SDLCALL * SDL_RenderKernelFunction) (void *userdata, const SDL_RenderKernelTile * tile);
+
+/**
+ *  \brief What a renderer did during one frame, see SDL_RenderGetStats().
+ *
+ *  Commands are counted when they are flushed, after consecutive copies that
+ *  share their state have been merged into one.
+ */
+typedef struct SDL_RenderStats
+{
+    Uint32 set_viewport;        /**< Viewport changes */
+    Uint32 set_cliprect;        /**< Clip rectangle changes */
+    Uint32 set_draw_color;      /**< Draw color changes */
+    Uint32 set_kernel_constants; /**< Kernel constant changes */
+    Uint32 clears;              /**< Clear commands */
+    Uint32 draw_points;         /**< Point drawing commands */
+    Uint32 draw_lines;          /**< Line drawing commands */
+    Uint32 fill_rects;          /**< Rectangle filling commands */
+    Uint32 copies;              /**< Copy commands */
+    Uint32 copy_rects;          /**< Rectangles drawn by the copy commands */
+    Uint32 copies_ex;           /**< Rotated or flipped copy commands */
+    Uint32 flushes;             /**< Queue flushes asked for by presenting, reading pixels, SDL_RenderFlush(),
+                                     changing the target or drawing with batching disabled */
+    Uint32 forced_flushes;      /**< Queue flushes forced by changing or destroying a texture that queued
+                                     commands use */
+    Uint64 vertex_bytes;        /**< Bytes of vertex data queued */
+    Uint32 texture_uploads;     /**< Texture updates sent to the renderer */
+    Uint32 texture_locks;       /**< Texture locks sent to the renderer */
+    Uint64 run_queue_us;        /**< Microseconds spent drawing the queued commands */
+    Uint64 present_us;          /**< Microseconds spent presenting */
+} SDL_RenderStats;
+
 
 /* Function prototypes */
 
@@ -1037,6 +1110,32 @@ extern DECLSPEC int SDLCALL SDL_RenderCopyExF(SDL_Renderer * renderer,
                                             const SDL_FPoint *center,
                                             const SDL_RendererFlip flip);
 
+/**
+ *  \brief Copy many portions of a texture to the current rendering target at once.
+ *
+ *  This draws the same as calling SDL_RenderCopyF() count times, but the
+ *  arguments are checked once and renderers that support it queue all the
+ *  copies as a single command.
+ *
+ *  \param renderer The renderer which should copy parts of a texture.
+ *  \param texture  The source texture.
+ *  \param srcrects An array of count source rectangles, or NULL to copy the
+ *                  entire texture every time.
+ *  \param dstrects An array of count destination rectangles.
+ *  \param colors   An array of count colors that replace the texture's color
+ *                  and alpha modulation for each copy, or NULL to use the
+ *                  texture's modulation for all of them.
+ *  \param count    The number of copies.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderCopyBatch(SDL_Renderer * renderer,
+                                                SDL_Texture * texture,
+                                                const SDL_Rect * srcrects,
+                                                const SDL_FRect * dstrects,
+                                                const SDL_Color * colors,
+                                                int count);
+
 /**
  *  \brief Read pixels from the current rendering target.
  *
@@ -1103,6 +1202,90 @@ extern DECLSPEC void SDLCALL SDL_DestroyRenderer(SDL_Renderer * renderer);
  */
 extern DECLSPEC int SDLCALL SDL_RenderFlush(SDL_Renderer * renderer);
 
+/**
+ *  \brief Get what the renderer did during the last frame.
+ *
+ *  A frame ends with each SDL_RenderPresent(), and includes the time spent
+ *  presenting it. The counters are always kept up to date, so this is cheap
+ *  enough to call every frame.
+ *
+ *  \param renderer The renderer to query.
+ *  \param stats    Filled in with the statistics of the last presented
+ *                  frame, or zeros if no frame was presented yet.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderGetStats(SDL_Renderer * renderer,
+                                               SDL_RenderStats * stats);
+
+/**
+ *  \brief Create a per-pixel kernel for a rendering context.
+ *
+ *  \param renderer    The renderer that will run the kernel.
+ *  \param function    The CPU implementation, used by the software renderer,
+ *                     or NULL.
+ *  \param userdata    A pointer passed to every call of function.
+ *  \param shader      Compiled pixel shader bytecode for hardware renderers
+ *                     (a ps_2_0 shader for "direct3d"), or NULL.
+ *  \param shader_size The size of shader in bytes.
+ *
+ *  \return The created kernel, or NULL if the renderer can't run any of the
+ *          given implementations; call SDL_GetError() for more information.
+ *
+ *  \sa SDL_RenderSetKernel()
+ *  \sa SDL_DestroyRenderKernel()
+ */
+extern DECLSPEC SDL_RenderKernel * SDLCALL SDL_CreateRenderKernel(SDL_Renderer * renderer,
+                                                                 SDL_RenderKernelFunction function,
+                                                                 void *userdata,
+                                                                 const void *shader,
+                                                                 size_t shader_size);
+
+/**
+ *  \brief Set the kernel used to produce the pixels of later SDL_RenderCopy() calls.
+ *
+ *  While a kernel is set, every SDL_RenderCopy() writes the output of the
+ *  kernel to its destination rectangle instead of the texture texels. The
+ *  texture's blend mode and color and alpha modulation still apply to the
+ *  result. Rotated and flipped copies are not affected.
+ *
+ *  \param renderer The renderer for which the kernel should be set.
+ *  \param kernel   The kernel to use, or NULL to go back to plain copies.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderSetKernel(SDL_Renderer * renderer,
+                                                SDL_RenderKernel * kernel);
+
+/**
+ *  \brief Set the constants seen by kernels in later SDL_RenderCopy() calls.
+ *
+ *  The constants are recorded with the queued draws, so changing them between
+ *  copies does not flush the renderer. CPU kernels get them in their tiles,
+ *  and "direct3d" loads them into pixel shader registers starting at c0,
+ *  padded with zeros to a multiple of four.
+ *
+ *  \param renderer  The renderer for which the constants should be set.
+ *  \param constants The values to use.
+ *  \param count     The number of floats in constants, at most
+ *                   SDL_RENDER_KERNEL_MAX_CONSTANTS.
+ *
+ *  \return 0 on success, or -1 if the renderer doesn't support kernels or
+ *          there are too many constants.
+ *
+ *  \sa SDL_RenderSetKernel()
+ */
+extern DECLSPEC int SDLCALL SDL_RenderSetKernelConstants(SDL_Renderer * renderer,
+                                                         const float *constants,
+                                                         int count);
+
+/**
+ *  \brief Destroy a kernel, unsetting it first if it is in use.
+ *
+ *  \sa SDL_CreateRenderKernel()
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyRenderKernel(SDL_RenderKernel * kernel);
+
 
 /**
  *  \brief Bind the texture to the current OpenGL/ES/ES2 context for use with
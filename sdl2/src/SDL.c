@@ -42,6 +42,9 @@
 #include "haptic/SDL_haptic_c.h"
 #include "joystick/SDL_joystick_c.h"
 #include "sensor/SDL_sensor_c.h"
+#include "thread/SDL_threadpool_c.h"
+#include "video/SDL_blit.h"
+#include "video/SDL_pixels_c.h"
 
 /* Initialization/Cleanup routines */
 #if !SDL_TIMERS_DISABLED
@@ -417,6 +420,10 @@ SDL_Quit(void)
 #endif
     SDL_QuitSubSystem(SDL_INIT_EVERYTHING);
 
+    SDL_QuitThreadPool();
+    SDL_QuitPaletteTrees();
+    SDL_QuitBlit();
+
 #if !SDL_TIMERS_DISABLED
     SDL_TicksQuit();
 #endif
@@ -749,3 +749,11 @@
 #define SDL_GetAndroidSDKVersion SDL_GetAndroidSDKVersion_REAL
 #define SDL_isupper SDL_isupper_REAL
 #define SDL_islower SDL_islower_REAL
+#define SDL_CreateRenderKernel SDL_CreateRenderKernel_REAL
+#define SDL_RenderSetKernel SDL_RenderSetKernel_REAL
+#define SDL_DestroyRenderKernel SDL_DestroyRenderKernel_REAL
+#define SDL_RenderSetKernelConstants SDL_RenderSetKernelConstants_REAL
+#define SDL_RenderCopyBatch SDL_RenderCopyBatch_REAL
+#define SDL_RenderGetStats SDL_RenderGetStats_REAL
+#define SDL_SoftStretchLinear SDL_SoftStretchLinear_REAL
+#define SDL_PremultiplyAlpha SDL_PremultiplyAlpha_REAL
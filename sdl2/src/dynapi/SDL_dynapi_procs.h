@@ -809,3 +809,11 @@ SDL_DYNAPI_PROC(int,SDL_GetAndroidSDKVersion,(void),(),return)
 #endif
 SDL_DYNAPI_PROC(int,SDL_isupper,(int a),(a),return)
 SDL_DYNAPI_PROC(int,SDL_islower,(int a),(a),return)
+SDL_DYNAPI_PROC(SDL_RenderKernel*,SDL_CreateRenderKernel,(SDL_Renderer *a, SDL_RenderKernelFunction b, void *c, const void *d, size_t e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_RenderSetKernel,(SDL_Renderer *a, SDL_RenderKernel *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyRenderKernel,(SDL_RenderKernel *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_RenderSetKernelConstants,(SDL_Renderer *a, const float *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_RenderCopyBatch,(SDL_Renderer *a, SDL_Texture *b, const SDL_Rect *c, const SDL_FRect *d, const SDL_Color *e, int f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_RenderGetStats,(SDL_Renderer *a, SDL_RenderStats *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_SoftStretchLinear,(SDL_Surface *a, const SDL_Rect *b, SDL_Surface *c, const SDL_Rect *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_PremultiplyAlpha,(int a, int b, Uint32 c, const void *d, int e, Uint32 f, void *g, int h),(a,b,c,d,e,f,g,h),return)
@@ -26,6 +26,7 @@
 #include "SDL_hints.h"
 #include "SDL_log.h"
 #include "SDL_render.h"
+#include "SDL_timer.h"
 #include "SDL_sysrender.h"
 #include "software/SDL_render_sw_c.h"
 
@@ -49,6 +50,13 @@
         return retval; \
     }
 
+#define CHECK_KERNEL_MAGIC(kernel, retval) \
+    SDL_assert(kernel && kernel->magic == &kernel_magic); \
+    if (!kernel || kernel->magic != &kernel_magic) { \
+        SDL_SetError("Invalid kernel"); \
+        return retval; \
+    }
+
 /* Predefined blend modes */
 #define SDL_COMPOSE_BLENDMODE(srcColorFactor, dstColorFactor, colorOperation, \
                               srcAlphaFactor, dstAlphaFactor, alphaOperation) \
@@ -67,6 +75,10 @@
     SDL_COMPOSE_BLENDMODE(SDL_BLENDFACTOR_SRC_ALPHA, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD, \
                           SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD)
 
+#define SDL_BLENDMODE_BLEND_PREMULTIPLIED_FULL \
+    SDL_COMPOSE_BLENDMODE(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD, \
+                          SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD)
+
 #define SDL_BLENDMODE_ADD_FULL \
     SDL_COMPOSE_BLENDMODE(SDL_BLENDFACTOR_SRC_ALPHA, SDL_BLENDFACTOR_ONE, SDL_BLENDOPERATION_ADD, \
                           SDL_BLENDFACTOR_ZERO, SDL_BLENDFACTOR_ONE, SDL_BLENDOPERATION_ADD)
@@ -113,6 +125,7 @@ static const SDL_RenderDriver *render_drivers[] = {
 
 static char renderer_magic;
 static char texture_magic;
+static char kernel_magic;
 
 static SDL_INLINE void
 DebugLogRenderCommands(const SDL_RenderCommand *cmd)
@@ -199,50 +212,97 @@ DebugLogRenderCommands(const SDL_RenderCommand *cmd)
                         (int) cmd->data.draw.b, (int) cmd->data.draw.a,
                         (int) cmd->data.draw.blend, cmd->data.draw.texture);
                 break;
+
+            case SDL_RENDERCMD_SETKERNELCONSTANTS:
+                SDL_Log(" %u. set kernel constants (first=%u, count=%d)", i++,
+                        (unsigned int) cmd->data.constants.first,
+                        cmd->data.constants.count);
+                break;
         }
         cmd = cmd->next;
     }
 #endif
 }
 
+static void
+CountRenderCommand(SDL_RenderStats *stats, const SDL_RenderCommand *cmd)
+{
+    switch (cmd->command) {
+        case SDL_RENDERCMD_NO_OP: break;
+        case SDL_RENDERCMD_SETVIEWPORT: stats->set_viewport++; break;
+        case SDL_RENDERCMD_SETCLIPRECT: stats->set_cliprect++; break;
+        case SDL_RENDERCMD_SETDRAWCOLOR: stats->set_draw_color++; break;
+        case SDL_RENDERCMD_SETKERNELCONSTANTS: stats->set_kernel_constants++; break;
+        case SDL_RENDERCMD_CLEAR: stats->clears++; break;
+        case SDL_RENDERCMD_DRAW_POINTS: stats->draw_points++; break;
+        case SDL_RENDERCMD_DRAW_LINES: stats->draw_lines++; break;
+        case SDL_RENDERCMD_FILL_RECTS: stats->fill_rects++; break;
+        case SDL_RENDERCMD_COPY:
+            stats->copies++;
+            stats->copy_rects += (Uint32) cmd->data.draw.count;
+            break;
+        case SDL_RENDERCMD_COPY_EX: stats->copies_ex++; break;
+    }
+}
+
 static int
-FlushRenderCommands(SDL_Renderer *renderer)
+FlushRenderCommandQueue(SDL_Renderer *renderer, const SDL_bool forced)
 {
+    SDL_RenderCommand *cmds = renderer->render_commands;
+    const size_t count = renderer->render_commands_used;
+    Uint64 start;
+    size_t i;
     int retval;
 
-    SDL_assert((renderer->render_commands == NULL) == (renderer->render_commands_tail == NULL));
-
-    if (renderer->render_commands == NULL) {  /* nothing to do! */
+    if (count == 0) {  /* nothing to do! */
         SDL_assert(renderer->vertex_data_used == 0);
         return 0;
     }
 
-    DebugLogRenderCommands(renderer->render_commands);
-
-    retval = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
+    /* The backends walk the queue as a list, which is now in its final place in memory. */
+    for (i = 0; i < count - 1; i++) {
+        CountRenderCommand(&renderer->stats, &cmds[i]);
+        cmds[i].next = &cmds[i + 1];
+    }
+    CountRenderCommand(&renderer->stats, &cmds[count - 1]);
+    cmds[count - 1].next = NULL;
 
-    /* Move the whole render command queue to the unused pool so we can reuse them next time. */
-    if (renderer->render_commands_tail != NULL) {
-        renderer->render_commands_tail->next = renderer->render_commands_pool;
-        renderer->render_commands_pool = renderer->render_commands;
-        renderer->render_commands_tail = NULL;
-        renderer->render_commands = NULL;
+    if (forced) {
+        renderer->stats.forced_flushes++;
+    } else {
+        renderer->stats.flushes++;
     }
+
+    DebugLogRenderCommands(cmds);
+
+    start = SDL_GetPerformanceCounter();
+    retval = renderer->RunCommandQueue(renderer, cmds, renderer->vertex_data, renderer->vertex_data_used);
+    renderer->run_queue_ticks += SDL_GetPerformanceCounter() - start;
+
+    /* Keep the array around so we can reuse it next time. */
+    renderer->render_commands_used = 0;
     renderer->vertex_data_used = 0;
     renderer->render_command_generation++;
     renderer->color_queued = SDL_FALSE;
     renderer->viewport_queued = SDL_FALSE;
     renderer->cliprect_queued = SDL_FALSE;
+    renderer->kernel_constants_queued = SDL_FALSE;
     return retval;
 }
 
+static int
+FlushRenderCommands(SDL_Renderer *renderer)
+{
+    return FlushRenderCommandQueue(renderer, SDL_FALSE);
+}
+
 static int
 FlushRenderCommandsIfTextureNeeded(SDL_Texture *texture)
 {
     SDL_Renderer *renderer = texture->renderer;
     if (texture->last_command_generation == renderer->render_command_generation) {
         /* the current command queue depends on this texture, flush the queue now before it changes */
-        return FlushRenderCommands(renderer);
+        return FlushRenderCommandQueue(renderer, SDL_TRUE);
     }
     return 0;
 }
@@ -289,39 +349,42 @@ SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes, const
     }
 
     renderer->vertex_data_used += aligner + numbytes;
+    renderer->stats.vertex_bytes += aligner + numbytes;
 
     return ((Uint8 *) renderer->vertex_data) + aligned;
 }
 
+/* Growing the queue moves it, so the returned command is only valid until the next one is allocated. */
 static SDL_RenderCommand *
 AllocateRenderCommand(SDL_Renderer *renderer)
 {
     SDL_RenderCommand *retval = NULL;
 
     /* !!! FIXME: are there threading limitations in SDL's render API? If not, we need to mutex this. */
-    retval = renderer->render_commands_pool;
-    if (retval != NULL) {
-        renderer->render_commands_pool = retval->next;
-        retval->next = NULL;
-    } else {
-        retval = SDL_calloc(1, sizeof (*retval));
-        if (!retval) {
+    if (renderer->render_commands_used == renderer->render_commands_allocation) {
+        const size_t newcount = renderer->render_commands ? renderer->render_commands_allocation * 2 : 64;
+        void *ptr = SDL_realloc(renderer->render_commands, newcount * sizeof (SDL_RenderCommand));
+        if (ptr == NULL) {
             SDL_OutOfMemory();
             return NULL;
         }
+        renderer->render_commands = (SDL_RenderCommand *) ptr;
+        renderer->render_commands_allocation = newcount;
     }
 
-    SDL_assert((renderer->render_commands == NULL) == (renderer->render_commands_tail == NULL));
-    if (renderer->render_commands_tail != NULL) {
-        renderer->render_commands_tail->next = retval;
-    } else {
-        renderer->render_commands = retval;
-    }
-    renderer->render_commands_tail = retval;
+    retval = &renderer->render_commands[renderer->render_commands_used++];
+    SDL_zerop(retval);
 
     return retval;
 }
 
+/* The most recently queued command */
+static SDL_INLINE SDL_RenderCommand *
+LastRenderCommand(SDL_Renderer *renderer)
+{
+    return renderer->render_commands_used ? &renderer->render_commands[renderer->render_commands_used - 1] : NULL;
+}
+
 static int
 QueueCmdSetViewport(SDL_Renderer *renderer)
 {
@@ -396,6 +459,26 @@ QueueCmdSetDrawColor(SDL_Renderer *renderer, const Uint8 r, const Uint8 g, const
     return retval;
 }
 
+static int
+QueueCmdSetKernelConstants(SDL_Renderer *renderer)
+{
+    SDL_RenderCommand *cmd = AllocateRenderCommand(renderer);
+    int retval = -1;
+
+    if (cmd != NULL) {
+        cmd->command = SDL_RENDERCMD_SETKERNELCONSTANTS;
+        cmd->data.constants.first = 0;  /* render backend will fill this in. */
+        cmd->data.constants.count = renderer->num_kernel_constants;
+        retval = renderer->QueueSetKernelConstants(renderer, cmd, renderer->kernel_constants);
+        if (retval < 0) {
+            cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            renderer->kernel_constants_queued = SDL_TRUE;
+        }
+    }
+    return retval;
+}
+
 static int
 QueueCmdClear(SDL_Renderer *renderer)
 {
@@ -446,6 +529,7 @@ PrepQueueCmdDrawSolid(SDL_Renderer *renderer, const SDL_RenderCommandType cmdtyp
             cmd->data.draw.a = renderer->a;
             cmd->data.draw.blend = renderer->blendMode;
             cmd->data.draw.texture = NULL;  /* no texture. */
+            cmd->data.draw.kernel = NULL;
         }
     }
     return cmd;
@@ -494,47 +578,148 @@ QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect * rects, const int cou
 }
 
 static SDL_RenderCommand *
-PrepQueueCmdDrawTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_RenderCommandType cmdtype)
+PrepQueueCmdDrawTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_RenderCommandType cmdtype,
+                        const Uint8 r, const Uint8 g, const Uint8 b, const Uint8 a)
 {
     /* !!! FIXME: drop this draw if viewport w or h is zero. */
     SDL_RenderCommand *cmd = NULL;
-    if (PrepQueueCmdDraw(renderer, texture->r, texture->g, texture->b, texture->a) == 0) {
+    const SDL_bool use_kernel = (cmdtype == SDL_RENDERCMD_COPY && renderer->kernel) ? SDL_TRUE : SDL_FALSE;
+    int retval = PrepQueueCmdDraw(renderer, r, g, b, a);
+
+    /* Like the draw state, constants are queued lazily before the first draw that needs them. */
+    if (retval == 0 && use_kernel && !renderer->kernel_constants_queued) {
+        retval = QueueCmdSetKernelConstants(renderer);
+    }
+
+    if (retval == 0) {
         cmd = AllocateRenderCommand(renderer);
         if (cmd != NULL) {
             cmd->command = cmdtype;
             cmd->data.draw.first = 0;  /* render backend will fill this in. */
             cmd->data.draw.count = 0;  /* render backend will fill this in. */
-            cmd->data.draw.r = texture->r;
-            cmd->data.draw.g = texture->g;
-            cmd->data.draw.b = texture->b;
-            cmd->data.draw.a = texture->a;
+            cmd->data.draw.r = r;
+            cmd->data.draw.g = g;
+            cmd->data.draw.b = b;
+            cmd->data.draw.a = a;
             cmd->data.draw.blend = texture->blendMode;
             cmd->data.draw.texture = texture;
+            cmd->data.draw.kernel = NULL;
+            cmd->data.draw.colors = SDL_FALSE;
+
+            /* Kernels only replace the texels of plain copies. */
+            if (use_kernel) {
+                cmd->data.draw.kernel = renderer->kernel;
+                renderer->kernel->last_command_generation = renderer->render_command_generation;
+            }
         }
     }
     return cmd;
 }
 
+/* Folds the copy that was just queued into the command before it when
+ * nothing else was queued in between (queued_before is the number of commands
+ * queued before the copy), they share all of their draw state and their
+ * vertex data is contiguous. The backend then sets that state up once for the
+ * whole run. */
+static void
+MergeQueuedCopy(SDL_Renderer *renderer, const size_t queued_before)
+{
+    SDL_RenderCommand *cmd = LastRenderCommand(renderer);
+    SDL_RenderCommand *prev;
+    size_t copysize;
+
+    if (!renderer->merge_copies || queued_before == 0 || renderer->render_commands_used != queued_before + 1 ||
+        cmd->data.draw.count == 0) {
+        return;
+    }
+
+    prev = cmd - 1;
+    if (prev->command != SDL_RENDERCMD_COPY || prev->data.draw.colors || cmd->data.draw.colors ||
+        prev->data.draw.texture != cmd->data.draw.texture ||
+        prev->data.draw.kernel != cmd->data.draw.kernel ||
+        prev->data.draw.blend != cmd->data.draw.blend ||
+        prev->data.draw.r != cmd->data.draw.r ||
+        prev->data.draw.g != cmd->data.draw.g ||
+        prev->data.draw.b != cmd->data.draw.b ||
+        prev->data.draw.a != cmd->data.draw.a) {
+        return;
+    }
+
+    copysize = (renderer->vertex_data_used - cmd->data.draw.first) / cmd->data.draw.count;
+    if (prev->data.draw.first + prev->data.draw.count * copysize != cmd->data.draw.first) {
+        return;
+    }
+
+    prev->data.draw.count += cmd->data.draw.count;
+
+    /* cmd is the tail of the queue, give it back. */
+    renderer->render_commands_used--;
+}
+
 static int
 QueueCmdCopy(SDL_Renderer *renderer, SDL_Texture * texture, const SDL_Rect * srcrect, const SDL_FRect * dstrect)
 {
-    SDL_RenderCommand *cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY);
+    const size_t queued_before = renderer->render_commands_used;
+    SDL_RenderCommand *cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY,
+                                                     texture->r, texture->g, texture->b, texture->a);
     int retval = -1;
     if (cmd != NULL) {
         retval = renderer->QueueCopy(renderer, cmd, texture, srcrect, dstrect);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            MergeQueuedCopy(renderer, queued_before);
         }
     }
     return retval;
 }
 
+static int
+QueueCmdCopyBatch(SDL_Renderer *renderer, SDL_Texture * texture, const SDL_Rect * srcrects,
+                  const SDL_FRect * dstrects, const SDL_Color * colors, const int count)
+{
+    SDL_RenderCommand *cmd;
+    int i, retval = -1;
+
+    if (renderer->QueueCopyBatch) {
+        cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY,
+                                      texture->r, texture->g, texture->b, texture->a);
+        if (cmd != NULL) {
+            retval = renderer->QueueCopyBatch(renderer, cmd, texture, srcrects, dstrects, colors, count);
+            if (retval < 0) {
+                cmd->command = SDL_RENDERCMD_NO_OP;
+            }
+        }
+        return retval;
+    }
+
+    /* Everything else gets one copy at a time, each with its own color. */
+    for (i = 0; i < count; i++) {
+        const size_t queued_before = renderer->render_commands_used;
+        const SDL_Color *color = colors ? &colors[i] : NULL;
+        cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY,
+                                      color ? color->r : texture->r, color ? color->g : texture->g,
+                                      color ? color->b : texture->b, color ? color->a : texture->a);
+        if (cmd == NULL) {
+            return -1;
+        }
+        retval = renderer->QueueCopy(renderer, cmd, texture, &srcrects[i], &dstrects[i]);
+        if (retval < 0) {
+            cmd->command = SDL_RENDERCMD_NO_OP;
+            return retval;
+        }
+        MergeQueuedCopy(renderer, queued_before);
+    }
+    return 0;
+}
+
 static int
 QueueCmdCopyEx(SDL_Renderer *renderer, SDL_Texture * texture,
                const SDL_Rect * srcquad, const SDL_FRect * dstrect,
                const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip)
 {
-    SDL_RenderCommand *cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY_EX);
+    SDL_RenderCommand *cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_COPY_EX,
+                                                     texture->r, texture->g, texture->b, texture->a);
     int retval = -1;
     SDL_assert(renderer->QueueCopyEx != NULL);  /* should have caught at higher level. */
     if (cmd != NULL) {
@@ -924,6 +1109,9 @@ SDL_CreateSoftwareRenderer(SDL_Surface * surface)
         /* new textures start at zero, so we start at 1 so first render doesn't flush by accident. */
         renderer->render_command_generation = 1;
 
+        /* Like an explicitly requested driver, only batch if the app asks for it. */
+        renderer->batching = SDL_GetHintBoolean(SDL_HINT_RENDER_BATCHING, SDL_FALSE);
+
         SDL_RenderSetViewport(renderer, NULL);
     }
     return renderer;
@@ -1551,6 +1739,7 @@ SDL_UpdateTexture(SDL_Texture * texture, const SDL_Rect * rect,
         if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
             return -1;
         }
+        renderer->stats.texture_uploads++;
         return renderer->UpdateTexture(renderer, texture, rect, pixels, pitch);
     }
 }
@@ -1666,6 +1855,7 @@ int SDL_UpdateYUVTexture(SDL_Texture * texture, const SDL_Rect * rect,
             if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
                 return -1;
             }
+            renderer->stats.texture_uploads++;
             return renderer->UpdateTextureYUV(renderer, texture, rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
         } else {
             return SDL_Unsupported();
@@ -1733,6 +1923,7 @@ SDL_LockTexture(SDL_Texture * texture, const SDL_Rect * rect,
         if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
             return -1;
         }
+        renderer->stats.texture_locks++;
         return renderer->LockTexture(renderer, texture, rect, pixels, pitch);
     }
 }
@@ -3000,6 +3191,99 @@ SDL_RenderCopyF(SDL_Renderer * renderer, SDL_Texture * texture,
     return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
 }
 
+int
+SDL_RenderCopyBatch(SDL_Renderer * renderer, SDL_Texture * texture,
+                    const SDL_Rect * srcrects, const SDL_FRect * dstrects,
+                    const SDL_Color * colors, int count)
+{
+    SDL_Rect texture_rect, *real_srcrects;
+    SDL_FRect viewport_rect, *real_dstrects;
+    SDL_Color *real_colors = NULL;
+    SDL_Rect r;
+    Uint8 *scratch;
+    size_t instance_size;
+    SDL_bool isstack;
+    int i, visible = 0;
+    int retval;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (renderer != texture->renderer) {
+        return SDL_SetError("Texture was not created with this renderer");
+    }
+    if (!dstrects) {
+        return SDL_SetError("SDL_RenderCopyBatch(): Passed NULL dstrects");
+    }
+    if (count < 1) {
+        return 0;
+    }
+
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+
+    texture_rect.x = 0;
+    texture_rect.y = 0;
+    texture_rect.w = texture->w;
+    texture_rect.h = texture->h;
+
+    SDL_zero(r);
+    SDL_RenderGetViewport(renderer, &r);
+    viewport_rect.x = 0.0f;
+    viewport_rect.y = 0.0f;
+    viewport_rect.w = (float) r.w;
+    viewport_rect.h = (float) r.h;
+
+    if (texture->native) {
+        texture = texture->native;
+    }
+
+    /* The copies that survive clipping, in the same order */
+    instance_size = sizeof (SDL_FRect) + sizeof (SDL_Rect) + (colors ? sizeof (SDL_Color) : 0);
+    scratch = SDL_small_alloc(Uint8, count * instance_size, &isstack);
+    if (!scratch) {
+        return SDL_OutOfMemory();
+    }
+    real_dstrects = (SDL_FRect *) scratch;
+    real_srcrects = (SDL_Rect *) (real_dstrects + count);
+    if (colors) {
+        real_colors = (SDL_Color *) (real_srcrects + count);
+    }
+
+    for (i = 0; i < count; i++) {
+        SDL_Rect *srcrect = &real_srcrects[visible];
+        SDL_FRect *dstrect = &real_dstrects[visible];
+
+        *srcrect = texture_rect;
+        if (srcrects && !SDL_IntersectRect(&srcrects[i], &texture_rect, srcrect)) {
+            continue;
+        }
+        if (!SDL_HasIntersectionF(&dstrects[i], &viewport_rect)) {
+            continue;
+        }
+
+        dstrect->x = dstrects[i].x * renderer->scale.x;
+        dstrect->y = dstrects[i].y * renderer->scale.y;
+        dstrect->w = dstrects[i].w * renderer->scale.x;
+        dstrect->h = dstrects[i].h * renderer->scale.y;
+        if (colors) {
+            real_colors[visible] = colors[i];
+        }
+        visible++;
+    }
+
+    retval = 0;
+    if (visible > 0) {
+        texture->last_command_generation = renderer->render_command_generation;
+        retval = QueueCmdCopyBatch(renderer, texture, real_srcrects, real_dstrects, real_colors, visible);
+    }
+    SDL_small_free(scratch, isstack);
+
+    return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
+}
+
 int
 SDL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
                const SDL_Rect * srcrect, const SDL_Rect * dstrect,
@@ -3104,6 +3388,127 @@ SDL_RenderCopyExF(SDL_Renderer * renderer, SDL_Texture * texture,
     return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
 }
 
+SDL_RenderKernel *
+SDL_CreateRenderKernel(SDL_Renderer * renderer, SDL_RenderKernelFunction function,
+                       void *userdata, const void *shader, size_t shader_size)
+{
+    SDL_RenderKernel *kernel;
+
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    if (!renderer->CreateKernel) {
+        SDL_Unsupported();
+        return NULL;
+    }
+    if (!function && !shader) {
+        SDL_SetError("Kernel needs a function or a shader");
+        return NULL;
+    }
+
+    kernel = (SDL_RenderKernel *) SDL_calloc(1, sizeof(*kernel));
+    if (!kernel) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    kernel->function = function;
+    kernel->userdata = userdata;
+    kernel->renderer = renderer;
+
+    if (renderer->CreateKernel(renderer, kernel, shader, shader_size) < 0) {
+        SDL_free(kernel);
+        return NULL;
+    }
+
+    kernel->magic = &kernel_magic;
+    kernel->next = renderer->kernels;
+    if (renderer->kernels) {
+        renderer->kernels->prev = kernel;
+    }
+    renderer->kernels = kernel;
+    return kernel;
+}
+
+int
+SDL_RenderSetKernel(SDL_Renderer * renderer, SDL_RenderKernel * kernel)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (kernel) {
+        CHECK_KERNEL_MAGIC(kernel, -1);
+        if (renderer != kernel->renderer) {
+            return SDL_SetError("Kernel was not created with this renderer");
+        }
+    }
+
+    /* Queued copies keep the kernel they were recorded with, no flush needed. */
+    renderer->kernel = kernel;
+    return 0;
+}
+
+int
+SDL_RenderSetKernelConstants(SDL_Renderer * renderer, const float *constants, int count)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!renderer->QueueSetKernelConstants) {
+        return SDL_Unsupported();
+    }
+    if (count < 0 || count > SDL_RENDER_KERNEL_MAX_CONSTANTS) {
+        return SDL_InvalidParamError("count");
+    }
+    if (!constants && count > 0) {
+        return SDL_InvalidParamError("constants");
+    }
+
+    if (count == renderer->num_kernel_constants &&
+        (count == 0 || SDL_memcmp(constants, renderer->kernel_constants, count * sizeof (float)) == 0)) {
+        return 0;  /* nothing changed. */
+    }
+
+    /* Keep the tail zeroed, backends may read whole float4 registers. */
+    SDL_zero(renderer->kernel_constants);
+    if (count > 0) {
+        SDL_memcpy(renderer->kernel_constants, constants, count * sizeof (float));
+    }
+    renderer->num_kernel_constants = count;
+
+    /* The next copy with a kernel queues the new values, no flush needed. */
+    renderer->kernel_constants_queued = SDL_FALSE;
+    return 0;
+}
+
+void
+SDL_DestroyRenderKernel(SDL_RenderKernel * kernel)
+{
+    SDL_Renderer *renderer;
+
+    CHECK_KERNEL_MAGIC(kernel, );
+
+    renderer = kernel->renderer;
+    if (kernel->last_command_generation == renderer->render_command_generation) {
+        FlushRenderCommands(renderer);
+    }
+    if (renderer->kernel == kernel) {
+        renderer->kernel = NULL;
+    }
+
+    kernel->magic = NULL;
+
+    if (kernel->next) {
+        kernel->next->prev = kernel->prev;
+    }
+    if (kernel->prev) {
+        kernel->prev->next = kernel->next;
+    } else {
+        renderer->kernels = kernel->next;
+    }
+
+    if (renderer->DestroyKernel) {
+        renderer->DestroyKernel(renderer, kernel);
+    }
+    SDL_free(kernel);
+}
+
 int
 SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                      Uint32 format, void * pixels, int pitch)
@@ -3146,6 +3551,8 @@ SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
 void
 SDL_RenderPresent(SDL_Renderer * renderer)
 {
+    Uint64 start, frequency;
+
     CHECK_RENDERER_MAGIC(renderer, );
 
     FlushRenderCommands(renderer);  /* time to send everything to the GPU! */
@@ -3155,7 +3562,31 @@ SDL_RenderPresent(SDL_Renderer * renderer)
     //    return;
     // }
  
+    start = SDL_GetPerformanceCounter();
     renderer->RenderPresent(renderer);
+    renderer->present_ticks += SDL_GetPerformanceCounter() - start;
+
+    /* That was the end of the frame */
+    frequency = SDL_GetPerformanceFrequency();
+    renderer->stats.run_queue_us = renderer->run_queue_ticks * 1000000 / frequency;
+    renderer->stats.present_us = renderer->present_ticks * 1000000 / frequency;
+    renderer->last_stats = renderer->stats;
+    SDL_zero(renderer->stats);
+    renderer->run_queue_ticks = 0;
+    renderer->present_ticks = 0;
+}
+
+int
+SDL_RenderGetStats(SDL_Renderer * renderer, SDL_RenderStats * stats)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    *stats = renderer->last_stats;
+    return 0;
 }
 
 void
@@ -3204,28 +3635,14 @@ SDL_DestroyTexture(SDL_Texture * texture)
 void
 SDL_DestroyRenderer(SDL_Renderer * renderer)
 {
-    SDL_RenderCommand *cmd;
-
     CHECK_RENDERER_MAGIC(renderer, );
 
     SDL_DelEventWatch(SDL_RendererEventWatch, renderer);
 
-    if (renderer->render_commands_tail != NULL) {
-        renderer->render_commands_tail->next = renderer->render_commands_pool;
-        cmd = renderer->render_commands;
-    } else {
-        cmd = renderer->render_commands_pool;
-    }
-
-    renderer->render_commands_pool = NULL;
-    renderer->render_commands_tail = NULL;
+    SDL_free(renderer->render_commands);
     renderer->render_commands = NULL;
-
-    while (cmd != NULL) {
-        SDL_RenderCommand *next = cmd->next;
-        SDL_free(cmd);
-        cmd = next;
-    }
+    renderer->render_commands_used = 0;
+    renderer->render_commands_allocation = 0;
 
     SDL_free(renderer->vertex_data);
 
@@ -3236,6 +3653,10 @@ SDL_DestroyRenderer(SDL_Renderer * renderer)
         SDL_assert(tex != renderer->textures);  /* satisfy static analysis. */
     }
 
+    while (renderer->kernels) {
+        SDL_DestroyRenderKernel(renderer->kernels);
+    }
+
     if (renderer->window) {
         SDL_SetWindowData(renderer->window, SDL_WINDOWRENDERDATA, NULL);
     }
@@ -3316,6 +3737,9 @@ SDL_GetShortBlendMode(SDL_BlendMode blendMode)
     if (blendMode == SDL_BLENDMODE_BLEND_FULL) {
         return SDL_BLENDMODE_BLEND;
     }
+    if (blendMode == SDL_BLENDMODE_BLEND_PREMULTIPLIED_FULL) {
+        return SDL_BLENDMODE_BLEND_PREMULTIPLIED;
+    }
     if (blendMode == SDL_BLENDMODE_ADD_FULL) {
         return SDL_BLENDMODE_ADD;
     }
@@ -3337,6 +3761,9 @@ SDL_GetLongBlendMode(SDL_BlendMode blendMode)
     if (blendMode == SDL_BLENDMODE_BLEND) {
         return SDL_BLENDMODE_BLEND_FULL;
     }
+    if (blendMode == SDL_BLENDMODE_BLEND_PREMULTIPLIED) {
+        return SDL_BLENDMODE_BLEND_PREMULTIPLIED_FULL;
+    }
     if (blendMode == SDL_BLENDMODE_ADD) {
         return SDL_BLENDMODE_ADD_FULL;
     }
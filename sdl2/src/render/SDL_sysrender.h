@@ -63,6 +63,23 @@ struct SDL_Texture
     SDL_Texture *next;
 };
 
+/* Define the SDL render kernel structure */
+struct SDL_RenderKernel
+{
+    const void *magic;
+    SDL_RenderKernelFunction function;  /**< CPU implementation, or NULL */
+    void *userdata;                     /**< Passed to function */
+
+    SDL_Renderer *renderer;
+
+    Uint32 last_command_generation; /* last command queue generation this kernel was in. */
+
+    void *driverdata;           /**< Driver specific kernel representation */
+
+    SDL_RenderKernel *prev;
+    SDL_RenderKernel *next;
+};
+
 typedef enum
 {
     SDL_RENDERCMD_NO_OP,
@@ -74,7 +91,8 @@ typedef enum
     SDL_RENDERCMD_DRAW_LINES,
     SDL_RENDERCMD_FILL_RECTS,
     SDL_RENDERCMD_COPY,
-    SDL_RENDERCMD_COPY_EX
+    SDL_RENDERCMD_COPY_EX,
+    SDL_RENDERCMD_SETKERNELCONSTANTS
 } SDL_RenderCommandType;
 
 typedef struct SDL_RenderCommand
@@ -95,11 +113,17 @@ typedef struct SDL_RenderCommand
             Uint8 r, g, b, a;
             SDL_BlendMode blend;
             SDL_Texture *texture;
+            SDL_RenderKernel *kernel;
+            SDL_bool colors;  /* each copy of the command has its own color, see QueueCopyBatch */
         } draw;
         struct {
             size_t first;
             Uint8 r, g, b, a;
         } color;
+        struct {
+            size_t first;
+            int count;
+        } constants;
     } data;
     struct SDL_RenderCommand *next;
 } SDL_RenderCommand;
@@ -116,6 +140,8 @@ struct SDL_Renderer
     int (*CreateTexture) (SDL_Renderer * renderer, SDL_Texture * texture);
     int (*QueueSetViewport) (SDL_Renderer * renderer, SDL_RenderCommand *cmd);
     int (*QueueSetDrawColor) (SDL_Renderer * renderer, SDL_RenderCommand *cmd);
+    int (*QueueSetKernelConstants) (SDL_Renderer * renderer, SDL_RenderCommand *cmd,
+                                    const float *constants);
     int (*QueueDrawPoints) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FPoint * points,
                              int count);
     int (*QueueDrawLines) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FPoint * points,
@@ -127,6 +153,12 @@ struct SDL_Renderer
     int (*QueueCopyEx) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
                         const SDL_Rect * srcquad, const SDL_FRect * dstrect,
                         const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip);
+    /* Optional: queues count copies as one COPY command. When colors isn't
+       NULL, it replaces the color of the command for each copy and the
+       backend sets cmd->data.draw.colors. */
+    int (*QueueCopyBatch) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                           const SDL_Rect * srcrects, const SDL_FRect * dstrects,
+                           const SDL_Color * colors, int count);
     int (*RunCommandQueue) (SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize);
     int (*UpdateTexture) (SDL_Renderer * renderer, SDL_Texture * texture,
                           const SDL_Rect * rect, const void *pixels,
@@ -145,6 +177,9 @@ struct SDL_Renderer
                              Uint32 format, void * pixels, int pitch);
     void (*RenderPresent) (SDL_Renderer * renderer);
     void (*DestroyTexture) (SDL_Renderer * renderer, SDL_Texture * texture);
+    int (*CreateKernel) (SDL_Renderer * renderer, SDL_RenderKernel * kernel,
+                         const void *shader, size_t shader_size);
+    void (*DestroyKernel) (SDL_Renderer * renderer, SDL_RenderKernel * kernel);
 
     void (*DestroyRenderer) (SDL_Renderer * renderer);
 
@@ -194,14 +229,23 @@ struct SDL_Renderer
     SDL_Texture *target;
     SDL_mutex *target_mutex;
 
+    /* The list of kernels, and the one applied to texture copies */
+    SDL_RenderKernel *kernels;
+    SDL_RenderKernel *kernel;
+    float kernel_constants[SDL_RENDER_KERNEL_MAX_CONSTANTS];
+    int num_kernel_constants;
+
     Uint8 r, g, b, a;                   /**< Color for drawing operations values */
     SDL_BlendMode blendMode;            /**< The drawing blend mode */
 
     SDL_bool always_batch;
+    SDL_bool merge_copies;  /* backend draws every rect of COPY commands with count > 1 */
     SDL_bool batching;
+    /* The queue is one array, reused from flush to flush. Its next pointers
+     * are only linked up when it is handed to RunCommandQueue. */
     SDL_RenderCommand *render_commands;
-    SDL_RenderCommand *render_commands_tail;
-    SDL_RenderCommand *render_commands_pool;
+    size_t render_commands_used;
+    size_t render_commands_allocation;
     Uint32 render_command_generation;
     Uint32 last_queued_color;
     SDL_Rect last_queued_viewport;
@@ -210,11 +254,18 @@ struct SDL_Renderer
     SDL_bool color_queued;
     SDL_bool viewport_queued;
     SDL_bool cliprect_queued;
+    SDL_bool kernel_constants_queued;
 
     void *vertex_data;
     size_t vertex_data_used;
     size_t vertex_data_allocation;
 
+    /* The frame being drawn and the last presented one */
+    SDL_RenderStats stats;
+    SDL_RenderStats last_stats;
+    Uint64 run_queue_ticks;  /* stats.run_queue_us so far, in performance counter ticks */
+    Uint64 present_ticks;    /* stats.present_us so far, in performance counter ticks */
+
     void *driverdata;
 };
 
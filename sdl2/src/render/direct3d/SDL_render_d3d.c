@@ -55,6 +55,7 @@ typedef struct
     SDL_bool cliprect_dirty;
     SDL_bool is_copy_ex;
     LPDIRECT3DPIXELSHADER9 shader;
+    SDL_RenderKernel *kernel;
 } D3D_DrawStateCache;
 
 
@@ -808,6 +809,23 @@ D3D_QueueSetViewport(SDL_Renderer * renderer, SDL_RenderCommand *cmd)
     return 0;  /* nothing to do in this backend. */
 }
 
+static int
+D3D_QueueSetKernelConstants(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const float *constants)
+{
+    /* Shader constants are whole float4 registers, and the block is rounded
+       up to whole vertices so the vertices queued after it stay indexable. */
+    const size_t constantslen = ((cmd->data.constants.count + 3) / 4) * 4 * sizeof (float);
+    const size_t vertslen = ((constantslen + sizeof (Vertex) - 1) / sizeof (Vertex)) * sizeof (Vertex);
+    float *verts = (float *) SDL_AllocateRenderVertices(renderer, vertslen, 0, &cmd->data.constants.first);
+
+    if (!verts) {
+        return -1;
+    }
+
+    SDL_memcpy(verts, constants, constantslen);
+    return 0;
+}
+
 static int
 D3D_QueueDrawPoints(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FPoint * points, int count)
 {
@@ -1122,9 +1140,10 @@ SetDrawState(D3D_RenderData *data, const SDL_RenderCommand *cmd)
     const SDL_bool was_copy_ex = data->drawstate.is_copy_ex;
     const SDL_bool is_copy_ex = (cmd->command == SDL_RENDERCMD_COPY_EX);
     SDL_Texture *texture = cmd->data.draw.texture;
+    SDL_RenderKernel *kernel = cmd->data.draw.kernel;
     const SDL_BlendMode blend = cmd->data.draw.blend;
 
-    if (texture != data->drawstate.texture) {
+    if (texture != data->drawstate.texture || kernel != data->drawstate.kernel) {
         D3D_TextureData *oldtexturedata = data->drawstate.texture ? (D3D_TextureData *) data->drawstate.texture->driverdata : NULL;
         D3D_TextureData *newtexturedata = texture ? (D3D_TextureData *) texture->driverdata : NULL;
         LPDIRECT3DPIXELSHADER9 shader = NULL;
@@ -1140,6 +1159,9 @@ SetDrawState(D3D_RenderData *data, const SDL_RenderCommand *cmd)
         if (texture && SetupTextureState(data, texture, &shader) < 0) {
             return -1;
         }
+        if (kernel) {
+            shader = (LPDIRECT3DPIXELSHADER9) kernel->driverdata;
+        }
 
         if (shader != data->drawstate.shader) {
             const HRESULT result = IDirect3DDevice9_SetPixelShader(data->device, shader);
@@ -1150,6 +1172,7 @@ SetDrawState(D3D_RenderData *data, const SDL_RenderCommand *cmd)
         }
 
         data->drawstate.texture = texture;
+        data->drawstate.kernel = kernel;
     } else if (texture) {
         D3D_TextureData *texturedata = (D3D_TextureData *) texture->driverdata;
         UpdateDirtyTexture(data->device, &texturedata->texture);
@@ -1432,6 +1455,15 @@ D3D_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *verti
                 break;
             }
 
+            case SDL_RENDERCMD_SETKERNELCONSTANTS: {
+                const float *constants = (const float *) (((Uint8 *) vertices) + cmd->data.constants.first);
+                const UINT registers = (UINT) ((cmd->data.constants.count + 3) / 4);
+                if (registers > 0) {
+                    IDirect3DDevice9_SetPixelShaderConstantF(data->device, 0, constants, registers);
+                }
+                break;
+            }
+
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
@@ -1553,6 +1585,44 @@ D3D_DestroyTexture(SDL_Renderer * renderer, SDL_Texture * texture)
     texture->driverdata = NULL;
 }
 
+static int
+D3D_CreateKernel(SDL_Renderer * renderer, SDL_RenderKernel * kernel, const void *shader, size_t shader_size)
+{
+    D3D_RenderData *data = (D3D_RenderData *) renderer->driverdata;
+    LPDIRECT3DPIXELSHADER9 pixelshader;
+    HRESULT result;
+
+    if (!shader) {
+        return SDL_SetError("Direct3D renderer needs pixel shader bytecode for kernels");
+    }
+
+    result = IDirect3DDevice9_CreatePixelShader(data->device, (const DWORD *) shader, &pixelshader);
+    if (FAILED(result)) {
+        return D3D_SetError("CreatePixelShader()", result);
+    }
+    kernel->driverdata = pixelshader;
+    return 0;
+}
+
+static void
+D3D_DestroyKernel(SDL_Renderer * renderer, SDL_RenderKernel * kernel)
+{
+    D3D_RenderData *data = (D3D_RenderData *) renderer->driverdata;
+    LPDIRECT3DPIXELSHADER9 pixelshader = (LPDIRECT3DPIXELSHADER9) kernel->driverdata;
+
+    if (data->drawstate.kernel == kernel) {
+        data->drawstate.kernel = NULL;
+        data->drawstate.texture = NULL;
+        data->drawstate.shader = NULL;
+        IDirect3DDevice9_SetPixelShader(data->device, NULL);
+    }
+
+    if (pixelshader) {
+        IDirect3DPixelShader9_Release(pixelshader);
+    }
+    kernel->driverdata = NULL;
+}
+
 static void
 D3D_DestroyRenderer(SDL_Renderer * renderer)
 {
@@ -1658,6 +1728,7 @@ D3D_Reset(SDL_Renderer * renderer)
     data->drawstate.cliprect_enabled_dirty = SDL_TRUE;
     data->drawstate.texture = NULL;
     data->drawstate.shader = NULL;
+    data->drawstate.kernel = NULL;
     data->drawstate.blend = SDL_BLENDMODE_INVALID;
     data->drawstate.is_copy_ex = SDL_FALSE;
     IDirect3DDevice9_SetTransform(data->device, D3DTS_VIEW, (D3DMATRIX*)&d3dmatrix);
@@ -1719,6 +1790,8 @@ D3D_CreateRenderer(SDL_Window * window, Uint32 flags)
     renderer->SetRenderTarget = D3D_SetRenderTarget;
     renderer->QueueSetViewport = D3D_QueueSetViewport;
     renderer->QueueSetDrawColor = D3D_QueueSetViewport;  /* SetViewport and SetDrawColor are (currently) no-ops. */
+    renderer->QueueSetKernelConstants = D3D_QueueSetKernelConstants;
+    renderer->merge_copies = SDL_TRUE;  /* the COPY case draws one fan per copy. */
     renderer->QueueDrawPoints = D3D_QueueDrawPoints;
     renderer->QueueDrawLines = D3D_QueueDrawPoints;  /* lines and points queue vertices the same way. */
     renderer->QueueFillRects = D3D_QueueFillRects;
@@ -1728,6 +1801,8 @@ D3D_CreateRenderer(SDL_Window * window, Uint32 flags)
     renderer->RenderReadPixels = D3D_RenderReadPixels;
     renderer->RenderPresent = D3D_RenderPresent;
     renderer->DestroyTexture = D3D_DestroyTexture;
+    renderer->CreateKernel = D3D_CreateKernel;
+    renderer->DestroyKernel = D3D_DestroyKernel;
     renderer->DestroyRenderer = D3D_DestroyRenderer;
     renderer->info = D3D_RenderDriver.info;
     renderer->info.flags = (SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE);
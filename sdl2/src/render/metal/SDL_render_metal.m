@@ -1456,6 +1456,9 @@ METAL_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *ver
                 break;
             }
 
+            case SDL_RENDERCMD_SETKERNELCONSTANTS:
+                break;  /* never queued, this backend has no kernels. */
+
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
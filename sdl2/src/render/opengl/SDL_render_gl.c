@@ -1351,6 +1351,9 @@ GL_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 break;
             }
 
+            case SDL_RENDERCMD_SETKERNELCONSTANTS:
+                break;  /* never queued, this backend has no kernels. */
+
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
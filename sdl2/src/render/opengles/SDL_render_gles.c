@@ -953,6 +953,9 @@ GLES_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vert
                 break;
             }
 
+            case SDL_RENDERCMD_SETKERNELCONSTANTS:
+                break;  /* never queued, this backend has no kernels. */
+
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
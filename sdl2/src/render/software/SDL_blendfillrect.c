@@ -239,11 +239,7 @@ SDL_BlendFillRect(SDL_Surface * dst, const SDL_Rect * rect,
         rect = &dst->clip_rect;
     }
 
-    if (blendMode == SDL_BLENDMODE_BLEND || blendMode == SDL_BLENDMODE_ADD) {
-        r = DRAW_MUL(r, a);
-        g = DRAW_MUL(g, a);
-        b = DRAW_MUL(b, a);
-    }
+    DRAW_PREP_COLOR(blendMode, r, g, b, a);
 
     switch (dst->format->BitsPerPixel) {
     case 15:
@@ -299,11 +295,7 @@ SDL_BlendFillRects(SDL_Surface * dst, const SDL_Rect * rects, int count,
         return SDL_SetError("SDL_BlendFillRects(): Unsupported surface format");
     }
 
-    if (blendMode == SDL_BLENDMODE_BLEND || blendMode == SDL_BLENDMODE_ADD) {
-        r = DRAW_MUL(r, a);
-        g = DRAW_MUL(g, a);
-        b = DRAW_MUL(b, a);
-    }
+    DRAW_PREP_COLOR(blendMode, r, g, b, a);
 
     /* FIXME: Does this function pointer slow things down significantly? */
     switch (dst->format->BitsPerPixel) {
@@ -28,6 +28,24 @@
 
 #define DRAW_MUL(_a, _b) (((unsigned)(_a)*(_b))/255)
 
+/* Brings the caller's color into that form. SDL_BLENDMODE_BLEND_PREMULTIPLIED
+ * colors already are premultiplied, so RGB is only clamped to a and they are
+ * drawn with the blend case.
+ */
+#define DRAW_PREP_COLOR(blendMode, r, g, b, a) \
+do { \
+    if (blendMode == SDL_BLENDMODE_BLEND || blendMode == SDL_BLENDMODE_ADD) { \
+        r = DRAW_MUL(r, a); \
+        g = DRAW_MUL(g, a); \
+        b = DRAW_MUL(b, a); \
+    } else if (blendMode == SDL_BLENDMODE_BLEND_PREMULTIPLIED) { \
+        r = SDL_min(r, a); \
+        g = SDL_min(g, a); \
+        b = SDL_min(b, a); \
+        blendMode = SDL_BLENDMODE_BLEND; \
+    } \
+} while (0)
+
 #define DRAW_FASTSETPIXEL(type) \
     *pixel = (type) color
 
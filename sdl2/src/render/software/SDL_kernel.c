@@ -0,0 +1,246 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+#if SDL_VIDEO_RENDER_SW && !SDL_RENDER_DISABLED
+
+#include "SDL_assert.h"
+#include "SDL_atomic.h"
+#include "SDL_kernel.h"
+#include "../../thread/SDL_threadpool_c.h"
+
+/* The destination is processed in bands of whole KERNEL_TILE_H rows, one band
+   per job, and every band is cut into tiles narrow enough for the kernel output
+   to still be in cache when it gets composited onto the target. */
+#define KERNEL_TILE_W   256
+#define KERNEL_TILE_H   16
+
+typedef struct
+{
+    const SDL_RenderKernel *kernel;
+    SDL_Surface *dst;
+    SDL_Rect dstrect;
+    SDL_Rect area;
+    int band_h;
+    SDL_RenderKernelTile tile;
+    SDL_bool direct;
+    /* One scratch tile and one view of the target per band, when not direct.
+       They're set up on the calling thread, so the workers share no surface state. */
+    SDL_Surface **scratch_surfaces;
+    SDL_Surface **band_surfaces;
+    SDL_atomic_t failed;
+} SW_KernelJob;
+
+static SDL_bool
+CanWriteDirectly(const SDL_Surface *dst, SDL_BlendMode blend, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    if (blend != SDL_BLENDMODE_NONE || (r & g & b & a) != 0xFF) {
+        return SDL_FALSE;
+    }
+    /* The alpha written by the kernel is simply ignored on RGB888 targets. */
+    return (dst->format->format == SDL_PIXELFORMAT_ARGB8888 ||
+            dst->format->format == SDL_PIXELFORMAT_RGB888) ? SDL_TRUE : SDL_FALSE;
+}
+
+static void
+RunKernelBand(void *data, int band)
+{
+    SW_KernelJob *job = (SW_KernelJob *) data;
+    const SDL_RenderKernel *kernel = job->kernel;
+    const SDL_Rect *area = &job->area;
+    SDL_Surface *dst = job->dst;
+    SDL_RenderKernelTile tile = job->tile;
+    const int band_y = area->y + band * job->band_h;
+    const int band_end = SDL_min(band_y + job->band_h, area->y + area->h);
+    int x, y;
+
+    for (y = band_y; y < band_end; y += KERNEL_TILE_H) {
+        const int h = SDL_min(KERNEL_TILE_H, band_end - y);
+        Uint8 *row = (Uint8 *) dst->pixels + y * dst->pitch;
+
+        tile.y = y - job->dstrect.y;
+        tile.h = h;
+        for (x = area->x; x < area->x + area->w; x += KERNEL_TILE_W) {
+            tile.x = x - job->dstrect.x;
+            tile.w = SDL_min(KERNEL_TILE_W, area->x + area->w - x);
+
+            if (job->direct) {
+                tile.pixels = (Uint32 *) (row + x * sizeof (Uint32));
+                tile.pitch = dst->pitch;
+                kernel->function(kernel->userdata, &tile);
+            } else {
+                SDL_Surface *scratch = job->scratch_surfaces[band];
+                SDL_Rect srcrect, dstrect;
+
+                tile.pixels = (Uint32 *) scratch->pixels;
+                tile.pitch = scratch->pitch;
+                kernel->function(kernel->userdata, &tile);
+
+                srcrect.x = 0;
+                srcrect.y = 0;
+                srcrect.w = tile.w;
+                srcrect.h = h;
+                dstrect.x = x;
+                dstrect.y = y - band_y;
+                dstrect.w = tile.w;
+                dstrect.h = h;
+                if (SDL_LowerBlit(scratch, &srcrect, job->band_surfaces[band], &dstrect) < 0) {
+                    SDL_AtomicSet(&job->failed, 1);
+                    return;
+                }
+            }
+        }
+    }
+}
+
+/* Creates the scratch tile and target view of every band, with the state of src */
+static SDL_bool
+CreateKernelBandSurfaces(SW_KernelJob *job, SDL_Surface *src, int num_bands)
+{
+    SDL_Surface *dst = job->dst;
+    SDL_BlendMode blend;
+    Uint8 r, g, b, a;
+    int i;
+
+    job->scratch_surfaces = (SDL_Surface **) SDL_calloc(num_bands * 2, sizeof (SDL_Surface *));
+    if (!job->scratch_surfaces) {
+        return SDL_FALSE;
+    }
+    job->band_surfaces = job->scratch_surfaces + num_bands;
+
+    SDL_GetSurfaceBlendMode(src, &blend);
+    SDL_GetSurfaceColorMod(src, &r, &g, &b);
+    SDL_GetSurfaceAlphaMod(src, &a);
+    for (i = 0; i < num_bands; i++) {
+        const int y = job->area.y + i * job->band_h;
+        const int h = SDL_min(job->band_h, job->area.y + job->area.h - y);
+        SDL_Surface *scratch = SDL_CreateRGBSurfaceWithFormat(0, KERNEL_TILE_W, KERNEL_TILE_H, 32,
+                                                              SDL_PIXELFORMAT_ARGB8888);
+        SDL_Surface *view = SDL_CreateRGBSurfaceWithFormatFrom((Uint8 *) dst->pixels + y * dst->pitch,
+                                                               dst->w, h, dst->format->BitsPerPixel,
+                                                               dst->pitch, dst->format->format);
+
+        job->scratch_surfaces[i] = scratch;
+        job->band_surfaces[i] = view;
+        if (!scratch || !view) {
+            return SDL_FALSE;
+        }
+        if (dst->format->palette) {
+            SDL_SetSurfacePalette(view, dst->format->palette);
+        }
+        SDL_SetSurfaceBlendMode(scratch, blend);
+        SDL_SetSurfaceColorMod(scratch, r, g, b);
+        SDL_SetSurfaceAlphaMod(scratch, a);
+    }
+    return SDL_TRUE;
+}
+
+static void
+FreeKernelBandSurfaces(SW_KernelJob *job, int num_bands)
+{
+    int i;
+
+    if (job->scratch_surfaces) {
+        for (i = 0; i < num_bands * 2; i++) {
+            SDL_FreeSurface(job->scratch_surfaces[i]);
+        }
+        SDL_free(job->scratch_surfaces);
+    }
+}
+
+int
+SDL_SW_RunKernel(SDL_Surface * dst, const SDL_Rect * dstrect,
+                 SDL_Surface * src, const SDL_Rect * srcrect,
+                 const SDL_RenderKernel * kernel,
+                 const float *constants, int num_constants)
+{
+    SW_KernelJob job;
+    SDL_BlendMode blend;
+    Uint8 r, g, b, a;
+    int num_tile_rows, num_bands;
+
+    SDL_assert(kernel->function != NULL);
+
+    SDL_zero(job);
+    if (!SDL_IntersectRect(dstrect, &dst->clip_rect, &job.area)) {
+        return 0;
+    }
+
+    job.kernel = kernel;
+    job.dst = dst;
+    job.dstrect = *dstrect;
+    SDL_GetSurfaceBlendMode(src, &blend);
+    SDL_GetSurfaceColorMod(src, &r, &g, &b);
+    SDL_GetSurfaceAlphaMod(src, &a);
+    job.direct = CanWriteDirectly(dst, blend, r, g, b, a);
+    SDL_AtomicSet(&job.failed, 0);
+
+    /* Direct bands need nothing but the target, so they're kept small for
+       load balancing. Composited bands each need their own surfaces, so
+       there's one per thread, and indexed targets are done on this thread
+       because blits into them use the shared palette. */
+    num_tile_rows = (job.area.h + KERNEL_TILE_H - 1) / KERNEL_TILE_H;
+    if (job.direct) {
+        num_bands = num_tile_rows;
+    } else if (dst->format->palette) {
+        num_bands = 1;
+    } else {
+        num_bands = SDL_min(num_tile_rows, SDL_GetParallelism());
+    }
+    job.band_h = ((num_tile_rows + num_bands - 1) / num_bands) * KERNEL_TILE_H;
+    num_bands = (job.area.h + job.band_h - 1) / job.band_h;
+
+    if (!job.direct && !CreateKernelBandSurfaces(&job, src, num_bands)) {
+        FreeKernelBandSurfaces(&job, num_bands);
+        return SDL_OutOfMemory();
+    }
+
+    if (SDL_MUSTLOCK(src)) {
+        SDL_LockSurface(src);
+    }
+
+    job.tile.dst_w = dstrect->w;
+    job.tile.dst_h = dstrect->h;
+    job.tile.src_pixels = (const Uint8 *) src->pixels + srcrect->y * src->pitch +
+                          srcrect->x * src->format->BytesPerPixel;
+    job.tile.src_pitch = src->pitch;
+    job.tile.src_format = src->format->format;
+    job.tile.src_w = srcrect->w;
+    job.tile.src_h = srcrect->h;
+    job.tile.constants = constants;
+    job.tile.num_constants = num_constants;
+
+    SDL_ParallelFor(num_bands, RunKernelBand, &job);
+
+    if (SDL_MUSTLOCK(src)) {
+        SDL_UnlockSurface(src);
+    }
+
+    FreeKernelBandSurfaces(&job, num_bands);
+    if (SDL_AtomicGet(&job.failed)) {
+        return SDL_SetError("Couldn't composite the kernel output");
+    }
+    return 0;
+}
+
+#endif /* SDL_VIDEO_RENDER_SW && !SDL_RENDER_DISABLED */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,37 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_kernel_h_
+#define SDL_kernel_h_
+
+#include "../../SDL_internal.h"
+#include "../SDL_sysrender.h"
+
+/* Runs kernel over dstrect (clipped to the dst clip rect), compositing the
+   result with the blend mode and modulation currently set on src. */
+extern int SDL_SW_RunKernel(SDL_Surface * dst, const SDL_Rect * dstrect,
+                            SDL_Surface * src, const SDL_Rect * srcrect,
+                            const SDL_RenderKernel * kernel,
+                            const float *constants, int num_constants);
+
+#endif /* SDL_kernel_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
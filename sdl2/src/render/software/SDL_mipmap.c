@@ -0,0 +1,217 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+#if SDL_VIDEO_RENDER_SW && !SDL_RENDER_DISABLED
+
+#include "SDL_assert.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_mipmap.h"
+#include "../../video/SDL_blit.h"
+
+/* Each channel of the result is (a + b + c + d + 2) / 4. Every code path
+   rounds the same way, so the mip levels don't depend on the CPU.
+   Straight alpha colors are weighted by their alpha instead, see
+   Downsample2x2_Weighted(). */
+
+typedef void (*SDL_DownsampleRowFunc)(const Uint8 *row0, const Uint8 *row1, Uint8 *dst, int width);
+
+static void
+Downsample2x2(const Uint8 *row0, const Uint8 *row1, Uint8 *dst, int width)
+{
+    int x, c;
+
+    for (x = 0; x < width; ++x) {
+        for (c = 0; c < 4; ++c) {
+            dst[c] = (Uint8) ((row0[c] + row0[4 + c] + row1[c] + row1[4 + c] + 2) >> 2);
+        }
+        row0 += 8;
+        row1 += 8;
+        dst += 4;
+    }
+}
+
+/* Transparent texels keep whatever color they were given, often black.
+   Weighting by alpha keeps that color out of the partly covered result,
+   which would otherwise show as a dark fringe when blended. Blocks with
+   a single alpha value, like opaque ones, come out as Downsample2x2(). */
+static void
+Downsample2x2_Weighted(const Uint8 *row0, const Uint8 *row1, Uint8 *dst, int width, int alpha)
+{
+    int x, c;
+
+    for (x = 0; x < width; ++x) {
+        const unsigned a0 = row0[alpha], a1 = row0[4 + alpha];
+        const unsigned a2 = row1[alpha], a3 = row1[4 + alpha];
+        const unsigned sum = a0 + a1 + a2 + a3;
+
+        if (a0 == a1 && a0 == a2 && a0 == a3) {
+            Downsample2x2(row0, row1, dst, 1);
+        } else {
+            for (c = 0; c < 4; ++c) {
+                if (c == alpha) {
+                    dst[c] = (Uint8) ((sum + 2) >> 2);
+                } else {
+                    dst[c] = (Uint8) ((row0[c] * a0 + row0[4 + c] * a1 +
+                                       row1[c] * a2 + row1[4 + c] * a3 + sum / 2) / sum);
+                }
+            }
+        }
+        row0 += 8;
+        row1 += 8;
+        dst += 4;
+    }
+}
+
+#if HAVE_SSE2_INTRINSICS
+/* Sums the rows and the pixel pairs of a and b, 4 pixels each, into the
+   16-bit channels of 2 pixels */
+static SDL_INLINE __m128i
+SumPixelPairs_SSE2(__m128i a, __m128i b)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+    const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+    return _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+}
+
+static void
+Downsample2x2_SSE2(const Uint8 *row0, const Uint8 *row1, Uint8 *dst, int width)
+{
+    const __m128i two = _mm_set1_epi16(2);
+    int x;
+
+    for (x = 0; x + 4 <= width; x += 4) {
+        const __m128i *s0 = (const __m128i *) (row0 + x * 8);
+        const __m128i *s1 = (const __m128i *) (row1 + x * 8);
+        const __m128i a = SumPixelPairs_SSE2(_mm_loadu_si128(s0), _mm_loadu_si128(s1));
+        const __m128i b = SumPixelPairs_SSE2(_mm_loadu_si128(s0 + 1), _mm_loadu_si128(s1 + 1));
+        _mm_storeu_si128((__m128i *) (dst + x * 4),
+                         _mm_packus_epi16(_mm_srli_epi16(_mm_add_epi16(a, two), 2),
+                                          _mm_srli_epi16(_mm_add_epi16(b, two), 2)));
+    }
+    Downsample2x2(row0 + x * 8, row1 + x * 8, dst + x * 4, width - x);
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_AVX2_INTRINSICS
+/* The same as SumPixelPairs_SSE2 in each 128-bit lane */
+SDL_TARGETING("avx2") SDL_FORCE_INLINE __m256i
+SumPixelPairs_AVX2(__m256i a, __m256i b)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i lo = _mm256_add_epi16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero));
+    const __m256i hi = _mm256_add_epi16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero));
+    return _mm256_add_epi16(_mm256_unpacklo_epi64(lo, hi), _mm256_unpackhi_epi64(lo, hi));
+}
+
+SDL_TARGETING("avx2") static void
+Downsample2x2_AVX2(const Uint8 *row0, const Uint8 *row1, Uint8 *dst, int width)
+{
+    const __m256i two = _mm256_set1_epi16(2);
+    int x;
+
+    for (x = 0; x + 8 <= width; x += 8) {
+        const __m256i *s0 = (const __m256i *) (row0 + x * 8);
+        const __m256i *s1 = (const __m256i *) (row1 + x * 8);
+        const __m256i a = SumPixelPairs_AVX2(_mm256_loadu_si256(s0), _mm256_loadu_si256(s1));
+        const __m256i b = SumPixelPairs_AVX2(_mm256_loadu_si256(s0 + 1), _mm256_loadu_si256(s1 + 1));
+        const __m256i result = _mm256_packus_epi16(_mm256_srli_epi16(_mm256_add_epi16(a, two), 2),
+                                                   _mm256_srli_epi16(_mm256_add_epi16(b, two), 2));
+        /* The pack interleaves the 128-bit lanes of a and b */
+        _mm256_storeu_si256((__m256i *) (dst + x * 4), _mm256_permute4x64_epi64(result, 0xD8));
+    }
+    Downsample2x2(row0 + x * 8, row1 + x * 8, dst + x * 4, width - x);
+}
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+static void
+Downsample2x2_NEON(const Uint8 *row0, const Uint8 *row1, Uint8 *dst, int width)
+{
+    int x, c;
+
+    for (x = 0; x + 8 <= width; x += 8) {
+        const uint8x16x4_t a = vld4q_u8(row0 + x * 8);
+        const uint8x16x4_t b = vld4q_u8(row1 + x * 8);
+        uint8x8x4_t result;
+
+        for (c = 0; c < 4; ++c) {
+            result.val[c] = vrshrn_n_u16(vaddq_u16(vpaddlq_u8(a.val[c]), vpaddlq_u8(b.val[c])), 2);
+        }
+        vst4_u8(dst + x * 4, result);
+    }
+    Downsample2x2(row0 + x * 8, row1 + x * 8, dst + x * 4, width - x);
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
+static SDL_DownsampleRowFunc
+GetDownsampleRowFunc(void)
+{
+#if HAVE_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return Downsample2x2_AVX2;
+    }
+#endif
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return Downsample2x2_SSE2;
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return Downsample2x2_NEON;
+    }
+#endif
+    return Downsample2x2;
+}
+
+void
+SDL_SW_DownsampleSurface(SDL_Surface * src, SDL_Surface * dst, SDL_bool premultiplied)
+{
+    const SDL_DownsampleRowFunc func = GetDownsampleRowFunc();
+    const Uint8 *srcrow = (const Uint8 *) src->pixels;
+    Uint8 *dstrow = (Uint8 *) dst->pixels;
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    const int alpha = src->format->Ashift / 8;
+#else
+    const int alpha = 3 - src->format->Ashift / 8;
+#endif
+    const SDL_bool weighted = (src->format->Amask && !premultiplied) ? SDL_TRUE : SDL_FALSE;
+    int y;
+
+    SDL_assert(src->format->format == dst->format->format);
+    SDL_assert(dst->w * 2 <= src->w && dst->h * 2 <= src->h);
+
+    for (y = 0; y < dst->h; ++y) {
+        if (weighted) {
+            Downsample2x2_Weighted(srcrow, srcrow + src->pitch, dstrow, dst->w, alpha);
+        } else {
+            func(srcrow, srcrow + src->pitch, dstrow, dst->w);
+        }
+        srcrow += 2 * src->pitch;
+        dstrow += dst->pitch;
+    }
+}
+
+#endif /* SDL_VIDEO_RENDER_SW && !SDL_RENDER_DISABLED */
+
+/* vi: set ts=4 sw=4 expandtab: */
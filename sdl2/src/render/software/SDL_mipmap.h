@@ -0,0 +1,36 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_mipmap_h_
+#define SDL_mipmap_h_
+
+#include "../../SDL_internal.h"
+#include "SDL_surface.h"
+
+/* Fills dst with the average of each 2x2 block of src. Both are 32-bit
+   surfaces with 8-bit channels in the same format, and dst is at most half
+   as wide and half as tall as src. Unless the colors are premultiplied,
+   they are averaged weighted by their alpha. */
+extern void SDL_SW_DownsampleSurface(SDL_Surface * src, SDL_Surface * dst, SDL_bool premultiplied);
+
+#endif /* SDL_mipmap_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
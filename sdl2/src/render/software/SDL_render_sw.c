@@ -33,7 +33,12 @@
 #include "SDL_blendpoint.h"
 #include "SDL_drawline.h"
 #include "SDL_drawpoint.h"
+#include "SDL_kernel.h"
+#include "SDL_mipmap.h"
 #include "SDL_rotate.h"
+#include "SDL_transform.h"
+#include "../../thread/SDL_threadpool_c.h"
+#include "../../video/SDL_blit.h"
 
 /* SDL surface based renderer implementation */
 
@@ -41,15 +46,50 @@ typedef struct
 {
     const SDL_Rect *viewport;
     const SDL_Rect *cliprect;
+    const SDL_Rect *band;  /* when replaying in bands, nothing is drawn outside of this */
     SDL_bool surface_cliprect_dirty;
+    const float *kernel_constants;
+    int num_kernel_constants;
 } SW_DrawStateCache;
 
+/* Past this many, damaged areas are merged with the nearest one */
+#define SW_MAX_DAMAGE_RECTS 8
+
 typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+    SDL_bool bands;  /* see SDL_HINT_RENDER_SOFTWARE_BANDS */
+    SDL_Rect damage[SW_MAX_DAMAGE_RECTS];  /* what changed on the window surface since the last present */
+    int num_damage;
+    SDL_bool mipmaps;  /* see SDL_HINT_RENDER_SOFTWARE_MIPMAPS */
+    SDL_Texture *target;
+    SDL_Surface **band_views;  /* kept between flushes, see SW_RunCommandsInBands() */
+    int num_band_views;
 } SW_RenderData;
 
+/* Enough levels for any texture up to 65536 pixels wide */
+#define SW_MAX_MIP_LEVELS 16
+
+/* Texture surfaces are never handed to the application, so their userdata
+   holds the mip chain once the texture has been drawn minified. */
+typedef struct
+{
+    int num_filtered;  /* how many levels are up to date with the texture */
+    SDL_bool premultiplied;  /* whether the levels were filtered for SDL_BLENDMODE_BLEND_PREMULTIPLIED */
+    SDL_Surface *levels[SW_MAX_MIP_LEVELS];  /* level i is the texture shrunk by 2^(i+1), created on first use */
+} SW_MipChain;
+
+
+static void
+SW_DamageAll(SW_RenderData *data)
+{
+    data->damage[0].x = 0;
+    data->damage[0].y = 0;
+    data->damage[0].w = data->window ? data->window->w : 0;
+    data->damage[0].h = data->window ? data->window->h : 0;
+    data->num_damage = 1;
+}
 
 static SDL_Surface *
 SW_ActivateRenderer(SDL_Renderer * renderer)
@@ -63,6 +103,7 @@ SW_ActivateRenderer(SDL_Renderer * renderer)
         SDL_Surface *surface = SDL_GetWindowSurface(renderer->window);
         if (surface) {
             data->surface = data->window = surface;
+            SW_DamageAll(data);
         }
     }
     return data->surface;
@@ -76,6 +117,8 @@ SW_WindowEvent(SDL_Renderer * renderer, const SDL_WindowEvent *event)
     if (event->event == SDL_WINDOWEVENT_SIZE_CHANGED) {
         data->surface = NULL;
         data->window = NULL;
+    } else if (event->event == SDL_WINDOWEVENT_EXPOSED) {
+        SW_DamageAll(data);
     }
 }
 
@@ -103,6 +146,22 @@ SW_GetOutputSize(SDL_Renderer * renderer, int *w, int *h)
     return -1;
 }
 
+static SDL_bool
+SW_SupportsBlendMode(SDL_Renderer * renderer, SDL_BlendMode blendMode)
+{
+    switch (blendMode) {
+    case SDL_BLENDMODE_NONE:
+    case SDL_BLENDMODE_BLEND:
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+    case SDL_BLENDMODE_ADD:
+    case SDL_BLENDMODE_MOD:
+    case SDL_BLENDMODE_MUL:
+        return SDL_TRUE;
+    default:
+        return SDL_FALSE;
+    }
+}
+
 static int
 SW_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 {
@@ -135,6 +194,16 @@ SW_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
     return 0;
 }
 
+static void
+SW_InvalidateMipmaps(SDL_Texture * texture)
+{
+    SW_MipChain *chain = (SW_MipChain *) ((SDL_Surface *) texture->driverdata)->userdata;
+
+    if (chain) {
+        chain->num_filtered = 0;
+    }
+}
+
 static int
 SW_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
                  const SDL_Rect * rect, const void *pixels, int pitch)
@@ -144,6 +213,7 @@ SW_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
     int row;
     size_t length;
 
+    SW_InvalidateMipmaps(texture);
     if(SDL_MUSTLOCK(surface))
         SDL_LockSurface(surface);
     src = (Uint8 *) pixels;
@@ -167,6 +237,7 @@ SW_LockTexture(SDL_Renderer * renderer, SDL_Texture * texture,
 {
     SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
 
+    SW_InvalidateMipmaps(texture);
     *pixels =
         (void *) ((Uint8 *) surface->pixels + rect->y * surface->pitch +
                   rect->x * surface->format->BytesPerPixel);
@@ -182,6 +253,16 @@ SW_UnlockTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 static void
 SW_SetTextureScaleMode(SDL_Renderer * renderer, SDL_Texture * texture, SDL_ScaleMode scaleMode)
 {
+    /* Scaled copies read texture->scaleMode when they are drawn */
+}
+
+static int
+SW_CreateKernel(SDL_Renderer * renderer, SDL_RenderKernel * kernel, const void *shader, size_t shader_size)
+{
+    if (!kernel->function) {
+        return SDL_SetError("Software renderer needs a CPU kernel function");
+    }
+    return 0;
 }
 
 static int
@@ -194,6 +275,7 @@ SW_SetRenderTarget(SDL_Renderer * renderer, SDL_Texture * texture)
     } else {
         data->surface = data->window;
     }
+    data->target = texture;
     return 0;
 }
 
@@ -203,6 +285,20 @@ SW_QueueSetViewport(SDL_Renderer * renderer, SDL_RenderCommand *cmd)
     return 0;  /* nothing to do in this backend. */
 }
 
+static int
+SW_QueueSetKernelConstants(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const float *constants)
+{
+    const size_t size = cmd->data.constants.count * sizeof (float);
+    float *verts = (float *) SDL_AllocateRenderVertices(renderer, size, sizeof (float), &cmd->data.constants.first);
+
+    if (!verts) {
+        return -1;
+    }
+
+    SDL_memcpy(verts, constants, size);
+    return 0;
+}
+
 static int
 SW_QueueDrawPoints(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FPoint * points, int count)
 {
@@ -266,18 +362,17 @@ SW_QueueFillRects(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FRe
     return 0;
 }
 
-static int
-SW_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
-             const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+/* A COPY command holds count source and destination rect pairs, each
+   followed by an SDL_Color when the copies have their own colors. */
+static SDL_INLINE size_t
+CopyDataSize(const SDL_RenderCommand *cmd)
 {
-    SDL_Rect *verts = (SDL_Rect *) SDL_AllocateRenderVertices(renderer, 2 * sizeof (SDL_Rect), 0, &cmd->data.draw.first);
-
-    if (!verts) {
-        return -1;
-    }
-
-    cmd->data.draw.count = 1;
+    return 2 * sizeof (SDL_Rect) + (cmd->data.draw.colors ? sizeof (SDL_Color) : 0);
+}
 
+static void
+SW_SetCopyRects(SDL_Renderer * renderer, SDL_Rect *verts, const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+{
     SDL_memcpy(verts, srcrect, sizeof (SDL_Rect));
     verts++;
 
@@ -290,6 +385,50 @@ SW_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * text
     }
     verts->w = (int)dstrect->w;
     verts->h = (int)dstrect->h;
+}
+
+static int
+SW_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+             const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+{
+    SDL_Rect *verts = (SDL_Rect *) SDL_AllocateRenderVertices(renderer, 2 * sizeof (SDL_Rect), 0, &cmd->data.draw.first);
+
+    if (!verts) {
+        return -1;
+    }
+
+    cmd->data.draw.count = 1;
+
+    SW_SetCopyRects(renderer, verts, srcrect, dstrect);
+
+    return 0;
+}
+
+static int
+SW_QueueCopyBatch(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                  const SDL_Rect * srcrects, const SDL_FRect * dstrects,
+                  const SDL_Color * colors, int count)
+{
+    size_t size;
+    Uint8 *verts;
+    int i;
+
+    cmd->data.draw.colors = colors ? SDL_TRUE : SDL_FALSE;
+    size = CopyDataSize(cmd);
+
+    verts = (Uint8 *) SDL_AllocateRenderVertices(renderer, count * size, 0, &cmd->data.draw.first);
+    if (!verts) {
+        return -1;
+    }
+
+    cmd->data.draw.count = count;
+
+    for (i = 0; i < count; i++, verts += size) {
+        SW_SetCopyRects(renderer, (SDL_Rect *) verts, &srcrects[i], &dstrects[i]);
+        if (colors) {
+            SDL_memcpy(verts + 2 * sizeof (SDL_Rect), &colors[i], sizeof (SDL_Color));
+        }
+    }
 
     return 0;
 }
@@ -355,6 +494,13 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
         return -1;
     }
 
+    /* Draw straight from the texture when the formats allow it, instead of
+     * going through scaled, rotated and mask surfaces below.
+     */
+    if (SDL_SW_CanBlitTransformed(src, surface)) {
+        return SDL_SW_BlitTransformed(src, srcrect, surface, final_rect, angle, center, flip, texture->scaleMode);
+    }
+
     tmp_rect.x = 0;
     tmp_rect.y = 0;
     tmp_rect.w = final_rect->w;
@@ -435,7 +581,8 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
             retval = -1;
         } else {
             SDL_SetSurfaceBlendMode(src_clone, SDL_BLENDMODE_NONE);
-            retval = SDL_BlitScaled(src_clone, srcrect, src_scaled, &scale_rect);
+            retval = SDL_PrivateUpperBlitScaled(src_clone, srcrect, src_scaled, &scale_rect,
+                                                (texture->scaleMode != SDL_ScaleModeNearest) ? SDL_TRUE : SDL_FALSE);
             SDL_FreeSurface(src_clone);
             src_clone = src_scaled;
             src_scaled = NULL;
@@ -562,15 +709,9 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
 }
 
 static void
-PrepTextureForCopy(const SDL_RenderCommand *cmd)
-{
-    const Uint8 r = cmd->data.draw.r;
-    const Uint8 g = cmd->data.draw.g;
-    const Uint8 b = cmd->data.draw.b;
-    const Uint8 a = cmd->data.draw.a;
-    const SDL_BlendMode blend = cmd->data.draw.blend;
-    SDL_Texture *texture = cmd->data.draw.texture;
-    SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
+PrepTextureForCopy(SDL_Surface *surface, const Uint8 r, const Uint8 g, const Uint8 b, const Uint8 a,
+                   const SDL_BlendMode blend)
+{
     const SDL_bool colormod = ((r & g & b) != 0xFF);
     const SDL_bool alphamod = (a != 0xFF);
     const SDL_bool blending = ((blend == SDL_BLENDMODE_ADD) || (blend == SDL_BLENDMODE_MOD) || (blend == SDL_BLENDMODE_MUL));
@@ -585,42 +726,121 @@ PrepTextureForCopy(const SDL_RenderCommand *cmd)
     SDL_SetSurfaceBlendMode(surface, blend);
 }
 
-static void
-SetDrawState(SDL_Surface *surface, SW_DrawStateCache *drawstate)
+static SDL_bool
+SW_FilterMipLevels(SDL_Surface *surface, SW_MipChain *chain, int num_levels)
 {
-    if (drawstate->surface_cliprect_dirty) {
-        const SDL_Rect *viewport = drawstate->viewport;
-        const SDL_Rect *cliprect = drawstate->cliprect;
-        SDL_assert(viewport != NULL);  /* the higher level should have forced a SDL_RENDERCMD_SETVIEWPORT */
-
-        if (cliprect != NULL) {
-            SDL_Rect clip_rect;
-            clip_rect.x = cliprect->x + viewport->x;
-            clip_rect.y = cliprect->y + viewport->y;
-            clip_rect.w = cliprect->w;
-            clip_rect.h = cliprect->h;
-            SDL_IntersectRect(viewport, &clip_rect, &clip_rect);
-            SDL_SetClipRect(surface, &clip_rect);
-        } else {
-            SDL_SetClipRect(surface, drawstate->viewport);
+    SDL_bool locked = SDL_FALSE;
+
+    if (SDL_MUSTLOCK(surface)) {
+        if (SDL_LockSurface(surface) < 0) {
+            return SDL_FALSE;
         }
-        drawstate->surface_cliprect_dirty = SDL_FALSE;
+        locked = SDL_TRUE;
+    }
+    for (; chain->num_filtered < num_levels; ++chain->num_filtered) {
+        const int i = chain->num_filtered;
+        SDL_Surface *src = (i == 0) ? surface : chain->levels[i - 1];
+
+        if (!chain->levels[i]) {
+            chain->levels[i] = SDL_CreateRGBSurfaceWithFormat(0, surface->w >> (i + 1), surface->h >> (i + 1),
+                                                              32, surface->format->format);
+            if (!chain->levels[i]) {
+                break;
+            }
+        }
+        SDL_SW_DownsampleSurface(src, chain->levels[i], chain->premultiplied);
+    }
+    if (locked) {
+        SDL_UnlockSurface(surface);
     }
+    return (chain->num_filtered >= num_levels);
 }
 
-static int
-SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+/* Returns the smallest mip level of texture that srcrect can be read from
+   without magnifying it to dstrect when drawn with blend, and the rect in
+   that level. */
+static SDL_Surface *
+SW_GetMipLevel(SDL_Texture * texture, const SDL_Rect *srcrect, const SDL_Rect *dstrect, SDL_BlendMode blend,
+               SDL_Rect *levelrect)
 {
-    SDL_Surface *surface = SW_ActivateRenderer(renderer);
-    SW_DrawStateCache drawstate;
+    SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
+    SW_MipChain *chain = (SW_MipChain *) surface->userdata;
+    const SDL_bool premultiplied = (blend == SDL_BLENDMODE_BLEND_PREMULTIPLIED) ? SDL_TRUE : SDL_FALSE;
+    int level = 0;
 
-    if (!surface) {
-        return -1;
+    if (!SDL_ISPIXELFORMAT_LINEAR_STRETCH(surface->format->format) || dstrect->w <= 0 || dstrect->h <= 0) {
+        return surface;
+    }
+    while (level < SW_MAX_MIP_LEVELS &&
+           (srcrect->w >> (level + 1)) >= dstrect->w && (srcrect->h >> (level + 1)) >= dstrect->h) {
+        ++level;
+    }
+    if (level == 0) {
+        return surface;
     }
 
-    drawstate.viewport = NULL;
-    drawstate.cliprect = NULL;
-    drawstate.surface_cliprect_dirty = SDL_TRUE;
+    if (!chain) {
+        chain = (SW_MipChain *) SDL_calloc(1, sizeof (*chain));
+        if (!chain) {
+            return surface;
+        }
+        surface->userdata = chain;
+    }
+    if (chain->premultiplied != premultiplied) {
+        chain->premultiplied = premultiplied;
+        chain->num_filtered = 0;
+    }
+    if (!SW_FilterMipLevels(surface, chain, level)) {
+        return surface;
+    }
+
+    levelrect->x = srcrect->x >> level;
+    levelrect->y = srcrect->y >> level;
+    levelrect->w = ((srcrect->x + srcrect->w) >> level) - levelrect->x;
+    levelrect->h = ((srcrect->y + srcrect->h) >> level) - levelrect->y;
+    return chain->levels[level - 1];
+}
+
+/* The area draws are clipped to, before clipping to the surface */
+static void
+GetDrawClipRect(const SW_DrawStateCache *drawstate, SDL_Rect *clip_rect)
+{
+    const SDL_Rect *viewport = drawstate->viewport;
+    const SDL_Rect *cliprect = drawstate->cliprect;
+    SDL_assert(viewport != NULL);  /* the higher level should have forced a SDL_RENDERCMD_SETVIEWPORT */
+
+    if (cliprect != NULL) {
+        clip_rect->x = cliprect->x + viewport->x;
+        clip_rect->y = cliprect->y + viewport->y;
+        clip_rect->w = cliprect->w;
+        clip_rect->h = cliprect->h;
+        SDL_IntersectRect(viewport, clip_rect, clip_rect);
+    } else {
+        *clip_rect = *viewport;
+    }
+    if (drawstate->band != NULL) {
+        SDL_IntersectRect(drawstate->band, clip_rect, clip_rect);
+    }
+}
+
+static void
+SetDrawState(SDL_Surface *surface, SW_DrawStateCache *drawstate)
+{
+    if (drawstate->surface_cliprect_dirty) {
+        SDL_Rect clip_rect;
+        GetDrawClipRect(drawstate, &clip_rect);
+        SDL_SetClipRect(surface, &clip_rect);
+        drawstate->surface_cliprect_dirty = SDL_FALSE;
+    }
+}
+
+/* Replays the queue into surface. views is NULL, or holds the surfaces to copy
+   from in place of the textures, picked for each copy by view_indices. */
+static void
+SW_RunCommands(SDL_Renderer * renderer, SDL_Surface *surface, SW_DrawStateCache *drawstate,
+               SDL_RenderCommand *cmd, void *vertices, SDL_Surface **views, const int *view_indices)
+{
+    int copies = 0;
 
     while (cmd) {
         switch (cmd->command) {
@@ -629,14 +849,14 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
             }
 
             case SDL_RENDERCMD_SETVIEWPORT: {
-                drawstate.viewport = &cmd->data.viewport.rect;
-                drawstate.surface_cliprect_dirty = SDL_TRUE;
+                drawstate->viewport = &cmd->data.viewport.rect;
+                drawstate->surface_cliprect_dirty = SDL_TRUE;
                 break;
             }
 
             case SDL_RENDERCMD_SETCLIPRECT: {
-                drawstate.cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;                
-                drawstate.surface_cliprect_dirty = SDL_TRUE;
+                drawstate->cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;                
+                drawstate->surface_cliprect_dirty = SDL_TRUE;
                 break;
             }
 
@@ -645,10 +865,10 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 const Uint8 g = cmd->data.color.g;
                 const Uint8 b = cmd->data.color.b;
                 const Uint8 a = cmd->data.color.a;
-                /* By definition the clear ignores the clip rect */
-                SDL_SetClipRect(surface, NULL);
+                /* By definition the clear ignores the clip rect, but not the band */
+                SDL_SetClipRect(surface, drawstate->band);
                 SDL_FillRect(surface, NULL, SDL_MapRGBA(surface->format, r, g, b, a));
-                drawstate.surface_cliprect_dirty = SDL_TRUE;
+                drawstate->surface_cliprect_dirty = SDL_TRUE;
                 break;
             }
 
@@ -660,7 +880,7 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 const int count = (int) cmd->data.draw.count;
                 const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
                 const SDL_BlendMode blend = cmd->data.draw.blend;
-                SetDrawState(surface, &drawstate);
+                SetDrawState(surface, drawstate);
                 if (blend == SDL_BLENDMODE_NONE) {
                     SDL_DrawPoints(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
                 } else {
@@ -677,7 +897,7 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 const int count = (int) cmd->data.draw.count;
                 const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
                 const SDL_BlendMode blend = cmd->data.draw.blend;
-                SetDrawState(surface, &drawstate);
+                SetDrawState(surface, drawstate);
                 if (blend == SDL_BLENDMODE_NONE) {
                     SDL_DrawLines(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
                 } else {
@@ -694,7 +914,7 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 const int count = (int) cmd->data.draw.count;
                 const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
                 const SDL_BlendMode blend = cmd->data.draw.blend;
-                SetDrawState(surface, &drawstate);
+                SetDrawState(surface, drawstate);
                 if (blend == SDL_BLENDMODE_NONE) {
                     SDL_FillRects(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
                 } else {
@@ -704,37 +924,78 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
             }
 
             case SDL_RENDERCMD_COPY: {
-                SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                const SDL_Rect *srcrect = verts;
-                SDL_Rect *dstrect = verts + 1;
+                const Uint8 *verts = ((Uint8 *) vertices) + cmd->data.draw.first;
+                const size_t size = CopyDataSize(cmd);
+                const size_t count = cmd->data.draw.count;
                 SDL_Texture *texture = cmd->data.draw.texture;
-                SDL_Surface *src = (SDL_Surface *) texture->driverdata;
+                SDL_Surface *src = views ? views[view_indices[copies++]] : (SDL_Surface *) texture->driverdata;
+                const SDL_bool mipmaps = ((SW_RenderData *) renderer->driverdata)->mipmaps && !views;
+                const SDL_bool linear = (texture->scaleMode != SDL_ScaleModeNearest) ? SDL_TRUE : SDL_FALSE;
+                SDL_Color color;
+                size_t i;
+
+                SetDrawState(surface, drawstate);
+
+                color.r = cmd->data.draw.r;
+                color.g = cmd->data.draw.g;
+                color.b = cmd->data.draw.b;
+                color.a = cmd->data.draw.a;
+                PrepTextureForCopy(src, color.r, color.g, color.b, color.a, cmd->data.draw.blend);
+
+                /* Merged copies share all of their state, only the rects (and maybe the colors) change. */
+                for (i = 0; i < count; i++, verts += size) {
+                    const SDL_Rect *srcrect = (const SDL_Rect *) verts;
+                    SDL_Rect dstrect = srcrect[1];  /* the blits clip this, and the queue may be shared */
+
+                    if (cmd->data.draw.colors) {
+                        color = *(const SDL_Color *) &srcrect[2];
+                        PrepTextureForCopy(src, color.r, color.g, color.b, color.a, cmd->data.draw.blend);
+                    }
 
-                SetDrawState(surface, &drawstate);
+                    if (cmd->data.draw.kernel) {
+                        SDL_SW_RunKernel(surface, &dstrect, src, srcrect, cmd->data.draw.kernel,
+                                         drawstate->kernel_constants, drawstate->num_kernel_constants);
+                    } else if ( srcrect->w == dstrect.w && srcrect->h == dstrect.h ) {
+                        SDL_BlitSurface(src, srcrect, surface, &dstrect);
+                    } else {
+                        /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
+                         * to avoid potentially frequent RLE encoding/decoding.
+                         */
+                        SDL_Rect levelrect;
+                        SDL_Surface *level = src;
 
-                PrepTextureForCopy(cmd);
+                        if (mipmaps) {
+                            level = SW_GetMipLevel(texture, srcrect, &dstrect, cmd->data.draw.blend, &levelrect);
+                        }
 
-                if ( srcrect->w == dstrect->w && srcrect->h == dstrect->h ) {
-                    SDL_BlitSurface(src, srcrect, surface, dstrect);
-                } else {
-                    /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
-                     * to avoid potentially frequent RLE encoding/decoding.
-                     */
-                    SDL_SetSurfaceRLE(surface, 0);
-                    SDL_BlitScaled(src, srcrect, surface, dstrect);
+                        SDL_SetSurfaceRLE(surface, 0);
+                        if (level != src) {
+                            PrepTextureForCopy(level, color.r, color.g, color.b, color.a, cmd->data.draw.blend);
+                            SDL_PrivateUpperBlitScaled(level, &levelrect, surface, &dstrect, linear);
+                        } else {
+                            SDL_PrivateUpperBlitScaled(src, srcrect, surface, &dstrect, linear);
+                        }
+                    }
                 }
                 break;
             }
 
             case SDL_RENDERCMD_COPY_EX: {
                 const CopyExData *copydata = (CopyExData *) (((Uint8 *) vertices) + cmd->data.draw.first);
-                SetDrawState(surface, &drawstate);
-                PrepTextureForCopy(cmd);
+                SetDrawState(surface, drawstate);
+                PrepTextureForCopy((SDL_Surface *) cmd->data.draw.texture->driverdata, cmd->data.draw.r,
+                                   cmd->data.draw.g, cmd->data.draw.b, cmd->data.draw.a, cmd->data.draw.blend);
                 SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
                                 &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip);
                 break;
             }
 
+            case SDL_RENDERCMD_SETKERNELCONSTANTS: {
+                drawstate->kernel_constants = (const float *) (((Uint8 *) vertices) + cmd->data.constants.first);
+                drawstate->num_kernel_constants = cmd->data.constants.count;
+                break;
+            }
+
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
@@ -742,6 +1003,381 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
         cmd = cmd->next;
     }
 
+}
+
+/* Replaying the queue once per band gives exactly the pixels of a single
+   replay only if every command clips pixel-exactly. Points, rects, clears,
+   kernels and unscaled copies do. The endpoints of clipped lines move, and so
+   do the source pixels picked by clipped scaled or rotated copies. */
+#define SW_MIN_BAND_HEIGHT  32
+#define SW_MAX_BAND_TEXTURES 64
+
+typedef struct
+{
+    SDL_Renderer *renderer;
+    SDL_RenderCommand *cmd;
+    void *vertices;
+    int band_h;
+    int num_textures;
+    SDL_Texture *textures[SW_MAX_BAND_TEXTURES];
+    int *view_indices;   /* for each copy in the queue, which texture it reads */
+    SDL_Surface **views; /* per band, a view of the target then one per texture */
+} SW_BandJob;
+
+static SDL_bool
+SW_CanRunInBands(SDL_Surface *surface, SDL_RenderCommand *cmd, void *vertices, int *num_copies)
+{
+    if (SDL_ISPIXELFORMAT_INDEXED(surface->format->format) || SDL_MUSTLOCK(surface)) {
+        return SDL_FALSE;
+    }
+
+    *num_copies = 0;
+    for (; cmd; cmd = cmd->next) {
+        switch (cmd->command) {
+            case SDL_RENDERCMD_DRAW_LINES:
+            case SDL_RENDERCMD_COPY_EX:
+                return SDL_FALSE;
+
+            case SDL_RENDERCMD_COPY: {
+                const Uint8 *verts = ((Uint8 *) vertices) + cmd->data.draw.first;
+                const size_t size = CopyDataSize(cmd);
+                SDL_Surface *src = (SDL_Surface *) cmd->data.draw.texture->driverdata;
+                size_t i;
+
+                /* RLE blits read the encoded copy, which can't be shared */
+                if (!src->pixels || (src->flags & SDL_RLEACCEL) ||
+                    (src->map->info.flags & SDL_COPY_RLE_DESIRED)) {
+                    return SDL_FALSE;
+                }
+                if (!cmd->data.draw.kernel) {
+                    for (i = 0; i < cmd->data.draw.count; i++, verts += size) {
+                        const SDL_Rect *rects = (const SDL_Rect *) verts;
+                        if (rects[0].w != rects[1].w || rects[0].h != rects[1].h) {
+                            return SDL_FALSE;
+                        }
+                    }
+                }
+                ++*num_copies;
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+    return SDL_TRUE;
+}
+
+/* Points view, a surface sharing the pixels of another one but none of its
+   state, at surface. The view is only created again if the format changed. */
+static SDL_Surface *
+SW_UpdateSurfaceView(SDL_Surface *view, SDL_Surface *surface)
+{
+    if (view && view->format->format == surface->format->format) {
+        view->pixels = surface->pixels;
+        view->w = surface->w;
+        view->h = surface->h;
+        view->pitch = surface->pitch;
+        SDL_SetClipRect(view, NULL);
+        return view;
+    }
+    SDL_FreeSurface(view);
+    return SDL_CreateRGBSurfaceWithFormatFrom(surface->pixels, surface->w, surface->h,
+                                              surface->format->BitsPerPixel, surface->pitch,
+                                              surface->format->format);
+}
+
+static void
+SW_RunBand(void *data, int index)
+{
+    SW_BandJob *job = (SW_BandJob *) data;
+    SDL_Surface **views = &job->views[index * (1 + job->num_textures)];
+    SW_DrawStateCache drawstate;
+    SDL_Rect band;
+
+    band.x = 0;
+    band.y = index * job->band_h;
+    band.w = views[0]->w;
+    band.h = SDL_min(job->band_h, views[0]->h - band.y);
+
+    drawstate.viewport = NULL;
+    drawstate.cliprect = NULL;
+    drawstate.band = &band;
+    drawstate.surface_cliprect_dirty = SDL_TRUE;
+    drawstate.kernel_constants = NULL;
+    drawstate.num_kernel_constants = 0;
+
+    SW_RunCommands(job->renderer, views[0], &drawstate, job->cmd, job->vertices, views + 1, job->view_indices);
+}
+
+/* Returns SDL_FALSE if the queue has to be replayed on this thread instead. */
+static SDL_bool
+SW_RunCommandsInBands(SDL_Renderer * renderer, SDL_Surface *surface, SDL_RenderCommand *cmd, void *vertices)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    const int threads = SDL_GetParallelism();
+    const int num_bands = SDL_min(threads * 2, surface->h / SW_MIN_BAND_HEIGHT);
+    SW_BandJob job;
+    SDL_RenderCommand *it;
+    int num_copies, num_views, i, j;
+    SDL_bool retval = SDL_TRUE;
+
+    if (threads < 2 || num_bands < 2 || !SW_CanRunInBands(surface, cmd, vertices, &num_copies)) {
+        return SDL_FALSE;
+    }
+
+    SDL_zero(job);
+    job.renderer = renderer;
+    job.cmd = cmd;
+    job.vertices = vertices;
+    job.band_h = (surface->h + num_bands - 1) / num_bands;
+    job.view_indices = SDL_stack_alloc(int, num_copies + 1);
+
+    /* Collect the textures, so each band gets its own views of them. */
+    for (it = cmd, j = 0; it; it = it->next) {
+        if (it->command == SDL_RENDERCMD_COPY) {
+            for (i = 0; i < job.num_textures && job.textures[i] != it->data.draw.texture; i++) {
+                /* just searching */
+            }
+            if (i == job.num_textures) {
+                if (job.num_textures == SW_MAX_BAND_TEXTURES) {
+                    SDL_stack_free(job.view_indices);
+                    return SDL_FALSE;
+                }
+                job.textures[job.num_textures++] = it->data.draw.texture;
+            }
+            job.view_indices[j++] = i;
+        }
+    }
+
+    /* The views outlive the flush, only what they point at changes */
+    num_views = num_bands * (1 + job.num_textures);
+    if (num_views > data->num_band_views) {
+        SDL_Surface **views = (SDL_Surface **) SDL_realloc(data->band_views, num_views * sizeof (SDL_Surface *));
+        if (!views) {
+            SDL_stack_free(job.view_indices);
+            return SDL_FALSE;
+        }
+        SDL_memset(views + data->num_band_views, 0, (num_views - data->num_band_views) * sizeof (SDL_Surface *));
+        data->band_views = views;
+        data->num_band_views = num_views;
+    }
+    job.views = data->band_views;
+    for (i = 0; i < num_bands; i++) {
+        SDL_Surface **views = &job.views[i * (1 + job.num_textures)];
+        views[0] = SW_UpdateSurfaceView(views[0], surface);
+        if (!views[0]) {
+            retval = SDL_FALSE;
+        }
+        for (j = 0; j < job.num_textures; j++) {
+            views[1 + j] = SW_UpdateSurfaceView(views[1 + j], (SDL_Surface *) job.textures[j]->driverdata);
+            if (!views[1 + j]) {
+                retval = SDL_FALSE;
+            }
+        }
+    }
+
+    if (retval) {
+        SDL_ParallelFor(num_bands, SW_RunBand, &job);
+    }
+
+    SDL_stack_free(job.view_indices);
+    return retval;
+}
+
+/* Records that rect, inside clip, is going to change on the window surface */
+static void
+SW_AddDamage(SW_RenderData *data, const SDL_Rect *clip, const SDL_Rect *rect)
+{
+    SDL_Rect area;
+    int i;
+
+    if (!SDL_IntersectRect(rect, clip, &area)) {
+        return;
+    }
+
+    /* Absorb every damaged area that this one overlaps or touches */
+    for (i = 0; i < data->num_damage; ) {
+        const SDL_Rect *damage = &data->damage[i];
+        if (damage->x <= area.x + area.w && area.x <= damage->x + damage->w &&
+            damage->y <= area.y + area.h && area.y <= damage->y + damage->h) {
+            SDL_UnionRect(damage, &area, &area);
+            data->damage[i] = data->damage[--data->num_damage];
+            i = 0;
+        } else {
+            ++i;
+        }
+    }
+
+    if (data->num_damage == SW_MAX_DAMAGE_RECTS) {
+        /* Merge with the area that grows the least, which may now touch others */
+        int best = 0, best_growth = 0;
+        SDL_Rect merged;
+
+        for (i = 0; i < data->num_damage; i++) {
+            const SDL_Rect *damage = &data->damage[i];
+            int growth;
+            SDL_UnionRect(damage, &area, &merged);
+            growth = merged.w * merged.h - damage->w * damage->h;
+            if (i == 0 || growth < best_growth) {
+                best = i;
+                best_growth = growth;
+            }
+        }
+        SDL_UnionRect(&data->damage[best], &area, &merged);
+        data->damage[best] = data->damage[--data->num_damage];
+        SW_AddDamage(data, clip, &merged);
+        return;
+    }
+
+    data->damage[data->num_damage++] = area;
+}
+
+/* The area SW_RenderCopyEx() may touch, two pixels wider on each side than
+   its rotated destination to be safe from rounding the center. */
+static void
+GetCopyExBounds(const CopyExData *copydata, SDL_Rect *bounds)
+{
+    const SDL_Rect *dstrect = &copydata->dstrect;
+    const double centerx = dstrect->x + (int) copydata->center.x;
+    const double centery = dstrect->y + (int) copydata->center.y;
+    double cangle, sangle, minx = 0.0, miny = 0.0;
+    int dstwidth, dstheight, i;
+
+    SDLgfx_rotozoomSurfaceSizeTrig(dstrect->w, dstrect->h, copydata->angle, &dstwidth, &dstheight, &cangle, &sangle);
+    sangle = -sangle;
+
+    for (i = 0; i < 4; i++) {
+        const double px = dstrect->x + ((i & 1) ? dstrect->w : 0) - centerx;
+        const double py = dstrect->y + ((i & 2) ? dstrect->h : 0) - centery;
+        const double x = px * cangle - py * sangle + centerx;
+        const double y = px * sangle + py * cangle + centery;
+        minx = (i == 0) ? x : SDL_min(minx, x);
+        miny = (i == 0) ? y : SDL_min(miny, y);
+    }
+
+    bounds->x = (int) minx - 2;
+    bounds->y = (int) miny - 2;
+    bounds->w = dstwidth + 4;
+    bounds->h = dstheight + 4;
+}
+
+/* Records the parts of the window surface the queue is going to draw to, so
+   presenting only has to update those. */
+static void
+SW_AccumulateDamage(SW_RenderData *data, SDL_Surface *surface, SDL_RenderCommand *cmd, void *vertices)
+{
+    SW_DrawStateCache drawstate;
+    SDL_Rect clip_rect, bounds;
+
+    SDL_zero(drawstate);
+    for (; cmd; cmd = cmd->next) {
+        switch (cmd->command) {
+            case SDL_RENDERCMD_SETVIEWPORT:
+                drawstate.viewport = &cmd->data.viewport.rect;
+                continue;
+
+            case SDL_RENDERCMD_SETCLIPRECT:
+                drawstate.cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;
+                continue;
+
+            case SDL_RENDERCMD_CLEAR:
+                SW_DamageAll(data);
+                continue;
+
+            case SDL_RENDERCMD_DRAW_POINTS:
+            case SDL_RENDERCMD_DRAW_LINES:
+            case SDL_RENDERCMD_FILL_RECTS:
+            case SDL_RENDERCMD_COPY:
+            case SDL_RENDERCMD_COPY_EX:
+                break;
+
+            default:
+                continue;
+        }
+
+        GetDrawClipRect(&drawstate, &clip_rect);
+        bounds.x = 0;
+        bounds.y = 0;
+        bounds.w = surface->w;
+        bounds.h = surface->h;
+        if (!SDL_IntersectRect(&bounds, &clip_rect, &clip_rect)) {
+            continue;
+        }
+
+        switch (cmd->command) {
+            case SDL_RENDERCMD_DRAW_POINTS:
+            case SDL_RENDERCMD_DRAW_LINES: {
+                const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
+                if (SDL_EnclosePoints(verts, (int) cmd->data.draw.count, NULL, &bounds)) {
+                    SW_AddDamage(data, &clip_rect, &bounds);
+                }
+                break;
+            }
+
+            case SDL_RENDERCMD_FILL_RECTS: {
+                const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
+                size_t i;
+                for (i = 0; i < cmd->data.draw.count; i++) {
+                    SW_AddDamage(data, &clip_rect, &verts[i]);
+                }
+                break;
+            }
+
+            case SDL_RENDERCMD_COPY: {
+                const Uint8 *verts = ((Uint8 *) vertices) + cmd->data.draw.first;
+                const size_t size = CopyDataSize(cmd);
+                size_t i;
+                for (i = 0; i < cmd->data.draw.count; i++, verts += size) {
+                    SW_AddDamage(data, &clip_rect, &((const SDL_Rect *) verts)[1]);
+                }
+                break;
+            }
+
+            case SDL_RENDERCMD_COPY_EX: {
+                const CopyExData *copydata = (CopyExData *) (((Uint8 *) vertices) + cmd->data.draw.first);
+                GetCopyExBounds(copydata, &bounds);
+                SW_AddDamage(data, &clip_rect, &bounds);
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+}
+
+static int
+SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+    SW_DrawStateCache drawstate;
+
+    if (!surface) {
+        return -1;
+    }
+
+    if (renderer->window && surface == data->window) {
+        SW_AccumulateDamage(data, surface, cmd, vertices);
+    }
+    if (data->target) {
+        SW_InvalidateMipmaps(data->target);
+    }
+
+    if (data->bands && SW_RunCommandsInBands(renderer, surface, cmd, vertices)) {
+        return 0;
+    }
+
+    drawstate.viewport = NULL;
+    drawstate.cliprect = NULL;
+    drawstate.band = NULL;
+    drawstate.surface_cliprect_dirty = SDL_TRUE;
+    drawstate.kernel_constants = NULL;
+    drawstate.num_kernel_constants = 0;
+
+    SW_RunCommands(renderer, surface, &drawstate, cmd, vertices, NULL, NULL);
+
     return 0;
 }
 
@@ -779,10 +1415,13 @@ SW_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
 static void
 SW_RenderPresent(SDL_Renderer * renderer)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Window *window = renderer->window;
 
-    if (window) {
-        SDL_UpdateWindowSurface(window);
+    /* Only what was drawn since the last present needs to reach the screen */
+    if (window && data->num_damage > 0) {
+        SDL_UpdateWindowSurfaceRects(window, data->damage, data->num_damage);
+        data->num_damage = 0;
     }
 }
 
@@ -790,7 +1429,15 @@ static void
 SW_DestroyTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 {
     SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
+    SW_MipChain *chain = (SW_MipChain *) surface->userdata;
 
+    if (chain) {
+        int i;
+        for (i = 0; i < SW_MAX_MIP_LEVELS; i++) {
+            SDL_FreeSurface(chain->levels[i]);
+        }
+        SDL_free(chain);
+    }
     SDL_FreeSurface(surface);
 }
 
@@ -798,7 +1445,14 @@ static void
 SW_DestroyRenderer(SDL_Renderer * renderer)
 {
     SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    int i;
 
+    if (data) {
+        for (i = 0; i < data->num_band_views; i++) {
+            SDL_FreeSurface(data->band_views[i]);
+        }
+        SDL_free(data->band_views);
+    }
     SDL_free(data);
     SDL_free(renderer);
 }
@@ -828,22 +1482,34 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     }
     data->surface = surface;
     data->window = surface;
+    data->bands = SDL_GetHintBoolean(SDL_HINT_RENDER_SOFTWARE_BANDS, SDL_FALSE);
+    data->mipmaps = SDL_GetHintBoolean(SDL_HINT_RENDER_SOFTWARE_MIPMAPS, SDL_FALSE);
+    SW_DamageAll(data);
 
     renderer->WindowEvent = SW_WindowEvent;
     renderer->GetOutputSize = SW_GetOutputSize;
+    renderer->SupportsBlendMode = SW_SupportsBlendMode;
     renderer->CreateTexture = SW_CreateTexture;
     renderer->UpdateTexture = SW_UpdateTexture;
     renderer->LockTexture = SW_LockTexture;
     renderer->UnlockTexture = SW_UnlockTexture;
     renderer->SetTextureScaleMode = SW_SetTextureScaleMode;
+    renderer->CreateKernel = SW_CreateKernel;
     renderer->SetRenderTarget = SW_SetRenderTarget;
     renderer->QueueSetViewport = SW_QueueSetViewport;
     renderer->QueueSetDrawColor = SW_QueueSetViewport;  /* SetViewport and SetDrawColor are (currently) no-ops. */
+    renderer->QueueSetKernelConstants = SW_QueueSetKernelConstants;
+    renderer->merge_copies = SDL_TRUE;
     renderer->QueueDrawPoints = SW_QueueDrawPoints;
     renderer->QueueDrawLines = SW_QueueDrawPoints;  /* lines and points queue vertices the same way. */
     renderer->QueueFillRects = SW_QueueFillRects;
     renderer->QueueCopy = SW_QueueCopy;
     renderer->QueueCopyEx = SW_QueueCopyEx;
+    /* Setting SDL_RENDER_SOFTWARE_COPY_BATCH to "0" queues batches one copy at
+       a time, like renderers without QueueCopyBatch do, so tests can check that path. */
+    if (SDL_GetHintBoolean("SDL_RENDER_SOFTWARE_COPY_BATCH", SDL_TRUE)) {
+        renderer->QueueCopyBatch = SW_QueueCopyBatch;
+    }
     renderer->RunCommandQueue = SW_RunCommandQueue;
     renderer->RenderReadPixels = SW_RenderReadPixels;
     renderer->RenderPresent = SW_RenderPresent;
@@ -0,0 +1,555 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+#if SDL_VIDEO_RENDER_SW && !SDL_RENDER_DISABLED
+
+#include "SDL_transform.h"
+#include "../../video/SDL_blit.h"
+
+/* Every target pixel whose center maps inside srcrect is drawn, so the
+   covered area is exactly the transformed dstrect. Pixels are handled in
+   runs of up to TRANSFORM_RUN: they are sampled and moved to the target
+   channel order into a small buffer, then composited onto the target. */
+#define TRANSFORM_RUN   64
+
+typedef struct
+{
+    const Uint8 *pixels;  /* the top left of srcrect */
+    int pitch;
+    int w, h;
+    int src_rshift, src_gshift, src_bshift, src_ashift;
+    SDL_bool src_alpha;
+    int dst_rshift, dst_gshift, dst_bshift, dst_ashift;  /* dst_ashift is the unused byte without alpha */
+    Uint32 dst_keep;  /* the bits of the target pixels that get stored */
+    SDL_bool convert;
+    SDL_bool linear;
+    SDL_BlendMode blend;
+    Uint8 r, g, b, a;
+} TransformState;
+
+typedef void (*TransformBlendFunc) (Uint32 *dst, const Uint32 *src, int count, const TransformState *state);
+
+static SDL_bool
+HasByteChannels(const SDL_PixelFormat *fmt)
+{
+    if (fmt->BytesPerPixel != 4 ||
+        (fmt->Rshift % 8) || (fmt->Gshift % 8) || (fmt->Bshift % 8) ||
+        fmt->Rmask != (0xFFu << fmt->Rshift) ||
+        fmt->Gmask != (0xFFu << fmt->Gshift) ||
+        fmt->Bmask != (0xFFu << fmt->Bshift)) {
+        return SDL_FALSE;
+    }
+    if (fmt->Amask && ((fmt->Ashift % 8) || fmt->Amask != (0xFFu << fmt->Ashift))) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+/* The byte left over by the color channels */
+static int
+GetAlphaShift(const SDL_PixelFormat *fmt)
+{
+    return fmt->Amask ? fmt->Ashift : 48 - fmt->Rshift - fmt->Gshift - fmt->Bshift;
+}
+
+SDL_bool
+SDL_SW_CanBlitTransformed(SDL_Surface * src, SDL_Surface * dst)
+{
+    if ((src->map->info.flags & SDL_COPY_COLORKEY) ||
+        !HasByteChannels(src->format) || !HasByteChannels(dst->format)) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+/* x / 255, rounded, for x up to 255 * 255. SDL_Blit_Slow() and the generated
+   blitters truncate instead, so a rotated or flipped copy can come out up to
+   three steps per channel brighter than the same unrotated copy. */
+static SDL_INLINE Uint32
+Div255(Uint32 x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+/* (a * (256 - f) + b * f + 128) / 256 for each channel, two channels at a time */
+static SDL_INLINE Uint32
+Lerp(Uint32 a, Uint32 b, int f)
+{
+    const Uint32 g = 256 - f;
+    const Uint32 rb = ((a & 0x00FF00FF) * g + (b & 0x00FF00FF) * f + 0x00800080) >> 8;
+    const Uint32 ag = ((a >> 8) & 0x00FF00FF) * g + ((b >> 8) & 0x00FF00FF) * f + 0x00800080;
+
+    return (rb & 0x00FF00FF) | (ag & 0xFF00FF00);
+}
+
+static SDL_INLINE Uint32
+SampleNearest(const TransformState *state, Sint64 u, Sint64 v)
+{
+    return ((const Uint32 *) (state->pixels + (int) (v >> 16) * state->pitch))[(int) (u >> 16)];
+}
+
+/* Samples between the four nearest pixel centers, clamped to the edges of srcrect */
+static SDL_INLINE Uint32
+SampleLinear(const TransformState *state, Sint64 u, Sint64 v)
+{
+    const Uint32 *row0, *row1;
+    int x0 = 0, y0 = 0, fx = 0, fy = 0;
+    int x1, y1;
+
+    u -= 0x8000;
+    v -= 0x8000;
+    if (u > 0) {
+        x0 = (int) (u >> 16);
+        fx = (int) ((u >> 8) & 0xFF);
+    }
+    if (v > 0) {
+        y0 = (int) (v >> 16);
+        fy = (int) ((v >> 8) & 0xFF);
+    }
+    x1 = SDL_min(x0 + 1, state->w - 1);
+    y1 = SDL_min(y0 + 1, state->h - 1);
+    row0 = (const Uint32 *) (state->pixels + y0 * state->pitch);
+    row1 = (const Uint32 *) (state->pixels + y1 * state->pitch);
+    return Lerp(Lerp(row0[x0], row0[x1], fx), Lerp(row1[x0], row1[x1], fx), fy);
+}
+
+/* Moves the channels of a source pixel to where the target has them, and modulates them */
+static SDL_INLINE Uint32
+ConvertPixel(const TransformState *state, Uint32 pixel)
+{
+    Uint32 r = (pixel >> state->src_rshift) & 0xFF;
+    Uint32 g = (pixel >> state->src_gshift) & 0xFF;
+    Uint32 b = (pixel >> state->src_bshift) & 0xFF;
+    Uint32 a = state->src_alpha ? (pixel >> state->src_ashift) & 0xFF : 0xFF;
+
+    if ((state->r & state->g & state->b) != 0xFF) {
+        r = Div255(r * state->r);
+        g = Div255(g * state->g);
+        b = Div255(b * state->b);
+    }
+    if (state->a != 0xFF) {
+        a = Div255(a * state->a);
+        if (state->blend == SDL_BLENDMODE_BLEND_PREMULTIPLIED) {
+            /* Premultiplied colors are scaled along with their alpha */
+            r = Div255(r * state->a);
+            g = Div255(g * state->a);
+            b = Div255(b * state->a);
+        }
+    }
+    return (r << state->dst_rshift) | (g << state->dst_gshift) |
+           (b << state->dst_bshift) | (a << state->dst_ashift);
+}
+
+static void
+Blend_None(Uint32 *dst, const Uint32 *src, int count, const TransformState *state)
+{
+    const Uint32 keep = state->dst_keep;
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        dst[i] = src[i] & keep;
+    }
+}
+
+/* The blend of SDL_Blit_Slow(), but with one rounded division per channel
+   where it premultiplies and blends with two truncated ones. The alpha
+   channel is blended like the colors, as if its source value was 255. */
+static void
+Blend_Blend(Uint32 *dst, const Uint32 *src, int count, const TransformState *state)
+{
+    const int ashift = state->dst_ashift;
+    const Uint32 keep = state->dst_keep;
+    int i, shift;
+
+    for (i = 0; i < count; ++i) {
+        const Uint32 s = src[i] | (0xFFu << ashift);
+        const Uint32 d = dst[i];
+        const Uint32 sa = (src[i] >> ashift) & 0xFF;
+        Uint32 out = 0;
+
+        for (shift = 0; shift < 32; shift += 8) {
+            out |= Div255(((s >> shift) & 0xFF) * sa + ((d >> shift) & 0xFF) * (255 - sa)) << shift;
+        }
+        dst[i] = out & keep;
+    }
+}
+
+/* The source colors are already multiplied by their alpha */
+static void
+Blend_Premultiplied(Uint32 *dst, const Uint32 *src, int count, const TransformState *state)
+{
+    const int ashift = state->dst_ashift;
+    const Uint32 keep = state->dst_keep;
+    int i, shift;
+
+    for (i = 0; i < count; ++i) {
+        const Uint32 s = src[i];
+        const Uint32 d = dst[i];
+        const Uint32 sa = (s >> ashift) & 0xFF;
+        Uint32 out = 0;
+
+        for (shift = 0; shift < 32; shift += 8) {
+            const Uint32 c = ((s >> shift) & 0xFF) + Div255(((d >> shift) & 0xFF) * (255 - sa));
+            out |= SDL_min(c, 255) << shift;
+        }
+        dst[i] = out & keep;
+    }
+}
+
+/* SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD and SDL_BLENDMODE_MUL, which all keep
+   the target alpha. Like Blend_Blend(), these round where SDL_Blit_Slow()
+   truncates. */
+static void
+Blend_Other(Uint32 *dst, const Uint32 *src, int count, const TransformState *state)
+{
+    const int ashift = state->dst_ashift;
+    const Uint32 keep = state->dst_keep;
+    int i, shift;
+
+    for (i = 0; i < count; ++i) {
+        const Uint32 s = src[i];
+        const Uint32 d = dst[i];
+        const Uint32 sa = (s >> ashift) & 0xFF;
+        Uint32 out = d & (0xFFu << ashift);
+
+        for (shift = 0; shift < 32; shift += 8) {
+            const Uint32 sc = (s >> shift) & 0xFF;
+            const Uint32 dc = (d >> shift) & 0xFF;
+            Uint32 c;
+
+            if (shift == ashift) {
+                continue;
+            }
+            switch (state->blend) {
+            case SDL_BLENDMODE_ADD:
+                c = Div255(sc * sa) + dc;
+                break;
+            case SDL_BLENDMODE_MOD:
+                c = Div255(sc * dc);
+                break;
+            default:
+                c = Div255(sc * dc + dc * (255 - sa));
+                break;
+            }
+            out |= SDL_min(c, 255) << shift;
+        }
+        dst[i] = out & keep;
+    }
+}
+
+#if HAVE_SSE2_INTRINSICS
+static void
+Blend_Blend_SSE2(Uint32 *dst, const Uint32 *src, int count, const TransformState *state)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ashift = _mm_cvtsi32_si128(state->dst_ashift);
+    const __m128i opaque = _mm_set1_epi32((int) (0xFFu << state->dst_ashift));
+    const __m128i keep = _mm_set1_epi32((int) state->dst_keep);
+    const __m128i x255 = _mm_set1_epi16(255);
+    const __m128i x128 = _mm_set1_epi16(128);
+    int i;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const __m128i s = _mm_loadu_si128((const __m128i *) (src + i));
+        const __m128i d = _mm_loadu_si128((const __m128i *) (dst + i));
+        const __m128i s1 = _mm_or_si128(s, opaque);
+        __m128i a = _mm_and_si128(_mm_srl_epi32(s, ashift), _mm_set1_epi32(0xFF));
+        __m128i alo, ahi, lo, hi;
+
+        /* Spread the alpha of each pixel over its four 16-bit channels */
+        a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+        alo = _mm_unpacklo_epi32(a, a);
+        ahi = _mm_unpackhi_epi32(a, a);
+
+        lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s1, zero), alo),
+                           _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_sub_epi16(x255, alo)));
+        hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s1, zero), ahi),
+                           _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_sub_epi16(x255, ahi)));
+        lo = _mm_add_epi16(lo, x128);
+        hi = _mm_add_epi16(hi, x128);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        _mm_storeu_si128((__m128i *) (dst + i), _mm_and_si128(_mm_packus_epi16(lo, hi), keep));
+    }
+    Blend_Blend(dst + i, src + i, count - i, state);
+}
+
+static void
+Blend_Premultiplied_SSE2(Uint32 *dst, const Uint32 *src, int count, const TransformState *state)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ashift = _mm_cvtsi32_si128(state->dst_ashift);
+    const __m128i keep = _mm_set1_epi32((int) state->dst_keep);
+    const __m128i x255 = _mm_set1_epi16(255);
+    const __m128i x128 = _mm_set1_epi16(128);
+    int i;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const __m128i s = _mm_loadu_si128((const __m128i *) (src + i));
+        const __m128i d = _mm_loadu_si128((const __m128i *) (dst + i));
+        __m128i a = _mm_and_si128(_mm_srl_epi32(s, ashift), _mm_set1_epi32(0xFF));
+        __m128i alo, ahi, lo, hi;
+
+        /* Spread the alpha of each pixel over its four 16-bit channels */
+        a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+        alo = _mm_unpacklo_epi32(a, a);
+        ahi = _mm_unpackhi_epi32(a, a);
+
+        lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_sub_epi16(x255, alo)), x128);
+        hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_sub_epi16(x255, ahi)), x128);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(s, zero));
+        hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(s, zero));
+        _mm_storeu_si128((__m128i *) (dst + i), _mm_and_si128(_mm_packus_epi16(lo, hi), keep));
+    }
+    Blend_Premultiplied(dst + i, src + i, count - i, state);
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+/* Narrows [*first, *last) to the pixels x for which s0 + x * ds is in
+   [0, size), give or take a pixel */
+static void
+ClipSpan(double s0, double ds, int size, int *first, int *last)
+{
+    double a, b;
+
+    if (SDL_fabs(ds) < 1e-9) {
+        if (s0 < 0 || s0 >= size) {
+            *last = *first;
+        }
+        return;
+    }
+    a = -s0 / ds;
+    b = (size - s0) / ds;
+    if (a > b) {
+        const double t = a;
+        a = b;
+        b = t;
+    }
+    if (a - 1 > *first) {
+        *first = (a - 1 < *last) ? (int) SDL_floor(a - 1) : *last;
+    }
+    if (b + 1 < *last) {
+        *last = (b + 1 > *first) ? (int) SDL_ceil(b + 1) : *first;
+    }
+}
+
+static SDL_INLINE SDL_bool
+IsInside(const TransformState *state, Sint64 u, Sint64 v)
+{
+    return (u >= 0 && v >= 0 && u < ((Sint64) state->w << 16) && v < ((Sint64) state->h << 16)) ? SDL_TRUE : SDL_FALSE;
+}
+
+int
+SDL_SW_BlitTransformed(SDL_Surface * src, const SDL_Rect * srcrect,
+                       SDL_Surface * dst, const SDL_Rect * dstrect,
+                       double angle, const SDL_FPoint * center,
+                       SDL_RendererFlip flip, SDL_ScaleMode scaleMode)
+{
+    TransformState state;
+    TransformBlendFunc blend_func;
+    Uint32 run[TRANSFORM_RUN];
+    double cangle, sangle, kx, ky, cx, cy;
+    double u0, v0, du_dx, dv_dx, du_dy, dv_dy;
+    double minx, miny, maxx, maxy;
+    Sint64 fdu, fdv;
+    SDL_Rect bounds;
+    int x, y, i;
+
+    if (!SDL_SW_CanBlitTransformed(src, dst)) {
+        return SDL_SetError("Transformed blits need 32-bit surfaces with 8-bit channels");
+    }
+    if (srcrect->w <= 0 || srcrect->h <= 0 || dstrect->w <= 0 || dstrect->h <= 0) {
+        return 0;
+    }
+
+    state.w = srcrect->w;
+    state.h = srcrect->h;
+    state.src_rshift = src->format->Rshift;
+    state.src_gshift = src->format->Gshift;
+    state.src_bshift = src->format->Bshift;
+    state.src_ashift = src->format->Ashift;
+    state.src_alpha = src->format->Amask ? SDL_TRUE : SDL_FALSE;
+    state.dst_rshift = dst->format->Rshift;
+    state.dst_gshift = dst->format->Gshift;
+    state.dst_bshift = dst->format->Bshift;
+    state.dst_ashift = GetAlphaShift(dst->format);
+    state.dst_keep = dst->format->Amask ? 0xFFFFFFFF : ~(0xFFu << state.dst_ashift);
+    state.linear = (scaleMode != SDL_ScaleModeNearest) ? SDL_TRUE : SDL_FALSE;
+    SDL_GetSurfaceBlendMode(src, &state.blend);
+    SDL_GetSurfaceColorMod(src, &state.r, &state.g, &state.b);
+    SDL_GetSurfaceAlphaMod(src, &state.a);
+    state.convert = (!state.src_alpha || (state.r & state.g & state.b & state.a) != 0xFF ||
+                     state.src_rshift != state.dst_rshift || state.src_gshift != state.dst_gshift ||
+                     state.src_bshift != state.dst_bshift || state.src_ashift != state.dst_ashift) ? SDL_TRUE : SDL_FALSE;
+
+    /* Blending opaque pixels is copying them */
+    if ((state.blend == SDL_BLENDMODE_BLEND || state.blend == SDL_BLENDMODE_BLEND_PREMULTIPLIED) &&
+        !state.src_alpha && state.a == 0xFF) {
+        state.blend = SDL_BLENDMODE_NONE;
+    }
+    switch (state.blend) {
+    case SDL_BLENDMODE_NONE:
+        blend_func = Blend_None;
+        break;
+    case SDL_BLENDMODE_BLEND:
+        blend_func = Blend_Blend;
+#if HAVE_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            blend_func = Blend_Blend_SSE2;
+        }
+#endif
+        break;
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        blend_func = Blend_Premultiplied;
+#if HAVE_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            blend_func = Blend_Premultiplied_SSE2;
+        }
+#endif
+        break;
+    default:
+        blend_func = Blend_Other;
+        break;
+    }
+
+    /* The inverse of the transform: for the center of the target pixel
+       (x, y), undo the rotation around center, then the flip, then scale to
+       srcrect. This is affine, so the source position, in source pixels
+       relative to srcrect, is (u0 + x * du_dx + y * du_dy, v0 + ...). */
+    cangle = SDL_cos(angle * (M_PI / 180.0));
+    sangle = SDL_sin(angle * (M_PI / 180.0));
+    kx = (double) srcrect->w / dstrect->w;
+    ky = (double) srcrect->h / dstrect->h;
+    cx = dstrect->x + center->x;
+    cy = dstrect->y + center->y;
+    du_dx = cangle * kx;
+    du_dy = sangle * kx;
+    dv_dx = -sangle * ky;
+    dv_dy = cangle * ky;
+    u0 = ((0.5 - cx) * cangle + (0.5 - cy) * sangle + center->x) * kx;
+    v0 = (-(0.5 - cx) * sangle + (0.5 - cy) * cangle + center->y) * ky;
+    if (flip & SDL_FLIP_HORIZONTAL) {
+        u0 = srcrect->w - u0;
+        du_dx = -du_dx;
+        du_dy = -du_dy;
+    }
+    if (flip & SDL_FLIP_VERTICAL) {
+        v0 = srcrect->h - v0;
+        dv_dx = -dv_dx;
+        dv_dy = -dv_dy;
+    }
+    fdu = (Sint64) SDL_floor(du_dx * 65536.0);
+    fdv = (Sint64) SDL_floor(dv_dx * 65536.0);
+
+    /* Only the pixels inside the bounding box of the rotated dstrect can be
+       drawn, so don't walk the rest of the clip rectangle */
+    minx = maxx = cx - center->x * cangle + center->y * sangle;
+    miny = maxy = cy - center->x * sangle - center->y * cangle;
+    for (i = 1; i < 4; ++i) {
+        const double ax = ((i & 1) ? dstrect->w : 0) - center->x;
+        const double ay = ((i & 2) ? dstrect->h : 0) - center->y;
+        const double px = cx + ax * cangle - ay * sangle;
+        const double py = cy + ax * sangle + ay * cangle;
+
+        minx = SDL_min(minx, px);
+        maxx = SDL_max(maxx, px);
+        miny = SDL_min(miny, py);
+        maxy = SDL_max(maxy, py);
+    }
+    bounds.x = (int) SDL_floor(minx) - 1;
+    bounds.y = (int) SDL_floor(miny) - 1;
+    bounds.w = (int) SDL_ceil(maxx) + 1 - bounds.x;
+    bounds.h = (int) SDL_ceil(maxy) + 1 - bounds.y;
+    if (!SDL_IntersectRect(&bounds, &dst->clip_rect, &bounds)) {
+        return 0;
+    }
+
+    /* It is possible to encounter an RLE encoded surface here and locking it is
+     * necessary because this code is going to access the pixel buffer directly.
+     */
+    if (SDL_MUSTLOCK(src)) {
+        SDL_LockSurface(src);
+    }
+    state.pixels = (const Uint8 *) src->pixels + srcrect->y * src->pitch + srcrect->x * 4;
+    state.pitch = src->pitch;
+
+    for (y = bounds.y; y < bounds.y + bounds.h; ++y) {
+        const double u_row = u0 + y * du_dy;
+        const double v_row = v0 + y * dv_dy;
+        Uint32 *dstrow = (Uint32 *) ((Uint8 *) dst->pixels + y * dst->pitch);
+        int first = bounds.x;
+        int last = bounds.x + bounds.w;
+        Sint64 u, v;
+
+        ClipSpan(u_row, du_dx, srcrect->w, &first, &last);
+        ClipSpan(v_row, dv_dx, srcrect->h, &first, &last);
+        if (first >= last) {
+            continue;
+        }
+
+        /* Trim the span to the pixels that really are inside. Positions
+           change monotonically along the row, so everything between the
+           ends is inside too. */
+        u = (Sint64) SDL_floor((u_row + first * du_dx) * 65536.0);
+        v = (Sint64) SDL_floor((v_row + first * dv_dx) * 65536.0);
+        while (first < last && !IsInside(&state, u, v)) {
+            ++first;
+            u += fdu;
+            v += fdv;
+        }
+        while (first < last && !IsInside(&state, u + (last - 1 - first) * fdu, v + (last - 1 - first) * fdv)) {
+            --last;
+        }
+
+        for (x = first; x < last; x += TRANSFORM_RUN) {
+            const int count = SDL_min(TRANSFORM_RUN, last - x);
+
+            if (state.linear) {
+                for (i = 0; i < count; ++i, u += fdu, v += fdv) {
+                    run[i] = SampleLinear(&state, u, v);
+                }
+            } else {
+                for (i = 0; i < count; ++i, u += fdu, v += fdv) {
+                    run[i] = SampleNearest(&state, u, v);
+                }
+            }
+            if (state.convert) {
+                for (i = 0; i < count; ++i) {
+                    run[i] = ConvertPixel(&state, run[i]);
+                }
+            }
+            blend_func(dstrow + x, run, count, &state);
+        }
+    }
+
+    if (SDL_MUSTLOCK(src)) {
+        SDL_UnlockSurface(src);
+    }
+    return 0;
+}
+
+#endif /* SDL_VIDEO_RENDER_SW && !SDL_RENDER_DISABLED */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,215 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#include "SDL_atomic.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_hints.h"
+#include "SDL_thread.h"
+#include "SDL_systhread.h"
+#include "SDL_threadpool_c.h"
+
+#define SDL_MAX_POOL_THREADS 64
+
+typedef struct
+{
+    SDL_Thread *threads[SDL_MAX_POOL_THREADS];
+    int num_threads;
+    SDL_sem *work;
+    SDL_sem *done;
+    SDL_atomic_t quit;
+
+    /* The job being run, only changed while no worker is awake. */
+    SDL_ParallelFunction func;
+    void *data;
+    int count;
+    SDL_atomic_t next;
+} SDL_ThreadPool;
+
+static SDL_ThreadPool *SDL_pool = NULL;
+static SDL_bool SDL_pool_failed = SDL_FALSE;
+static SDL_SpinLock SDL_pool_lock = 0;
+static SDL_atomic_t SDL_pool_busy;
+
+static void
+RunParallelJobs(SDL_ThreadPool *pool)
+{
+    int index;
+
+    while ((index = SDL_AtomicAdd(&pool->next, 1)) < pool->count) {
+        pool->func(pool->data, index);
+    }
+}
+
+static int SDLCALL
+SDL_PoolWorker(void *data)
+{
+    SDL_ThreadPool *pool = (SDL_ThreadPool *) data;
+
+    for (;;) {
+        SDL_SemWait(pool->work);
+        if (SDL_AtomicGet(&pool->quit)) {
+            break;
+        }
+        RunParallelJobs(pool);
+        SDL_SemPost(pool->done);
+    }
+    return 0;
+}
+
+static int
+GetPoolThreadCount(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_WORKER_THREADS);
+    int count = (hint && *hint) ? SDL_atoi(hint) : SDL_GetCPUCount();
+
+    /* The calling thread does its share of the work, too. */
+    return SDL_min(SDL_max(count - 1, 0), SDL_MAX_POOL_THREADS);
+}
+
+static void
+DestroyThreadPool(SDL_ThreadPool *pool)
+{
+    int i;
+
+    SDL_AtomicSet(&pool->quit, 1);
+    for (i = 0; i < pool->num_threads; ++i) {
+        SDL_SemPost(pool->work);
+    }
+    for (i = 0; i < pool->num_threads; ++i) {
+        SDL_WaitThread(pool->threads[i], NULL);
+    }
+    if (pool->work) {
+        SDL_DestroySemaphore(pool->work);
+    }
+    if (pool->done) {
+        SDL_DestroySemaphore(pool->done);
+    }
+    SDL_free(pool);
+}
+
+static SDL_ThreadPool *
+CreateThreadPool(void)
+{
+    const int num_threads = GetPoolThreadCount();
+    SDL_ThreadPool *pool;
+
+    if (num_threads == 0) {
+        return NULL;
+    }
+
+    pool = (SDL_ThreadPool *) SDL_calloc(1, sizeof (*pool));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->work = SDL_CreateSemaphore(0);
+    pool->done = SDL_CreateSemaphore(0);
+    if (!pool->work || !pool->done) {
+        DestroyThreadPool(pool);
+        return NULL;
+    }
+
+    while (pool->num_threads < num_threads) {
+        SDL_Thread *thread = SDL_CreateThreadInternal(SDL_PoolWorker, "SDLWorker", 0, pool);
+        if (!thread) {
+            break;
+        }
+        pool->threads[pool->num_threads++] = thread;
+    }
+
+    if (pool->num_threads == 0) {
+        DestroyThreadPool(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+static SDL_ThreadPool *
+GetThreadPool(void)
+{
+    SDL_AtomicLock(&SDL_pool_lock);
+    if (!SDL_pool && !SDL_pool_failed) {
+        SDL_pool = CreateThreadPool();
+        SDL_pool_failed = SDL_pool ? SDL_FALSE : SDL_TRUE;
+    }
+    SDL_AtomicUnlock(&SDL_pool_lock);
+    return SDL_pool;
+}
+
+int
+SDL_GetParallelism(void)
+{
+    SDL_ThreadPool *pool = GetThreadPool();
+    return pool ? pool->num_threads + 1 : 1;
+}
+
+void
+SDL_ParallelFor(int count, SDL_ParallelFunction func, void *data)
+{
+    int i;
+
+    if (count > 1 && SDL_AtomicCAS(&SDL_pool_busy, 0, 1)) {
+        SDL_ThreadPool *pool = GetThreadPool();
+        if (pool) {
+            const int wake = SDL_min(pool->num_threads, count - 1);
+
+            pool->func = func;
+            pool->data = data;
+            pool->count = count;
+            SDL_AtomicSet(&pool->next, 0);
+
+            for (i = 0; i < wake; ++i) {
+                SDL_SemPost(pool->work);
+            }
+            RunParallelJobs(pool);
+            for (i = 0; i < wake; ++i) {
+                SDL_SemWait(pool->done);
+            }
+
+            SDL_AtomicSet(&SDL_pool_busy, 0);
+            return;
+        }
+        SDL_AtomicSet(&SDL_pool_busy, 0);
+    }
+
+    for (i = 0; i < count; ++i) {
+        func(data, i);
+    }
+}
+
+void
+SDL_QuitThreadPool(void)
+{
+    SDL_ThreadPool *pool;
+
+    SDL_AtomicLock(&SDL_pool_lock);
+    pool = SDL_pool;
+    SDL_pool = NULL;
+    SDL_pool_failed = SDL_FALSE;
+    SDL_AtomicUnlock(&SDL_pool_lock);
+
+    if (pool) {
+        DestroyThreadPool(pool);
+    }
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,44 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#ifndef SDL_threadpool_c_h_
+#define SDL_threadpool_c_h_
+
+/* A process-wide pool of worker threads for splitting CPU-bound work, like
+   software rendering and large surface blits, into independent pieces. */
+
+typedef void (*SDL_ParallelFunction) (void *data, int index);
+
+/* Calls func(data, i) once for every i in [0, count), spread across the
+   worker threads and the calling thread, and returns when all calls are done.
+   Nested or concurrent calls simply run on the calling thread. */
+extern void SDL_ParallelFor(int count, SDL_ParallelFunction func, void *data);
+
+/* The number of threads SDL_ParallelFor() can use, including the caller. */
+extern int SDL_GetParallelism(void);
+
+/* Stops the worker threads; they are restarted on demand. */
+extern void SDL_QuitThreadPool(void);
+
+#endif /* SDL_threadpool_c_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
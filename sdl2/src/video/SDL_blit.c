@@ -20,6 +20,8 @@
 */
 #include "../SDL_internal.h"
 
+#include "SDL_hints.h"
+#include "SDL_log.h"
 #include "SDL_video.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
@@ -28,6 +30,63 @@
 #include "SDL_blit_slow.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
+#include "../thread/SDL_threadpool_c.h"
+
+/* Blits smaller than this aren't worth waking the worker threads for */
+#define SDL_PARALLEL_BLIT_MIN_PIXELS    (256 * 256)
+#define SDL_PARALLEL_BLIT_MIN_ROWS      32
+
+typedef struct
+{
+    const SDL_BlitInfo *info;
+    SDL_BlitFunc blit;
+    int count;
+} SDL_BlitStripes;
+
+static void
+SDL_RunBlitStripe(void *data, int index)
+{
+    const SDL_BlitStripes *stripes = (const SDL_BlitStripes *) data;
+    SDL_BlitInfo info = *stripes->info;
+    const int y = (info.dst_h * index) / stripes->count;
+    const int h = (info.dst_h * (index + 1)) / stripes->count - y;
+
+    /* Each stripe gets its own copy of the blit info, which the blitters advance */
+    info.src += y * info.src_pitch;
+    info.dst += y * info.dst_pitch;
+    info.src_h = h;
+    info.dst_h = h;
+    stripes->blit(&info);
+}
+
+/* Returns how many row stripes to split a blit into, see SDL_HINT_PARALLEL_BLITS */
+static int
+SDL_GetBlitStripes(SDL_Surface * src, SDL_Surface * dst, const SDL_BlitInfo * info)
+{
+    const Uint8 *src_end = (const Uint8 *) src->pixels + src->h * src->pitch;
+    const Uint8 *dst_end = (const Uint8 *) dst->pixels + dst->h * dst->pitch;
+
+    if (info->dst_w * info->dst_h < SDL_PARALLEL_BLIT_MIN_PIXELS ||
+        info->dst_h < 2 * SDL_PARALLEL_BLIT_MIN_ROWS) {
+        return 1;
+    }
+    /* Scaled blits step through the source relative to the first row */
+    if (info->flags & SDL_COPY_NEAREST) {
+        return 1;
+    }
+    if (SDL_ISPIXELFORMAT_INDEXED(src->format->format) ||
+        SDL_ISPIXELFORMAT_INDEXED(dst->format->format)) {
+        return 1;
+    }
+    /* Overlapping blits rely on the order the rows are copied in */
+    if ((const Uint8 *) src->pixels < dst_end && (const Uint8 *) dst->pixels < src_end) {
+        return 1;
+    }
+    if (!SDL_GetHintBoolean(SDL_HINT_PARALLEL_BLITS, SDL_FALSE)) {
+        return 1;
+    }
+    return SDL_min(SDL_GetParallelism(), info->dst_h / SDL_PARALLEL_BLIT_MIN_ROWS);
+}
 
 /* The general purpose software blit routine */
 static int SDLCALL
@@ -64,6 +123,7 @@ SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
     if (okay && !SDL_RectEmpty(srcrect)) {
         SDL_BlitFunc RunBlit;
         SDL_BlitInfo *info = &src->map->info;
+        int stripes;
 
         /* Set up the blit information */
         info->src = (Uint8 *) src->pixels +
@@ -85,7 +145,17 @@ SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
         RunBlit = (SDL_BlitFunc) src->map->data;
 
         /* Run the actual software blit */
-        RunBlit(info);
+        stripes = SDL_GetBlitStripes(src, dst, info);
+        if (stripes > 1) {
+            SDL_BlitStripes job;
+
+            job.info = info;
+            job.blit = RunBlit;
+            job.count = stripes;
+            SDL_ParallelFor(stripes, SDL_RunBlitStripe, &job);
+        } else {
+            RunBlit(info);
+        }
     }
 
     /* We need to unlock the surfaces if they're locked */
@@ -99,8 +169,6 @@ SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
     return (okay ? 0 : -1);
 }
 
-#if SDL_HAVE_BLIT_AUTO
-
 #ifdef __MACOSX__
 #include <sys/sysctl.h>
 
@@ -126,45 +194,90 @@ SDL_UseAltivecPrefetch()
 }
 #endif /* __MACOSX__ */
 
-static SDL_BlitFunc
-SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
-                   SDL_BlitFuncEntry * entries)
+/* The SDL_BLIT_CPU_FEATURES override, -1 if there isn't one. It's watched as
+   a hint, so the environment is read once and tests can change it with
+   SDL_SetHint() to compare the scalar blitters with the SIMD ones. */
+static int cpu_features_override = -1;
+static SDL_bool cpu_features_watched = SDL_FALSE;
+
+static void SDLCALL
+SDL_BlitCPUFeaturesChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
 {
-    int i, flagcheck = (flags & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_COLORKEY | SDL_COPY_NEAREST));
-    static int features = 0x7fffffff;
+    unsigned int features;
 
-    /* Get the available CPU features */
-    if (features == 0x7fffffff) {
-        const char *override = SDL_getenv("SDL_BLIT_CPU_FEATURES");
+    if (hint && *hint && SDL_sscanf(hint, "%u", &features) == 1) {
+        cpu_features_override = (int) features;
+    } else {
+        cpu_features_override = -1;
+    }
+}
 
-        features = SDL_CPU_ANY;
+int
+SDL_GetBlitCPUFeatures(void)
+{
+    static int cpu_features = 0x7fffffff;
 
-        /* Allow an override for testing .. */
-        if (override) {
-            SDL_sscanf(override, "%u", &features);
-        } else {
-            if (SDL_HasMMX()) {
-                features |= SDL_CPU_MMX;
-            }
-            if (SDL_Has3DNow()) {
-                features |= SDL_CPU_3DNOW;
-            }
-            if (SDL_HasSSE()) {
-                features |= SDL_CPU_SSE;
-            }
-            if (SDL_HasSSE2()) {
-                features |= SDL_CPU_SSE2;
-            }
-            if (SDL_HasAltiVec()) {
-                if (SDL_UseAltivecPrefetch()) {
-                    features |= SDL_CPU_ALTIVEC_PREFETCH;
-                } else {
-                    features |= SDL_CPU_ALTIVEC_NOPREFETCH;
-                }
+    if (!cpu_features_watched) {
+        cpu_features_watched = SDL_TRUE;
+        SDL_AddHintCallback("SDL_BLIT_CPU_FEATURES", SDL_BlitCPUFeaturesChanged, NULL);
+    }
+
+    /* Get the available CPU features */
+    if (cpu_features == 0x7fffffff) {
+        cpu_features = SDL_CPU_ANY;
+        if (SDL_HasMMX()) {
+            cpu_features |= SDL_CPU_MMX;
+        }
+        if (SDL_Has3DNow()) {
+            cpu_features |= SDL_CPU_3DNOW;
+        }
+        if (SDL_HasSSE()) {
+            cpu_features |= SDL_CPU_SSE;
+        }
+        if (SDL_HasSSE2()) {
+            cpu_features |= SDL_CPU_SSE2;
+        }
+        if (SDL_HasSSE41()) {
+            cpu_features |= SDL_CPU_SSE41;
+        }
+        if (SDL_HasAVX2()) {
+            cpu_features |= SDL_CPU_AVX2;
+        }
+        if (SDL_HasNEON()) {
+            cpu_features |= SDL_CPU_NEON;
+        }
+        if (SDL_HasAltiVec()) {
+            if (SDL_UseAltivecPrefetch()) {
+                cpu_features |= SDL_CPU_ALTIVEC_PREFETCH;
+            } else {
+                cpu_features |= SDL_CPU_ALTIVEC_NOPREFETCH;
             }
         }
     }
 
+    return (cpu_features_override >= 0) ? cpu_features_override : cpu_features;
+}
+
+void
+SDL_QuitBlit(void)
+{
+    /* SDL_ClearHints() frees the callback, so it has to be added again after SDL_Init() */
+    if (cpu_features_watched) {
+        SDL_DelHintCallback("SDL_BLIT_CPU_FEATURES", SDL_BlitCPUFeaturesChanged, NULL);
+        cpu_features_watched = SDL_FALSE;
+    }
+    cpu_features_override = -1;
+}
+
+#if SDL_HAVE_BLIT_AUTO
+
+static SDL_BlitFunc
+SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
+                   SDL_BlitFuncEntry * entries)
+{
+    int i, flagcheck = (flags & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND_MASK | SDL_COPY_COLORKEY | SDL_COPY_NEAREST));
+    const int features = SDL_GetBlitCPUFeatures();
+
     for (i = 0; entries[i].func; ++i) {
         /* Check for matching pixel formats */
         if (src_format != entries[i].src_format) {
@@ -191,6 +304,23 @@ SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
 }
 #endif /* SDL_HAVE_BLIT_AUTO */
 
+/* Tells test/testblitbench.c, or anyone debugging a slow blit, which family
+   of blitters was chosen. Blit maps are calculated often enough that the
+   message is only put together when someone listens for it. */
+static void
+SDL_LogBlitChoice(SDL_Surface * surface, const char *kind)
+{
+    SDL_BlitMap *map = surface->map;
+
+    map->kind = kind;
+    if (SDL_LogGetPriority(SDL_LOG_CATEGORY_VIDEO) <= SDL_LOG_PRIORITY_DEBUG) {
+        SDL_LogDebug(SDL_LOG_CATEGORY_VIDEO, "Blit %s to %s with flags 0x%x uses %s",
+                     SDL_GetPixelFormatName(surface->format->format),
+                     SDL_GetPixelFormatName(map->dst->format->format),
+                     map->info.flags, kind);
+    }
+}
+
 /* Figure out which of many blit routines to set up on a surface */
 int
 SDL_CalculateBlit(SDL_Surface * surface)
@@ -198,6 +328,7 @@ SDL_CalculateBlit(SDL_Surface * surface)
     SDL_BlitFunc blit = NULL;
     SDL_BlitMap *map = surface->map;
     SDL_Surface *dst = map->dst;
+    const char *kind = NULL;
 
     /* We don't currently support blitting to < 8 bpp surfaces */
     if (dst->format->BitsPerPixel < 8) {
@@ -222,6 +353,7 @@ SDL_CalculateBlit(SDL_Surface * surface)
     /* See if we can do RLE acceleration */
     if (map->info.flags & SDL_COPY_RLE_DESIRED) {
         if (SDL_RLESurface(surface) == 0) {
+            SDL_LogBlitChoice(surface, "rle");
             return 0;
         }
     }
@@ -230,31 +362,51 @@ SDL_CalculateBlit(SDL_Surface * surface)
     /* Choose a standard blit function */
     if (map->identity && !(map->info.flags & ~SDL_COPY_RLE_DESIRED)) {
         blit = SDL_BlitCopy;
-    } else if (surface->format->Rloss > 8 || dst->format->Rloss > 8) {
+        kind = "copy";
+    } else if ((surface->format->Rloss > 8 && !SDL_ISPIXELFORMAT_10BIT(surface->format->format)) ||
+               (dst->format->Rloss > 8 && !SDL_ISPIXELFORMAT_10BIT(dst->format->format))) {
         /* Greater than 8 bits per channel not supported yet */
         SDL_InvalidateMap(map);
         return SDL_SetError("Blit combination not supported");
+    } else if (SDL_ISPIXELFORMAT_10BIT(surface->format->format) ||
+               SDL_ISPIXELFORMAT_10BIT(dst->format->format)) {
+        /* The other blitters expect 8-bit channels, so only plain conversions
+           have special cases. The rest uses the generated or slow blitters. */
+        if (SDL_ISPIXELFORMAT_INDEXED(surface->format->format)) {
+            SDL_InvalidateMap(map);
+            return SDL_SetError("Blit combination not supported");
+        }
+#if SDL_HAVE_BLIT_N
+        if (!(map->info.flags & ~SDL_COPY_RLE_DESIRED)) {
+            blit = SDL_CalculateBlitN(surface);
+            kind = "N";
+        }
+#endif
     }
 #if SDL_HAVE_BLIT_0
     else if (surface->format->BitsPerPixel < 8 &&
                SDL_ISPIXELFORMAT_INDEXED(surface->format->format)) {
         blit = SDL_CalculateBlit0(surface);
+        kind = "0";
     }
 #endif
 #if SDL_HAVE_BLIT_1
     else if (surface->format->BytesPerPixel == 1 &&
                SDL_ISPIXELFORMAT_INDEXED(surface->format->format)) {
         blit = SDL_CalculateBlit1(surface);
+        kind = "1";
     }
 #endif
 #if SDL_HAVE_BLIT_A
-    else if (map->info.flags & SDL_COPY_BLEND) {
+    else if (map->info.flags & (SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED)) {
         blit = SDL_CalculateBlitA(surface);
+        kind = "A";
     }
 #endif
 #if SDL_HAVE_BLIT_N
     else {
         blit = SDL_CalculateBlitN(surface);
+        kind = "N";
     }
 #endif
 #if SDL_HAVE_BLIT_AUTO
@@ -265,6 +417,7 @@ SDL_CalculateBlit(SDL_Surface * surface)
         blit =
             SDL_ChooseBlitFunc(src_format, dst_format, map->info.flags,
                                SDL_GeneratedBlitFuncTable);
+        kind = "auto";
     }
 #endif
 
@@ -280,6 +433,7 @@ SDL_CalculateBlit(SDL_Surface * surface)
             !SDL_ISPIXELFORMAT_INDEXED(dst_format) &&
             !SDL_ISPIXELFORMAT_FOURCC(dst_format)) {
             blit = SDL_Blit_Slow;
+            kind = "slow";
         }
     }
     map->data = blit;
@@ -290,6 +444,7 @@ SDL_CalculateBlit(SDL_Surface * surface)
         return SDL_SetError("Blit combination not supported");
     }
 
+    SDL_LogBlitChoice(surface, kind);
     return 0;
 }
 
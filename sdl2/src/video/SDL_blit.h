@@ -39,10 +39,12 @@ extern Uint8* SDL_expand_byte[9];
 #define SDL_COPY_MUL                0x00000080
 #define SDL_COPY_COLORKEY           0x00000100
 #define SDL_COPY_NEAREST            0x00000200
+#define SDL_COPY_BLEND_PREMULTIPLIED 0x00000400
 #define SDL_COPY_RLE_DESIRED        0x00001000
 #define SDL_COPY_RLE_COLORKEY       0x00002000
 #define SDL_COPY_RLE_ALPHAKEY       0x00004000
 #define SDL_COPY_RLE_MASK           (SDL_COPY_RLE_DESIRED|SDL_COPY_RLE_COLORKEY|SDL_COPY_RLE_ALPHAKEY)
+#define SDL_COPY_BLEND_MASK         (SDL_COPY_BLEND|SDL_COPY_BLEND_PREMULTIPLIED|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)
 
 /* SDL blit CPU flags */
 #define SDL_CPU_ANY                 0x00000000
@@ -52,6 +54,33 @@ extern Uint8* SDL_expand_byte[9];
 #define SDL_CPU_SSE2                0x00000008
 #define SDL_CPU_ALTIVEC_PREFETCH    0x00000010
 #define SDL_CPU_ALTIVEC_NOPREFETCH  0x00000020
+#define SDL_CPU_SSE41               0x00000040
+#define SDL_CPU_AVX2                0x00000080
+#define SDL_CPU_NEON                0x00000100
+
+/* SIMD code paths. SSE2 and NEON are built when the compiler targets them,
+   SSE4.1 and AVX2 are built for their own target and only used when
+   SDL_HasSSE41() and SDL_HasAVX2() are true */
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
+#endif
+#ifdef __ARM_NEON
+#define HAVE_NEON_INTRINSICS 1
+#endif
+#if defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H) && \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#if defined(__GNUC__) || defined(__clang__)
+#define HAVE_SSE41_INTRINSICS 1
+#define HAVE_AVX2_INTRINSICS 1
+#define SDL_TARGETING(x) __attribute__((target(x)))
+#elif defined(_MSC_VER) && (_MSC_VER >= 1700)
+#define HAVE_SSE41_INTRINSICS 1
+#define HAVE_AVX2_INTRINSICS 1
+#endif
+#endif
+#ifndef SDL_TARGETING
+#define SDL_TARGETING(x)
+#endif
 
 typedef struct
 {
@@ -83,6 +112,22 @@ typedef struct
     SDL_BlitFunc func;
 } SDL_BlitFuncEntry;
 
+/* A blitter worked out before, kept around for when the same state comes back */
+typedef struct
+{
+    Uint32 dst_format;
+    int flags;
+    Uint8 r, g, b, a;   /* only matter for indexed sources */
+    Uint32 src_palette_version;
+    int identity;
+    SDL_blit blit;
+    void *data;
+    const char *kind;
+    Uint8 *table;       /* owned by the cache */
+} SDL_BlitMapCacheEntry;
+
+#define SDL_BLITMAP_CACHE_SIZE  4
+
 /* Blit mapping definition */
 typedef struct SDL_BlitMap
 {
@@ -90,16 +135,27 @@ typedef struct SDL_BlitMap
     int identity;
     SDL_blit blit;
     void *data;
+    const char *kind;   /* the family of blitters chosen, for debugging */
     SDL_BlitInfo info;
 
     /* the version count matches the destination; mismatch indicates
        an invalid mapping */
     Uint32 dst_palette_version;
     Uint32 src_palette_version;
+
+    /* the last few mappings, so switching blend modes and modulation
+       back and forth doesn't recalculate the blitter every time */
+    SDL_BlitMapCacheEntry cache[SDL_BLITMAP_CACHE_SIZE];
+    int num_cached;
+    int next_cached;
 } SDL_BlitMap;
 
 /* Functions found in SDL_blit.c */
 extern int SDL_CalculateBlit(SDL_Surface * surface);
+extern void SDL_QuitBlit(void);
+
+/* The SDL_CPU_* features the blitters may use, which SDL_BLIT_CPU_FEATURES can override */
+extern int SDL_GetBlitCPUFeatures(void);
 
 /* Functions found in SDL_blit_*.c */
 extern SDL_BlitFunc SDL_CalculateBlit0(SDL_Surface * surface);
@@ -107,6 +163,28 @@ extern SDL_BlitFunc SDL_CalculateBlit1(SDL_Surface * surface);
 extern SDL_BlitFunc SDL_CalculateBlitN(SDL_Surface * surface);
 extern SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface * surface);
 
+/* Converts between the 8888, 888, 24-bit and 565 RGB formats without a blit
+   map, returns SDL_FALSE if this pair of formats isn't handled */
+extern SDL_bool SDL_ConvertPixels_RGB_to_RGB(int width, int height,
+                                             Uint32 src_format, const void * src, int src_pitch,
+                                             Uint32 dst_format, void * dst, int dst_pitch);
+
+/* Formats with more than 8 bits per color channel, which need their own blitters */
+#define SDL_ISPIXELFORMAT_10BIT(format) ((format) == SDL_PIXELFORMAT_ARGB2101010)
+
+/* Functions found in SDL_stretch.c */
+#define SDL_ISPIXELFORMAT_LINEAR_STRETCH(format) \
+    (SDL_BYTESPERPIXEL(format) == 4 && !SDL_ISPIXELFORMAT_10BIT(format))
+extern int SDL_LowerSoftStretchLinear(SDL_Surface * src, const SDL_Rect * srcrect,
+                                      SDL_Surface * dst, const SDL_Rect * dstrect,
+                                      const SDL_Rect * area,
+                                      SDL_BlitFunc blit, const SDL_BlitInfo * info);
+
+/* Functions found in SDL_surface.c */
+extern int SDL_PrivateUpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
+                                      SDL_Surface * dst, SDL_Rect * dstrect,
+                                      SDL_bool linear);
+
 /*
  * Useful macros for blitting routines
  */
@@ -512,6 +512,203 @@ Blit1toNAlphaKey(SDL_BlitInfo * info)
     }
 }
 
+#if HAVE_AVX2_INTRINSICS
+/* The AVX2 blitters look up eight pixels at a time with a gather from the
+   color table. The table of 2 bytes per pixel is read 4 bytes at a time,
+   Map1toN pads it for that. */
+
+SDL_TARGETING("avx2") SDL_FORCE_INLINE __m256i
+Gather1to4AVX2(const Uint8 * src, const Uint32 * map)
+{
+    const __m256i index = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *) src));
+    return _mm256_i32gather_epi32((const int *) map, index, 4);
+}
+
+/* Sixteen pixels, looked up as 32-bit words and narrowed to 16 bits */
+SDL_TARGETING("avx2") SDL_FORCE_INLINE __m256i
+Gather1to2AVX2(const Uint8 * src, const Uint16 * map)
+{
+    const __m256i mask = _mm256_set1_epi32(0xFFFF);
+    const __m256i lo = _mm256_i32gather_epi32((const int *) map, _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *) src)), 2);
+    const __m256i hi = _mm256_i32gather_epi32((const int *) map, _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *) (src + 8))), 2);
+    return _mm256_permute4x64_epi64(_mm256_packus_epi32(_mm256_and_si256(lo, mask), _mm256_and_si256(hi, mask)), 0xD8);
+}
+
+SDL_TARGETING("avx2") static void
+Blit1to2AVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const Uint16 *map = (const Uint16 *) info->table;
+
+    while (height--) {
+        const Uint8 *s = src;
+        Uint16 *d = (Uint16 *) dst;
+        int n = width;
+
+        for (; n >= 16; n -= 16, s += 16, d += 16) {
+            _mm256_storeu_si256((__m256i *) d, Gather1to2AVX2(s, map));
+        }
+        for (; n > 0; --n) {
+            *d++ = map[*s++];
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+SDL_TARGETING("avx2") static void
+Blit1to3AVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const Uint8 *map = info->table;
+    /* The table has 4 bytes per entry, keep the first 3 of each */
+    const __m256i pack = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                                          0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+
+    while (height--) {
+        const Uint8 *s = src;
+        Uint8 *d = dst;
+        int n = width;
+
+        for (; n >= 8; n -= 8, s += 8, d += 24) {
+            const __m256i p = _mm256_shuffle_epi8(Gather1to4AVX2(s, (const Uint32 *) map), pack);
+            const __m128i hi = _mm256_extracti128_si256(p, 1);
+            _mm_storeu_si128((__m128i *) d, _mm256_castsi256_si128(p));
+            _mm_storel_epi64((__m128i *) (d + 12), hi);
+            *(Uint32 *) (d + 20) = (Uint32) _mm_cvtsi128_si32(_mm_srli_si128(hi, 8));
+        }
+        for (; n > 0; --n, ++s, d += 3) {
+            const int o = *s * 4;
+            d[0] = map[o];
+            d[1] = map[o + 1];
+            d[2] = map[o + 2];
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+SDL_TARGETING("avx2") static void
+Blit1to4AVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const Uint32 *map = (const Uint32 *) info->table;
+
+    while (height--) {
+        const Uint8 *s = src;
+        Uint32 *d = (Uint32 *) dst;
+        int n = width;
+
+        for (; n >= 8; n -= 8, s += 8, d += 8) {
+            _mm256_storeu_si256((__m256i *) d, Gather1to4AVX2(s, map));
+        }
+        for (; n > 0; --n) {
+            *d++ = map[*s++];
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+SDL_TARGETING("avx2") static void
+Blit1to2KeyAVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const Uint16 *map = (const Uint16 *) info->table;
+    const Uint32 ckey = info->colorkey;
+    __m256i vckey;
+
+    if (ckey > 0xFF) {
+        /* No pixel can match */
+        Blit1to2AVX2(info);
+        return;
+    }
+    vckey = _mm256_set1_epi16((Sint16) ckey);
+
+    while (height--) {
+        const Uint8 *s = src;
+        Uint16 *d = (Uint16 *) dst;
+        int n = width;
+
+        for (; n >= 16; n -= 16, s += 16, d += 16) {
+            const __m256i keyed = _mm256_cmpeq_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) s)), vckey);
+            const int bits = _mm256_movemask_epi8(keyed);
+            if (bits != -1) {
+                __m256i out = Gather1to2AVX2(s, map);
+                if (bits) {
+                    out = _mm256_blendv_epi8(out, _mm256_loadu_si256((const __m256i *) d), keyed);
+                }
+                _mm256_storeu_si256((__m256i *) d, out);
+            }
+        }
+        for (; n > 0; --n, ++s, ++d) {
+            if (*s != ckey) {
+                *d = map[*s];
+            }
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+SDL_TARGETING("avx2") static void
+Blit1to4KeyAVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const Uint32 *map = (const Uint32 *) info->table;
+    const Uint32 ckey = info->colorkey;
+    const __m256i vckey = _mm256_set1_epi32((int) ckey);
+
+    while (height--) {
+        const Uint8 *s = src;
+        Uint32 *d = (Uint32 *) dst;
+        int n = width;
+
+        for (; n >= 8; n -= 8, s += 8, d += 8) {
+            const __m256i keyed = _mm256_cmpeq_epi32(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *) s)), vckey);
+            const int bits = _mm256_movemask_epi8(keyed);
+            if (bits != -1) {
+                __m256i out = Gather1to4AVX2(s, map);
+                if (bits) {
+                    out = _mm256_blendv_epi8(out, _mm256_loadu_si256((const __m256i *) d), keyed);
+                }
+                _mm256_storeu_si256((__m256i *) d, out);
+            }
+        }
+        for (; n > 0; --n, ++s, ++d) {
+            if (*s != ckey) {
+                *d = map[*s];
+            }
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+static const SDL_BlitFunc one_blit_avx2[] = {
+    (SDL_BlitFunc) NULL, (SDL_BlitFunc) NULL, Blit1to2AVX2, Blit1to3AVX2, Blit1to4AVX2
+};
+
+static const SDL_BlitFunc one_blitkey_avx2[] = {
+    (SDL_BlitFunc) NULL, (SDL_BlitFunc) NULL, Blit1to2KeyAVX2, (SDL_BlitFunc) NULL, Blit1to4KeyAVX2
+};
+#endif /* HAVE_AVX2_INTRINSICS */
+
 static const SDL_BlitFunc one_blit[] = {
     (SDL_BlitFunc) NULL, Blit1to1, Blit1to2, Blit1to3, Blit1to4
 };
@@ -534,9 +731,19 @@ SDL_CalculateBlit1(SDL_Surface * surface)
     }
     switch (surface->map->info.flags & ~SDL_COPY_RLE_MASK) {
     case 0:
+#if HAVE_AVX2_INTRINSICS
+        if (one_blit_avx2[which] && SDL_HasAVX2()) {
+            return one_blit_avx2[which];
+        }
+#endif
         return one_blit[which];
 
     case SDL_COPY_COLORKEY:
+#if HAVE_AVX2_INTRINSICS
+        if (one_blitkey_avx2[which] && SDL_HasAVX2()) {
+            return one_blitkey_avx2[which];
+        }
+#endif
         return one_blitkey[which];
 
     case SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
@@ -575,6 +575,51 @@ BlitRGBtoRGBPixelAlpha(SDL_BlitInfo * info)
     }
 }
 
+/* fast ARGB888->(A)RGB888 blending with premultiplied pixel alpha */
+static void
+BlitRGBtoRGBPremultipliedPixelAlpha(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    Uint32 ashift = info->src_fmt->Ashift;
+
+    while (height--) {
+        /* *INDENT-OFF* */
+        DUFFS_LOOP4({
+        Uint32 s = *srcp;
+        Uint32 alpha = (s >> ashift) & 0xFF;
+        if (alpha == SDL_ALPHA_OPAQUE) {
+            *dstp = s;
+        } else if (s) {
+            /*
+             * dst * (255 - alpha) / 255 on two channels at a time,
+             * then a saturating add of the source
+             */
+            Uint32 d = *dstp;
+            Uint32 inva = 0xFF - alpha;
+            Uint32 d1 = (d & 0xff00ff) * inva;
+            Uint32 d2 = ((d >> 8) & 0xff00ff) * inva;
+            d1 = ((d1 + 0x10001 + ((d1 >> 8) & 0xff00ff)) >> 8) & 0xff00ff;
+            d2 = ((d2 + 0x10001 + ((d2 >> 8) & 0xff00ff)) >> 8) & 0xff00ff;
+            d1 += s & 0xff00ff;
+            d2 += (s >> 8) & 0xff00ff;
+            d1 = (d1 | ((d1 & 0x1000100) - ((d1 & 0x1000100) >> 8))) & 0xff00ff;
+            d2 = (d2 | ((d2 & 0x1000100) - ((d2 & 0x1000100) >> 8))) & 0xff00ff;
+            *dstp = d1 | (d2 << 8);
+        }
+        ++srcp;
+        ++dstp;
+        }, width);
+        /* *INDENT-ON* */
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
 #ifdef __3dNOW__
 /* fast (as in MMX with prefetch) ARGB888->(A)RGB888 blending with pixel alpha */
 static void
@@ -1037,6 +1082,742 @@ Blit555to555SurfaceAlphaMMX(SDL_BlitInfo * info)
 
 #endif /* __MMX__ */
 
+#if HAVE_SSE2_INTRINSICS || HAVE_AVX2_INTRINSICS
+/* The SSE2 and AVX2 blenders below do the same arithmetic as the MMX ones,
+   on 4 or 8 pixels (8 or 16 for 16bpp) at a time. The last pixels of a row
+   go through a small buffer, so every pixel gets the same result. */
+#define SIMD_TAIL_BEGIN(type, count)                                     \
+    type srcbuf[count], dstbuf[count];                                   \
+    SDL_memcpy(srcbuf, srcp, n * sizeof (type));                         \
+    SDL_memcpy(dstbuf, dstp, n * sizeof (type));
+#define SIMD_TAIL_END(type)                                              \
+    SDL_memcpy(dstp, dstbuf, n * sizeof (type));                         \
+    srcp += n;                                                           \
+    dstp += n;
+#endif
+
+#if HAVE_SSE2_INTRINSICS
+
+/* Blend four ARGB888 pixels with their own alpha, keeping fully transparent
+   and fully opaque pixels exact */
+SDL_FORCE_INLINE __m128i
+BlendPixelAlphaSSE2(__m128i src, __m128i dst, __m128i amask, __m128i amask16, __m128i ashift)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alpha = _mm_and_si128(src, amask);
+    const __m128i transparent = _mm_cmpeq_epi32(alpha, zero);
+    const __m128i opaque = _mm_cmpeq_epi32(alpha, amask);
+    __m128i a = _mm_srl_epi32(alpha, ashift);       /* 000A per pixel */
+    __m128i alo, ahi, slo, shi, dlo, dhi, res;
+
+    a = _mm_or_si128(a, _mm_slli_epi32(a, 16));     /* 0A0A per pixel */
+    alo = _mm_unpacklo_epi32(a, a);                 /* 0A0A0A0A for pixels 0 and 1 */
+    ahi = _mm_unpackhi_epi32(a, a);                 /* 0A0A0A0A for pixels 2 and 3 */
+
+    slo = _mm_unpacklo_epi8(src, zero);
+    shi = _mm_unpackhi_epi8(src, zero);
+    dlo = _mm_unpacklo_epi8(dst, zero);
+    dhi = _mm_unpackhi_epi8(dst, zero);
+
+    /* src * A (255 for the alpha channel) + dst * (255 - A), each >> 8 */
+    slo = _mm_srli_epi16(_mm_mullo_epi16(slo, _mm_or_si128(alo, amask16)), 8);
+    shi = _mm_srli_epi16(_mm_mullo_epi16(shi, _mm_or_si128(ahi, amask16)), 8);
+    dlo = _mm_srli_epi16(_mm_mullo_epi16(dlo, _mm_xor_si128(alo, _mm_set1_epi16(0xFF))), 8);
+    dhi = _mm_srli_epi16(_mm_mullo_epi16(dhi, _mm_xor_si128(ahi, _mm_set1_epi16(0xFF))), 8);
+    res = _mm_packus_epi16(_mm_add_epi16(slo, dlo), _mm_add_epi16(shi, dhi));
+
+    res = _mm_or_si128(_mm_and_si128(opaque, src), _mm_andnot_si128(opaque, res));
+    return _mm_or_si128(_mm_and_si128(transparent, dst), _mm_andnot_si128(transparent, res));
+}
+
+/* fast ARGB888->(A)RGB888 blending with pixel alpha */
+static void
+BlitRGBtoRGBPixelAlphaSSE2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    SDL_PixelFormat *sf = info->src_fmt;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i amask = _mm_set1_epi32(sf->Amask);
+    const __m128i amask16 = _mm_unpacklo_epi8(amask, zero);
+    const __m128i ashift = _mm_cvtsi32_si128(sf->Ashift);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 4; n -= 4, srcp += 4, dstp += 4) {
+            const __m128i src = _mm_loadu_si128((const __m128i *) srcp);
+            const __m128i alpha = _mm_and_si128(src, amask);
+
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero)) == 0xFFFF) {
+                /* fully transparent, nothing to do */
+            } else if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, amask)) == 0xFFFF) {
+                _mm_storeu_si128((__m128i *) dstp, src);
+            } else {
+                const __m128i dst = _mm_loadu_si128((const __m128i *) dstp);
+                _mm_storeu_si128((__m128i *) dstp,
+                                 BlendPixelAlphaSSE2(src, dst, amask, amask16, ashift));
+            }
+        }
+        if (n) {
+            SIMD_TAIL_BEGIN(Uint32, 4);
+            _mm_storeu_si128((__m128i *) dstbuf,
+                             BlendPixelAlphaSSE2(_mm_loadu_si128((const __m128i *) srcbuf),
+                                                 _mm_loadu_si128((const __m128i *) dstbuf),
+                                                 amask, amask16, ashift));
+            SIMD_TAIL_END(Uint32);
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+/* Blend four ARGB888 pixels with premultiplied alpha:
+   src + dst * (255 - srcA) / 255 on every channel */
+SDL_FORCE_INLINE __m128i
+BlendPremultipliedSSE2(__m128i src, __m128i dst, __m128i ashift)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i x255 = _mm_set1_epi16(0xFF);
+    __m128i a = _mm_and_si128(_mm_srl_epi32(src, ashift), _mm_set1_epi32(0xFF));
+    __m128i alo, ahi, dlo, dhi;
+
+    a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+    alo = _mm_xor_si128(_mm_unpacklo_epi32(a, a), x255);  /* 255 - A for pixels 0 and 1 */
+    ahi = _mm_xor_si128(_mm_unpackhi_epi32(a, a), x255);  /* 255 - A for pixels 2 and 3 */
+
+    dlo = _mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), alo);
+    dhi = _mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), ahi);
+    /* x / 255, truncated, is (x + 1 + (x >> 8)) >> 8 for x up to 255 * 255 */
+    dlo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(dlo, _mm_set1_epi16(1)), _mm_srli_epi16(dlo, 8)), 8);
+    dhi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(dhi, _mm_set1_epi16(1)), _mm_srli_epi16(dhi, 8)), 8);
+    return _mm_adds_epu8(src, _mm_packus_epi16(dlo, dhi));
+}
+
+/* fast ARGB888->(A)RGB888 blending with premultiplied pixel alpha */
+static void
+BlitRGBtoRGBPremultipliedPixelAlphaSSE2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    SDL_PixelFormat *sf = info->src_fmt;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i amask = _mm_set1_epi32(sf->Amask);
+    const __m128i ashift = _mm_cvtsi32_si128(sf->Ashift);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 4; n -= 4, srcp += 4, dstp += 4) {
+            const __m128i src = _mm_loadu_si128((const __m128i *) srcp);
+
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(src, zero)) == 0xFFFF) {
+                /* fully transparent, nothing to do */
+            } else if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(src, amask), amask)) == 0xFFFF) {
+                _mm_storeu_si128((__m128i *) dstp, src);
+            } else {
+                const __m128i dst = _mm_loadu_si128((const __m128i *) dstp);
+                _mm_storeu_si128((__m128i *) dstp, BlendPremultipliedSSE2(src, dst, ashift));
+            }
+        }
+        if (n) {
+            SIMD_TAIL_BEGIN(Uint32, 4);
+            _mm_storeu_si128((__m128i *) dstbuf,
+                             BlendPremultipliedSSE2(_mm_loadu_si128((const __m128i *) srcbuf),
+                                                    _mm_loadu_si128((const __m128i *) dstbuf),
+                                                    ashift));
+            SIMD_TAIL_END(Uint32);
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+/* Blend four RGB888 pixels with the surface alpha, in mm_alpha on every
+   color channel and 0 on the remaining one */
+SDL_FORCE_INLINE __m128i
+BlendSurfaceAlphaSSE2(__m128i src, __m128i dst, __m128i mm_alpha, __m128i dsta)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i slo = _mm_unpacklo_epi8(src, zero);
+    __m128i shi = _mm_unpackhi_epi8(src, zero);
+    __m128i dlo = _mm_unpacklo_epi8(dst, zero);
+    __m128i dhi = _mm_unpackhi_epi8(dst, zero);
+
+    /* dst + (src - dst) * alpha >> 8 */
+    slo = _mm_srli_epi16(_mm_mullo_epi16(_mm_sub_epi16(slo, dlo), mm_alpha), 8);
+    shi = _mm_srli_epi16(_mm_mullo_epi16(_mm_sub_epi16(shi, dhi), mm_alpha), 8);
+    dlo = _mm_add_epi8(slo, dlo);
+    dhi = _mm_add_epi8(shi, dhi);
+    return _mm_or_si128(_mm_packus_epi16(dlo, dhi), dsta);
+}
+
+/* Blend four RGB888 pixels at 50% */
+SDL_FORCE_INLINE __m128i
+BlendSurfaceAlpha128SSE2(__m128i src, __m128i dst, __m128i hmask, __m128i lmask, __m128i dsta)
+{
+    __m128i res = _mm_add_epi32(_mm_and_si128(src, hmask), _mm_and_si128(dst, hmask));
+    res = _mm_add_epi32(_mm_srli_epi32(res, 1), _mm_and_si128(_mm_and_si128(src, dst), lmask));
+    return _mm_or_si128(res, dsta);
+}
+
+/* fast RGB888->(A)RGB888 blending with surface alpha */
+static void
+BlitRGBtoRGBSurfaceAlphaSSE2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    SDL_PixelFormat *df = info->dst_fmt;
+    unsigned alpha = info->a;
+    const __m128i dsta = _mm_set1_epi32(df->Amask);
+
+    if (alpha == 128 && (df->Rmask | df->Gmask | df->Bmask) == 0x00FFFFFF) {
+        /* only use the a128 version when R,G,B occupy lower bits */
+        const __m128i hmask = _mm_set1_epi32(0x00fefefe);
+        const __m128i lmask = _mm_set1_epi32(0x00010101);
+
+        while (height--) {
+            int n = width;
+
+            for (; n >= 4; n -= 4, srcp += 4, dstp += 4) {
+                const __m128i src = _mm_loadu_si128((const __m128i *) srcp);
+                const __m128i dst = _mm_loadu_si128((const __m128i *) dstp);
+                _mm_storeu_si128((__m128i *) dstp,
+                                 BlendSurfaceAlpha128SSE2(src, dst, hmask, lmask, dsta));
+            }
+            if (n) {
+                SIMD_TAIL_BEGIN(Uint32, 4);
+                _mm_storeu_si128((__m128i *) dstbuf,
+                                 BlendSurfaceAlpha128SSE2(_mm_loadu_si128((const __m128i *) srcbuf),
+                                                          _mm_loadu_si128((const __m128i *) dstbuf),
+                                                          hmask, lmask, dsta));
+                SIMD_TAIL_END(Uint32);
+            }
+            srcp += srcskip;
+            dstp += dstskip;
+        }
+    } else {
+        Uint32 amult = alpha | (alpha << 8);
+        Uint32 chanmask = (0xff << df->Rshift) | (0xff << df->Gshift) | (0xff << df->Bshift);
+        __m128i mm_alpha;
+
+        amult = amult | (amult << 16);
+        mm_alpha = _mm_unpacklo_epi8(_mm_set1_epi32(amult & chanmask), _mm_setzero_si128());
+
+        while (height--) {
+            int n = width;
+
+            for (; n >= 4; n -= 4, srcp += 4, dstp += 4) {
+                const __m128i src = _mm_loadu_si128((const __m128i *) srcp);
+                const __m128i dst = _mm_loadu_si128((const __m128i *) dstp);
+                _mm_storeu_si128((__m128i *) dstp,
+                                 BlendSurfaceAlphaSSE2(src, dst, mm_alpha, dsta));
+            }
+            if (n) {
+                SIMD_TAIL_BEGIN(Uint32, 4);
+                _mm_storeu_si128((__m128i *) dstbuf,
+                                 BlendSurfaceAlphaSSE2(_mm_loadu_si128((const __m128i *) srcbuf),
+                                                       _mm_loadu_si128((const __m128i *) dstbuf),
+                                                       mm_alpha, dsta));
+                SIMD_TAIL_END(Uint32);
+            }
+            srcp += srcskip;
+            dstp += dstskip;
+        }
+    }
+}
+
+/* Blend eight RGB565 pixels, mm_alpha is the 5-bit alpha << 6 */
+SDL_FORCE_INLINE __m128i
+Blend565SurfaceAlphaSSE2(__m128i src, __m128i dst, __m128i mm_alpha)
+{
+    const __m128i gmask = _mm_set1_epi16(0x07E0);
+    const __m128i bmask = _mm_set1_epi16(0x001F);
+    __m128i s, d, res;
+
+    /* red */
+    s = _mm_srli_epi16(src, 11);
+    d = _mm_srli_epi16(dst, 11);
+    s = _mm_srli_epi16(_mm_mullo_epi16(_mm_sub_epi16(s, d), mm_alpha), 11);
+    res = _mm_slli_epi16(_mm_add_epi16(s, d), 11);
+
+    /* green -- process the bits in place */
+    s = _mm_and_si128(src, gmask);
+    d = _mm_and_si128(dst, gmask);
+    s = _mm_slli_epi16(_mm_mulhi_epi16(_mm_sub_epi16(s, d), mm_alpha), 5);
+    res = _mm_or_si128(res, _mm_add_epi16(s, d));
+
+    /* blue */
+    s = _mm_and_si128(src, bmask);
+    d = _mm_and_si128(dst, bmask);
+    s = _mm_srli_epi16(_mm_mullo_epi16(_mm_sub_epi16(s, d), mm_alpha), 11);
+    return _mm_or_si128(res, _mm_and_si128(_mm_add_epi16(s, d), bmask));
+}
+
+/* Blend eight RGB555 pixels, mm_alpha is the 5-bit alpha << 6 */
+SDL_FORCE_INLINE __m128i
+Blend555SurfaceAlphaSSE2(__m128i src, __m128i dst, __m128i mm_alpha)
+{
+    const __m128i rmask = _mm_set1_epi16(0x7C00);
+    const __m128i gmask = _mm_set1_epi16(0x03E0);
+    const __m128i bmask = _mm_set1_epi16(0x001F);
+    __m128i s, d, res;
+
+    /* red -- process the bits in place */
+    s = _mm_and_si128(src, rmask);
+    d = _mm_and_si128(dst, rmask);
+    s = _mm_slli_epi16(_mm_mulhi_epi16(_mm_sub_epi16(s, d), mm_alpha), 5);
+    res = _mm_and_si128(_mm_add_epi16(s, d), rmask);
+
+    /* green -- process the bits in place */
+    s = _mm_and_si128(src, gmask);
+    d = _mm_and_si128(dst, gmask);
+    s = _mm_slli_epi16(_mm_mulhi_epi16(_mm_sub_epi16(s, d), mm_alpha), 5);
+    res = _mm_or_si128(res, _mm_add_epi16(s, d));
+
+    /* blue */
+    s = _mm_and_si128(src, bmask);
+    d = _mm_and_si128(dst, bmask);
+    s = _mm_srli_epi16(_mm_mullo_epi16(_mm_sub_epi16(s, d), mm_alpha), 11);
+    return _mm_or_si128(res, _mm_and_si128(_mm_add_epi16(s, d), bmask));
+}
+
+/* fast RGB565->RGB565 and RGB555->RGB555 blending with surface alpha */
+static void
+Blit16to16SurfaceAlphaSSE2(SDL_BlitInfo * info, SDL_bool is565)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint16 *srcp = (Uint16 *) info->src;
+    int srcskip = info->src_skip >> 1;
+    Uint16 *dstp = (Uint16 *) info->dst;
+    int dstskip = info->dst_skip >> 1;
+    /* cut alpha to 5 bits to get the exact same behaviour */
+    const __m128i mm_alpha = _mm_set1_epi16((short) ((info->a & ~(1 + 2 + 4)) << 3));
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 8; n -= 8, srcp += 8, dstp += 8) {
+            const __m128i src = _mm_loadu_si128((const __m128i *) srcp);
+            const __m128i dst = _mm_loadu_si128((const __m128i *) dstp);
+            _mm_storeu_si128((__m128i *) dstp, is565 ?
+                             Blend565SurfaceAlphaSSE2(src, dst, mm_alpha) :
+                             Blend555SurfaceAlphaSSE2(src, dst, mm_alpha));
+        }
+        if (n) {
+            SIMD_TAIL_BEGIN(Uint16, 8);
+            {
+                const __m128i src = _mm_loadu_si128((const __m128i *) srcbuf);
+                const __m128i dst = _mm_loadu_si128((const __m128i *) dstbuf);
+                _mm_storeu_si128((__m128i *) dstbuf, is565 ?
+                                 Blend565SurfaceAlphaSSE2(src, dst, mm_alpha) :
+                                 Blend555SurfaceAlphaSSE2(src, dst, mm_alpha));
+            }
+            SIMD_TAIL_END(Uint16);
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+/* fast RGB565->RGB565 blending with surface alpha */
+static void
+Blit565to565SurfaceAlphaSSE2(SDL_BlitInfo * info)
+{
+    if (info->a == 128) {
+        Blit16to16SurfaceAlpha128(info, 0xf7de);
+    } else {
+        Blit16to16SurfaceAlphaSSE2(info, SDL_TRUE);
+    }
+}
+
+/* fast RGB555->RGB555 blending with surface alpha */
+static void
+Blit555to555SurfaceAlphaSSE2(SDL_BlitInfo * info)
+{
+    if (info->a == 128) {
+        Blit16to16SurfaceAlpha128(info, 0xfbde);
+    } else {
+        Blit16to16SurfaceAlphaSSE2(info, SDL_FALSE);
+    }
+}
+
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_AVX2_INTRINSICS
+
+/* Blend eight ARGB888 pixels with their own alpha, keeping fully transparent
+   and fully opaque pixels exact */
+SDL_TARGETING("avx2") SDL_FORCE_INLINE __m256i
+BlendPixelAlphaAVX2(__m256i src, __m256i dst, __m256i amask, __m256i amask16, __m128i ashift)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i alpha = _mm256_and_si256(src, amask);
+    const __m256i transparent = _mm256_cmpeq_epi32(alpha, zero);
+    const __m256i opaque = _mm256_cmpeq_epi32(alpha, amask);
+    __m256i a = _mm256_srl_epi32(alpha, ashift);       /* 000A per pixel */
+    __m256i alo, ahi, slo, shi, dlo, dhi, res;
+
+    a = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));     /* 0A0A per pixel */
+    alo = _mm256_unpacklo_epi32(a, a);                 /* 0A0A0A0A for pixels 0, 1, 4 and 5 */
+    ahi = _mm256_unpackhi_epi32(a, a);                 /* 0A0A0A0A for pixels 2, 3, 6 and 7 */
+
+    slo = _mm256_unpacklo_epi8(src, zero);
+    shi = _mm256_unpackhi_epi8(src, zero);
+    dlo = _mm256_unpacklo_epi8(dst, zero);
+    dhi = _mm256_unpackhi_epi8(dst, zero);
+
+    /* src * A (255 for the alpha channel) + dst * (255 - A), each >> 8 */
+    slo = _mm256_srli_epi16(_mm256_mullo_epi16(slo, _mm256_or_si256(alo, amask16)), 8);
+    shi = _mm256_srli_epi16(_mm256_mullo_epi16(shi, _mm256_or_si256(ahi, amask16)), 8);
+    dlo = _mm256_srli_epi16(_mm256_mullo_epi16(dlo, _mm256_xor_si256(alo, _mm256_set1_epi16(0xFF))), 8);
+    dhi = _mm256_srli_epi16(_mm256_mullo_epi16(dhi, _mm256_xor_si256(ahi, _mm256_set1_epi16(0xFF))), 8);
+    res = _mm256_packus_epi16(_mm256_add_epi16(slo, dlo), _mm256_add_epi16(shi, dhi));
+
+    res = _mm256_or_si256(_mm256_and_si256(opaque, src), _mm256_andnot_si256(opaque, res));
+    return _mm256_or_si256(_mm256_and_si256(transparent, dst), _mm256_andnot_si256(transparent, res));
+}
+
+/* fast ARGB888->(A)RGB888 blending with pixel alpha */
+SDL_TARGETING("avx2") static void
+BlitRGBtoRGBPixelAlphaAVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    SDL_PixelFormat *sf = info->src_fmt;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i amask = _mm256_set1_epi32(sf->Amask);
+    const __m256i amask16 = _mm256_unpacklo_epi8(amask, zero);
+    const __m128i ashift = _mm_cvtsi32_si128(sf->Ashift);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 8; n -= 8, srcp += 8, dstp += 8) {
+            const __m256i src = _mm256_loadu_si256((const __m256i *) srcp);
+            const __m256i alpha = _mm256_and_si256(src, amask);
+
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(alpha, zero)) == -1) {
+                /* fully transparent, nothing to do */
+            } else if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(alpha, amask)) == -1) {
+                _mm256_storeu_si256((__m256i *) dstp, src);
+            } else {
+                const __m256i dst = _mm256_loadu_si256((const __m256i *) dstp);
+                _mm256_storeu_si256((__m256i *) dstp,
+                                 BlendPixelAlphaAVX2(src, dst, amask, amask16, ashift));
+            }
+        }
+        if (n) {
+            SIMD_TAIL_BEGIN(Uint32, 8);
+            _mm256_storeu_si256((__m256i *) dstbuf,
+                             BlendPixelAlphaAVX2(_mm256_loadu_si256((const __m256i *) srcbuf),
+                                                 _mm256_loadu_si256((const __m256i *) dstbuf),
+                                                 amask, amask16, ashift));
+            SIMD_TAIL_END(Uint32);
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+/* Blend eight ARGB888 pixels with premultiplied alpha:
+   src + dst * (255 - srcA) / 255 on every channel */
+SDL_TARGETING("avx2") SDL_FORCE_INLINE __m256i
+BlendPremultipliedAVX2(__m256i src, __m256i dst, __m128i ashift)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i x255 = _mm256_set1_epi16(0xFF);
+    __m256i a = _mm256_and_si256(_mm256_srl_epi32(src, ashift), _mm256_set1_epi32(0xFF));
+    __m256i alo, ahi, dlo, dhi;
+
+    a = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+    alo = _mm256_xor_si256(_mm256_unpacklo_epi32(a, a), x255);  /* 255 - A for pixels 0, 1, 4 and 5 */
+    ahi = _mm256_xor_si256(_mm256_unpackhi_epi32(a, a), x255);  /* 255 - A for pixels 2, 3, 6 and 7 */
+
+    dlo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(dst, zero), alo);
+    dhi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(dst, zero), ahi);
+    /* x / 255, truncated, is (x + 1 + (x >> 8)) >> 8 for x up to 255 * 255 */
+    dlo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(dlo, _mm256_set1_epi16(1)), _mm256_srli_epi16(dlo, 8)), 8);
+    dhi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(dhi, _mm256_set1_epi16(1)), _mm256_srli_epi16(dhi, 8)), 8);
+    return _mm256_adds_epu8(src, _mm256_packus_epi16(dlo, dhi));
+}
+
+/* fast ARGB888->(A)RGB888 blending with premultiplied pixel alpha */
+SDL_TARGETING("avx2") static void
+BlitRGBtoRGBPremultipliedPixelAlphaAVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    SDL_PixelFormat *sf = info->src_fmt;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i amask = _mm256_set1_epi32(sf->Amask);
+    const __m128i ashift = _mm_cvtsi32_si128(sf->Ashift);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 8; n -= 8, srcp += 8, dstp += 8) {
+            const __m256i src = _mm256_loadu_si256((const __m256i *) srcp);
+
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(src, zero)) == -1) {
+                /* fully transparent, nothing to do */
+            } else if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(src, amask), amask)) == -1) {
+                _mm256_storeu_si256((__m256i *) dstp, src);
+            } else {
+                const __m256i dst = _mm256_loadu_si256((const __m256i *) dstp);
+                _mm256_storeu_si256((__m256i *) dstp, BlendPremultipliedAVX2(src, dst, ashift));
+            }
+        }
+        if (n) {
+            SIMD_TAIL_BEGIN(Uint32, 8);
+            _mm256_storeu_si256((__m256i *) dstbuf,
+                                BlendPremultipliedAVX2(_mm256_loadu_si256((const __m256i *) srcbuf),
+                                                       _mm256_loadu_si256((const __m256i *) dstbuf),
+                                                       ashift));
+            SIMD_TAIL_END(Uint32);
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+/* Blend eight RGB888 pixels with the surface alpha, in mm_alpha on every
+   color channel and 0 on the remaining one */
+SDL_TARGETING("avx2") SDL_FORCE_INLINE __m256i
+BlendSurfaceAlphaAVX2(__m256i src, __m256i dst, __m256i mm_alpha, __m256i dsta)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i slo = _mm256_unpacklo_epi8(src, zero);
+    __m256i shi = _mm256_unpackhi_epi8(src, zero);
+    __m256i dlo = _mm256_unpacklo_epi8(dst, zero);
+    __m256i dhi = _mm256_unpackhi_epi8(dst, zero);
+
+    /* dst + (src - dst) * alpha >> 8 */
+    slo = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(slo, dlo), mm_alpha), 8);
+    shi = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(shi, dhi), mm_alpha), 8);
+    dlo = _mm256_add_epi8(slo, dlo);
+    dhi = _mm256_add_epi8(shi, dhi);
+    return _mm256_or_si256(_mm256_packus_epi16(dlo, dhi), dsta);
+}
+
+/* Blend eight RGB888 pixels at 50% */
+SDL_TARGETING("avx2") SDL_FORCE_INLINE __m256i
+BlendSurfaceAlpha128AVX2(__m256i src, __m256i dst, __m256i hmask, __m256i lmask, __m256i dsta)
+{
+    __m256i res = _mm256_add_epi32(_mm256_and_si256(src, hmask), _mm256_and_si256(dst, hmask));
+    res = _mm256_add_epi32(_mm256_srli_epi32(res, 1), _mm256_and_si256(_mm256_and_si256(src, dst), lmask));
+    return _mm256_or_si256(res, dsta);
+}
+
+/* fast RGB888->(A)RGB888 blending with surface alpha */
+SDL_TARGETING("avx2") static void
+BlitRGBtoRGBSurfaceAlphaAVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    SDL_PixelFormat *df = info->dst_fmt;
+    unsigned alpha = info->a;
+    const __m256i dsta = _mm256_set1_epi32(df->Amask);
+
+    if (alpha == 128 && (df->Rmask | df->Gmask | df->Bmask) == 0x00FFFFFF) {
+        /* only use the a128 version when R,G,B occupy lower bits */
+        const __m256i hmask = _mm256_set1_epi32(0x00fefefe);
+        const __m256i lmask = _mm256_set1_epi32(0x00010101);
+
+        while (height--) {
+            int n = width;
+
+            for (; n >= 8; n -= 8, srcp += 8, dstp += 8) {
+                const __m256i src = _mm256_loadu_si256((const __m256i *) srcp);
+                const __m256i dst = _mm256_loadu_si256((const __m256i *) dstp);
+                _mm256_storeu_si256((__m256i *) dstp,
+                                 BlendSurfaceAlpha128AVX2(src, dst, hmask, lmask, dsta));
+            }
+            if (n) {
+                SIMD_TAIL_BEGIN(Uint32, 8);
+                _mm256_storeu_si256((__m256i *) dstbuf,
+                                 BlendSurfaceAlpha128AVX2(_mm256_loadu_si256((const __m256i *) srcbuf),
+                                                          _mm256_loadu_si256((const __m256i *) dstbuf),
+                                                          hmask, lmask, dsta));
+                SIMD_TAIL_END(Uint32);
+            }
+            srcp += srcskip;
+            dstp += dstskip;
+        }
+    } else {
+        Uint32 amult = alpha | (alpha << 8);
+        Uint32 chanmask = (0xff << df->Rshift) | (0xff << df->Gshift) | (0xff << df->Bshift);
+        __m256i mm_alpha;
+
+        amult = amult | (amult << 16);
+        mm_alpha = _mm256_unpacklo_epi8(_mm256_set1_epi32(amult & chanmask), _mm256_setzero_si256());
+
+        while (height--) {
+            int n = width;
+
+            for (; n >= 8; n -= 8, srcp += 8, dstp += 8) {
+                const __m256i src = _mm256_loadu_si256((const __m256i *) srcp);
+                const __m256i dst = _mm256_loadu_si256((const __m256i *) dstp);
+                _mm256_storeu_si256((__m256i *) dstp,
+                                 BlendSurfaceAlphaAVX2(src, dst, mm_alpha, dsta));
+            }
+            if (n) {
+                SIMD_TAIL_BEGIN(Uint32, 8);
+                _mm256_storeu_si256((__m256i *) dstbuf,
+                                 BlendSurfaceAlphaAVX2(_mm256_loadu_si256((const __m256i *) srcbuf),
+                                                       _mm256_loadu_si256((const __m256i *) dstbuf),
+                                                       mm_alpha, dsta));
+                SIMD_TAIL_END(Uint32);
+            }
+            srcp += srcskip;
+            dstp += dstskip;
+        }
+    }
+}
+
+/* Blend sixteen RGB565 pixels, mm_alpha is the 5-bit alpha << 6 */
+SDL_TARGETING("avx2") SDL_FORCE_INLINE __m256i
+Blend565SurfaceAlphaAVX2(__m256i src, __m256i dst, __m256i mm_alpha)
+{
+    const __m256i gmask = _mm256_set1_epi16(0x07E0);
+    const __m256i bmask = _mm256_set1_epi16(0x001F);
+    __m256i s, d, res;
+
+    /* red */
+    s = _mm256_srli_epi16(src, 11);
+    d = _mm256_srli_epi16(dst, 11);
+    s = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(s, d), mm_alpha), 11);
+    res = _mm256_slli_epi16(_mm256_add_epi16(s, d), 11);
+
+    /* green -- process the bits in place */
+    s = _mm256_and_si256(src, gmask);
+    d = _mm256_and_si256(dst, gmask);
+    s = _mm256_slli_epi16(_mm256_mulhi_epi16(_mm256_sub_epi16(s, d), mm_alpha), 5);
+    res = _mm256_or_si256(res, _mm256_add_epi16(s, d));
+
+    /* blue */
+    s = _mm256_and_si256(src, bmask);
+    d = _mm256_and_si256(dst, bmask);
+    s = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(s, d), mm_alpha), 11);
+    return _mm256_or_si256(res, _mm256_and_si256(_mm256_add_epi16(s, d), bmask));
+}
+
+/* Blend sixteen RGB555 pixels, mm_alpha is the 5-bit alpha << 6 */
+SDL_TARGETING("avx2") SDL_FORCE_INLINE __m256i
+Blend555SurfaceAlphaAVX2(__m256i src, __m256i dst, __m256i mm_alpha)
+{
+    const __m256i rmask = _mm256_set1_epi16(0x7C00);
+    const __m256i gmask = _mm256_set1_epi16(0x03E0);
+    const __m256i bmask = _mm256_set1_epi16(0x001F);
+    __m256i s, d, res;
+
+    /* red -- process the bits in place */
+    s = _mm256_and_si256(src, rmask);
+    d = _mm256_and_si256(dst, rmask);
+    s = _mm256_slli_epi16(_mm256_mulhi_epi16(_mm256_sub_epi16(s, d), mm_alpha), 5);
+    res = _mm256_and_si256(_mm256_add_epi16(s, d), rmask);
+
+    /* green -- process the bits in place */
+    s = _mm256_and_si256(src, gmask);
+    d = _mm256_and_si256(dst, gmask);
+    s = _mm256_slli_epi16(_mm256_mulhi_epi16(_mm256_sub_epi16(s, d), mm_alpha), 5);
+    res = _mm256_or_si256(res, _mm256_add_epi16(s, d));
+
+    /* blue */
+    s = _mm256_and_si256(src, bmask);
+    d = _mm256_and_si256(dst, bmask);
+    s = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(s, d), mm_alpha), 11);
+    return _mm256_or_si256(res, _mm256_and_si256(_mm256_add_epi16(s, d), bmask));
+}
+
+/* fast RGB565->RGB565 and RGB555->RGB555 blending with surface alpha */
+SDL_TARGETING("avx2") static void
+Blit16to16SurfaceAlphaAVX2(SDL_BlitInfo * info, SDL_bool is565)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint16 *srcp = (Uint16 *) info->src;
+    int srcskip = info->src_skip >> 1;
+    Uint16 *dstp = (Uint16 *) info->dst;
+    int dstskip = info->dst_skip >> 1;
+    /* cut alpha to 5 bits to get the exact same behaviour */
+    const __m256i mm_alpha = _mm256_set1_epi16((short) ((info->a & ~(1 + 2 + 4)) << 3));
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 16; n -= 16, srcp += 16, dstp += 16) {
+            const __m256i src = _mm256_loadu_si256((const __m256i *) srcp);
+            const __m256i dst = _mm256_loadu_si256((const __m256i *) dstp);
+            _mm256_storeu_si256((__m256i *) dstp, is565 ?
+                             Blend565SurfaceAlphaAVX2(src, dst, mm_alpha) :
+                             Blend555SurfaceAlphaAVX2(src, dst, mm_alpha));
+        }
+        if (n) {
+            SIMD_TAIL_BEGIN(Uint16, 16);
+            {
+                const __m256i src = _mm256_loadu_si256((const __m256i *) srcbuf);
+                const __m256i dst = _mm256_loadu_si256((const __m256i *) dstbuf);
+                _mm256_storeu_si256((__m256i *) dstbuf, is565 ?
+                                 Blend565SurfaceAlphaAVX2(src, dst, mm_alpha) :
+                                 Blend555SurfaceAlphaAVX2(src, dst, mm_alpha));
+            }
+            SIMD_TAIL_END(Uint16);
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+/* fast RGB565->RGB565 blending with surface alpha */
+SDL_TARGETING("avx2") static void
+Blit565to565SurfaceAlphaAVX2(SDL_BlitInfo * info)
+{
+    if (info->a == 128) {
+        Blit16to16SurfaceAlpha128(info, 0xf7de);
+    } else {
+        Blit16to16SurfaceAlphaAVX2(info, SDL_TRUE);
+    }
+}
+
+/* fast RGB555->RGB555 blending with surface alpha */
+SDL_TARGETING("avx2") static void
+Blit555to555SurfaceAlphaAVX2(SDL_BlitInfo * info)
+{
+    if (info->a == 128) {
+        Blit16to16SurfaceAlpha128(info, 0xfbde);
+    } else {
+        Blit16to16SurfaceAlphaAVX2(info, SDL_FALSE);
+    }
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
 /* fast RGB565->RGB565 blending with surface alpha */
 static void
 Blit565to565SurfaceAlpha(SDL_BlitInfo * info)
@@ -1381,11 +2162,19 @@ SDL_CalculateBlitA(SDL_Surface * surface)
             if (sf->Rmask == df->Rmask
                 && sf->Gmask == df->Gmask
                 && sf->Bmask == df->Bmask && sf->BytesPerPixel == 4) {
-#if defined(__MMX__) || defined(__3dNOW__)
+#if defined(__MMX__) || defined(__3dNOW__) || HAVE_SSE2_INTRINSICS || HAVE_AVX2_INTRINSICS
                 if (sf->Rshift % 8 == 0
                     && sf->Gshift % 8 == 0
                     && sf->Bshift % 8 == 0
                     && sf->Ashift % 8 == 0 && sf->Aloss == 0) {
+#if HAVE_AVX2_INTRINSICS
+                    if (SDL_HasAVX2())
+                        return BlitRGBtoRGBPixelAlphaAVX2;
+#endif
+#if HAVE_SSE2_INTRINSICS
+                    if (SDL_HasSSE2())
+                        return BlitRGBtoRGBPixelAlphaSSE2;
+#endif
 #ifdef __3dNOW__
                     if (SDL_Has3DNow())
                         return BlitRGBtoRGBPixelAlphaMMX3DNOW;
@@ -1395,7 +2184,7 @@ SDL_CalculateBlitA(SDL_Surface * surface)
                         return BlitRGBtoRGBPixelAlphaMMX;
 #endif
                 }
-#endif /* __MMX__ || __3dNOW__ */
+#endif /* __MMX__ || __3dNOW__ || SSE2 || AVX2 */
                 if (sf->Amask == 0xff000000) {
 #if SDL_ARM_NEON_BLITTERS
                     if (SDL_HasNEON())
@@ -1416,6 +2205,28 @@ SDL_CalculateBlitA(SDL_Surface * surface)
         }
         return BlitNtoNPixelAlpha;
 
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        /* Per-pixel alpha blits of premultiplied colors */
+        if (df->BytesPerPixel == 4 && sf->BytesPerPixel == 4
+            && sf->Rmask == df->Rmask
+            && sf->Gmask == df->Gmask
+            && sf->Bmask == df->Bmask
+            && sf->Rshift % 8 == 0
+            && sf->Gshift % 8 == 0
+            && sf->Bshift % 8 == 0
+            && sf->Ashift % 8 == 0 && sf->Aloss == 0) {
+#if HAVE_AVX2_INTRINSICS
+            if (SDL_HasAVX2())
+                return BlitRGBtoRGBPremultipliedPixelAlphaAVX2;
+#endif
+#if HAVE_SSE2_INTRINSICS
+            if (SDL_HasSSE2())
+                return BlitRGBtoRGBPremultipliedPixelAlphaSSE2;
+#endif
+            return BlitRGBtoRGBPremultipliedPixelAlpha;
+        }
+        break;
+
     case SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
         if (sf->Amask == 0) {
             /* Per-surface alpha blits */
@@ -1431,6 +2242,14 @@ SDL_CalculateBlitA(SDL_Surface * surface)
             case 2:
                 if (surface->map->identity) {
                     if (df->Gmask == 0x7e0) {
+#if HAVE_AVX2_INTRINSICS
+                        if (SDL_HasAVX2())
+                            return Blit565to565SurfaceAlphaAVX2;
+#endif
+#if HAVE_SSE2_INTRINSICS
+                        if (SDL_HasSSE2())
+                            return Blit565to565SurfaceAlphaSSE2;
+#endif
 #ifdef __MMX__
                         if (SDL_HasMMX())
                             return Blit565to565SurfaceAlphaMMX;
@@ -1438,6 +2257,14 @@ SDL_CalculateBlitA(SDL_Surface * surface)
 #endif
                             return Blit565to565SurfaceAlpha;
                     } else if (df->Gmask == 0x3e0) {
+#if HAVE_AVX2_INTRINSICS
+                        if (SDL_HasAVX2())
+                            return Blit555to555SurfaceAlphaAVX2;
+#endif
+#if HAVE_SSE2_INTRINSICS
+                        if (SDL_HasSSE2())
+                            return Blit555to555SurfaceAlphaSSE2;
+#endif
 #ifdef __MMX__
                         if (SDL_HasMMX())
                             return Blit555to555SurfaceAlphaMMX;
@@ -1452,11 +2279,23 @@ SDL_CalculateBlitA(SDL_Surface * surface)
                 if (sf->Rmask == df->Rmask
                     && sf->Gmask == df->Gmask
                     && sf->Bmask == df->Bmask && sf->BytesPerPixel == 4) {
-#ifdef __MMX__
+#if HAVE_SSE2_INTRINSICS || HAVE_AVX2_INTRINSICS || defined(__MMX__)
                     if (sf->Rshift % 8 == 0
                         && sf->Gshift % 8 == 0
-                        && sf->Bshift % 8 == 0 && SDL_HasMMX())
-                        return BlitRGBtoRGBSurfaceAlphaMMX;
+                        && sf->Bshift % 8 == 0) {
+#if HAVE_AVX2_INTRINSICS
+                        if (SDL_HasAVX2())
+                            return BlitRGBtoRGBSurfaceAlphaAVX2;
+#endif
+#if HAVE_SSE2_INTRINSICS
+                        if (SDL_HasSSE2())
+                            return BlitRGBtoRGBSurfaceAlphaSSE2;
+#endif
+#ifdef __MMX__
+                        if (SDL_HasMMX())
+                            return BlitRGBtoRGBSurfaceAlphaMMX;
+#endif
+                    }
 #endif
                     if ((sf->Rmask | sf->Gmask | sf->Bmask) == 0xffffff) {
                         return BlitRGBtoRGBSurfaceAlpha;
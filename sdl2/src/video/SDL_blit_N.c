@@ -26,6 +26,7 @@
 #include "SDL_endian.h"
 #include "SDL_cpuinfo.h"
 #include "SDL_blit.h"
+#include "SDL_pixels_c.h"
 
 #include "SDL_assert.h"
 
@@ -3042,6 +3043,803 @@ BlitNto2101010(SDL_BlitInfo * info)
     }
 }
 
+#if HAVE_SSE2_INTRINSICS
+/* 32-bit formats with 8 bits per channel, which the SSE2 10-bit blitters handle */
+static SDL_bool
+Is8888Format(const SDL_PixelFormat * fmt)
+{
+    return (fmt->BytesPerPixel == 4 &&
+            fmt->Rloss == 0 && fmt->Gloss == 0 && fmt->Bloss == 0 &&
+            (!fmt->Amask || fmt->Aloss == 0)) ? SDL_TRUE : SDL_FALSE;
+}
+
+/* ARGB 2-10-10-10 --> 8888, four pixels at a time */
+static void
+Blit2101010to8888SSE2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    SDL_PixelFormat *dstfmt = info->dst_fmt;
+    const __m128i rshift = _mm_cvtsi32_si128(dstfmt->Rshift);
+    const __m128i gshift = _mm_cvtsi32_si128(dstfmt->Gshift);
+    const __m128i bshift = _mm_cvtsi32_si128(dstfmt->Bshift);
+    const __m128i ashift = _mm_cvtsi32_si128(dstfmt->Ashift);
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    const __m128i x55 = _mm_set1_epi32(0x55);
+
+    while (height--) {
+        const Uint32 *s = (const Uint32 *) src;
+        Uint32 *d = (Uint32 *) dst;
+        int n = width;
+
+        for (; n >= 4; n -= 4, s += 4, d += 4) {
+            const __m128i p = _mm_loadu_si128((const __m128i *) s);
+            const __m128i r = _mm_and_si128(_mm_srli_epi32(p, 22), mask);
+            const __m128i g = _mm_and_si128(_mm_srli_epi32(p, 12), mask);
+            const __m128i b = _mm_and_si128(_mm_srli_epi32(p, 2), mask);
+            __m128i out = _mm_or_si128(_mm_or_si128(_mm_sll_epi32(r, rshift), _mm_sll_epi32(g, gshift)),
+                                       _mm_sll_epi32(b, bshift));
+            if (dstfmt->Amask) {
+                /* Expands the 2-bit alpha like SDL_expand_byte[6] */
+                const __m128i a = _mm_mullo_epi16(_mm_srli_epi32(p, 30), x55);
+                out = _mm_or_si128(out, _mm_sll_epi32(a, ashift));
+            }
+            _mm_storeu_si128((__m128i *) d, out);
+        }
+        for (; n > 0; --n, ++s, ++d) {
+            unsigned sR, sG, sB, sA;
+            RGBA_FROM_ARGB2101010(*s, sR, sG, sB, sA);
+            PIXEL_FROM_RGBA(*d, dstfmt, sR, sG, sB, sA);
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+/* 8888 --> ARGB 2-10-10-10, four pixels at a time */
+static void
+Blit8888to2101010SSE2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    SDL_PixelFormat *srcfmt = info->src_fmt;
+    const __m128i rshift = _mm_cvtsi32_si128(srcfmt->Rshift);
+    const __m128i gshift = _mm_cvtsi32_si128(srcfmt->Gshift);
+    const __m128i bshift = _mm_cvtsi32_si128(srcfmt->Bshift);
+    const __m128i ashift = _mm_cvtsi32_si128(srcfmt->Ashift);
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i three = _mm_set1_epi32(0x3);
+    const __m128i one = _mm_set1_epi32(1);
+
+    while (height--) {
+        const Uint32 *s = (const Uint32 *) src;
+        Uint32 *d = (Uint32 *) dst;
+        int n = width;
+
+        for (; n >= 4; n -= 4, s += 4, d += 4) {
+            const __m128i p = _mm_loadu_si128((const __m128i *) s);
+            const __m128i r = _mm_and_si128(_mm_srl_epi32(p, rshift), mask);
+            const __m128i g = _mm_and_si128(_mm_srl_epi32(p, gshift), mask);
+            const __m128i b = _mm_and_si128(_mm_srl_epi32(p, bshift), mask);
+            const __m128i a = srcfmt->Amask ? _mm_and_si128(_mm_srl_epi32(p, ashift), mask) : mask;
+            /* 8 to 10 bits is (c << 2) | 3, except that 0 stays 0 */
+            const __m128i r10 = _mm_andnot_si128(_mm_cmpeq_epi32(r, zero), _mm_or_si128(_mm_slli_epi32(r, 2), three));
+            const __m128i g10 = _mm_andnot_si128(_mm_cmpeq_epi32(g, zero), _mm_or_si128(_mm_slli_epi32(g, 2), three));
+            const __m128i b10 = _mm_andnot_si128(_mm_cmpeq_epi32(b, zero), _mm_or_si128(_mm_slli_epi32(b, 2), three));
+            /* (a * 3) / 255, exact for these small values */
+            const __m128i a3 = _mm_add_epi32(_mm_slli_epi32(a, 1), a);
+            const __m128i a2 = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(a3, one), _mm_srli_epi32(a3, 8)), 8);
+            const __m128i out = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(a2, 30), _mm_slli_epi32(r10, 20)),
+                                             _mm_or_si128(_mm_slli_epi32(g10, 10), b10));
+            _mm_storeu_si128((__m128i *) d, out);
+        }
+        for (; n > 0; --n, ++s, ++d) {
+            Uint32 Pixel;
+            unsigned sR, sG, sB, sA;
+            RGBA_FROM_8888(*s, srcfmt, sR, sG, sB, sA);
+            if (!srcfmt->Amask) {
+                sA = 0xFF;
+            }
+            ARGB2101010_FROM_RGBA(Pixel, sR, sG, sB, sA);
+            *d = Pixel;
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_SSE2_INTRINSICS || HAVE_AVX2_INTRINSICS || HAVE_NEON_INTRINSICS
+/* The SIMD colorkey blitters compare a vector of pixels against the key at
+   once and merge only the pixels that differ into the destination. They give
+   the same results as Blit2to2Key, BlitNtoNKey and BlitNtoNKeyCopyAlpha. */
+
+/* 4 -> 4 bytes: the bytes of a pixel that doesn't match the key are reordered
+   by shuffle, ANDed with andmask and ORed with ormask */
+typedef struct
+{
+    Uint32 rgbmask;
+    Uint32 ckey;
+    Uint32 andmask;
+    Uint32 ormask;
+    Uint8 shuffle[4];
+} KeyBlit4to4;
+
+static void
+SetupKeyBlit4to4(const SDL_BlitInfo * info, KeyBlit4to4 * key)
+{
+    SDL_PixelFormat *srcfmt = info->src_fmt;
+    SDL_PixelFormat *dstfmt = info->dst_fmt;
+
+    key->rgbmask = ~srcfmt->Amask;
+    key->ckey = info->colorkey & key->rgbmask;
+    key->andmask = 0xFFFFFFFF;
+    key->ormask = 0;
+    key->shuffle[0] = 0;
+    key->shuffle[1] = 1;
+    key->shuffle[2] = 2;
+    key->shuffle[3] = 3;
+
+    if (srcfmt->Rmask == dstfmt->Rmask &&
+        srcfmt->Gmask == dstfmt->Gmask &&
+        srcfmt->Bmask == dstfmt->Bmask) {
+        if (srcfmt->Amask && dstfmt->Amask) {
+            /* Copied as is */
+        } else if (dstfmt->Amask) {
+            key->ormask = (Uint32) info->a << dstfmt->Ashift;
+        } else {
+            key->andmask = srcfmt->Rmask | srcfmt->Gmask | srcfmt->Bmask;
+        }
+    } else {
+        Uint8 andbytes[4] = { 0xFF, 0xFF, 0xFF, 0xFF };
+        Uint8 orbytes[4] = { 0, 0, 0, 0 };
+        int alpha_channel, p0, p1, p2, p3;
+
+        get_permutation(srcfmt, dstfmt, &p0, &p1, &p2, &p3, &alpha_channel);
+        key->shuffle[0] = (Uint8) p0;
+        key->shuffle[1] = (Uint8) p1;
+        key->shuffle[2] = (Uint8) p2;
+        key->shuffle[3] = (Uint8) p3;
+        if (!(srcfmt->Amask && dstfmt->Amask)) {
+            andbytes[alpha_channel] = 0;
+            orbytes[alpha_channel] = dstfmt->Amask ? info->a : 0;
+        }
+        SDL_memcpy(&key->andmask, andbytes, sizeof(andbytes));
+        SDL_memcpy(&key->ormask, orbytes, sizeof(orbytes));
+    }
+}
+
+/* The scalar version, for the pixels at the end of a row */
+static SDL_INLINE Uint32
+KeyBlit4to4Pixel(const KeyBlit4to4 * key, Uint32 pixel)
+{
+    const Uint8 *src = (const Uint8 *) &pixel;
+    Uint8 dst[4];
+    Uint32 out;
+
+    dst[0] = src[key->shuffle[0]];
+    dst[1] = src[key->shuffle[1]];
+    dst[2] = src[key->shuffle[2]];
+    dst[3] = src[key->shuffle[3]];
+    SDL_memcpy(&out, dst, sizeof(dst));
+    return (out & key->andmask) | key->ormask;
+}
+
+#if HAVE_SSE2_INTRINSICS || HAVE_AVX2_INTRINSICS
+/* 2 -> 4 bytes: 5 and 6 bit channels are expanded to 8 bits the way
+   SDL_expand_byte does it, with (c << shift) * mult >> 16 */
+typedef struct
+{
+    Uint16 rgbmask;
+    Uint16 ckey;
+    Uint16 mask[3];
+    int srl[3];
+    int sll[3];
+    Uint16 mult[3];
+    int dstshift[3];
+    Uint32 ormask;
+} KeyBlit2to4;
+
+static SDL_bool
+SetupKeyBlit2to4(const SDL_BlitInfo * info, KeyBlit2to4 * key)
+{
+    SDL_PixelFormat *srcfmt = info->src_fmt;
+    SDL_PixelFormat *dstfmt = info->dst_fmt;
+    const Uint32 masks[3] = { srcfmt->Rmask, srcfmt->Gmask, srcfmt->Bmask };
+    const int shifts[3] = { srcfmt->Rshift, srcfmt->Gshift, srcfmt->Bshift };
+    const int losses[3] = { srcfmt->Rloss, srcfmt->Gloss, srcfmt->Bloss };
+    const Uint32 ckey = info->colorkey & ~srcfmt->Amask;
+    int i;
+
+    if (ckey > 0xFFFF) {
+        /* Never matches a 16-bit pixel */
+        return SDL_FALSE;
+    }
+    key->rgbmask = (Uint16) ~srcfmt->Amask;
+    key->ckey = (Uint16) ckey;
+    for (i = 0; i < 3; ++i) {
+        const int up = (losses[i] == 3) ? 4 : 3;
+        key->mask[i] = (Uint16) masks[i];
+        key->srl[i] = SDL_max(shifts[i] - up, 0);
+        key->sll[i] = SDL_max(up - shifts[i], 0);
+        key->mult[i] = (losses[i] == 3) ? 33693 : 33159;
+    }
+    key->dstshift[0] = dstfmt->Rshift;
+    key->dstshift[1] = dstfmt->Gshift;
+    key->dstshift[2] = dstfmt->Bshift;
+    key->ormask = dstfmt->Amask ? ((Uint32) info->a << dstfmt->Ashift) : 0;
+    return SDL_TRUE;
+}
+
+static SDL_INLINE Uint32
+KeyBlit2to4Pixel(const KeyBlit2to4 * key, Uint16 pixel)
+{
+    Uint32 out = key->ormask;
+    int i;
+
+    for (i = 0; i < 3; ++i) {
+        const Uint32 c = (Uint32) (((pixel & key->mask[i]) >> key->srl[i]) << key->sll[i]);
+        out |= ((c * key->mult[i]) >> 16) << key->dstshift[i];
+    }
+    return out;
+}
+#endif /* HAVE_SSE2_INTRINSICS || HAVE_AVX2_INTRINSICS */
+
+#if HAVE_SSE2_INTRINSICS
+/* 16-bit colorkey blit, eight pixels at a time */
+static void
+Blit2to2KeySSE2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const Uint32 rgbmask = ~info->src_fmt->Amask;
+    const Uint32 ckey = info->colorkey & rgbmask;
+    __m128i vrgbmask, vckey;
+
+    if (ckey > 0xFFFF) {
+        Blit2to2Key(info);
+        return;
+    }
+    vrgbmask = _mm_set1_epi16((Sint16) rgbmask);
+    vckey = _mm_set1_epi16((Sint16) ckey);
+
+    while (height--) {
+        const Uint16 *s = (const Uint16 *) src;
+        Uint16 *d = (Uint16 *) dst;
+        int n = width;
+
+        for (; n >= 8; n -= 8, s += 8, d += 8) {
+            const __m128i p = _mm_loadu_si128((const __m128i *) s);
+            const __m128i keyed = _mm_cmpeq_epi16(_mm_and_si128(p, vrgbmask), vckey);
+            const int bits = _mm_movemask_epi8(keyed);
+            if (bits == 0) {
+                _mm_storeu_si128((__m128i *) d, p);
+            } else if (bits != 0xFFFF) {
+                const __m128i old = _mm_loadu_si128((const __m128i *) d);
+                _mm_storeu_si128((__m128i *) d, _mm_or_si128(_mm_and_si128(keyed, old), _mm_andnot_si128(keyed, p)));
+            }
+        }
+        for (; n > 0; --n, ++s, ++d) {
+            if ((*s & rgbmask) != ckey) {
+                *d = *s;
+            }
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+/* 32-bit colorkey blit with matching RGB masks, four pixels at a time */
+static void
+Blit4to4KeySSE2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    KeyBlit4to4 key;
+    __m128i rgbmask, ckey, andmask, ormask;
+
+    SetupKeyBlit4to4(info, &key);
+    rgbmask = _mm_set1_epi32((int) key.rgbmask);
+    ckey = _mm_set1_epi32((int) key.ckey);
+    andmask = _mm_set1_epi32((int) key.andmask);
+    ormask = _mm_set1_epi32((int) key.ormask);
+
+    while (height--) {
+        const Uint32 *s = (const Uint32 *) src;
+        Uint32 *d = (Uint32 *) dst;
+        int n = width;
+
+        for (; n >= 4; n -= 4, s += 4, d += 4) {
+            const __m128i p = _mm_loadu_si128((const __m128i *) s);
+            const __m128i keyed = _mm_cmpeq_epi32(_mm_and_si128(p, rgbmask), ckey);
+            const int bits = _mm_movemask_epi8(keyed);
+            if (bits != 0xFFFF) {
+                __m128i out = _mm_or_si128(_mm_and_si128(p, andmask), ormask);
+                if (bits) {
+                    const __m128i old = _mm_loadu_si128((const __m128i *) d);
+                    out = _mm_or_si128(_mm_and_si128(keyed, old), _mm_andnot_si128(keyed, out));
+                }
+                _mm_storeu_si128((__m128i *) d, out);
+            }
+        }
+        for (; n > 0; --n, ++s, ++d) {
+            if ((*s & key.rgbmask) != key.ckey) {
+                *d = (*s & key.andmask) | key.ormask;
+            }
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+/* 16-bit to 32-bit colorkey blit, eight pixels at a time */
+static void
+Blit2to4KeySSE2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const __m128i zero = _mm_setzero_si128();
+    KeyBlit2to4 key;
+    __m128i rgbmask, ckey, ormask, mask[3], mult[3], srl[3], sll[3], dstshift[3];
+    int i;
+
+    if (!SetupKeyBlit2to4(info, &key)) {
+        BlitNtoNKey(info);
+        return;
+    }
+    rgbmask = _mm_set1_epi16((Sint16) key.rgbmask);
+    ckey = _mm_set1_epi16((Sint16) key.ckey);
+    ormask = _mm_set1_epi32((int) key.ormask);
+    for (i = 0; i < 3; ++i) {
+        mask[i] = _mm_set1_epi16((Sint16) key.mask[i]);
+        mult[i] = _mm_set1_epi16((Sint16) key.mult[i]);
+        srl[i] = _mm_cvtsi32_si128(key.srl[i]);
+        sll[i] = _mm_cvtsi32_si128(key.sll[i]);
+        dstshift[i] = _mm_cvtsi32_si128(key.dstshift[i]);
+    }
+
+    while (height--) {
+        const Uint16 *s = (const Uint16 *) src;
+        Uint32 *d = (Uint32 *) dst;
+        int n = width;
+
+        for (; n >= 8; n -= 8, s += 8, d += 8) {
+            const __m128i p = _mm_loadu_si128((const __m128i *) s);
+            const __m128i keyed = _mm_cmpeq_epi16(_mm_and_si128(p, rgbmask), ckey);
+            const int bits = _mm_movemask_epi8(keyed);
+            __m128i lo = ormask, hi = ormask;
+
+            if (bits == 0xFFFF) {
+                continue;
+            }
+            for (i = 0; i < 3; ++i) {
+                __m128i c = _mm_and_si128(p, mask[i]);
+                c = _mm_mulhi_epu16(_mm_sll_epi16(_mm_srl_epi16(c, srl[i]), sll[i]), mult[i]);
+                lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_unpacklo_epi16(c, zero), dstshift[i]));
+                hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_unpackhi_epi16(c, zero), dstshift[i]));
+            }
+            if (bits) {
+                const __m128i keyedlo = _mm_unpacklo_epi16(keyed, keyed);
+                const __m128i keyedhi = _mm_unpackhi_epi16(keyed, keyed);
+                lo = _mm_or_si128(_mm_and_si128(keyedlo, _mm_loadu_si128((const __m128i *) d)), _mm_andnot_si128(keyedlo, lo));
+                hi = _mm_or_si128(_mm_and_si128(keyedhi, _mm_loadu_si128((const __m128i *) (d + 4))), _mm_andnot_si128(keyedhi, hi));
+            }
+            _mm_storeu_si128((__m128i *) d, lo);
+            _mm_storeu_si128((__m128i *) (d + 4), hi);
+        }
+        for (; n > 0; --n, ++s, ++d) {
+            if ((*s & key.rgbmask) != key.ckey) {
+                *d = KeyBlit2to4Pixel(&key, *s);
+            }
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_SSE41_INTRINSICS
+/* 32-bit colorkey blit with any byte order, four pixels at a time */
+SDL_TARGETING("sse4.1") static void
+Blit4to4KeySSE41(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    KeyBlit4to4 key;
+    Uint32 shuffle;
+    __m128i rgbmask, ckey, andmask, ormask, vshuffle;
+
+    SetupKeyBlit4to4(info, &key);
+    SDL_memcpy(&shuffle, key.shuffle, sizeof(shuffle));
+    rgbmask = _mm_set1_epi32((int) key.rgbmask);
+    ckey = _mm_set1_epi32((int) key.ckey);
+    andmask = _mm_set1_epi32((int) key.andmask);
+    ormask = _mm_set1_epi32((int) key.ormask);
+    vshuffle = _mm_add_epi8(_mm_set1_epi32((int) shuffle),
+                            _mm_setr_epi8(0, 0, 0, 0, 4, 4, 4, 4, 8, 8, 8, 8, 12, 12, 12, 12));
+
+    while (height--) {
+        const Uint32 *s = (const Uint32 *) src;
+        Uint32 *d = (Uint32 *) dst;
+        int n = width;
+
+        for (; n >= 4; n -= 4, s += 4, d += 4) {
+            const __m128i p = _mm_loadu_si128((const __m128i *) s);
+            const __m128i keyed = _mm_cmpeq_epi32(_mm_and_si128(p, rgbmask), ckey);
+            const int bits = _mm_movemask_epi8(keyed);
+            if (bits != 0xFFFF) {
+                __m128i out = _mm_or_si128(_mm_and_si128(_mm_shuffle_epi8(p, vshuffle), andmask), ormask);
+                if (bits) {
+                    out = _mm_blendv_epi8(out, _mm_loadu_si128((const __m128i *) d), keyed);
+                }
+                _mm_storeu_si128((__m128i *) d, out);
+            }
+        }
+        for (; n > 0; --n, ++s, ++d) {
+            if ((*s & key.rgbmask) != key.ckey) {
+                *d = KeyBlit4to4Pixel(&key, *s);
+            }
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+#endif /* HAVE_SSE41_INTRINSICS */
+
+#if HAVE_AVX2_INTRINSICS
+/* 16-bit colorkey blit, sixteen pixels at a time */
+SDL_TARGETING("avx2") static void
+Blit2to2KeyAVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const Uint32 rgbmask = ~info->src_fmt->Amask;
+    const Uint32 ckey = info->colorkey & rgbmask;
+    __m256i vrgbmask, vckey;
+
+    if (ckey > 0xFFFF) {
+        Blit2to2Key(info);
+        return;
+    }
+    vrgbmask = _mm256_set1_epi16((Sint16) rgbmask);
+    vckey = _mm256_set1_epi16((Sint16) ckey);
+
+    while (height--) {
+        const Uint16 *s = (const Uint16 *) src;
+        Uint16 *d = (Uint16 *) dst;
+        int n = width;
+
+        for (; n >= 16; n -= 16, s += 16, d += 16) {
+            const __m256i p = _mm256_loadu_si256((const __m256i *) s);
+            const __m256i keyed = _mm256_cmpeq_epi16(_mm256_and_si256(p, vrgbmask), vckey);
+            const int bits = _mm256_movemask_epi8(keyed);
+            if (bits == 0) {
+                _mm256_storeu_si256((__m256i *) d, p);
+            } else if (bits != -1) {
+                const __m256i old = _mm256_loadu_si256((const __m256i *) d);
+                _mm256_storeu_si256((__m256i *) d, _mm256_blendv_epi8(p, old, keyed));
+            }
+        }
+        for (; n > 0; --n, ++s, ++d) {
+            if ((*s & rgbmask) != ckey) {
+                *d = *s;
+            }
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+/* 32-bit colorkey blit with any byte order, eight pixels at a time */
+SDL_TARGETING("avx2") static void
+Blit4to4KeyAVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    KeyBlit4to4 key;
+    Uint32 shuffle;
+    __m256i rgbmask, ckey, andmask, ormask, vshuffle;
+
+    SetupKeyBlit4to4(info, &key);
+    SDL_memcpy(&shuffle, key.shuffle, sizeof(shuffle));
+    rgbmask = _mm256_set1_epi32((int) key.rgbmask);
+    ckey = _mm256_set1_epi32((int) key.ckey);
+    andmask = _mm256_set1_epi32((int) key.andmask);
+    ormask = _mm256_set1_epi32((int) key.ormask);
+    vshuffle = _mm256_add_epi8(_mm256_set1_epi32((int) shuffle),
+                               _mm256_setr_epi8(0, 0, 0, 0, 4, 4, 4, 4, 8, 8, 8, 8, 12, 12, 12, 12,
+                                                0, 0, 0, 0, 4, 4, 4, 4, 8, 8, 8, 8, 12, 12, 12, 12));
+
+    while (height--) {
+        const Uint32 *s = (const Uint32 *) src;
+        Uint32 *d = (Uint32 *) dst;
+        int n = width;
+
+        for (; n >= 8; n -= 8, s += 8, d += 8) {
+            const __m256i p = _mm256_loadu_si256((const __m256i *) s);
+            const __m256i keyed = _mm256_cmpeq_epi32(_mm256_and_si256(p, rgbmask), ckey);
+            const int bits = _mm256_movemask_epi8(keyed);
+            if (bits != -1) {
+                __m256i out = _mm256_or_si256(_mm256_and_si256(_mm256_shuffle_epi8(p, vshuffle), andmask), ormask);
+                if (bits) {
+                    out = _mm256_blendv_epi8(out, _mm256_loadu_si256((const __m256i *) d), keyed);
+                }
+                _mm256_storeu_si256((__m256i *) d, out);
+            }
+        }
+        for (; n > 0; --n, ++s, ++d) {
+            if ((*s & key.rgbmask) != key.ckey) {
+                *d = KeyBlit4to4Pixel(&key, *s);
+            }
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+/* 16-bit to 32-bit colorkey blit, sixteen pixels at a time */
+SDL_TARGETING("avx2") static void
+Blit2to4KeyAVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    KeyBlit2to4 key;
+    __m256i rgbmask, ckey, ormask, mask[3], mult[3];
+    __m128i srl[3], sll[3], dstshift[3];
+    int i;
+
+    if (!SetupKeyBlit2to4(info, &key)) {
+        BlitNtoNKey(info);
+        return;
+    }
+    rgbmask = _mm256_set1_epi16((Sint16) key.rgbmask);
+    ckey = _mm256_set1_epi16((Sint16) key.ckey);
+    ormask = _mm256_set1_epi32((int) key.ormask);
+    for (i = 0; i < 3; ++i) {
+        mask[i] = _mm256_set1_epi16((Sint16) key.mask[i]);
+        mult[i] = _mm256_set1_epi16((Sint16) key.mult[i]);
+        srl[i] = _mm_cvtsi32_si128(key.srl[i]);
+        sll[i] = _mm_cvtsi32_si128(key.sll[i]);
+        dstshift[i] = _mm_cvtsi32_si128(key.dstshift[i]);
+    }
+
+    while (height--) {
+        const Uint16 *s = (const Uint16 *) src;
+        Uint32 *d = (Uint32 *) dst;
+        int n = width;
+
+        for (; n >= 16; n -= 16, s += 16, d += 16) {
+            /* Widened to 32 bits in two halves of eight pixels, in order */
+            const __m256i p = _mm256_loadu_si256((const __m256i *) s);
+            const __m256i keyed = _mm256_cmpeq_epi16(_mm256_and_si256(p, rgbmask), ckey);
+            const int bits = _mm256_movemask_epi8(keyed);
+            __m256i lo = ormask, hi = ormask;
+
+            if (bits == -1) {
+                continue;
+            }
+            for (i = 0; i < 3; ++i) {
+                __m256i c = _mm256_and_si256(p, mask[i]);
+                c = _mm256_mulhi_epu16(_mm256_sll_epi16(_mm256_srl_epi16(c, srl[i]), sll[i]), mult[i]);
+                lo = _mm256_or_si256(lo, _mm256_sll_epi32(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(c)), dstshift[i]));
+                hi = _mm256_or_si256(hi, _mm256_sll_epi32(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(c, 1)), dstshift[i]));
+            }
+            if (bits) {
+                const __m256i keyedlo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(keyed));
+                const __m256i keyedhi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(keyed, 1));
+                lo = _mm256_blendv_epi8(lo, _mm256_loadu_si256((const __m256i *) d), keyedlo);
+                hi = _mm256_blendv_epi8(hi, _mm256_loadu_si256((const __m256i *) (d + 8)), keyedhi);
+            }
+            _mm256_storeu_si256((__m256i *) d, lo);
+            _mm256_storeu_si256((__m256i *) (d + 8), hi);
+        }
+        for (; n > 0; --n, ++s, ++d) {
+            if ((*s & key.rgbmask) != key.ckey) {
+                *d = KeyBlit2to4Pixel(&key, *s);
+            }
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+/* 16-bit colorkey blit, eight pixels at a time */
+static void
+Blit2to2KeyNEON(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    const Uint32 rgbmask = ~info->src_fmt->Amask;
+    const Uint32 ckey = info->colorkey & rgbmask;
+    uint16x8_t vrgbmask, vckey;
+
+    if (ckey > 0xFFFF) {
+        Blit2to2Key(info);
+        return;
+    }
+    vrgbmask = vdupq_n_u16((uint16_t) rgbmask);
+    vckey = vdupq_n_u16((uint16_t) ckey);
+
+    while (height--) {
+        const Uint16 *s = (const Uint16 *) src;
+        Uint16 *d = (Uint16 *) dst;
+        int n = width;
+
+        for (; n >= 8; n -= 8, s += 8, d += 8) {
+            const uint16x8_t p = vld1q_u16(s);
+            const uint16x8_t keyed = vceqq_u16(vandq_u16(p, vrgbmask), vckey);
+            vst1q_u16(d, vbslq_u16(keyed, vld1q_u16(d), p));
+        }
+        for (; n > 0; --n, ++s, ++d) {
+            if ((*s & rgbmask) != ckey) {
+                *d = *s;
+            }
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+/* 32-bit colorkey blit with matching RGB masks, four pixels at a time */
+static void
+Blit4to4KeyNEON(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    Uint8 *dst = info->dst;
+    KeyBlit4to4 key;
+    uint32x4_t rgbmask, ckey, andmask, ormask;
+
+    SetupKeyBlit4to4(info, &key);
+    rgbmask = vdupq_n_u32(key.rgbmask);
+    ckey = vdupq_n_u32(key.ckey);
+    andmask = vdupq_n_u32(key.andmask);
+    ormask = vdupq_n_u32(key.ormask);
+
+    while (height--) {
+        const Uint32 *s = (const Uint32 *) src;
+        Uint32 *d = (Uint32 *) dst;
+        int n = width;
+
+        for (; n >= 4; n -= 4, s += 4, d += 4) {
+            const uint32x4_t p = vld1q_u32(s);
+            const uint32x4_t keyed = vceqq_u32(vandq_u32(p, rgbmask), ckey);
+            const uint32x4_t out = vorrq_u32(vandq_u32(p, andmask), ormask);
+            vst1q_u32(d, vbslq_u32(keyed, vld1q_u32(d), out));
+        }
+        for (; n > 0; --n, ++s, ++d) {
+            if ((*s & key.rgbmask) != key.ckey) {
+                *d = (*s & key.andmask) | key.ormask;
+            }
+        }
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
+/* Picks a SIMD version of Blit2to2Key, BlitNtoNKey or BlitNtoNKeyCopyAlpha
+   for these formats, or NULL if there is none */
+static SDL_BlitFunc
+ChooseBlitKeySIMD(SDL_Surface * surface)
+{
+    SDL_PixelFormat *srcfmt = surface->format;
+    SDL_PixelFormat *dstfmt = surface->map->dst->format;
+    const SDL_bool copy_alpha = (srcfmt->Amask && dstfmt->Amask) ? SDL_TRUE : SDL_FALSE;
+
+    if (srcfmt->BytesPerPixel == 2 && surface->map->identity) {
+#if HAVE_AVX2_INTRINSICS
+        if (SDL_HasAVX2()) {
+            return Blit2to2KeyAVX2;
+        }
+#endif
+#if HAVE_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            return Blit2to2KeySSE2;
+        }
+#endif
+#if HAVE_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            return Blit2to2KeyNEON;
+        }
+#endif
+        return NULL;
+    }
+
+    if (srcfmt->BytesPerPixel == 4 && dstfmt->BytesPerPixel == 4) {
+        const SDL_bool same_rgb = (srcfmt->Rmask == dstfmt->Rmask &&
+                                   srcfmt->Gmask == dstfmt->Gmask &&
+                                   srcfmt->Bmask == dstfmt->Bmask) ? SDL_TRUE : SDL_FALSE;
+        SDL_bool shuffle;
+
+        if (copy_alpha && srcfmt->format == dstfmt->format) {
+            /* BlitNtoNKeyCopyAlpha only copies these */
+            if (srcfmt->format != SDL_PIXELFORMAT_ARGB8888 &&
+                srcfmt->format != SDL_PIXELFORMAT_ABGR8888 &&
+                srcfmt->format != SDL_PIXELFORMAT_BGRA8888 &&
+                srcfmt->format != SDL_PIXELFORMAT_RGBA8888) {
+                return NULL;
+            }
+            shuffle = SDL_FALSE;
+        } else {
+            shuffle = (copy_alpha || !same_rgb) ? SDL_TRUE : SDL_FALSE;
+        }
+        if (shuffle && (SDL_ISPIXELFORMAT_10BIT(srcfmt->format) ||
+                        SDL_ISPIXELFORMAT_10BIT(dstfmt->format))) {
+            return NULL;
+        }
+
+#if HAVE_AVX2_INTRINSICS
+        if (SDL_HasAVX2()) {
+            return Blit4to4KeyAVX2;
+        }
+#endif
+        if (shuffle) {
+#if HAVE_SSE41_INTRINSICS
+            if (SDL_HasSSE41()) {
+                return Blit4to4KeySSE41;
+            }
+#endif
+            return NULL;
+        }
+#if HAVE_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            return Blit4to4KeySSE2;
+        }
+#endif
+#if HAVE_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            return Blit4to4KeyNEON;
+        }
+#endif
+        return NULL;
+    }
+
+    if (srcfmt->BytesPerPixel == 2 && dstfmt->BytesPerPixel == 4 && !copy_alpha &&
+        (srcfmt->Rloss == 2 || srcfmt->Rloss == 3) &&
+        (srcfmt->Gloss == 2 || srcfmt->Gloss == 3) &&
+        (srcfmt->Bloss == 2 || srcfmt->Bloss == 3) &&
+        dstfmt->Rloss == 0 && dstfmt->Gloss == 0 && dstfmt->Bloss == 0 &&
+        (!dstfmt->Amask || dstfmt->Aloss == 0)) {
+#if HAVE_AVX2_INTRINSICS
+        if (SDL_HasAVX2()) {
+            return Blit2to4KeyAVX2;
+        }
+#endif
+#if HAVE_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            return Blit2to4KeySSE2;
+        }
+#endif
+    }
+    return NULL;
+}
+#endif /* HAVE_SSE2_INTRINSICS || HAVE_AVX2_INTRINSICS || HAVE_NEON_INTRINSICS */
+
 /* Blit_3or4_to_3or4__same_rgb: 3 or 4 bpp, same RGB triplet */
 static void
 Blit_3or4_to_3or4__same_rgb(SDL_BlitInfo * info)
@@ -3415,8 +4213,18 @@ SDL_CalculateBlitN(SDL_Surface * surface)
             if (blitfun == BlitNtoN) {  /* default C fallback catch-all. Slow! */
                 if (srcfmt->format == SDL_PIXELFORMAT_ARGB2101010) {
                     blitfun = Blit2101010toN;
+#if HAVE_SSE2_INTRINSICS
+                    if (Is8888Format(dstfmt) && SDL_HasSSE2()) {
+                        blitfun = Blit2101010to8888SSE2;
+                    }
+#endif
                 } else if (dstfmt->format == SDL_PIXELFORMAT_ARGB2101010) {
                     blitfun = BlitNto2101010;
+#if HAVE_SSE2_INTRINSICS
+                    if (Is8888Format(srcfmt) && SDL_HasSSE2()) {
+                        blitfun = Blit8888to2101010SSE2;
+                    }
+#endif
                 } else if (srcfmt->BytesPerPixel == 4 &&
                             dstfmt->BytesPerPixel == 4 &&
                             srcfmt->Rmask == dstfmt->Rmask &&
@@ -3445,6 +4253,12 @@ SDL_CalculateBlitN(SDL_Surface * surface)
            because RLE is the preferred fast way to deal with this.
            If a particular case turns out to be useful we'll add it. */
 
+#if HAVE_SSE2_INTRINSICS || HAVE_AVX2_INTRINSICS || HAVE_NEON_INTRINSICS
+        blitfun = ChooseBlitKeySIMD(surface);
+        if (blitfun) {
+            return blitfun;
+        }
+#endif
         if (srcfmt->BytesPerPixel == 2 && surface->map->identity)
             return Blit2to2Key;
         else if (dstfmt->BytesPerPixel == 1)
@@ -3467,6 +4281,581 @@ SDL_CalculateBlitN(SDL_Surface * surface)
     return NULL;
 }
 
+/*
+ * Direct conversions for SDL_ConvertPixels(), which skip the blit map and
+ * convert a row at a time
+ */
+
+/* Values of PixelConvert::index besides the source bytes 0 to 3 */
+#define CONVERT_ZERO 4
+#define CONVERT_ONES 5
+
+typedef struct
+{
+    int srcbpp;
+    int dstbpp;
+
+    /* Formats with 8 bits per channel: the source byte of each destination
+       byte, as a pshufb mask for four pixels and the bytes to OR in */
+    Uint8 index[4];
+    Uint8 shuffle[16];
+    Uint8 orbytes[16];
+
+    /* 565 <-> 8888: r, g and b in the 16-bit and the 32-bit pixel */
+    Uint32 mask16[3];
+    int shift16[3];
+    int loss16[3];
+    int shift32[3];
+    Uint32 ormask;
+    /* RGB565: the low bits of green, which Blit_RGB565_32() expands by
+       shifting them, since it looks up the two bytes of a pixel separately */
+    Uint16 lowgreen;
+} PixelConvert;
+
+typedef void (*PixelConvertRowFunc) (const PixelConvert * conv, const Uint8 * src, Uint8 * dst, int width);
+
+/* The byte of each pixel holding r, g, b and a (or -1) for 24 and 32-bit
+   formats with 8 bits per channel */
+static SDL_bool
+GetByteLayout(const SDL_PixelFormat * fmt, int layout[4])
+{
+    const Uint32 masks[4] = { fmt->Rmask, fmt->Gmask, fmt->Bmask, fmt->Amask };
+    const int shifts[4] = { fmt->Rshift, fmt->Gshift, fmt->Bshift, fmt->Ashift };
+    int i;
+
+    if (fmt->BytesPerPixel < 3) {
+        return SDL_FALSE;
+    }
+    for (i = 0; i < 4; ++i) {
+        if (!masks[i]) {
+            if (i < 3) {
+                return SDL_FALSE;
+            }
+            layout[i] = -1;
+            continue;
+        }
+        if ((shifts[i] % 8) != 0 || masks[i] != (0xFFu << shifts[i])) {
+            return SDL_FALSE;
+        }
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        layout[i] = shifts[i] / 8;
+#else
+        layout[i] = fmt->BytesPerPixel - 1 - shifts[i] / 8;
+#endif
+    }
+    return SDL_TRUE;
+}
+
+/* Padding bytes of the destination are written as zero, alpha is 0xFF if the
+   source doesn't have any */
+static void
+SetupConvertShuffle(PixelConvert * conv, const int srclayout[4], const int dstlayout[4])
+{
+    int i, j, k;
+
+    for (j = 0; j < 4; ++j) {
+        conv->index[j] = CONVERT_ZERO;
+    }
+    for (i = 0; i < 4; ++i) {
+        if (dstlayout[i] < 0) {
+            continue;
+        }
+        if (srclayout[i] >= 0) {
+            conv->index[dstlayout[i]] = (Uint8) srclayout[i];
+        } else {
+            conv->index[dstlayout[i]] = CONVERT_ONES;
+        }
+    }
+
+    SDL_memset(conv->shuffle, 0x80, sizeof(conv->shuffle));
+    SDL_memset(conv->orbytes, 0, sizeof(conv->orbytes));
+    for (k = 0; k < 4; ++k) {
+        for (j = 0; j < conv->dstbpp; ++j) {
+            const int pos = k * conv->dstbpp + j;
+            if (conv->index[j] < 4) {
+                conv->shuffle[pos] = (Uint8) (k * conv->srcbpp + conv->index[j]);
+            } else if (conv->index[j] == CONVERT_ONES) {
+                conv->orbytes[pos] = 0xFF;
+            }
+        }
+    }
+}
+
+static void
+ConvertShuffleRow(const PixelConvert * conv, const Uint8 * src, Uint8 * dst, int width)
+{
+    const int srcbpp = conv->srcbpp;
+    const int dstbpp = conv->dstbpp;
+    Uint8 bytes[6];
+
+    bytes[3] = 0;
+    bytes[CONVERT_ZERO] = 0;
+    bytes[CONVERT_ONES] = 0xFF;
+    while (width--) {
+        bytes[0] = src[0];
+        bytes[1] = src[1];
+        bytes[2] = src[2];
+        if (srcbpp == 4) {
+            bytes[3] = src[3];
+        }
+        dst[0] = bytes[conv->index[0]];
+        dst[1] = bytes[conv->index[1]];
+        dst[2] = bytes[conv->index[2]];
+        if (dstbpp == 4) {
+            dst[3] = bytes[conv->index[3]];
+        }
+        src += srcbpp;
+        dst += dstbpp;
+    }
+}
+
+static void
+Setup565Convert(PixelConvert * conv, const SDL_PixelFormat * fmt16, const SDL_PixelFormat * fmt32)
+{
+    conv->mask16[0] = fmt16->Rmask;
+    conv->mask16[1] = fmt16->Gmask;
+    conv->mask16[2] = fmt16->Bmask;
+    conv->shift16[0] = fmt16->Rshift;
+    conv->shift16[1] = fmt16->Gshift;
+    conv->shift16[2] = fmt16->Bshift;
+    conv->loss16[0] = fmt16->Rloss;
+    conv->loss16[1] = fmt16->Gloss;
+    conv->loss16[2] = fmt16->Bloss;
+    conv->shift32[0] = fmt32->Rshift;
+    conv->shift32[1] = fmt32->Gshift;
+    conv->shift32[2] = fmt32->Bshift;
+    conv->ormask = fmt32->Amask;
+}
+
+static void
+Convert565to8888Row(const PixelConvert * conv, const Uint8 * src, Uint8 * dst, int width)
+{
+    const Uint16 *s = (const Uint16 *) src;
+    Uint32 *d = (Uint32 *) dst;
+    int i;
+
+    for (; width > 0; --width, ++s, ++d) {
+        Uint32 pixel = conv->ormask;
+        for (i = 0; i < 3; ++i) {
+            const Uint32 c = (*s & conv->mask16[i]) >> conv->shift16[i];
+            pixel |= (Uint32) SDL_expand_byte[conv->loss16[i]][c] << conv->shift32[i];
+        }
+        pixel += (Uint32) ((*s & conv->lowgreen) >> 3) << conv->shift32[1];
+        *d = pixel;
+    }
+}
+
+static void
+Convert8888to565Row(const PixelConvert * conv, const Uint8 * src, Uint8 * dst, int width)
+{
+    const Uint32 *s = (const Uint32 *) src;
+    Uint16 *d = (Uint16 *) dst;
+    int i;
+
+    for (; width > 0; --width, ++s, ++d) {
+        const Uint32 p = *s;
+        Uint32 pixel = 0;
+        for (i = 0; i < 3; ++i) {
+            pixel |= ((p >> (conv->shift32[i] + conv->loss16[i])) << conv->shift16[i]) & conv->mask16[i];
+        }
+        *d = (Uint16) pixel;
+    }
+}
+
+#if HAVE_SSE41_INTRINSICS
+SDL_TARGETING("sse4.1") static void
+ConvertShuffle4to4SSE41(const PixelConvert * conv, const Uint8 * src, Uint8 * dst, int width)
+{
+    const __m128i shuffle = _mm_loadu_si128((const __m128i *) conv->shuffle);
+    const __m128i orbytes = _mm_loadu_si128((const __m128i *) conv->orbytes);
+    int n = width;
+
+    for (; n >= 4; n -= 4, src += 16, dst += 16) {
+        const __m128i p = _mm_loadu_si128((const __m128i *) src);
+        _mm_storeu_si128((__m128i *) dst, _mm_or_si128(_mm_shuffle_epi8(p, shuffle), orbytes));
+    }
+    ConvertShuffleRow(conv, src, dst, n);
+}
+
+/* Sixteen pixels at a time, from three vectors of packed pixels to four */
+SDL_TARGETING("sse4.1") static void
+ConvertShuffle3to4SSE41(const PixelConvert * conv, const Uint8 * src, Uint8 * dst, int width)
+{
+    const __m128i shuffle = _mm_loadu_si128((const __m128i *) conv->shuffle);
+    const __m128i orbytes = _mm_loadu_si128((const __m128i *) conv->orbytes);
+    int n = width;
+
+    for (; n >= 16; n -= 16, src += 48, dst += 64) {
+        const __m128i a = _mm_loadu_si128((const __m128i *) src);
+        const __m128i b = _mm_loadu_si128((const __m128i *) (src + 16));
+        const __m128i c = _mm_loadu_si128((const __m128i *) (src + 32));
+        const __m128i p1 = _mm_alignr_epi8(b, a, 12);
+        const __m128i p2 = _mm_alignr_epi8(c, b, 8);
+        const __m128i p3 = _mm_srli_si128(c, 4);
+        _mm_storeu_si128((__m128i *) dst, _mm_or_si128(_mm_shuffle_epi8(a, shuffle), orbytes));
+        _mm_storeu_si128((__m128i *) (dst + 16), _mm_or_si128(_mm_shuffle_epi8(p1, shuffle), orbytes));
+        _mm_storeu_si128((__m128i *) (dst + 32), _mm_or_si128(_mm_shuffle_epi8(p2, shuffle), orbytes));
+        _mm_storeu_si128((__m128i *) (dst + 48), _mm_or_si128(_mm_shuffle_epi8(p3, shuffle), orbytes));
+    }
+    ConvertShuffleRow(conv, src, dst, n);
+}
+
+/* Sixteen pixels at a time, from four vectors to three of packed pixels.
+   Everything is loaded before it's stored, so this works in place */
+SDL_TARGETING("sse4.1") static void
+ConvertShuffle4to3SSE41(const PixelConvert * conv, const Uint8 * src, Uint8 * dst, int width)
+{
+    const __m128i shuffle = _mm_loadu_si128((const __m128i *) conv->shuffle);
+    int n = width;
+
+    for (; n >= 16; n -= 16, src += 64, dst += 48) {
+        const __m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) src), shuffle);
+        const __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (src + 16)), shuffle);
+        const __m128i c = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (src + 32)), shuffle);
+        const __m128i d = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (src + 48)), shuffle);
+        _mm_storeu_si128((__m128i *) dst, _mm_or_si128(a, _mm_slli_si128(b, 12)));
+        _mm_storeu_si128((__m128i *) (dst + 16), _mm_or_si128(_mm_srli_si128(b, 4), _mm_slli_si128(c, 8)));
+        _mm_storeu_si128((__m128i *) (dst + 32), _mm_or_si128(_mm_srli_si128(c, 8), _mm_slli_si128(d, 4)));
+    }
+    ConvertShuffleRow(conv, src, dst, n);
+}
+#endif /* HAVE_SSE41_INTRINSICS */
+
+#if HAVE_AVX2_INTRINSICS
+SDL_TARGETING("avx2") static void
+ConvertShuffle4to4AVX2(const PixelConvert * conv, const Uint8 * src, Uint8 * dst, int width)
+{
+    const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) conv->shuffle));
+    const __m256i orbytes = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) conv->orbytes));
+    int n = width;
+
+    for (; n >= 8; n -= 8, src += 32, dst += 32) {
+        const __m256i p = _mm256_loadu_si256((const __m256i *) src);
+        _mm256_storeu_si256((__m256i *) dst, _mm256_or_si256(_mm256_shuffle_epi8(p, shuffle), orbytes));
+    }
+    ConvertShuffleRow(conv, src, dst, n);
+}
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#if HAVE_SSE2_INTRINSICS
+/* Eight pixels at a time, expanded like SDL_expand_byte with
+   (c << shift) * mult >> 16, see SetupKeyBlit2to4() */
+static void
+Convert565to8888SSE2(const PixelConvert * conv, const Uint8 * src, Uint8 * dst, int width)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ormask = _mm_set1_epi32((int) conv->ormask);
+    const __m128i lowgreen = _mm_set1_epi16((Sint16) conv->lowgreen);
+    __m128i mask[3], mult[3], srl[3], sll[3], shift32[3];
+    int i, n = width;
+
+    for (i = 0; i < 3; ++i) {
+        const int up = (conv->loss16[i] == 3) ? 4 : 3;
+        mask[i] = _mm_set1_epi16((Sint16) conv->mask16[i]);
+        mult[i] = _mm_set1_epi16((Sint16) ((conv->loss16[i] == 3) ? 33693 : 33159));
+        srl[i] = _mm_cvtsi32_si128(SDL_max(conv->shift16[i] - up, 0));
+        sll[i] = _mm_cvtsi32_si128(SDL_max(up - conv->shift16[i], 0));
+        shift32[i] = _mm_cvtsi32_si128(conv->shift32[i]);
+    }
+
+    for (; n >= 8; n -= 8, src += 16, dst += 32) {
+        const __m128i p = _mm_loadu_si128((const __m128i *) src);
+        __m128i lo = ormask, hi = ormask;
+
+        for (i = 0; i < 3; ++i) {
+            __m128i c = _mm_and_si128(p, mask[i]);
+            c = _mm_mulhi_epu16(_mm_sll_epi16(_mm_srl_epi16(c, srl[i]), sll[i]), mult[i]);
+            if (i == 1) {
+                c = _mm_add_epi16(c, _mm_srli_epi16(_mm_and_si128(p, lowgreen), 3));
+            }
+            lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_unpacklo_epi16(c, zero), shift32[i]));
+            hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_unpackhi_epi16(c, zero), shift32[i]));
+        }
+        _mm_storeu_si128((__m128i *) dst, lo);
+        _mm_storeu_si128((__m128i *) (dst + 16), hi);
+    }
+    Convert565to8888Row(conv, src, dst, n);
+}
+
+/* Eight pixels at a time, truncated to 5 and 6 bits like PIXEL_FROM_RGB */
+static void
+Convert8888to565SSE2(const PixelConvert * conv, const Uint8 * src, Uint8 * dst, int width)
+{
+    __m128i mask[3], srl[3], sll[3];
+    int i, n = width;
+
+    for (i = 0; i < 3; ++i) {
+        mask[i] = _mm_set1_epi32((int) conv->mask16[i]);
+        srl[i] = _mm_cvtsi32_si128(conv->shift32[i] + conv->loss16[i]);
+        sll[i] = _mm_cvtsi32_si128(conv->shift16[i]);
+    }
+
+    for (; n >= 8; n -= 8, src += 32, dst += 16) {
+        const __m128i p0 = _mm_loadu_si128((const __m128i *) src);
+        const __m128i p1 = _mm_loadu_si128((const __m128i *) (src + 16));
+        __m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+
+        for (i = 0; i < 3; ++i) {
+            lo = _mm_or_si128(lo, _mm_and_si128(_mm_sll_epi32(_mm_srl_epi32(p0, srl[i]), sll[i]), mask[i]));
+            hi = _mm_or_si128(hi, _mm_and_si128(_mm_sll_epi32(_mm_srl_epi32(p1, srl[i]), sll[i]), mask[i]));
+        }
+        /* Sign extended, so the signed saturation keeps all 16 bits */
+        lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+        hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+        _mm_storeu_si128((__m128i *) dst, _mm_packs_epi32(lo, hi));
+    }
+    Convert8888to565Row(conv, src, dst, n);
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+/* Sixteen pixels at a time, with the channels split into their own vectors
+   by the interleaving loads and stores */
+static void
+ConvertShuffleNEON(const PixelConvert * conv, const Uint8 * src, Uint8 * dst, int width)
+{
+    const int srcbpp = conv->srcbpp;
+    const int dstbpp = conv->dstbpp;
+    uint8x16_t bytes[6];
+    int n = width;
+
+    bytes[3] = vdupq_n_u8(0);
+    bytes[CONVERT_ZERO] = vdupq_n_u8(0);
+    bytes[CONVERT_ONES] = vdupq_n_u8(0xFF);
+    for (; n >= 16; n -= 16, src += 16 * srcbpp, dst += 16 * dstbpp) {
+        if (srcbpp == 4) {
+            const uint8x16x4_t p = vld4q_u8(src);
+            bytes[0] = p.val[0];
+            bytes[1] = p.val[1];
+            bytes[2] = p.val[2];
+            bytes[3] = p.val[3];
+        } else {
+            const uint8x16x3_t p = vld3q_u8(src);
+            bytes[0] = p.val[0];
+            bytes[1] = p.val[1];
+            bytes[2] = p.val[2];
+        }
+        if (dstbpp == 4) {
+            uint8x16x4_t out;
+            out.val[0] = bytes[conv->index[0]];
+            out.val[1] = bytes[conv->index[1]];
+            out.val[2] = bytes[conv->index[2]];
+            out.val[3] = bytes[conv->index[3]];
+            vst4q_u8(dst, out);
+        } else {
+            uint8x16x3_t out;
+            out.val[0] = bytes[conv->index[0]];
+            out.val[1] = bytes[conv->index[1]];
+            out.val[2] = bytes[conv->index[2]];
+            vst3q_u8(dst, out);
+        }
+    }
+    ConvertShuffleRow(conv, src, dst, n);
+}
+
+static void
+Convert565to8888NEON(const PixelConvert * conv, const Uint8 * src, Uint8 * dst, int width)
+{
+    const uint32x4_t ormask = vdupq_n_u32(conv->ormask);
+    const uint16x8_t lowgreen = vdupq_n_u16(conv->lowgreen);
+    uint16x8_t mask[3];
+    int16x8_t shift16[3];
+    uint16x4_t mult[3];
+    int32x4_t shift32[3];
+    int i, n = width;
+
+    for (i = 0; i < 3; ++i) {
+        const int up = (conv->loss16[i] == 3) ? 4 : 3;
+        mask[i] = vdupq_n_u16((uint16_t) conv->mask16[i]);
+        shift16[i] = vdupq_n_s16((int16_t) (up - conv->shift16[i]));
+        mult[i] = vdup_n_u16((conv->loss16[i] == 3) ? 33693 : 33159);
+        shift32[i] = vdupq_n_s32(conv->shift32[i]);
+    }
+
+    for (; n >= 8; n -= 8, src += 16, dst += 32) {
+        const uint16x8_t p = vld1q_u16((const uint16_t *) src);
+        uint32x4_t lo = ormask, hi = ormask;
+
+        for (i = 0; i < 3; ++i) {
+            const uint16x8_t c = vshlq_u16(vandq_u16(p, mask[i]), shift16[i]);
+            uint16x4_t clo = vshrn_n_u32(vmull_u16(vget_low_u16(c), mult[i]), 16);
+            uint16x4_t chi = vshrn_n_u32(vmull_u16(vget_high_u16(c), mult[i]), 16);
+            if (i == 1) {
+                const uint16x8_t g = vshrq_n_u16(vandq_u16(p, lowgreen), 3);
+                clo = vadd_u16(clo, vget_low_u16(g));
+                chi = vadd_u16(chi, vget_high_u16(g));
+            }
+            lo = vorrq_u32(lo, vshlq_u32(vmovl_u16(clo), shift32[i]));
+            hi = vorrq_u32(hi, vshlq_u32(vmovl_u16(chi), shift32[i]));
+        }
+        vst1q_u32((uint32_t *) dst, lo);
+        vst1q_u32((uint32_t *) (dst + 16), hi);
+    }
+    Convert565to8888Row(conv, src, dst, n);
+}
+
+static void
+Convert8888to565NEON(const PixelConvert * conv, const Uint8 * src, Uint8 * dst, int width)
+{
+    uint32x4_t mask[3];
+    int32x4_t srl[3], sll[3];
+    int i, n = width;
+
+    for (i = 0; i < 3; ++i) {
+        mask[i] = vdupq_n_u32(conv->mask16[i]);
+        srl[i] = vdupq_n_s32(-(conv->shift32[i] + conv->loss16[i]));
+        sll[i] = vdupq_n_s32(conv->shift16[i]);
+    }
+
+    for (; n >= 8; n -= 8, src += 32, dst += 16) {
+        const uint32x4_t p0 = vld1q_u32((const uint32_t *) src);
+        const uint32x4_t p1 = vld1q_u32((const uint32_t *) (src + 16));
+        uint32x4_t lo = vdupq_n_u32(0), hi = vdupq_n_u32(0);
+
+        for (i = 0; i < 3; ++i) {
+            lo = vorrq_u32(lo, vandq_u32(vshlq_u32(vshlq_u32(p0, srl[i]), sll[i]), mask[i]));
+            hi = vorrq_u32(hi, vandq_u32(vshlq_u32(vshlq_u32(p1, srl[i]), sll[i]), mask[i]));
+        }
+        vst1q_u16((uint16_t *) dst, vcombine_u16(vmovn_u32(lo), vmovn_u32(hi)));
+    }
+    Convert8888to565Row(conv, src, dst, n);
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
+static SDL_bool
+Is565Format(const SDL_PixelFormat * fmt)
+{
+    return (fmt->format == SDL_PIXELFORMAT_RGB565 ||
+            fmt->format == SDL_PIXELFORMAT_BGR565) ? SDL_TRUE : SDL_FALSE;
+}
+
+static PixelConvertRowFunc
+SetupPixelConvert(const SDL_PixelFormat * srcfmt, const SDL_PixelFormat * dstfmt, PixelConvert * conv)
+{
+    int srclayout[4], dstlayout[4];
+    const SDL_bool src8 = GetByteLayout(srcfmt, srclayout);
+    const SDL_bool dst8 = GetByteLayout(dstfmt, dstlayout);
+
+    SDL_zerop(conv);
+    conv->srcbpp = srcfmt->BytesPerPixel;
+    conv->dstbpp = dstfmt->BytesPerPixel;
+
+    if (src8 && dst8) {
+        SetupConvertShuffle(conv, srclayout, dstlayout);
+        if (conv->srcbpp == 4 && conv->dstbpp == 4) {
+#if HAVE_AVX2_INTRINSICS
+            if (SDL_HasAVX2()) {
+                return ConvertShuffle4to4AVX2;
+            }
+#endif
+#if HAVE_SSE41_INTRINSICS
+            if (SDL_HasSSE41()) {
+                return ConvertShuffle4to4SSE41;
+            }
+#endif
+        } else if (conv->srcbpp == 3 && conv->dstbpp == 4) {
+#if HAVE_SSE41_INTRINSICS
+            if (SDL_HasSSE41()) {
+                return ConvertShuffle3to4SSE41;
+            }
+#endif
+        } else if (conv->srcbpp == 4 && conv->dstbpp == 3) {
+#if HAVE_SSE41_INTRINSICS
+            if (SDL_HasSSE41()) {
+                return ConvertShuffle4to3SSE41;
+            }
+#endif
+        }
+#if HAVE_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            return ConvertShuffleNEON;
+        }
+#endif
+        return ConvertShuffleRow;
+    }
+
+    if (Is565Format(srcfmt) && dst8 && conv->dstbpp == 4) {
+        Setup565Convert(conv, srcfmt, dstfmt);
+#if SDL_HAVE_BLIT_N_RGB565
+        if (srcfmt->format == SDL_PIXELFORMAT_RGB565) {
+            conv->mask16[1] = 0x0700;
+            conv->lowgreen = 0x00E0;
+        }
+#endif
+#if HAVE_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            return Convert565to8888SSE2;
+        }
+#endif
+#if HAVE_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            return Convert565to8888NEON;
+        }
+#endif
+        return Convert565to8888Row;
+    }
+
+    if (src8 && conv->srcbpp == 4 && Is565Format(dstfmt)) {
+        Setup565Convert(conv, dstfmt, srcfmt);
+#if HAVE_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            return Convert8888to565SSE2;
+        }
+#endif
+#if HAVE_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            return Convert8888to565NEON;
+        }
+#endif
+        return Convert8888to565Row;
+    }
+
+    return NULL;
+}
+
+SDL_bool
+SDL_ConvertPixels_RGB_to_RGB(int width, int height,
+                             Uint32 src_format, const void * src, int src_pitch,
+                             Uint32 dst_format, void * dst, int dst_pitch)
+{
+    SDL_PixelFormat srcfmt, dstfmt;
+    PixelConvert conv;
+    PixelConvertRowFunc convert_row;
+    const Uint8 *srcrow = (const Uint8 *) src;
+    Uint8 *dstrow = (Uint8 *) dst;
+
+    if (SDL_ISPIXELFORMAT_FOURCC(src_format) || SDL_ISPIXELFORMAT_INDEXED(src_format) ||
+        SDL_ISPIXELFORMAT_FOURCC(dst_format) || SDL_ISPIXELFORMAT_INDEXED(dst_format)) {
+        return SDL_FALSE;
+    }
+    if (width <= 0 || height <= 0) {
+        return SDL_FALSE;
+    }
+    if (SDL_InitFormat(&srcfmt, src_format) < 0 || SDL_InitFormat(&dstfmt, dst_format) < 0) {
+        return SDL_FALSE;
+    }
+    convert_row = SetupPixelConvert(&srcfmt, &dstfmt, &conv);
+    if (!convert_row) {
+        return SDL_FALSE;
+    }
+
+    /* Rows are converted front to back, so overlapping pixels only work out
+       when the destination doesn't get ahead of the source */
+    if (dstrow + (height - 1) * dst_pitch + width * conv.dstbpp > srcrow &&
+        srcrow + (height - 1) * src_pitch + width * conv.srcbpp > dstrow) {
+        if (dstrow > srcrow || dst_pitch > src_pitch || conv.dstbpp > conv.srcbpp) {
+            return SDL_FALSE;
+        }
+    }
+
+    while (height--) {
+        convert_row(&conv, srcrow, dstrow, width);
+        srcrow += src_pitch;
+        dstrow += dst_pitch;
+    }
+    return SDL_TRUE;
+}
+
 #endif /* SDL_HAVE_BLIT_N */
 
 /* vi: set ts=4 sw=4 expandtab: */
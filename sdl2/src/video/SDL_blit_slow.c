@@ -46,6 +46,8 @@ SDL_Blit_Slow(SDL_BlitInfo * info)
     SDL_PixelFormat *dst_fmt = info->dst_fmt;
     int srcbpp = src_fmt->BytesPerPixel;
     int dstbpp = dst_fmt->BytesPerPixel;
+    const SDL_bool src_10bit = SDL_ISPIXELFORMAT_10BIT(src_fmt->format);
+    const SDL_bool dst_10bit = SDL_ISPIXELFORMAT_10BIT(dst_fmt->format);
     Uint32 rgbmask = ~src_fmt->Amask;
     Uint32 ckey = info->colorkey & rgbmask;
 
@@ -73,7 +75,10 @@ SDL_Blit_Slow(SDL_BlitInfo * info)
                 src =
                     (info->src + (srcy * info->src_pitch) + (srcx * srcbpp));
             }
-            if (src_fmt->Amask) {
+            if (src_10bit) {
+                srcpixel = *(Uint32 *) src;
+                RGBA_FROM_ARGB2101010(srcpixel, srcR, srcG, srcB, srcA);
+            } else if (src_fmt->Amask) {
                 DISEMBLE_RGBA(src, srcbpp, src_fmt, srcpixel, srcR, srcG,
                               srcB, srcA);
             } else {
@@ -93,7 +98,10 @@ SDL_Blit_Slow(SDL_BlitInfo * info)
                     continue;
                 }
             }
-            if (dst_fmt->Amask) {
+            if (dst_10bit) {
+                dstpixel = *(Uint32 *) dst;
+                RGBA_FROM_ARGB2101010(dstpixel, dstR, dstG, dstB, dstA);
+            } else if (dst_fmt->Amask) {
                 DISEMBLE_RGBA(dst, dstbpp, dst_fmt, dstpixel, dstR, dstG,
                               dstB, dstA);
             } else {
@@ -117,8 +125,14 @@ SDL_Blit_Slow(SDL_BlitInfo * info)
                     srcG = (srcG * srcA) / 255;
                     srcB = (srcB * srcA) / 255;
                 }
+            } else if ((flags & (SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_MODULATE_ALPHA)) ==
+                       (SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_MODULATE_ALPHA)) {
+                /* Premultiplied colors are scaled along with their alpha */
+                srcR = (srcR * modulateA) / 255;
+                srcG = (srcG * modulateA) / 255;
+                srcB = (srcB * modulateA) / 255;
             }
-            switch (flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) {
+            switch (flags & SDL_COPY_BLEND_MASK) {
             case 0:
                 dstR = srcR;
                 dstG = srcG;
@@ -131,6 +145,18 @@ SDL_Blit_Slow(SDL_BlitInfo * info)
                 dstB = srcB + ((255 - srcA) * dstB) / 255;
                 dstA = srcA + ((255 - srcA) * dstA) / 255;
                 break;
+            case SDL_COPY_BLEND_PREMULTIPLIED:
+                dstR = srcR + ((255 - srcA) * dstR) / 255;
+                if (dstR > 255)
+                    dstR = 255;
+                dstG = srcG + ((255 - srcA) * dstG) / 255;
+                if (dstG > 255)
+                    dstG = 255;
+                dstB = srcB + ((255 - srcA) * dstB) / 255;
+                if (dstB > 255)
+                    dstB = 255;
+                dstA = srcA + ((255 - srcA) * dstA) / 255;
+                break;
             case SDL_COPY_ADD:
                 dstR = srcR + dstR;
                 if (dstR > 255)
@@ -162,7 +188,10 @@ SDL_Blit_Slow(SDL_BlitInfo * info)
                     dstA = 255;
                 break;
             }
-            if (dst_fmt->Amask) {
+            if (dst_10bit) {
+                ARGB2101010_FROM_RGBA(dstpixel, dstR, dstG, dstB, dstA);
+                *(Uint32 *) dst = dstpixel;
+            } else if (dst_fmt->Amask) {
                 ASSEMBLE_RGBA(dst, dstbpp, dst_fmt, dstR, dstG, dstB, dstA);
             } else {
                 ASSEMBLE_RGB(dst, dstbpp, dst_fmt, dstR, dstG, dstB);
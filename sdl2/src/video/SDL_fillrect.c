@@ -25,6 +25,14 @@
 #include "SDL_cpuinfo.h"
 
 
+/* Fills larger than a typical last level cache go around it with streaming
+   stores. Smaller ones are likely to be drawn on right away, so they are
+   written normally */
+#define SDL_FILLRECT_STREAM_THRESHOLD   (8 * 1024 * 1024)
+
+#define SDL_FILLRECT_STREAM(bpp, w, h) \
+    ((size_t) (w) * (bpp) * (h) > SDL_FILLRECT_STREAM_THRESHOLD)
+
 #ifdef __SSE__
 /* *INDENT-OFF* */
 
@@ -47,20 +55,34 @@
 #endif
 
 #define SSE_WORK \
-    for (i = n / 64; i--;) { \
-        _mm_stream_ps((float *)(p+0), c128); \
-        _mm_stream_ps((float *)(p+16), c128); \
-        _mm_stream_ps((float *)(p+32), c128); \
-        _mm_stream_ps((float *)(p+48), c128); \
-        p += 64; \
+    if (stream) { \
+        for (i = n / 64; i--;) { \
+            _mm_stream_ps((float *)(p+0), c128); \
+            _mm_stream_ps((float *)(p+16), c128); \
+            _mm_stream_ps((float *)(p+32), c128); \
+            _mm_stream_ps((float *)(p+48), c128); \
+            p += 64; \
+        } \
+    } else { \
+        for (i = n / 64; i--;) { \
+            _mm_store_ps((float *)(p+0), c128); \
+            _mm_store_ps((float *)(p+16), c128); \
+            _mm_store_ps((float *)(p+32), c128); \
+            _mm_store_ps((float *)(p+48), c128); \
+            p += 64; \
+        } \
     }
 
-#define SSE_END
+#define SSE_END \
+    if (stream) { \
+        _mm_sfence(); \
+    }
 
 #define DEFINE_SSE_FILLRECT(bpp, type) \
 static void \
 SDL_FillRect##bpp##SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
 { \
+    const SDL_bool stream = SDL_FILLRECT_STREAM(bpp, w, h); \
     int i, n; \
     Uint8 *p = NULL; \
  \
@@ -99,6 +121,7 @@ SDL_FillRect##bpp##SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
 static void
 SDL_FillRect1SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
 {
+    const SDL_bool stream = SDL_FILLRECT_STREAM(1, w, h);
     int i, n;
 
     SSE_BEGIN;
@@ -129,8 +152,112 @@ DEFINE_SSE_FILLRECT(2, Uint16)
 DEFINE_SSE_FILLRECT(4, Uint32)
 
 /* *INDENT-ON* */
+
+/* 16 pixels are 48 bytes, so three vectors of the color pattern, starting at
+   whichever of its bytes lines up with the first aligned store of the row */
+static void
+SDL_FillRect3SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+    const SDL_bool stream = SDL_FILLRECT_STREAM(3, w, h);
+    Uint8 pattern[64 + 2];
+    __m128 c0, c1, c2;
+    int i, n, phase;
+
+    for (i = 0; i < (int) sizeof (pattern); i += 3) {
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        pattern[i] = (Uint8) (color & 0xFF);
+        pattern[i + 1] = (Uint8) ((color >> 8) & 0xFF);
+        pattern[i + 2] = (Uint8) ((color >> 16) & 0xFF);
+#else
+        pattern[i] = (Uint8) ((color >> 16) & 0xFF);
+        pattern[i + 1] = (Uint8) ((color >> 8) & 0xFF);
+        pattern[i + 2] = (Uint8) (color & 0xFF);
+#endif
+    }
+
+    while (h--) {
+        Uint8 *p = pixels;
+        n = w * 3;
+        phase = 0;
+
+        if (n > 63) {
+            const int adjust = (16 - ((uintptr_t)p & 15)) & 15;
+            SDL_memcpy(p, pattern, adjust);
+            p += adjust;
+            n -= adjust;
+            phase = adjust % 3;
+
+            c0 = _mm_loadu_ps((const float *)(pattern + phase));
+            c1 = _mm_loadu_ps((const float *)(pattern + phase + 16));
+            c2 = _mm_loadu_ps((const float *)(pattern + phase + 32));
+            if (stream) {
+                for (i = n / 48; i--;) {
+                    _mm_stream_ps((float *)(p+0), c0);
+                    _mm_stream_ps((float *)(p+16), c1);
+                    _mm_stream_ps((float *)(p+32), c2);
+                    p += 48;
+                }
+            } else {
+                for (i = n / 48; i--;) {
+                    _mm_store_ps((float *)(p+0), c0);
+                    _mm_store_ps((float *)(p+16), c1);
+                    _mm_store_ps((float *)(p+32), c2);
+                    p += 48;
+                }
+            }
+            n %= 48;
+        }
+        SDL_memcpy(p, pattern + phase, n);
+        pixels += pitch;
+    }
+
+    SSE_END;
+}
 #endif /* __SSE__ */
 
+#if HAVE_AVX2_INTRINSICS
+/* This needs AVX only, HAVE_AVX2_INTRINSICS tells that the compiler can target it */
+SDL_TARGETING("avx") static void
+SDL_FillRect4AVX(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+    const SDL_bool stream = SDL_FILLRECT_STREAM(4, w, h);
+    const __m256 c256 = _mm256_castsi256_ps(_mm256_set1_epi32((int) color));
+
+    while (h--) {
+        Uint32 *p = (Uint32 *) pixels;
+        int n = w;
+
+        while (n > 0 && ((uintptr_t) p & 31)) {
+            *p++ = color;
+            --n;
+        }
+        if (stream) {
+            for (; n >= 32; n -= 32, p += 32) {
+                _mm256_stream_ps((float *) (p + 0), c256);
+                _mm256_stream_ps((float *) (p + 8), c256);
+                _mm256_stream_ps((float *) (p + 16), c256);
+                _mm256_stream_ps((float *) (p + 24), c256);
+            }
+        } else {
+            for (; n >= 32; n -= 32, p += 32) {
+                _mm256_store_ps((float *) (p + 0), c256);
+                _mm256_store_ps((float *) (p + 8), c256);
+                _mm256_store_ps((float *) (p + 16), c256);
+                _mm256_store_ps((float *) (p + 24), c256);
+            }
+        }
+        while (n-- > 0) {
+            *p++ = color;
+        }
+        pixels += pitch;
+    }
+
+    if (stream) {
+        _mm_sfence();
+    }
+}
+#endif /* HAVE_AVX2_INTRINSICS */
+
 static void
 SDL_FillRect1(Uint8 * pixels, int pitch, Uint32 color, int w, int h)
 {
@@ -295,11 +422,94 @@ static void fill_32_simd(Uint8 * pixels, int pitch, Uint32 color, int w, int h)
 }
 #endif
 
+static int SDLCALL
+SDL_CompareFillRectColumns(const void *a, const void *b)
+{
+    const SDL_Rect *A = (const SDL_Rect *) a;
+    const SDL_Rect *B = (const SDL_Rect *) b;
+
+    if (A->x != B->x) {
+        return (A->x < B->x) ? -1 : 1;
+    }
+    if (A->w != B->w) {
+        return (A->w < B->w) ? -1 : 1;
+    }
+    return (A->y < B->y) ? -1 : (A->y > B->y);
+}
+
+static int SDLCALL
+SDL_CompareFillRectRows(const void *a, const void *b)
+{
+    const SDL_Rect *A = (const SDL_Rect *) a;
+    const SDL_Rect *B = (const SDL_Rect *) b;
+
+    if (A->y != B->y) {
+        return (A->y < B->y) ? -1 : 1;
+    }
+    if (A->h != B->h) {
+        return (A->h < B->h) ? -1 : 1;
+    }
+    return (A->x < B->x) ? -1 : (A->x > B->x);
+}
+
+/*
+ * Clip the rects and merge the ones that touch or overlap and span exactly
+ * the same columns (x and w) or rows (y and h). Runs of rects, like the
+ * points and lines of the software renderer, are then filled in one go.
+ * Other overlapping rects are kept as they are and still filled twice.
+ * Returns the number of rects left in 'merged'.
+ */
+static int
+SDL_MergeFillRects(const SDL_Rect * rects, int count, const SDL_Rect * clip_rect,
+                   SDL_Rect * merged)
+{
+    int i, n = 0;
+
+    for (i = 0; i < count; ++i) {
+        if (SDL_IntersectRect(&rects[i], clip_rect, &merged[n])) {
+            ++n;
+        }
+    }
+    if (n < 2) {
+        return n;
+    }
+
+    SDL_qsort(merged, n, sizeof (*merged), SDL_CompareFillRectColumns);
+    count = n;
+    n = 0;
+    for (i = 1; i < count; ++i) {
+        SDL_Rect *last = &merged[n];
+        const SDL_Rect *rect = &merged[i];
+        if (rect->x == last->x && rect->w == last->w && rect->y <= last->y + last->h) {
+            last->h = SDL_max(last->h, rect->y + rect->h - last->y);
+        } else {
+            merged[++n] = *rect;
+        }
+    }
+    ++n;
+
+    SDL_qsort(merged, n, sizeof (*merged), SDL_CompareFillRectRows);
+    count = n;
+    n = 0;
+    for (i = 1; i < count; ++i) {
+        SDL_Rect *last = &merged[n];
+        const SDL_Rect *rect = &merged[i];
+        if (rect->y == last->y && rect->h == last->h && rect->x <= last->x + last->w) {
+            last->w = SDL_max(last->w, rect->x + rect->w - last->x);
+        } else {
+            merged[++n] = *rect;
+        }
+    }
+    return n + 1;
+}
+
 int
 SDL_FillRects(SDL_Surface * dst, const SDL_Rect * rects, int count,
               Uint32 color)
 {
     SDL_Rect clipped;
+    SDL_Rect *merged = NULL;
+    SDL_bool isstack = SDL_FALSE;
     Uint8 *pixels;
     const SDL_Rect* rect;
     void (*fill_function)(Uint8 * pixels, int pitch, Uint32 color, int w, int h) = NULL;
@@ -384,14 +594,25 @@ SDL_FillRects(SDL_Surface * dst, const SDL_Rect * rects, int count,
             }
 
         case 3:
-            /* 24-bit RGB is a slow path, at least for now. */
             {
+#ifdef __SSE__
+                if (SDL_HasSSE()) {
+                    fill_function = SDL_FillRect3SSE;
+                    break;
+                }
+#endif
                 fill_function = SDL_FillRect3;
                 break;
             }
 
         case 4:
             {
+#if HAVE_AVX2_INTRINSICS
+                if (SDL_HasAVX()) {
+                    fill_function = SDL_FillRect4AVX;
+                    break;
+                }
+#endif
 #ifdef __SSE__
                 if (SDL_HasSSE()) {
                     fill_function = SDL_FillRect4SSE;
@@ -407,13 +628,23 @@ SDL_FillRects(SDL_Surface * dst, const SDL_Rect * rects, int count,
         }
     }
 
+    if (count > 1) {
+        merged = SDL_small_alloc(SDL_Rect, count, &isstack);
+        if (merged) {
+            count = SDL_MergeFillRects(rects, count, &dst->clip_rect, merged);
+            rects = merged;
+        }
+    }
+
     for (i = 0; i < count; ++i) {
         rect = &rects[i];
-        /* Perform clipping */
-        if (!SDL_IntersectRect(rect, &dst->clip_rect, &clipped)) {
-            continue;
+        /* Perform clipping, the merged rects are clipped already */
+        if (!merged) {
+            if (!SDL_IntersectRect(rect, &dst->clip_rect, &clipped)) {
+                continue;
+            }
+            rect = &clipped;
         }
-        rect = &clipped;
 
         pixels = (Uint8 *) dst->pixels + rect->y * dst->pitch +
                                          rect->x * dst->format->BytesPerPixel;
@@ -421,6 +652,10 @@ SDL_FillRects(SDL_Surface * dst, const SDL_Rect * rects, int count,
         fill_function(pixels, dst->pitch, color, rect->w, rect->h);
     }
 
+    if (merged) {
+        SDL_small_free(merged, isstack);
+    }
+
     /* We're done! */
     return 0;
 }
@@ -642,6 +642,208 @@ SDL_FreeFormat(SDL_PixelFormat *format)
     SDL_free(format);
 }
 
+/*
+ * Nearest color lookups in larger palettes go through a k-d tree over the
+ * r, g, b, a components, built on first use. Trees are kept for the last few
+ * palettes, keyed by the palette version that SDL_SetPaletteColors() bumps.
+ */
+#define PALETTE_TREE_MIN_COLORS 16
+#define PALETTE_TREE_CACHE_SIZE 8
+
+typedef struct
+{
+    SDL_Color color;
+    Uint8 index;    /* of the color in the palette */
+    Uint8 axis;     /* component that splits the nodes below */
+} SDL_PaletteTreeNode;
+
+typedef struct
+{
+    const SDL_Palette *palette;
+    const SDL_Color *colors;
+    int ncolors;
+    Uint32 version;
+    SDL_PaletteTreeNode nodes[256];
+} SDL_PaletteTree;
+
+static SDL_PaletteTree *palette_trees[PALETTE_TREE_CACHE_SIZE];
+static int next_palette_tree = 0;
+static SDL_SpinLock palette_trees_lock = 0;
+
+#define NODE_COMPONENT(node, axis) (((const Uint8 *) &(node)->color)[axis])
+
+/* Reorders nodes[lo..hi) so that nodes[k] is the k-th smallest along axis */
+static void
+SelectPaletteTreeNodes(SDL_PaletteTreeNode * nodes, int lo, int hi, int k, int axis)
+{
+    while (hi - lo > 1) {
+        const Uint8 pivot = NODE_COMPONENT(&nodes[(lo + hi) / 2], axis);
+        int i = lo, j = hi - 1;
+
+        while (i <= j) {
+            while (NODE_COMPONENT(&nodes[i], axis) < pivot) {
+                ++i;
+            }
+            while (NODE_COMPONENT(&nodes[j], axis) > pivot) {
+                --j;
+            }
+            if (i <= j) {
+                const SDL_PaletteTreeNode tmp = nodes[i];
+                nodes[i++] = nodes[j];
+                nodes[j--] = tmp;
+            }
+        }
+        if (k <= j) {
+            hi = j + 1;
+        } else if (k >= i) {
+            lo = i;
+        } else {
+            return;
+        }
+    }
+}
+
+/* The node for nodes[lo..hi) is the median at (lo + hi) / 2, split along
+   the component with the widest range */
+static void
+BuildPaletteTree(SDL_PaletteTreeNode * nodes, int lo, int hi)
+{
+    while (hi - lo > 1) {
+        const int mid = (lo + hi) / 2;
+        Uint8 min[4] = { 255, 255, 255, 255 }, max[4] = { 0, 0, 0, 0 };
+        int i, axis, best = -1;
+
+        for (i = lo; i < hi; ++i) {
+            for (axis = 0; axis < 4; ++axis) {
+                min[axis] = SDL_min(min[axis], NODE_COMPONENT(&nodes[i], axis));
+                max[axis] = SDL_max(max[axis], NODE_COMPONENT(&nodes[i], axis));
+            }
+        }
+        for (axis = 0; axis < 4; ++axis) {
+            if (max[axis] - min[axis] > best) {
+                best = max[axis] - min[axis];
+                nodes[mid].axis = (Uint8) axis;
+            }
+        }
+        axis = nodes[mid].axis;
+        SelectPaletteTreeNodes(nodes, lo, hi, mid, axis);
+        nodes[mid].axis = (Uint8) axis;
+        BuildPaletteTree(nodes, lo, mid);
+        lo = mid + 1;
+    }
+}
+
+/* Finds the same color as the linear search, the lowest index among the
+   closest ones, so subtrees at exactly the best distance are searched too */
+static void
+SearchPaletteTree(const SDL_PaletteTreeNode * nodes, int lo, int hi, const Uint8 * color,
+                  unsigned int *smallest, int *pixel)
+{
+    while (lo < hi) {
+        const int mid = (lo + hi) / 2;
+        const SDL_PaletteTreeNode *node = &nodes[mid];
+        const int rd = node->color.r - color[0];
+        const int gd = node->color.g - color[1];
+        const int bd = node->color.b - color[2];
+        const int ad = node->color.a - color[3];
+        const unsigned int distance = (rd * rd) + (gd * gd) + (bd * bd) + (ad * ad);
+        const int split = color[node->axis] - NODE_COMPONENT(node, node->axis);
+
+        if (distance < *smallest || (distance == *smallest && node->index < *pixel)) {
+            *smallest = distance;
+            *pixel = node->index;
+        }
+        if (hi - lo == 1) {
+            return;
+        }
+        if (split < 0) {
+            SearchPaletteTree(nodes, lo, mid, color, smallest, pixel);
+            if ((unsigned int) (split * split) > *smallest) {
+                return;
+            }
+            lo = mid + 1;
+        } else {
+            SearchPaletteTree(nodes, mid + 1, hi, color, smallest, pixel);
+            if ((unsigned int) (split * split) > *smallest) {
+                return;
+            }
+            hi = mid;
+        }
+    }
+}
+
+static SDL_PaletteTree *
+GetPaletteTree(const SDL_Palette * pal)
+{
+    SDL_PaletteTree *tree = NULL;
+    int i;
+
+    for (i = 0; i < PALETTE_TREE_CACHE_SIZE; ++i) {
+        if (palette_trees[i] && palette_trees[i]->palette == pal) {
+            tree = palette_trees[i];
+            if (tree->version == pal->version && tree->colors == pal->colors &&
+                tree->ncolors == pal->ncolors) {
+                return tree;
+            }
+            break;
+        }
+    }
+
+    if (!tree) {
+        /* Replace the oldest tree */
+        i = next_palette_tree;
+        next_palette_tree = (next_palette_tree + 1) % PALETTE_TREE_CACHE_SIZE;
+        if (!palette_trees[i]) {
+            palette_trees[i] = (SDL_PaletteTree *) SDL_malloc(sizeof(SDL_PaletteTree));
+            if (!palette_trees[i]) {
+                return NULL;
+            }
+        }
+        tree = palette_trees[i];
+    }
+
+    tree->palette = pal;
+    tree->colors = pal->colors;
+    tree->ncolors = pal->ncolors;
+    tree->version = pal->version;
+    for (i = 0; i < pal->ncolors; ++i) {
+        tree->nodes[i].color = pal->colors[i];
+        tree->nodes[i].index = (Uint8) i;
+        tree->nodes[i].axis = 0;
+    }
+    BuildPaletteTree(tree->nodes, 0, pal->ncolors);
+    return tree;
+}
+
+/* Drops the tree of a palette that is going away */
+static void
+FreePaletteTree(const SDL_Palette * pal)
+{
+    int i;
+
+    SDL_AtomicLock(&palette_trees_lock);
+    for (i = 0; i < PALETTE_TREE_CACHE_SIZE; ++i) {
+        if (palette_trees[i] && palette_trees[i]->palette == pal) {
+            palette_trees[i]->palette = NULL;
+        }
+    }
+    SDL_AtomicUnlock(&palette_trees_lock);
+}
+
+void
+SDL_QuitPaletteTrees(void)
+{
+    int i;
+
+    SDL_AtomicLock(&palette_trees_lock);
+    for (i = 0; i < PALETTE_TREE_CACHE_SIZE; ++i) {
+        SDL_free(palette_trees[i]);
+        palette_trees[i] = NULL;
+    }
+    next_palette_tree = 0;
+    SDL_AtomicUnlock(&palette_trees_lock);
+}
+
 SDL_Palette *
 SDL_AllocPalette(int ncolors)
 {
@@ -738,6 +940,7 @@ SDL_FreePalette(SDL_Palette * palette)
     if (--palette->refcount > 0) {
         return;
     }
+    FreePaletteTree(palette);
     SDL_free(palette->colors);
     SDL_free(palette);
 }
@@ -783,6 +986,24 @@ SDL_FindColor(SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
     int i;
     Uint8 pixel = 0;
 
+    if (pal->ncolors > PALETTE_TREE_MIN_COLORS && pal->ncolors <= 256) {
+        SDL_PaletteTree *tree;
+        const Uint8 color[4] = { r, g, b, a };
+        int found = -1;
+
+        SDL_AtomicLock(&palette_trees_lock);
+        tree = GetPaletteTree(pal);
+        if (tree) {
+            smallest = ~0;
+            found = 256;
+            SearchPaletteTree(tree->nodes, 0, tree->ncolors, color, &smallest, &found);
+        }
+        SDL_AtomicUnlock(&palette_trees_lock);
+        if (found >= 0) {
+            return (Uint8) found;
+        }
+    }
+
     smallest = ~0;
     for (i = 0; i < pal->ncolors; ++i) {
         rd = pal->colors[i].r - r;
@@ -801,11 +1022,23 @@ SDL_FindColor(SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
     return (pixel);
 }
 
+/* The masks of 10-bit formats don't fit the Rloss and friends math */
+static Uint32
+Map10Bit(unsigned r, unsigned g, unsigned b, unsigned a)
+{
+    Uint32 pixel;
+
+    ARGB2101010_FROM_RGBA(pixel, r, g, b, a);
+    return pixel;
+}
+
 /* Find the opaque pixel value corresponding to an RGB triple */
 Uint32
 SDL_MapRGB(const SDL_PixelFormat * format, Uint8 r, Uint8 g, Uint8 b)
 {
-    if (format->palette == NULL) {
+    if (SDL_ISPIXELFORMAT_10BIT(format->format)) {
+        return Map10Bit(r, g, b, SDL_ALPHA_OPAQUE);
+    } else if (format->palette == NULL) {
         return (r >> format->Rloss) << format->Rshift
             | (g >> format->Gloss) << format->Gshift
             | (b >> format->Bloss) << format->Bshift | format->Amask;
@@ -819,7 +1052,9 @@ Uint32
 SDL_MapRGBA(const SDL_PixelFormat * format, Uint8 r, Uint8 g, Uint8 b,
             Uint8 a)
 {
-    if (format->palette == NULL) {
+    if (SDL_ISPIXELFORMAT_10BIT(format->format)) {
+        return Map10Bit(r, g, b, a);
+    } else if (format->palette == NULL) {
         return (r >> format->Rloss) << format->Rshift
             | (g >> format->Gloss) << format->Gshift
             | (b >> format->Bloss) << format->Bshift
@@ -833,7 +1068,11 @@ void
 SDL_GetRGB(Uint32 pixel, const SDL_PixelFormat * format, Uint8 * r, Uint8 * g,
            Uint8 * b)
 {
-    if (format->palette == NULL) {
+    if (SDL_ISPIXELFORMAT_10BIT(format->format)) {
+        Uint8 a;
+        RGBA_FROM_ARGB2101010(pixel, *r, *g, *b, a);
+        (void) a;
+    } else if (format->palette == NULL) {
         unsigned v;
         v = (pixel & format->Rmask) >> format->Rshift;
         *r = SDL_expand_byte[format->Rloss][v];
@@ -856,7 +1095,9 @@ void
 SDL_GetRGBA(Uint32 pixel, const SDL_PixelFormat * format,
             Uint8 * r, Uint8 * g, Uint8 * b, Uint8 * a)
 {
-    if (format->palette == NULL) {
+    if (SDL_ISPIXELFORMAT_10BIT(format->format)) {
+        RGBA_FROM_ARGB2101010(pixel, *r, *g, *b, *a);
+    } else if (format->palette == NULL) {
         unsigned v;
         v = (pixel & format->Rmask) >> format->Rshift;
         *r = SDL_expand_byte[format->Rloss][v];
@@ -923,7 +1164,8 @@ Map1toN(SDL_PixelFormat * src, Uint8 Rmod, Uint8 Gmod, Uint8 Bmod, Uint8 Amod,
     SDL_Palette *pal = src->palette;
 
     bpp = ((dst->BytesPerPixel == 3) ? 4 : dst->BytesPerPixel);
-    map = (Uint8 *) SDL_malloc(pal->ncolors * bpp);
+    /* Padded so the SIMD blitters can read any entry as a 32-bit word */
+    map = (Uint8 *) SDL_malloc(pal->ncolors * bpp + 2);
     if (map == NULL) {
         SDL_OutOfMemory();
         return (NULL);
@@ -975,6 +1217,19 @@ SDL_AllocBlitMap(void)
     return (map);
 }
 
+static SDL_bool
+IsCachedTable(const SDL_BlitMap * map, const Uint8 * table)
+{
+    int i;
+
+    for (i = 0; i < map->num_cached; ++i) {
+        if (map->cache[i].table == table) {
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
 void
 SDL_InvalidateMap(SDL_BlitMap * map)
 {
@@ -988,18 +1243,110 @@ SDL_InvalidateMap(SDL_BlitMap * map)
         }
     }
     map->dst = NULL;
+    map->kind = NULL;
     map->src_palette_version = 0;
     map->dst_palette_version = 0;
-    SDL_free(map->info.table);
+    if (!IsCachedTable(map, map->info.table)) {
+        SDL_free(map->info.table);
+    }
     map->info.table = NULL;
 }
 
+void
+SDL_FlushBlitMapCache(SDL_BlitMap * map)
+{
+    int i;
+
+    if (!map) {
+        return;
+    }
+    SDL_InvalidateMap(map);
+    for (i = 0; i < map->num_cached; ++i) {
+        SDL_free(map->cache[i].table);
+    }
+    map->num_cached = 0;
+    map->next_cached = 0;
+}
+
+/* Mappings to indexed surfaces depend on the palette contents, and RLE
+   encoding lives in the surface, so neither of those are cached. */
+static SDL_bool
+CanCacheMapping(SDL_BlitMap * map, SDL_Surface * dst)
+{
+    if (SDL_ISPIXELFORMAT_INDEXED(dst->format->format) ||
+        (map->info.flags & SDL_COPY_RLE_DESIRED)) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static SDL_bool
+IsSameMapping(const SDL_BlitMapCacheEntry * entry, SDL_Surface * src, SDL_Surface * dst)
+{
+    const SDL_BlitInfo *info = &src->map->info;
+
+    if (entry->dst_format != dst->format->format || entry->flags != info->flags) {
+        return SDL_FALSE;
+    }
+    /* The color table of indexed sources has the modulation baked in */
+    if (src->format->palette &&
+        (entry->src_palette_version != src->format->palette->version ||
+         entry->r != info->r || entry->g != info->g || entry->b != info->b || entry->a != info->a)) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static SDL_BlitMapCacheEntry *
+FindCachedMapping(SDL_Surface * src, SDL_Surface * dst)
+{
+    SDL_BlitMap *map = src->map;
+    int i;
+
+    for (i = 0; i < map->num_cached; ++i) {
+        if (IsSameMapping(&map->cache[i], src, dst)) {
+            return &map->cache[i];
+        }
+    }
+    return NULL;
+}
+
+/* Remembers the mapping just calculated, replacing the oldest one when full */
+static void
+CacheMapping(SDL_Surface * src, SDL_Surface * dst)
+{
+    SDL_BlitMap *map = src->map;
+    SDL_BlitMapCacheEntry *entry;
+
+    if (map->num_cached < SDL_BLITMAP_CACHE_SIZE) {
+        entry = &map->cache[map->num_cached++];
+    } else {
+        entry = &map->cache[map->next_cached];
+        map->next_cached = (map->next_cached + 1) % SDL_BLITMAP_CACHE_SIZE;
+        SDL_free(entry->table);
+    }
+    entry->dst_format = dst->format->format;
+    entry->flags = map->info.flags;
+    entry->r = map->info.r;
+    entry->g = map->info.g;
+    entry->b = map->info.b;
+    entry->a = map->info.a;
+    entry->src_palette_version = map->src_palette_version;
+    entry->identity = map->identity;
+    entry->blit = map->blit;
+    entry->data = map->data;
+    entry->kind = map->kind;
+    entry->table = map->info.table;
+}
+
 int
 SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst)
 {
     SDL_PixelFormat *srcfmt;
     SDL_PixelFormat *dstfmt;
     SDL_BlitMap *map;
+    SDL_BlitMapCacheEntry *cached = NULL;
+    SDL_bool cacheable;
 
     /* Clear out any previous mapping */
     map = src->map;
@@ -1014,7 +1361,14 @@ SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst)
     map->identity = 0;
     srcfmt = src->format;
     dstfmt = dst->format;
-    if (SDL_ISPIXELFORMAT_INDEXED(srcfmt->format)) {
+    cacheable = CanCacheMapping(map, dst);
+    if (cacheable) {
+        cached = FindCachedMapping(src, dst);
+    }
+    if (cached) {
+        map->identity = cached->identity;
+        map->info.table = cached->table;
+    } else if (SDL_ISPIXELFORMAT_INDEXED(srcfmt->format)) {
         if (SDL_ISPIXELFORMAT_INDEXED(dstfmt->format)) {
             /* Palette --> Palette */
             map->info.table =
@@ -1078,15 +1432,32 @@ SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst)
         map->src_palette_version = 0;
     }
 
+    if (cached) {
+        map->blit = cached->blit;
+        map->data = cached->data;
+        map->kind = cached->kind;
+        map->info.src_fmt = srcfmt;
+        map->info.src_pitch = src->pitch;
+        map->info.dst_fmt = dstfmt;
+        map->info.dst_pitch = dst->pitch;
+        return 0;
+    }
+
     /* Choose your blitters wisely */
-    return (SDL_CalculateBlit(src));
+    if (SDL_CalculateBlit(src) < 0) {
+        return -1;
+    }
+    if (cacheable) {
+        CacheMapping(src, dst);
+    }
+    return 0;
 }
 
 void
 SDL_FreeBlitMap(SDL_BlitMap * map)
 {
     if (map) {
-        SDL_InvalidateMap(map);
+        SDL_FlushBlitMapCache(map);
         SDL_free(map);
     }
 }
@@ -34,6 +34,7 @@ extern int SDL_InitFormat(SDL_PixelFormat * format, Uint32 pixel_format);
 /* Blit mapping functions */
 extern SDL_BlitMap *SDL_AllocBlitMap(void);
 extern void SDL_InvalidateMap(SDL_BlitMap * map);
+extern void SDL_FlushBlitMapCache(SDL_BlitMap * map);
 extern int SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst);
 extern void SDL_FreeBlitMap(SDL_BlitMap * map);
 
@@ -41,6 +42,9 @@ extern void SDL_FreeBlitMap(SDL_BlitMap * map);
 extern void SDL_DitherColors(SDL_Color * colors, int bpp);
 extern Uint8 SDL_FindColor(SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
 
+/* Frees the nearest color lookup trees kept for palettes, from SDL_Quit() */
+extern void SDL_QuitPaletteTrees(void);
+
 #endif /* SDL_pixels_c_h_ */
 
 /* vi: set ts=4 sw=4 expandtab: */
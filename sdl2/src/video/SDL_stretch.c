@@ -196,12 +196,372 @@ copy_row3(Uint8 * src, int src_w, Uint8 * dst, int dst_w)
     }
 }
 
+/* Bilinear stretching of 32-bit pixels with 8-bit channels.
+
+   Every destination pixel samples the source at its center, so the image
+   doesn't shift, and samples past the outermost source pixels are clamped to
+   them. Two source rows are blended into a temporary row first, then pairs of
+   pixels of that row are blended into the destination. Weights have 8 bits of
+   precision and every channel is rounded the same way in all the code paths
+   below, so the SIMD ones draw exactly what the scalar one does.
+*/
+
+#define LINEAR_WEIGHTS  8   /* weights for the left pixel x4, then the right one x4 */
+
+typedef void (*SDL_LinearRowsFunc) (const Uint32 *a, const Uint32 *b, Uint32 *out, int count, int f);
+typedef void (*SDL_LinearColumnsFunc) (const Uint32 *row, const int *columns, const Uint16 *weights, Uint32 *out, int count);
+
+/* Position of the center of destination pixel i in the source, in 16.16 fixed
+   point, clamped to the centers of the first and last source pixels */
+static int
+LinearSourcePosition(int i, int src_size, int dst_size)
+{
+    const Sint64 pos = ((Sint64) (2 * i + 1) * src_size * 0x10000) / (2 * dst_size) - 0x8000;
+    const Sint64 max = (Sint64) (src_size - 1) << 16;
+
+    return (int) (pos < 0 ? 0 : (pos > max ? max : pos));
+}
+
+/* (a * (256 - f) + b * f + 128) / 256 for each channel, two channels at a time */
+static SDL_INLINE Uint32
+LinearBlend(Uint32 a, Uint32 b, int f)
+{
+    const Uint32 g = 256 - f;
+    const Uint32 rb = ((a & 0x00FF00FF) * g + (b & 0x00FF00FF) * f + 0x00800080) >> 8;
+    const Uint32 ag = ((a >> 8) & 0x00FF00FF) * g + ((b >> 8) & 0x00FF00FF) * f + 0x00800080;
+
+    return (rb & 0x00FF00FF) | (ag & 0xFF00FF00);
+}
+
+static void
+LinearRows_Scalar(const Uint32 *a, const Uint32 *b, Uint32 *out, int count, int f)
+{
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        out[i] = LinearBlend(a[i], b[i], f);
+    }
+}
+
+static void
+LinearColumns_Scalar(const Uint32 *row, const int *columns, const Uint16 *weights, Uint32 *out, int count)
+{
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        const int x = columns[i];
+        const int f = weights[i * LINEAR_WEIGHTS + 4];
+
+        /* The last source pixel is only ever sampled with f == 0 */
+        out[i] = f ? LinearBlend(row[x], row[x + 1], f) : row[x];
+    }
+}
+
+#if HAVE_SSE2_INTRINSICS
+static void
+LinearRows_SSE2(const Uint32 *a, const Uint32 *b, Uint32 *out, int count, int f)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i wa = _mm_set1_epi16((short) (256 - f));
+    const __m128i wb = _mm_set1_epi16((short) f);
+    const __m128i round = _mm_set1_epi16(128);
+    int i;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const __m128i pa = _mm_loadu_si128((const __m128i *) (a + i));
+        const __m128i pb = _mm_loadu_si128((const __m128i *) (b + i));
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(pa, zero), wa),
+                                   _mm_mullo_epi16(_mm_unpacklo_epi8(pb, zero), wb));
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(pa, zero), wa),
+                                   _mm_mullo_epi16(_mm_unpackhi_epi8(pb, zero), wb));
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, round), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, round), 8);
+        _mm_storeu_si128((__m128i *) (out + i), _mm_packus_epi16(lo, hi));
+    }
+    LinearRows_Scalar(a + i, b + i, out + i, count - i, f);
+}
+
+/* Blends the two pixels loaded at p with the weights w, for two outputs */
+static SDL_INLINE __m128i
+LinearPair_SSE2(__m128i p, __m128i w0, __m128i w1)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(p, zero), w0);
+    const __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(p, zero), w1);
+    const __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+
+    return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(128)), 8);
+}
+
+static void
+LinearColumns_SSE2(const Uint32 *row, const int *columns, const Uint16 *weights, Uint32 *out, int count)
+{
+    int i;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const __m128i p01 = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *) (row + columns[i])),
+                                               _mm_loadl_epi64((const __m128i *) (row + columns[i + 1])));
+        const __m128i p23 = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *) (row + columns[i + 2])),
+                                               _mm_loadl_epi64((const __m128i *) (row + columns[i + 3])));
+        const Uint16 *w = weights + i * LINEAR_WEIGHTS;
+        const __m128i r01 = LinearPair_SSE2(p01, _mm_loadu_si128((const __m128i *) w),
+                                            _mm_loadu_si128((const __m128i *) (w + LINEAR_WEIGHTS)));
+        const __m128i r23 = LinearPair_SSE2(p23, _mm_loadu_si128((const __m128i *) (w + 2 * LINEAR_WEIGHTS)),
+                                            _mm_loadu_si128((const __m128i *) (w + 3 * LINEAR_WEIGHTS)));
+        _mm_storeu_si128((__m128i *) (out + i), _mm_packus_epi16(r01, r23));
+    }
+    LinearColumns_Scalar(row, columns + i, weights + i * LINEAR_WEIGHTS, out + i, count - i);
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_AVX2_INTRINSICS
+SDL_TARGETING("avx2") static void
+LinearRows_AVX2(const Uint32 *a, const Uint32 *b, Uint32 *out, int count, int f)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i wa = _mm256_set1_epi16((short) (256 - f));
+    const __m256i wb = _mm256_set1_epi16((short) f);
+    const __m256i round = _mm256_set1_epi16(128);
+    int i;
+
+    for (i = 0; i + 8 <= count; i += 8) {
+        const __m256i pa = _mm256_loadu_si256((const __m256i *) (a + i));
+        const __m256i pb = _mm256_loadu_si256((const __m256i *) (b + i));
+        __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(pa, zero), wa),
+                                      _mm256_mullo_epi16(_mm256_unpacklo_epi8(pb, zero), wb));
+        __m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(pa, zero), wa),
+                                      _mm256_mullo_epi16(_mm256_unpackhi_epi8(pb, zero), wb));
+        lo = _mm256_srli_epi16(_mm256_add_epi16(lo, round), 8);
+        hi = _mm256_srli_epi16(_mm256_add_epi16(hi, round), 8);
+        _mm256_storeu_si256((__m256i *) (out + i), _mm256_packus_epi16(lo, hi));
+    }
+    LinearRows_Scalar(a + i, b + i, out + i, count - i, f);
+}
+
+SDL_TARGETING("avx2") static void
+LinearColumns_AVX2(const Uint32 *row, const int *columns, const Uint16 *weights, Uint32 *out, int count)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i round = _mm256_set1_epi16(128);
+    int i;
+
+    /* Each 128-bit lane blends two pairs of pixels, like LinearPair_SSE2() */
+    for (i = 0; i + 4 <= count; i += 4) {
+        const Uint16 *w = weights + i * LINEAR_WEIGHTS;
+        const __m128i p01 = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *) (row + columns[i])),
+                                               _mm_loadl_epi64((const __m128i *) (row + columns[i + 1])));
+        const __m128i p23 = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *) (row + columns[i + 2])),
+                                               _mm_loadl_epi64((const __m128i *) (row + columns[i + 3])));
+        const __m256i p = _mm256_inserti128_si256(_mm256_castsi128_si256(p01), p23, 1);
+        const __m256i w02 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) w)),
+                                                    _mm_loadu_si128((const __m128i *) (w + 2 * LINEAR_WEIGHTS)), 1);
+        const __m256i w13 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) (w + LINEAR_WEIGHTS))),
+                                                    _mm_loadu_si128((const __m128i *) (w + 3 * LINEAR_WEIGHTS)), 1);
+        const __m256i lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(p, zero), w02);
+        const __m256i hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(p, zero), w13);
+        __m256i sum = _mm256_add_epi16(_mm256_unpacklo_epi64(lo, hi), _mm256_unpackhi_epi64(lo, hi));
+        sum = _mm256_srli_epi16(_mm256_add_epi16(sum, round), 8);
+        sum = _mm256_packus_epi16(sum, sum);
+        _mm_storeu_si128((__m128i *) (out + i),
+                         _mm_unpacklo_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1)));
+    }
+    LinearColumns_Scalar(row, columns + i, weights + i * LINEAR_WEIGHTS, out + i, count - i);
+}
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+static void
+LinearRows_NEON(const Uint32 *a, const Uint32 *b, Uint32 *out, int count, int f)
+{
+    const uint16_t wa = (uint16_t) (256 - f);
+    const uint16_t wb = (uint16_t) f;
+    int i;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        const uint8x16_t pa = vld1q_u8((const uint8_t *) (a + i));
+        const uint8x16_t pb = vld1q_u8((const uint8_t *) (b + i));
+        const uint16x8_t lo = vmlaq_n_u16(vmulq_n_u16(vmovl_u8(vget_low_u8(pa)), wa), vmovl_u8(vget_low_u8(pb)), wb);
+        const uint16x8_t hi = vmlaq_n_u16(vmulq_n_u16(vmovl_u8(vget_high_u8(pa)), wa), vmovl_u8(vget_high_u8(pb)), wb);
+        vst1q_u8((uint8_t *) (out + i), vcombine_u8(vmovn_u16(vrshrq_n_u16(lo, 8)), vmovn_u16(vrshrq_n_u16(hi, 8))));
+    }
+    LinearRows_Scalar(a + i, b + i, out + i, count - i, f);
+}
+
+static void
+LinearColumns_NEON(const Uint32 *row, const int *columns, const Uint16 *weights, Uint32 *out, int count)
+{
+    int i;
+
+    for (i = 0; i + 2 <= count; i += 2) {
+        const uint16x8_t m0 = vmulq_u16(vmovl_u8(vld1_u8((const uint8_t *) (row + columns[i]))),
+                                        vld1q_u16(weights + i * LINEAR_WEIGHTS));
+        const uint16x8_t m1 = vmulq_u16(vmovl_u8(vld1_u8((const uint8_t *) (row + columns[i + 1]))),
+                                        vld1q_u16(weights + (i + 1) * LINEAR_WEIGHTS));
+        const uint16x4_t r0 = vrshr_n_u16(vadd_u16(vget_low_u16(m0), vget_high_u16(m0)), 8);
+        const uint16x4_t r1 = vrshr_n_u16(vadd_u16(vget_low_u16(m1), vget_high_u16(m1)), 8);
+        vst1_u8((uint8_t *) (out + i), vmovn_u16(vcombine_u16(r0, r1)));
+    }
+    LinearColumns_Scalar(row, columns + i, weights + i * LINEAR_WEIGHTS, out + i, count - i);
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
+/* Bilinear stretch of srcrect into dstrect, drawing only the part of dstrect
+   that is inside area. Keeping the unclipped dstrect means that clipping
+   doesn't change where the source is sampled. The source must have a 32-bit
+   format and the rectangles must be inside the surfaces.
+   Without a blitter, dst must have the same format and the pixels are
+   stored. Otherwise every stretched row is passed to blit with a copy of
+   info, so it can be modulated and blended onto any destination format. */
+int
+SDL_LowerSoftStretchLinear(SDL_Surface * src, const SDL_Rect * srcrect,
+                           SDL_Surface * dst, const SDL_Rect * dstrect,
+                           const SDL_Rect * area,
+                           SDL_BlitFunc blit, const SDL_BlitInfo * info)
+{
+    SDL_LinearRowsFunc blend_rows = LinearRows_Scalar;
+    SDL_LinearColumnsFunc blend_columns = LinearColumns_Scalar;
+    const int features = SDL_GetBlitCPUFeatures();
+    Uint16 *weights;
+    int *columns;
+    Uint32 *row, *out = NULL;
+    int first, last, simd_count;
+    int i, j;
+    int src_locked = 0;
+    int dst_locked = 0;
+
+    if (!blit && src->format->format != dst->format->format) {
+        return SDL_SetError("Only works with same format surfaces");
+    }
+    if (!SDL_ISPIXELFORMAT_LINEAR_STRETCH(src->format->format)) {
+        return SDL_SetError("Linear stretching only works with 32-bit formats with 8-bit channels");
+    }
+    if (area->w <= 0 || area->h <= 0 || srcrect->w <= 0 || srcrect->h <= 0) {
+        return 0;
+    }
+
+#if HAVE_SSE2_INTRINSICS
+    if (features & SDL_CPU_SSE2) {
+        blend_rows = LinearRows_SSE2;
+        blend_columns = LinearColumns_SSE2;
+    }
+#endif
+#if HAVE_AVX2_INTRINSICS
+    if (features & SDL_CPU_AVX2) {
+        blend_rows = LinearRows_AVX2;
+        blend_columns = LinearColumns_AVX2;
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (features & SDL_CPU_NEON) {
+        blend_rows = LinearRows_NEON;
+        blend_columns = LinearColumns_NEON;
+    }
+#endif
+
+    weights = (Uint16 *) SDL_malloc(area->w * (LINEAR_WEIGHTS * sizeof(Uint16) + sizeof(int)) +
+                                    (srcrect->w + (blit ? area->w : 0)) * sizeof(Uint32));
+    if (!weights) {
+        return SDL_OutOfMemory();
+    }
+    columns = (int *) (weights + area->w * LINEAR_WEIGHTS);
+    row = (Uint32 *) (columns + area->w);
+    if (blit) {
+        out = row + srcrect->w;
+    }
+
+    /* The columns of every destination pixel are the same for all rows */
+    for (i = 0; i < area->w; ++i) {
+        const int pos = LinearSourcePosition(area->x - dstrect->x + i, srcrect->w, dstrect->w);
+        const Uint16 f = (Uint16) ((pos >> 8) & 0xFF);
+
+        columns[i] = pos >> 16;
+        for (j = 0; j < 4; ++j) {
+            weights[i * LINEAR_WEIGHTS + j] = 256 - f;
+            weights[i * LINEAR_WEIGHTS + 4 + j] = f;
+        }
+    }
+
+    /* The SIMD code always reads the pixel after each column, so it stops
+       before the columns that sample the last source pixel */
+    for (simd_count = area->w; simd_count > 0; --simd_count) {
+        if (columns[simd_count - 1] + 1 < srcrect->w) {
+            break;
+        }
+    }
+    first = columns[0];
+    last = SDL_min(columns[area->w - 1] + 1, srcrect->w - 1);
+
+    if (SDL_MUSTLOCK(dst)) {
+        if (SDL_LockSurface(dst) < 0) {
+            SDL_free(weights);
+            return SDL_SetError("Unable to lock destination surface");
+        }
+        dst_locked = 1;
+    }
+    if (SDL_MUSTLOCK(src)) {
+        if (SDL_LockSurface(src) < 0) {
+            if (dst_locked) {
+                SDL_UnlockSurface(dst);
+            }
+            SDL_free(weights);
+            return SDL_SetError("Unable to lock source surface");
+        }
+        src_locked = 1;
+    }
+
+    for (j = 0; j < area->h; ++j) {
+        const int pos = LinearSourcePosition(area->y - dstrect->y + j, srcrect->h, dstrect->h);
+        const int f = (pos >> 8) & 0xFF;
+        const Uint32 *srcp = (const Uint32 *) ((const Uint8 *) src->pixels +
+                                               (srcrect->y + (pos >> 16)) * src->pitch) + srcrect->x;
+        Uint8 *dstrow = (Uint8 *) dst->pixels + (area->y + j) * dst->pitch +
+                        area->x * dst->format->BytesPerPixel;
+        Uint32 *dstp = out ? out : (Uint32 *) dstrow;
+
+        /* Rows sampled at a pixel center don't need blending */
+        if (f) {
+            const Uint32 *next = (const Uint32 *) ((const Uint8 *) srcp + src->pitch);
+            blend_rows(srcp + first, next + first, row + first, last - first + 1, f);
+            srcp = row;
+        }
+        blend_columns(srcp, columns, weights, dstp, simd_count);
+        LinearColumns_Scalar(srcp, columns + simd_count, weights + simd_count * LINEAR_WEIGHTS,
+                             dstp + simd_count, area->w - simd_count);
+
+        if (blit) {
+            SDL_BlitInfo rowinfo = *info;
+
+            rowinfo.src = (Uint8 *) out;
+            rowinfo.src_w = area->w;
+            rowinfo.src_h = 1;
+            rowinfo.src_pitch = area->w * 4;
+            rowinfo.src_skip = 0;
+            rowinfo.dst = dstrow;
+            rowinfo.dst_w = area->w;
+            rowinfo.dst_h = 1;
+            rowinfo.dst_pitch = dst->pitch;
+            rowinfo.dst_skip = dst->pitch - area->w * dst->format->BytesPerPixel;
+            blit(&rowinfo);
+        }
+    }
+
+    if (dst_locked) {
+        SDL_UnlockSurface(dst);
+    }
+    if (src_locked) {
+        SDL_UnlockSurface(src);
+    }
+    SDL_free(weights);
+    return 0;
+}
+
 /* Perform a stretch blit between two surfaces of the same format.
    NOTE:  This function is not safe to call from multiple threads!
 */
-int
-SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
-                SDL_Surface * dst, const SDL_Rect * dstrect)
+static int
+SDL_UpperSoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
+                     SDL_Surface * dst, const SDL_Rect * dstrect,
+                     SDL_bool linear)
 {
     int src_locked;
     int dst_locked;
@@ -252,6 +612,10 @@ SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
         dstrect = &full_dst;
     }
 
+    if (linear) {
+        return SDL_LowerSoftStretchLinear(src, srcrect, dst, dstrect, dstrect, NULL, NULL);
+    }
+
     /* Lock the destination if it's in hardware */
     dst_locked = 0;
     if (SDL_MUSTLOCK(dst)) {
@@ -350,4 +714,18 @@ SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
     return (0);
 }
 
+int
+SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
+                SDL_Surface * dst, const SDL_Rect * dstrect)
+{
+    return SDL_UpperSoftStretch(src, srcrect, dst, dstrect, SDL_FALSE);
+}
+
+int
+SDL_SoftStretchLinear(SDL_Surface * src, const SDL_Rect * srcrect,
+                      SDL_Surface * dst, const SDL_Rect * dstrect)
+{
+    return SDL_UpperSoftStretch(src, srcrect, dst, dstrect, SDL_TRUE);
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
@@ -215,7 +215,7 @@ SDL_SetSurfacePalette(SDL_Surface * surface, SDL_Palette * palette)
     if (SDL_SetPixelFormatPalette(surface->format, palette) < 0) {
         return -1;
     }
-    SDL_InvalidateMap(surface->map);
+    SDL_FlushBlitMapCache(surface->map);
 
     return 0;
 }
@@ -494,8 +494,7 @@ SDL_SetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode blendMode)
 
     status = 0;
     flags = surface->map->info.flags;
-    surface->map->info.flags &=
-        ~(SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL);
+    surface->map->info.flags &= ~SDL_COPY_BLEND_MASK;
     switch (blendMode) {
     case SDL_BLENDMODE_NONE:
         break;
@@ -511,6 +510,9 @@ SDL_SetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode blendMode)
     case SDL_BLENDMODE_MUL:
         surface->map->info.flags |= SDL_COPY_MUL;
         break;
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        surface->map->info.flags |= SDL_COPY_BLEND_PREMULTIPLIED;
+        break;
     default:
         status = SDL_Unsupported();
         break;
@@ -534,8 +536,7 @@ SDL_GetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode *blendMode)
         return 0;
     }
 
-    switch (surface->map->
-            info.flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) {
+    switch (surface->map->info.flags & SDL_COPY_BLEND_MASK) {
     case SDL_COPY_BLEND:
         *blendMode = SDL_BLENDMODE_BLEND;
         break;
@@ -548,6 +549,9 @@ SDL_GetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode *blendMode)
     case SDL_COPY_MUL:
         *blendMode = SDL_BLENDMODE_MUL;
         break;
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        *blendMode = SDL_BLENDMODE_BLEND_PREMULTIPLIED;
+        break;
     default:
         *blendMode = SDL_BLENDMODE_NONE;
         break;
@@ -720,9 +724,173 @@ SDL_UpperBlit(SDL_Surface * src, const SDL_Rect * srcrect,
     return 0;
 }
 
+static const Uint32 complex_copy_flags = (
+    SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA |
+    SDL_COPY_BLEND_MASK | SDL_COPY_COLORKEY
+);
+
+/* Filtering would blend the colorkey and palette indices with their
+   neighbours, so those surfaces are always scaled with the nearest pixel */
+static SDL_bool
+SDL_CanBlitScaledLinear(SDL_Surface * src)
+{
+    if ((src->map->info.flags & SDL_COPY_COLORKEY) ||
+        SDL_ISPIXELFORMAT_INDEXED(src->format->format)) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+/* Returns the blitter that composites stretched rows onto dst. The rows
+   aren't scaled, so this maps the source the way SDL_UpperBlit() does, but
+   keeps RLE off the same way SDL_LowerBlitScaled() does. */
+static SDL_BlitFunc
+SDL_MapStretchedRows(SDL_Surface * src, SDL_Surface * dst)
+{
+    if (src->map->info.flags & SDL_COPY_NEAREST) {
+        src->map->info.flags &= ~SDL_COPY_NEAREST;
+        SDL_InvalidateMap(src->map);
+    }
+    if ((src->map->dst != dst) ||
+        (dst->format->palette &&
+         src->map->dst_palette_version != dst->format->palette->version)) {
+        if (SDL_MapSurface(src, dst) < 0) {
+            return NULL;
+        }
+    }
+    if (src->flags & SDL_RLEACCEL) {
+        /* The RLE blitters only read from the encoded surface */
+        src->map->info.flags |= SDL_COPY_NEAREST;
+        SDL_InvalidateMap(src->map);
+        if (SDL_MapSurface(src, dst) < 0) {
+            return NULL;
+        }
+    }
+    if (!src->map->data) {
+        SDL_SetError("Blit combination not supported");
+    }
+    return (SDL_BlitFunc) src->map->data;
+}
+
+/* Bilinear scaled blit of srcrect into dstrect, drawing only area, which
+   must be inside dstrect and the destination clip rectangle */
+static int
+SDL_LowerBlitScaledLinear(SDL_Surface * src, const SDL_Rect * srcrect,
+                          SDL_Surface * dst, const SDL_Rect * dstrect,
+                          const SDL_Rect * area)
+{
+    SDL_Surface *src32 = src;
+    SDL_Rect rect32 = *srcrect;
+    SDL_BlitFunc blit;
+    SDL_BlendMode blendMode;
+    Uint8 r, g, b, a;
+    int retval;
+
+    if (!(src->map->info.flags & complex_copy_flags) &&
+        src->format->format == dst->format->format &&
+        SDL_ISPIXELFORMAT_LINEAR_STRETCH(src->format->format)) {
+        return SDL_LowerSoftStretchLinear(src, srcrect, dst, dstrect, area, NULL, NULL);
+    }
+
+    /* Filter in a format the stretcher knows */
+    if (!SDL_ISPIXELFORMAT_LINEAR_STRETCH(src->format->format)) {
+        src32 = SDL_CreateRGBSurfaceWithFormat(0, srcrect->w, srcrect->h, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (!src32) {
+            return -1;
+        }
+        if (SDL_LockSurface(src) < 0) {
+            SDL_FreeSurface(src32);
+            return -1;
+        }
+        retval = SDL_ConvertPixels(srcrect->w, srcrect->h, src->format->format,
+                                   (Uint8 *) src->pixels + srcrect->y * src->pitch +
+                                   srcrect->x * src->format->BytesPerPixel,
+                                   src->pitch, src32->format->format,
+                                   src32->pixels, src32->pitch);
+        SDL_UnlockSurface(src);
+        if (retval < 0) {
+            SDL_FreeSurface(src32);
+            return retval;
+        }
+        SDL_GetSurfaceColorMod(src, &r, &g, &b);
+        SDL_GetSurfaceAlphaMod(src, &a);
+        SDL_GetSurfaceBlendMode(src, &blendMode);
+        SDL_SetSurfaceColorMod(src32, r, g, b);
+        SDL_SetSurfaceAlphaMod(src32, a);
+        SDL_SetSurfaceBlendMode(src32, blendMode);
+        rect32.x = 0;
+        rect32.y = 0;
+    }
+
+    /* Modulate and blend every row as soon as it's stretched */
+    blit = SDL_MapStretchedRows(src32, dst);
+    if (blit) {
+        retval = SDL_LowerSoftStretchLinear(src32, &rect32, dst, dstrect, area,
+                                            blit, &src32->map->info);
+    } else {
+        retval = -1;
+    }
+    if (src32 != src) {
+        SDL_FreeSurface(src32);
+    }
+    return retval;
+}
+
+/* Linear clipping keeps the whole destination rectangle, so that clipped
+   copies sample the source at the same positions as unclipped ones */
+static int
+SDL_UpperBlitScaledLinear(SDL_Surface * src, const SDL_Rect * srcrect,
+                          SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    SDL_Rect full_src, full_dst, area;
+
+    full_src.x = 0;
+    full_src.y = 0;
+    full_src.w = src->w;
+    full_src.h = src->h;
+    if (srcrect && !SDL_IntersectRect(srcrect, &full_src, &full_src)) {
+        full_src.w = full_src.h = 0;
+    }
+
+    if (dstrect) {
+        full_dst = *dstrect;
+    } else {
+        full_dst.x = 0;
+        full_dst.y = 0;
+        full_dst.w = dst->w;
+        full_dst.h = dst->h;
+    }
+    if (!SDL_IntersectRect(&full_dst, &dst->clip_rect, &area) ||
+        full_src.w == 0 || full_src.h == 0) {
+        area.x = full_dst.x;
+        area.y = full_dst.y;
+        area.w = area.h = 0;
+    }
+
+    if (dstrect) {
+        *dstrect = area;
+    }
+    if (area.w == 0 || area.h == 0) {
+        /* No-op. */
+        return 0;
+    }
+
+    return SDL_LowerBlitScaledLinear(src, &full_src, dst, &full_dst, &area);
+}
+
 int
 SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
               SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    return SDL_PrivateUpperBlitScaled(src, srcrect, dst, dstrect, SDL_FALSE);
+}
+
+/* SDL_UpperBlitScaled() with a choice of filter. Linear and best are both
+   bilinear; surfaces that can't be filtered fall back to nearest. */
+int
+SDL_PrivateUpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
+                           SDL_Surface * dst, SDL_Rect * dstrect,
+                           SDL_bool linear)
 {
     double src_x0, src_y0, src_x1, src_y1;
     double dst_x0, dst_y0, dst_x1, dst_y1;
@@ -760,6 +928,10 @@ SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
         return SDL_BlitSurface(src, srcrect, dst, dstrect);
     }
 
+    if (linear && SDL_CanBlitScaledLinear(src)) {
+        return SDL_UpperBlitScaledLinear(src, srcrect, dst, dstrect);
+    }
+
     scaling_w = (double)dst_w / src_w;
     scaling_h = (double)dst_h / src_h;
 
@@ -878,12 +1050,6 @@ int
 SDL_LowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
                 SDL_Surface * dst, SDL_Rect * dstrect)
 {
-    static const Uint32 complex_copy_flags = (
-        SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA |
-        SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL |
-        SDL_COPY_COLORKEY
-    );
-
     if (!(src->map->info.flags & SDL_COPY_NEAREST)) {
         src->map->info.flags |= SDL_COPY_NEAREST;
         SDL_InvalidateMap(src->map);
@@ -1168,8 +1334,11 @@ SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
     SDL_SetClipRect(convert, &surface->clip_rect);
 
     /* Enable alpha blending by default if the new surface has an
-     * alpha channel or alpha modulation */
-    if ((surface->format->Amask && format->Amask) ||
+     * alpha channel or alpha modulation, keeping premultiplied pixels
+     * marked as such */
+    if (copy_flags & SDL_COPY_BLEND_PREMULTIPLIED) {
+        SDL_SetSurfaceBlendMode(convert, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    } else if ((surface->format->Amask && format->Amask) ||
         (palette_has_alpha && format->Amask) ||
         (copy_flags & SDL_COPY_MODULATE_ALPHA)) {
         SDL_SetSurfaceBlendMode(convert, SDL_BLENDMODE_BLEND);
@@ -1285,6 +1454,14 @@ int SDL_ConvertPixels(int width, int height,
         return 0;
     }
 
+#if SDL_HAVE_BLIT_N
+    /* Fast path for the common RGB formats, without a blit map */
+    if (SDL_ConvertPixels_RGB_to_RGB(width, height, src_format, src, src_pitch,
+                                     dst_format, dst, dst_pitch)) {
+        return 0;
+    }
+#endif
+
     if (!SDL_CreateSurfaceOnStack(width, height, src_format, nonconst_src,
                                   src_pitch,
                                   &src_surface, &src_fmt, &src_blitmap)) {
@@ -1303,6 +1480,91 @@ int SDL_ConvertPixels(int width, int height,
     return SDL_LowerBlit(&src_surface, &rect, &dst_surface, &rect);
 }
 
+/*
+ * Multiply the color channels of a row of 8888 pixels by their alpha, in place
+ */
+static void
+SDL_PremultiplyAlpha8888Row(Uint32 *pixels, int width, Uint32 Amask, int Ashift)
+{
+    while (width--) {
+        const Uint32 pixel = *pixels;
+        const Uint32 A = (pixel & Amask) >> Ashift;
+        if (A != 0xFF) {
+            /* Two channels at a time, divided exactly by 255 */
+            Uint32 s1 = (pixel & ~Amask & 0x00FF00FF) * A;
+            Uint32 s2 = ((pixel & ~Amask) >> 8 & 0x00FF00FF) * A;
+            s1 = ((s1 + 0x00010001 + ((s1 >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+            s2 = ((s2 + 0x00010001 + ((s2 >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+            *pixels = ((s1 | (s2 << 8)) & ~Amask) | (pixel & Amask);
+        }
+        ++pixels;
+    }
+}
+
+/*
+ * Copy a block of pixels of one format to another, multiplying the color
+ * channels by alpha on the way, for use with SDL_BLENDMODE_BLEND_PREMULTIPLIED
+ */
+int SDL_PremultiplyAlpha(int width, int height,
+                         Uint32 src_format, const void * src, int src_pitch,
+                         Uint32 dst_format, void * dst, int dst_pitch)
+{
+    int Ashift;
+    Uint8 *row;
+
+    if (!src) {
+        return SDL_InvalidParamError("src");
+    }
+    if (!dst) {
+        return SDL_InvalidParamError("dst");
+    }
+    if (SDL_ISPIXELFORMAT_FOURCC(src_format) || SDL_ISPIXELFORMAT_FOURCC(dst_format)) {
+        return SDL_SetError("Can't premultiply alpha of YUV formats");
+    }
+    if (!SDL_ISPIXELFORMAT_ALPHA(dst_format)) {
+        return SDL_SetError("Destination format doesn't have an alpha channel");
+    }
+
+    if (SDL_ConvertPixels(width, height, src_format, src, src_pitch,
+                          dst_format, dst, dst_pitch) < 0) {
+        return -1;
+    }
+
+    row = (Uint8 *) dst;
+    if (SDL_PIXELTYPE(dst_format) == SDL_PIXELTYPE_PACKED32 &&
+        SDL_PIXELLAYOUT(dst_format) == SDL_PACKEDLAYOUT_8888) {
+        switch (SDL_PIXELORDER(dst_format)) {
+        case SDL_PACKEDORDER_ARGB:
+        case SDL_PACKEDORDER_ABGR:
+            Ashift = 24;
+            break;
+        default:
+            Ashift = 0;
+            break;
+        }
+        while (height--) {
+            SDL_PremultiplyAlpha8888Row((Uint32 *) row, width, 0xFFu << Ashift, Ashift);
+            row += dst_pitch;
+        }
+    } else {
+        /* Go through ARGB8888 a row at a time for the remaining formats */
+        Uint32 *tmp = (Uint32 *) SDL_malloc(width * sizeof(Uint32));
+        if (!tmp) {
+            return SDL_OutOfMemory();
+        }
+        while (height--) {
+            SDL_ConvertPixels(width, 1, dst_format, row, dst_pitch,
+                              SDL_PIXELFORMAT_ARGB8888, tmp, width * sizeof(Uint32));
+            SDL_PremultiplyAlpha8888Row(tmp, width, 0xFF000000, 24);
+            SDL_ConvertPixels(width, 1, SDL_PIXELFORMAT_ARGB8888, tmp, width * sizeof(Uint32),
+                              dst_format, row, dst_pitch);
+            row += dst_pitch;
+        }
+        SDL_free(tmp);
+    }
+    return 0;
+}
+
 /*
  * Free a surface created by the above function.
  */
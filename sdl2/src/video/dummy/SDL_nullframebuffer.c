@@ -22,6 +22,7 @@
 
 #if SDL_VIDEO_DRIVER_DUMMY
 
+#include "SDL_log.h"
 #include "../SDL_sysvideo.h"
 #include "SDL_nullframebuffer_c.h"
 
@@ -60,12 +61,23 @@ int SDL_DUMMY_UpdateWindowFramebuffer(_THIS, SDL_Window * window, const SDL_Rect
 {
     static int frame_number;
     SDL_Surface *surface;
+    int i;
 
     surface = (SDL_Surface *) SDL_GetWindowData(window, DUMMY_SURFACE);
     if (!surface) {
         return SDL_SetError("Couldn't find dummy surface for window");
     }
 
+    /* Tell whoever is listening, like the tests of the software renderer,
+       which parts of the window would have been sent to the display */
+    if (SDL_LogGetPriority(SDL_LOG_CATEGORY_VIDEO) <= SDL_LOG_PRIORITY_DEBUG) {
+        for (i = 0; i < numrects; ++i) {
+            SDL_LogDebug(SDL_LOG_CATEGORY_VIDEO, "Update window %u rect %d of %d: %d,%d %dx%d",
+                         SDL_GetWindowID(window), i + 1, numrects,
+                         rects[i].x, rects[i].y, rects[i].w, rects[i].h);
+        }
+    }
+
     /* Send the data to the display */
     if (SDL_getenv("SDL_VIDEO_DUMMY_SAVE_FRAMES")) {
         char file[128];
@@ -33,11 +33,17 @@ my @src_formats = (
     "RGBA8888",
     "ABGR8888",
     "BGRA8888",
+    "ARGB2101010",
 );
 my @dst_formats = (
     "RGB888",
     "BGR888",
     "ARGB8888",
+    "RGBA8888",
+    "ABGR8888",
+    "BGRA8888",
+    "RGB565",
+    "ARGB2101010",
 );
 
 my %format_size = (
@@ -47,6 +53,8 @@ my %format_size = (
     "RGBA8888" => 4,
     "ABGR8888" => 4,
     "BGRA8888" => 4,
+    "RGB565" => 2,
+    "ARGB2101010" => 4,
 );
 
 my %format_type = (
@@ -56,6 +64,8 @@ my %format_type = (
     "RGBA8888" => "Uint32",
     "ABGR8888" => "Uint32",
     "BGRA8888" => "Uint32",
+    "RGB565" => "Uint16",
+    "ARGB2101010" => "Uint32",
 );
 
 my %get_rgba_string_ignore_alpha = (
@@ -65,6 +75,8 @@ my %get_rgba_string_ignore_alpha = (
     "RGBA8888" => "_R = (Uint8)(_pixel >> 24); _G = (Uint8)(_pixel >> 16); _B = (Uint8)(_pixel >> 8);",
     "ABGR8888" => "_B = (Uint8)(_pixel >> 16); _G = (Uint8)(_pixel >> 8); _R = (Uint8)_pixel;",
     "BGRA8888" => "_B = (Uint8)(_pixel >> 24); _G = (Uint8)(_pixel >> 16); _R = (Uint8)(_pixel >> 8);",
+    "RGB565" => "_R = SDL_expand_byte[3][(_pixel >> 11) & 0x1F]; _G = SDL_expand_byte[2][(_pixel >> 5) & 0x3F]; _B = SDL_expand_byte[3][_pixel & 0x1F];",
+    "ARGB2101010" => "_R = (Uint8)(_pixel >> 22); _G = (Uint8)(_pixel >> 12); _B = (Uint8)(_pixel >> 2);",
 );
 
 my %get_rgba_string = (
@@ -74,6 +86,8 @@ my %get_rgba_string = (
     "RGBA8888" => $get_rgba_string_ignore_alpha{"RGBA8888"} . " _A = (Uint8)_pixel;",
     "ABGR8888" => $get_rgba_string_ignore_alpha{"ABGR8888"} . " _A = (Uint8)(_pixel >> 24);",
     "BGRA8888" => $get_rgba_string_ignore_alpha{"BGRA8888"} . " _A = (Uint8)_pixel;",
+    "RGB565" => $get_rgba_string_ignore_alpha{"RGB565"},
+    "ARGB2101010" => $get_rgba_string_ignore_alpha{"ARGB2101010"} . " _A = SDL_expand_byte[6][_pixel >> 30];",
 );
 
 my %set_rgba_string = (
@@ -83,6 +97,31 @@ my %set_rgba_string = (
     "RGBA8888" => "_pixel = (_R << 24) | (_G << 16) | (_B << 8) | _A;",
     "ABGR8888" => "_pixel = (_A << 24) | (_B << 16) | (_G << 8) | _R;",
     "BGRA8888" => "_pixel = (_B << 24) | (_G << 16) | (_R << 8) | _A;",
+    "RGB565" => "_pixel = ((_R >> 3) << 11) | ((_G >> 2) << 5) | (_B >> 3);",
+    "ARGB2101010" => "_pixel = (((_A * 3) / 255) << 30) | ((_R ? ((_R << 2) | 0x3) : 0) << 20) | ((_G ? ((_G << 2) | 0x3) : 0) << 10) | (_B ? ((_B << 2) | 0x3) : 0);",
+);
+
+# The channel in each byte of a pixel in memory, on little endian CPUs, for
+# the SIMD blitters. They work in the order of ARGB8888, which is "BGRA".
+# Formats that aren't listed here only get scalar blitters.
+my %format_bytes = (
+    "RGB888" => "BGRX",
+    "BGR888" => "RGBX",
+    "ARGB8888" => "BGRA",
+    "RGBA8888" => "ABGR",
+    "ABGR8888" => "RGBA",
+    "BGRA8888" => "ARGB",
+);
+
+# The SIMD instruction sets to create blitters for, fastest first
+my @simd_isas = (
+    "AVX2",
+    "SSE41",
+);
+
+my %simd_target = (
+    "AVX2" => "avx2",
+    "SSE41" => "sse4.1",
 );
 
 sub open_file {
@@ -143,6 +182,27 @@ extern SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[];
 __EOF__
 }
 
+sub copyfuncname
+{
+    my $src = shift;
+    my $dst = shift;
+    my $modulate = shift;
+    my $blend = shift;
+    my $scale = shift;
+
+    my $name = "SDL_Blit_${src}_${dst}";
+    if ( $modulate ) {
+        $name = "${name}_Modulate";
+    }
+    if ( $blend ) {
+        $name = "${name}_Blend";
+    }
+    if ( $scale ) {
+        $name = "${name}_Scale";
+    }
+    return $name;
+}
+
 sub output_copyfuncname
 {
     my $prefix = shift;
@@ -183,7 +243,7 @@ sub get_rgba
         $string = $get_rgba_string{$format};
     }
 
-    $string =~ s/_/$prefix/g;
+    $string =~ s/\b_/$prefix/g;
     if ( $prefix ne "" ) {
         print FILE <<__EOF__;
             ${prefix}pixel = *$prefix;
@@ -203,7 +263,7 @@ sub set_rgba
     my $prefix = shift;
     my $format = shift;
     my $string = $set_rgba_string{$format};
-    $string =~ s/_/$prefix/g;
+    $string =~ s/\b_/$prefix/g;
     print FILE <<__EOF__;
             $string
             *dst = ${prefix}pixel;
@@ -268,14 +328,25 @@ __EOF__
                     ${s}B = (${s}B * ${s}A) / 255;
                 }
             }
+__EOF__
+        }
+        if ($modulate) {
+            print FILE <<__EOF__;
+            if ((flags & (SDL_COPY_BLEND_PREMULTIPLIED|SDL_COPY_MODULATE_ALPHA)) == (SDL_COPY_BLEND_PREMULTIPLIED|SDL_COPY_MODULATE_ALPHA)) {
+                /* Premultiplied colors are scaled along with their alpha */
+                ${s}R = (${s}R * modulateA) / 255;
+                ${s}G = (${s}G * modulateA) / 255;
+                ${s}B = (${s}B * modulateA) / 255;
+            }
 __EOF__
         }
         print FILE <<__EOF__;
-            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD|SDL_COPY_MUL)) {
+            switch (flags & SDL_COPY_BLEND_MASK) {
             case SDL_COPY_BLEND:
 __EOF__
         if ($A_is_const_FF) {
             print FILE <<__EOF__;
+            case SDL_COPY_BLEND_PREMULTIPLIED:
                 ${d}R = ${s}R;
                 ${d}G = ${s}G;
                 ${d}B = ${s}B;
@@ -285,6 +356,18 @@ __EOF__
                 ${d}R = ${s}R + ((255 - ${s}A) * ${d}R) / 255;
                 ${d}G = ${s}G + ((255 - ${s}A) * ${d}G) / 255;
                 ${d}B = ${s}B + ((255 - ${s}A) * ${d}B) / 255;
+__EOF__
+            if ( $dst_has_alpha ) {
+                print FILE <<__EOF__;
+                ${d}A = ${s}A + ((255 - ${s}A) * ${d}A) / 255;
+__EOF__
+            }
+            print FILE <<__EOF__;
+                break;
+            case SDL_COPY_BLEND_PREMULTIPLIED:
+                ${d}R = ${s}R + ((255 - ${s}A) * ${d}R) / 255; if (${d}R > 255) ${d}R = 255;
+                ${d}G = ${s}G + ((255 - ${s}A) * ${d}G) / 255; if (${d}G > 255) ${d}G = 255;
+                ${d}B = ${s}B + ((255 - ${s}A) * ${d}B) / 255; if (${d}B > 255) ${d}B = 255;
 __EOF__
         }
         if ( $dst_has_alpha ) {
@@ -326,16 +409,10 @@ __EOF__
                 ${d}B = ((${s}B * ${d}B) + (${d}B * (255 - ${s}A))) / 255; if (${d}B > 255) ${d}B = 255;
 __EOF__
         }
-        if ( $dst_has_alpha ) {
-            if ($A_is_const_FF) {
-                print FILE <<__EOF__;
-                ${d}A = 0xFF;
-__EOF__
-            } else {
-                print FILE <<__EOF__;
+        if ( $dst_has_alpha && !$A_is_const_FF ) {
+            print FILE <<__EOF__;
                 ${d}A = ((${s}A * ${d}A) + (${d}A * (255 - ${s}A))) / 255; if (${d}A > 255) ${d}A = 255;
 __EOF__
-            }
         }
 
         print FILE <<__EOF__;
@@ -518,6 +595,308 @@ __EOF__
 __EOF__
 }
 
+# The pshufb control for one pixel, as a Uint32: for each byte of the "to"
+# layout, the byte of the "from" layout it comes from, or 0x80 for none
+sub swizzle
+{
+    my $from = shift;
+    my $to = shift;
+    my $value = 0;
+
+    for (my $i = 0; $i < 4; ++$i) {
+        my $channel = substr($to, $i, 1);
+        my $index = index($from, $channel);
+        if ( $channel eq "X" || $index < 0 ) {
+            $index = 0x80;
+        }
+        $value |= $index << (8 * $i);
+    }
+    return sprintf("0x%08X", $value);
+}
+
+sub has_simd
+{
+    my $src = shift;
+    my $dst = shift;
+
+    return exists($format_bytes{$src}) && exists($format_bytes{$dst});
+}
+
+sub output_simdcore
+{
+    print FILE <<__EOF__;
+/* The SIMD blitters swizzle pixels to ARGB8888 byte order, do the same
+   math as the scalar blitters on 16-bit channels, and swizzle the result
+   to the destination order. They draw exactly the same pixels as the
+   scalar blitters, which SDL_BLIT_CPU_FEATURES=0 selects for reference. */
+
+#define SDL_BLIT_SWIZZLE_NONE   0x03020100
+
+typedef struct
+{
+    int mode;               /* 0 for copies, else one of SDL_COPY_BLEND_MASK */
+    SDL_bool modulate;
+    SDL_bool modulate_color_by_alpha; /* premultiplied colors follow the alpha modulation */
+    Sint16 factors[4];      /* modulation of B, G, R and A, 255 when off */
+} SDL_BlitSIMDInfo;
+
+static SDL_bool
+SDL_SetupBlitSIMD(const SDL_BlitInfo *info, int blend, SDL_BlitSIMDInfo *simd)
+{
+    const int flags = info->flags;
+
+    simd->mode = 0;
+    if (blend) {
+        simd->mode = flags & SDL_COPY_BLEND_MASK;
+        if (!simd->mode) {
+            return SDL_FALSE;
+        }
+    }
+    simd->modulate = (flags & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA)) ? SDL_TRUE : SDL_FALSE;
+    simd->modulate_color_by_alpha = (simd->mode == SDL_COPY_BLEND_PREMULTIPLIED &&
+                                     (flags & SDL_COPY_MODULATE_ALPHA)) ? SDL_TRUE : SDL_FALSE;
+    simd->factors[0] = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    simd->factors[1] = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    simd->factors[2] = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    simd->factors[3] = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    return SDL_TRUE;
+}
+
+__EOF__
+    foreach my $isa (@simd_isas) {
+        my $target = $simd_target{$isa};
+        my $width = ($isa eq "AVX2") ? 8 : 4;
+        my $v = ($isa eq "AVX2") ? "__m256i" : "__m128i";
+        my $mm = ($isa eq "AVX2") ? "_mm256" : "_mm";
+        my $si = ($isa eq "AVX2") ? "si256" : "si128";
+        my $offsets = ($isa eq "AVX2") ?
+            "0, 0, 0, 0, 4, 4, 4, 4, 8, 8, 8, 8, 12, 12, 12, 12, 0, 0, 0, 0, 4, 4, 4, 4, 8, 8, 8, 8, 12, 12, 12, 12" :
+            "0, 0, 0, 0, 4, 4, 4, 4, 8, 8, 8, 8, 12, 12, 12, 12";
+        my $factors = ($isa eq "AVX2") ?
+            "f[0], f[1], f[2], f[3], f[0], f[1], f[2], f[3], f[0], f[1], f[2], f[3], f[0], f[1], f[2], f[3]" :
+            "f[0], f[1], f[2], f[3], f[0], f[1], f[2], f[3]";
+        my $gather;
+        if ($isa eq "AVX2") {
+            $gather = <<__EOF__;
+                if (scale) {
+                    const __m256i index = _mm256_srli_epi32(_mm256_add_epi32(_mm256_set1_epi32(posx), steps), 16);
+                    s = _mm256_i32gather_epi32((const int *) src, index, 4);
+                } else {
+                    s = _mm256_loadu_si256((const __m256i *) src);
+                }
+__EOF__
+        } else {
+            $gather = <<__EOF__;
+                if (scale) {
+                    s = _mm_setr_epi32((int) src[posx >> 16], (int) src[(posx + incx) >> 16],
+                                       (int) src[(posx + 2 * incx) >> 16], (int) src[(posx + 3 * incx) >> 16]);
+                } else {
+                    s = _mm_loadu_si128((const __m128i *) src);
+                }
+__EOF__
+        }
+        my $steps = ($isa eq "AVX2") ?
+            "    const __m256i steps = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(incx));\n" : "";
+        print FILE <<__EOF__;
+#if HAVE_${isa}_INTRINSICS
+/* x / 255, truncated like the scalar code, for x up to 255 * 255 */
+SDL_TARGETING("$target") SDL_FORCE_INLINE $v
+SDL_Div255_${isa}($v x)
+{
+    return ${mm}_srli_epi16(${mm}_add_epi16(${mm}_add_epi16(x, ${mm}_set1_epi16(1)), ${mm}_srli_epi16(x, 8)), 8);
+}
+
+/* Blends the unpacked 16-bit channels of s onto d */
+SDL_TARGETING("$target") SDL_FORCE_INLINE $v
+SDL_BlendChannels_${isa}($v s, $v d, const SDL_BlitSIMDInfo *simd, $v factors)
+{
+    const $v x255 = ${mm}_set1_epi16(255);
+    $v a;
+
+    if (simd->modulate) {
+        s = SDL_Div255_${isa}(${mm}_mullo_epi16(s, factors));
+    }
+    if (!simd->mode) {
+        return s;
+    }
+    a = ${mm}_shufflehi_epi16(${mm}_shufflelo_epi16(s, 0xFF), 0xFF);
+    if (simd->mode == SDL_COPY_BLEND || simd->mode == SDL_COPY_ADD) {
+        /* This goes away if we ever use premultiplied alpha */
+        s = SDL_Div255_${isa}(${mm}_mullo_epi16(s, ${mm}_blend_epi16(a, x255, 0x88)));
+    } else if (simd->modulate_color_by_alpha) {
+        const $v modulateA = ${mm}_set1_epi16(simd->factors[3]);
+        s = SDL_Div255_${isa}(${mm}_mullo_epi16(s, ${mm}_blend_epi16(modulateA, x255, 0x88)));
+    }
+    switch (simd->mode) {
+    case SDL_COPY_BLEND:
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        return ${mm}_add_epi16(s, SDL_Div255_${isa}(${mm}_mullo_epi16(${mm}_sub_epi16(x255, a), d)));
+    case SDL_COPY_ADD:
+        return ${mm}_add_epi16(s, d);
+    case SDL_COPY_MUL:
+    {
+        /* s * d + (255 - a) * d overflows 16 bits, so divide each product
+           and carry when the remainders add up to another 255 */
+        const $v sd = ${mm}_mullo_epi16(s, d);
+        const $v ad = ${mm}_mullo_epi16(${mm}_sub_epi16(x255, a), d);
+        const $v qs = SDL_Div255_${isa}(sd);
+        const $v qa = SDL_Div255_${isa}(ad);
+        const $v rs = ${mm}_sub_epi16(sd, ${mm}_mullo_epi16(qs, x255));
+        const $v ra = ${mm}_sub_epi16(ad, ${mm}_mullo_epi16(qa, x255));
+        const $v carry = ${mm}_cmpgt_epi16(${mm}_add_epi16(rs, ra), ${mm}_set1_epi16(254));
+        return ${mm}_sub_epi16(${mm}_add_epi16(qs, qa), carry);
+    }
+    default:
+        return SDL_Div255_${isa}(${mm}_mullo_epi16(s, d));
+    }
+}
+
+/* Blends $width pixels in ARGB8888 byte order */
+SDL_TARGETING("$target") SDL_FORCE_INLINE $v
+SDL_BlendPixels_${isa}($v s, $v d, const SDL_BlitSIMDInfo *simd, $v factors)
+{
+    const $v zero = ${mm}_setzero_${si}();
+    const $v lo = SDL_BlendChannels_${isa}(${mm}_unpacklo_epi8(s, zero), ${mm}_unpacklo_epi8(d, zero), simd, factors);
+    const $v hi = SDL_BlendChannels_${isa}(${mm}_unpackhi_epi8(s, zero), ${mm}_unpackhi_epi8(d, zero), simd, factors);
+    $v result = ${mm}_packus_epi16(lo, hi);
+
+    if (simd->mode == SDL_COPY_ADD || simd->mode == SDL_COPY_MOD) {
+        /* These keep the destination alpha */
+        const $v alpha = ${mm}_set1_epi32((int) 0xFF000000);
+        result = ${mm}_or_${si}(${mm}_andnot_${si}(alpha, result), ${mm}_and_${si}(alpha, d));
+    }
+    return result;
+}
+
+/* Blits $width pixels at a time. The swizzles are for src to ARGB8888, dst
+   to ARGB8888 and back, and are constant for each blitter, like src_alpha,
+   blend and scale, so this is inlined into a specialized copy for each. */
+SDL_TARGETING("$target") SDL_FORCE_INLINE SDL_bool
+SDL_Blit_${isa}(SDL_BlitInfo *info, Uint32 src_swizzle, Uint32 dst_load, Uint32 dst_store,
+                int src_alpha, int blend, int scale)
+{
+    const $v offsets = ${mm}_setr_epi8($offsets);
+    const $v src_shuffle = ${mm}_add_epi8(${mm}_set1_epi32((int) src_swizzle), offsets);
+    const $v load_shuffle = ${mm}_add_epi8(${mm}_set1_epi32((int) dst_load), offsets);
+    const $v store_shuffle = ${mm}_add_epi8(${mm}_set1_epi32((int) dst_store), offsets);
+    const $v opaque = ${mm}_set1_epi32(src_alpha ? 0 : (int) 0xFF000000);
+    const int incy = scale ? (info->src_h << 16) / info->dst_h : 0;
+    const int incx = scale ? (info->src_w << 16) / info->dst_w : 0;
+$steps    SDL_BlitSIMDInfo simd;
+    const Sint16 *f = simd.factors;
+    $v factors;
+    int posy = 0;
+
+    if (!SDL_SetupBlitSIMD(info, blend, &simd)) {
+        return SDL_FALSE;
+    }
+    factors = ${mm}_setr_epi16($factors);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *) (info->src + (scale ? (posy >> 16) * info->src_pitch : 0));
+        Uint32 *dst = (Uint32 *) info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+
+        while (n > 0) {
+            const int count = SDL_min(n, $width);
+            Uint32 srcbuf[$width], dstbuf[$width];
+            $v s, d, result;
+            int i;
+
+            if (count == $width) {
+$gather                d = ${mm}_loadu_${si}((const $v *) dst);
+            } else {
+                /* The last pixels of the row go through buffers */
+                SDL_zeroa(srcbuf);
+                SDL_zeroa(dstbuf);
+                for (i = 0; i < count; ++i) {
+                    srcbuf[i] = scale ? src[(posx + i * incx) >> 16] : src[i];
+                    dstbuf[i] = dst[i];
+                }
+                s = ${mm}_loadu_${si}((const $v *) srcbuf);
+                d = ${mm}_loadu_${si}((const $v *) dstbuf);
+            }
+
+            if (src_swizzle != SDL_BLIT_SWIZZLE_NONE) {
+                s = ${mm}_shuffle_epi8(s, src_shuffle);
+            }
+            s = ${mm}_or_${si}(s, opaque);
+            if (dst_load != SDL_BLIT_SWIZZLE_NONE) {
+                d = ${mm}_shuffle_epi8(d, load_shuffle);
+            }
+            result = SDL_BlendPixels_${isa}(s, d, &simd, factors);
+            if (dst_store != SDL_BLIT_SWIZZLE_NONE) {
+                result = ${mm}_shuffle_epi8(result, store_shuffle);
+            }
+
+            if (count == $width) {
+                ${mm}_storeu_${si}(($v *) dst, result);
+            } else {
+                ${mm}_storeu_${si}(($v *) dstbuf, result);
+                SDL_memcpy(dst, dstbuf, count * sizeof (Uint32));
+            }
+            if (scale) {
+                posx += count * incx;
+            } else {
+                src += count;
+            }
+            dst += count;
+            n -= count;
+        }
+        if (scale) {
+            posy += incy;
+        } else {
+            info->src += info->src_pitch;
+        }
+        info->dst += info->dst_pitch;
+    }
+    return SDL_TRUE;
+}
+#endif /* HAVE_${isa}_INTRINSICS */
+
+__EOF__
+    }
+}
+
+sub output_simdfunc
+{
+    my $src = shift;
+    my $dst = shift;
+    my $modulate = shift;
+    my $blend = shift;
+    my $scale = shift;
+    my $isa = shift;
+
+    my $name = copyfuncname($src, $dst, $modulate, $blend, $scale);
+    my $src_swizzle = swizzle($format_bytes{$src}, "BGRA");
+    my $dst_load = swizzle($format_bytes{$dst}, "BGRA");
+    my $dst_store = swizzle("BGRA", $format_bytes{$dst});
+    my $src_alpha = ($src =~ /A/) ? 1 : 0;
+
+    print FILE <<__EOF__;
+#if HAVE_${isa}_INTRINSICS
+SDL_TARGETING("$simd_target{$isa}") static void ${name}_${isa}(SDL_BlitInfo *info)
+{
+__EOF__
+    if ( $blend ) {
+        print FILE <<__EOF__;
+    if (!SDL_Blit_${isa}(info, $src_swizzle, $dst_load, $dst_store, $src_alpha, $blend, $scale)) {
+        $name(info);
+    }
+__EOF__
+    } else {
+        print FILE <<__EOF__;
+    SDL_Blit_${isa}(info, $src_swizzle, $dst_load, $dst_store, $src_alpha, $blend, $scale);
+__EOF__
+    }
+    print FILE <<__EOF__;
+}
+#endif
+
+__EOF__
+}
+
 sub output_copyfunc_h
 {
 }
@@ -537,10 +916,32 @@ sub output_copyfunctable
     print FILE <<__EOF__;
 SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
 __EOF__
+    foreach my $isa (@simd_isas) {
+        print FILE "#if HAVE_${isa}_INTRINSICS\n";
+        output_copyfunctable_entries($isa);
+        print FILE "#endif\n";
+    }
+    output_copyfunctable_entries("");
+    print FILE <<__EOF__;
+    { 0, 0, 0, 0, NULL }
+};
+
+__EOF__
+}
+
+sub output_copyfunctable_entries
+{
+    my $isa = shift;
+    my $cpu = ( $isa ne "" ) ? "SDL_CPU_$isa" : "SDL_CPU_ANY";
+    my $suffix = ( $isa ne "" ) ? "_$isa" : "";
+
     for (my $i = 0; $i <= $#src_formats; ++$i) {
         my $src = $src_formats[$i];
         for (my $j = 0; $j <= $#dst_formats; ++$j) {
             my $dst = $dst_formats[$j];
+            if ( $isa ne "" && !has_simd($src, $dst) ) {
+                next;
+            }
             for (my $modulate = 0; $modulate <= 1; ++$modulate) {
                 for (my $blend = 0; $blend <= 1; ++$blend) {
                     for (my $scale = 0; $scale <= 1; ++$scale) {
@@ -557,7 +958,7 @@ __EOF__
                                 }
                             }
                             if ( $blend ) {
-                                $flag = "SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL";
+                                $flag = "SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL";
                                 if ( $flags eq "" ) {
                                     $flags = $flag;
                                 } else {
@@ -575,19 +976,14 @@ __EOF__
                             if ( $flags eq "" ) {
                                 $flags = "0";
                             }
-                            print FILE "($flags), SDL_CPU_ANY,";
-                            output_copyfuncname("", $src_formats[$i], $dst_formats[$j], $modulate, $blend, $scale, 0, " },\n");
+                            print FILE "($flags), $cpu,";
+                            output_copyfuncname("", $src_formats[$i], $dst_formats[$j], $modulate, $blend, $scale, 0, "$suffix },\n");
                         }
                     }
                 }
             }
         }
     }
-    print FILE <<__EOF__;
-    { 0, 0, 0, 0, NULL }
-};
-
-__EOF__
 }
 
 sub output_copyfunc_c
@@ -600,6 +996,11 @@ sub output_copyfunc_c
             for (my $scale = 0; $scale <= 1; ++$scale) {
                 if ( $modulate || $blend || $scale ) {
                     output_copyfunc($src, $dst, $modulate, $blend, $scale);
+                    if ( has_simd($src, $dst) ) {
+                        foreach my $isa (@simd_isas) {
+                            output_simdfunc($src, $dst, $modulate, $blend, $scale, $isa);
+                        }
+                    }
                 }
             }
         }
@@ -618,6 +1019,7 @@ close_file("SDL_blit_auto.h");
 
 open_file("SDL_blit_auto.c");
 output_copyinc();
+output_simdcore();
 for (my $i = 0; $i <= $#src_formats; ++$i) {
     for (my $j = 0; $j <= $#dst_formats; ++$j) {
         output_copyfunc_c($src_formats[$i], $dst_formats[$j]);
@@ -502,6 +502,107 @@ pixels_calcGammaRamp(void *arg)
   return TEST_COMPLETED;
 }
 
+/**
+ * @brief Call to SDL_MapRGBA on indexed formats with larger palettes
+ *
+ * Compares the result with a linear scan for the nearest color, which picks
+ * the lowest index among equally near colors.
+ *
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_MapRGBA
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_SetPaletteColors
+ */
+int
+pixels_mapRGBAPalette(void *arg)
+{
+  SDL_PixelFormat *format;
+  SDL_Palette *palette;
+  SDL_Color colors[256];
+  SDL_Color query;
+  Uint32 result, expected;
+  unsigned int distance, smallest;
+  int variation, ncolors, i, j, k, dr, dg, db, da, mismatches;
+
+  format = SDL_AllocFormat(SDL_PIXELFORMAT_INDEX8);
+  SDLTest_AssertPass("Call to SDL_AllocFormat(SDL_PIXELFORMAT_INDEX8)");
+  SDLTest_AssertCheck(format != NULL, "Verify result is not NULL");
+  if (format == NULL) return TEST_ABORTED;
+
+  for (variation = 0; variation < 4; variation++) {
+    ncolors = (variation == 0) ? 17 : (variation == 1) ? 256 : SDLTest_RandomIntegerInRange(17, 256);
+    palette = SDL_AllocPalette(ncolors);
+    SDLTest_AssertCheck(palette != NULL, "Verify result from SDL_AllocPalette(%d) is not NULL", ncolors);
+    if (palette == NULL) continue;
+
+    /* The last variation draws from few values, so many colors are equally near */
+    for (i = 0; i < ncolors; i++) {
+      if (variation == 3) {
+        colors[i].r = (Uint8) (SDLTest_RandomIntegerInRange(0, 3) * 85);
+        colors[i].g = (Uint8) (SDLTest_RandomIntegerInRange(0, 3) * 85);
+        colors[i].b = (Uint8) (SDLTest_RandomIntegerInRange(0, 3) * 85);
+        colors[i].a = (Uint8) (SDLTest_RandomIntegerInRange(0, 1) * 255);
+      } else {
+        colors[i].r = SDLTest_RandomUint8();
+        colors[i].g = SDLTest_RandomUint8();
+        colors[i].b = SDLTest_RandomUint8();
+        colors[i].a = SDLTest_RandomUint8();
+      }
+    }
+    SDL_SetPaletteColors(palette, colors, 0, ncolors);
+    SDL_SetPixelFormatPalette(format, palette);
+    SDLTest_AssertPass("Call to SDL_SetPixelFormatPalette() with %d colors", ncolors);
+
+    /* Once as set, and again after SDL_SetPaletteColors changed a color */
+    for (k = 0; k < 2; k++) {
+      mismatches = 0;
+      for (j = 0; j < 1000; j++) {
+        if (j < ncolors) {
+          query = colors[j];
+        } else {
+          query.r = SDLTest_RandomUint8();
+          query.g = SDLTest_RandomUint8();
+          query.b = SDLTest_RandomUint8();
+          query.a = SDLTest_RandomUint8();
+        }
+
+        expected = 0;
+        smallest = ~0U;
+        for (i = 0; i < ncolors; i++) {
+          dr = colors[i].r - query.r;
+          dg = colors[i].g - query.g;
+          db = colors[i].b - query.b;
+          da = colors[i].a - query.a;
+          distance = (unsigned int) (dr * dr + dg * dg + db * db + da * da);
+          if (distance < smallest) {
+            smallest = distance;
+            expected = i;
+          }
+        }
+
+        result = SDL_MapRGBA(format, query.r, query.g, query.b, query.a);
+        if (result != expected) {
+          if (mismatches == 0) {
+            SDLTest_AssertCheck(result == expected, "Validate SDL_MapRGBA(%u,%u,%u,%u) with %d colors; expected: %u, got: %u",
+              query.r, query.g, query.b, query.a, ncolors, expected, result);
+          }
+          mismatches++;
+        }
+      }
+      SDLTest_AssertCheck(mismatches == 0, "Validate SDL_MapRGBA against a linear scan with %d colors; expected: 0 mismatches, got: %d", ncolors, mismatches);
+
+      i = SDLTest_RandomIntegerInRange(0, ncolors - 1);
+      colors[i].r ^= 0x80;
+      SDL_SetPaletteColors(palette, &colors[i], i, 1);
+    }
+
+    SDL_SetPixelFormatPalette(format, NULL);
+    SDL_FreePalette(palette);
+  }
+
+  SDL_FreeFormat(format);
+
+  return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Pixels test cases */
@@ -517,9 +618,12 @@ static const SDLTest_TestCaseReference pixelsTest3 =
 static const SDLTest_TestCaseReference pixelsTest4 =
         { (SDLTest_TestCaseFp)pixels_getPixelFormatName, "pixels_getPixelFormatName", "Call to SDL_GetPixelFormatName", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference pixelsTest5 =
+        { (SDLTest_TestCaseFp)pixels_mapRGBAPalette, "pixels_mapRGBAPalette", "Call to SDL_MapRGBA with palettes of more than 16 colors", TEST_ENABLED };
+
 /* Sequence of Pixels test cases */
 static const SDLTest_TestCaseReference *pixelsTests[] =  {
-    &pixelsTest1, &pixelsTest2, &pixelsTest3, &pixelsTest4, NULL
+    &pixelsTest1, &pixelsTest2, &pixelsTest3, &pixelsTest4, &pixelsTest5, NULL
 };
 
 /* Pixels test suite (global) */
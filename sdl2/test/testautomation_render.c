@@ -1023,6 +1023,1388 @@ _compare(SDL_Surface *referenceSurface, int allowable_error)
    SDL_FreeSurface(testSurface);
 }
 
+/**
+ * @brief Checks that the pixel at (x, y) of surface is within 1 of each channel of expected.
+ */
+static void
+_checkPixel(SDL_Surface *surface, int x, int y, Uint32 expected, const char *what)
+{
+   const Uint32 pixel = ((Uint32 *)((Uint8 *)surface->pixels + y * surface->pitch))[x];
+   int shift, ok = 1;
+
+   for (shift = 0; shift < 32; shift += 8) {
+      if (SDL_abs((int)((pixel >> shift) & 0xFF) - (int)((expected >> shift) & 0xFF)) > 1) {
+         ok = 0;
+      }
+   }
+   SDLTest_AssertCheck(ok, "Validate %s at (%i,%i), expected: 0x%08x, got: 0x%08x", what, x, y, expected, pixel);
+}
+
+/**
+ * @brief Creates a software renderer drawing to a new w x h surface of the given format.
+ *
+ * Software renderers only batch their commands when SDL_HINT_RENDER_BATCHING asks for it.
+ */
+static SDL_Renderer *
+_createSoftwareRenderer(int w, int h, Uint32 format, SDL_bool batching, SDL_Surface **target)
+{
+   const char *hint = SDL_GetHint(SDL_HINT_RENDER_BATCHING);
+   char *saved = hint ? SDL_strdup(hint) : NULL;
+   SDL_Renderer *swrenderer;
+
+   *target = SDL_CreateRGBSurfaceWithFormat(0, w, h, SDL_BITSPERPIXEL(format), format);
+   SDLTest_AssertCheck(*target != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   if (*target == NULL) {
+      SDL_free(saved);
+      return NULL;
+   }
+   SDL_SetHint(SDL_HINT_RENDER_BATCHING, batching ? "1" : "0");
+   swrenderer = SDL_CreateSoftwareRenderer(*target);
+   SDL_SetHint(SDL_HINT_RENDER_BATCHING, saved ? saved : "");
+   SDL_free(saved);
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(*target);
+      *target = NULL;
+   }
+   return swrenderer;
+}
+
+/**
+ * @brief Finds the first pixel where two surfaces of the same size and format differ.
+ *
+ * \return SDL_TRUE and the position of the pixel if there is one.
+ */
+static SDL_bool
+_findMismatch(SDL_Surface *expected, SDL_Surface *actual, int *x, int *y)
+{
+   const int bpp = expected->format->BytesPerPixel;
+   int i, j;
+
+   for (j = 0; j < expected->h; j++) {
+      const Uint8 *e = (const Uint8 *)expected->pixels + j * expected->pitch;
+      const Uint8 *a = (const Uint8 *)actual->pixels + j * actual->pitch;
+      for (i = 0; i < expected->w * bpp; i++) {
+         if (e[i] != a[i]) {
+            *x = i / bpp;
+            *y = j;
+            return SDL_TRUE;
+         }
+      }
+   }
+   *x = *y = 0;
+   return SDL_FALSE;
+}
+
+/**
+ * @brief Tests that rotated and flipped copies of premultiplied textures match plain copies.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateSoftwareRenderer
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderCopyEx
+ */
+int
+render_testCopyExPremultiplied(void *arg)
+{
+   const SDL_Rect plain = { 0, 0, 8, 8 };
+   const SDL_Rect flipped = { 16, 0, 8, 8 };
+   const SDL_Rect rotated = { 0, 16, 8, 8 };
+   Uint32 pixels[8 * 8];
+   SDL_Surface *target;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture;
+   int i, ret;
+
+   target = SDL_CreateRGBSurfaceWithFormat(0, 32, 32, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(target != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   if (target == NULL) {
+      return TEST_ABORTED;
+   }
+   swrenderer = SDL_CreateSoftwareRenderer(target);
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(target);
+      return TEST_ABORTED;
+   }
+
+   /* Half transparent red, premultiplied */
+   for (i = 0; i < SDL_arraysize(pixels); i++) {
+      pixels[i] = 0x80800000;
+   }
+   texture = SDL_CreateTexture(swrenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 8, 8);
+   SDLTest_AssertCheck(texture != NULL, "Verify result from SDL_CreateTexture is not NULL");
+   if (texture != NULL) {
+      SDL_UpdateTexture(texture, NULL, pixels, 8 * 4);
+      ret = SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SetTextureBlendMode, expected: 0, got: %i", ret);
+
+      /* Without and with alpha modulation, which scales the premultiplied colors too */
+      for (i = 0; i < 2; i++) {
+         const Uint32 expected = (i == 0) ? 0xFF80007F : 0xFF4000BF;
+
+         SDL_SetRenderDrawColor(swrenderer, 0, 0, 255, 255);
+         SDL_RenderClear(swrenderer);
+         SDL_SetTextureAlphaMod(texture, (i == 0) ? 255 : 128);
+         ret = SDL_RenderCopy(swrenderer, texture, NULL, &plain);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopy, expected: 0, got: %i", ret);
+         ret = SDL_RenderCopyEx(swrenderer, texture, NULL, &flipped, 0.0, NULL, SDL_FLIP_HORIZONTAL);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopyEx, expected: 0, got: %i", ret);
+         ret = SDL_RenderCopyEx(swrenderer, texture, NULL, &rotated, 90.0, NULL, SDL_FLIP_NONE);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopyEx, expected: 0, got: %i", ret);
+         SDL_RenderPresent(swrenderer);
+
+         _checkPixel(target, 4, 4, expected, "SDL_RenderCopy");
+         _checkPixel(target, 20, 4, expected, "flipped SDL_RenderCopyEx");
+         _checkPixel(target, 4, 20, expected, "rotated SDL_RenderCopyEx");
+         _checkPixel(target, 28, 28, 0xFF0000FF, "background");
+      }
+      SDL_DestroyTexture(texture);
+   }
+
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(target);
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Returns the texel of a 2x downsampled ARGB8888 image at (x, y), with the colors weighted by alpha if asked.
+ */
+static Uint32
+_mipTexel(const Uint32 *pixels, int w, int x, int y, SDL_bool weighted)
+{
+   const Uint32 block[4] = {
+      pixels[(2 * y) * w + 2 * x], pixels[(2 * y) * w + 2 * x + 1],
+      pixels[(2 * y + 1) * w + 2 * x], pixels[(2 * y + 1) * w + 2 * x + 1]
+   };
+   Uint32 asum = 0, result;
+   int i, shift;
+
+   for (i = 0; i < 4; i++) {
+      asum += block[i] >> 24;
+   }
+   result = ((asum + 2) / 4) << 24;
+   for (shift = 0; shift < 24; shift += 8) {
+      Uint32 sum = 0;
+      for (i = 0; i < 4; i++) {
+         sum += ((block[i] >> shift) & 0xFF) * ((weighted && asum) ? (block[i] >> 24) : 1);
+      }
+      if (weighted && asum) {
+         result |= ((sum + asum / 2) / asum) << shift;
+      } else {
+         result |= ((sum + 2) / 4) << shift;
+      }
+   }
+   return result;
+}
+
+/**
+ * @brief Tests that minified copies read mipmaps filtered for the texture's blend mode.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateSoftwareRenderer
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderCopy
+ */
+int
+render_testCopyMipmapped(void *arg)
+{
+   const SDL_Rect dstrect = { 0, 0, 8, 8 };
+   const SDL_BlendMode modes[] = { SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND_PREMULTIPLIED };
+   Uint32 pixels[16 * 16];
+   SDL_Surface *target;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture;
+   int i, x, y, shift, ret;
+
+   target = SDL_CreateRGBSurfaceWithFormat(0, 8, 8, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(target != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   if (target == NULL) {
+      return TEST_ABORTED;
+   }
+   SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_MIPMAPS, "1");
+   swrenderer = SDL_CreateSoftwareRenderer(target);
+   SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_MIPMAPS, NULL);
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(target);
+      return TEST_ABORTED;
+   }
+
+   /* Random alphas, with the colors at most the alpha so they are valid premultiplied too */
+   for (i = 0; i < SDL_arraysize(pixels); i++) {
+      const Uint32 a = SDLTest_RandomIntegerInRange(0, 3) * 85;
+      pixels[i] = a << 24;
+      for (shift = 0; shift < 24; shift += 8) {
+         pixels[i] |= (Uint32) SDLTest_RandomIntegerInRange(0, a) << shift;
+      }
+   }
+   texture = SDL_CreateTexture(swrenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 16, 16);
+   SDLTest_AssertCheck(texture != NULL, "Verify result from SDL_CreateTexture is not NULL");
+   if (texture != NULL) {
+      SDL_UpdateTexture(texture, NULL, pixels, 16 * 4);
+
+      /* Copied onto transparent black, both modes store the mip level as is */
+      for (i = 0; i < SDL_arraysize(modes); i++) {
+         const SDL_bool weighted = (modes[i] != SDL_BLENDMODE_BLEND_PREMULTIPLIED) ? SDL_TRUE : SDL_FALSE;
+         int mismatches = 0;
+         Uint32 expected = 0, pixel = 0;
+
+         SDL_SetRenderDrawColor(swrenderer, 0, 0, 0, 0);
+         SDL_RenderClear(swrenderer);
+         SDL_SetTextureBlendMode(texture, modes[i]);
+         ret = SDL_RenderCopy(swrenderer, texture, NULL, &dstrect);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopy, expected: 0, got: %i", ret);
+         SDL_RenderPresent(swrenderer);
+
+         for (y = 0; y < 8; y++) {
+            for (x = 0; x < 8; x++) {
+               const Uint32 p = ((Uint32 *)((Uint8 *)target->pixels + y * target->pitch))[x];
+               const Uint32 e = _mipTexel(pixels, 16, x, y, weighted);
+               if (p != e) {
+                  expected = e;
+                  pixel = p;
+                  mismatches++;
+               }
+            }
+         }
+         SDLTest_AssertCheck(mismatches == 0,
+            "Validate mip level with %s filtering, expected: 0 mismatches, got: %i (last expected 0x%08x, got 0x%08x)",
+            weighted ? "alpha weighted" : "premultiplied", mismatches, expected, pixel);
+      }
+      SDL_DestroyTexture(texture);
+   }
+
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(target);
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief A render kernel writing its position in the destination rectangle and its first constant.
+ */
+static void SDLCALL
+_positionKernel(void *userdata, const SDL_RenderKernelTile *tile)
+{
+   const Uint32 c = (tile->num_constants > 0) ? (Uint32)tile->constants[0] : 0;
+   int x, y;
+
+   for (y = 0; y < tile->h; y++) {
+      Uint32 *row = (Uint32 *)((Uint8 *)tile->pixels + y * tile->pitch);
+      for (x = 0; x < tile->w; x++) {
+         const Uint32 dx = tile->x + x, dy = tile->y + y;
+         row[x] = (((dx + dy) * 8 & 0xFF) << 24) | ((dx & 0xFF) << 16) | ((dy & 0xFF) << 8) | (c & 0xFF);
+      }
+   }
+}
+
+/**
+ * @brief Tests that copies with a kernel composite its output like a blit of it would.
+ *
+ * The copy is bigger than a kernel tile and clipped, and drawn to a target the kernel
+ * writes directly, an RGB target and an indexed one, with several blend modes.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateSoftwareRenderer
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderCopy
+ */
+int
+render_testKernel(void *arg)
+{
+   const Uint32 formats[] = { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_INDEX8 };
+   const SDL_BlendMode modes[] = { SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD };
+   const SDL_Rect dstrect = { 7, 3, 280, 45 };
+   const SDL_Rect cliprect = { 10, 5, 270, 40 };
+   const float constants[] = { 77.0f };
+   SDL_RenderKernelTile tile;
+   SDL_Surface *output;
+   int i, j, x, y, ret;
+
+   /* What the kernel writes for the whole copy, in one tile */
+   output = SDL_CreateRGBSurfaceWithFormat(0, dstrect.w, dstrect.h, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(output != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   if (output == NULL) {
+      return TEST_ABORTED;
+   }
+   SDL_zero(tile);
+   tile.pixels = (Uint32 *)output->pixels;
+   tile.pitch = output->pitch;
+   tile.w = tile.dst_w = dstrect.w;
+   tile.h = tile.dst_h = dstrect.h;
+   tile.constants = constants;
+   tile.num_constants = SDL_arraysize(constants);
+   _positionKernel(NULL, &tile);
+
+   for (i = 0; i < SDL_arraysize(formats); i++) {
+      for (j = 0; j < SDL_arraysize(modes); j++) {
+         const SDL_bool modulate = (modes[j] == SDL_BLENDMODE_BLEND) ? SDL_TRUE : SDL_FALSE;
+         SDL_Surface *target, *reference;
+         SDL_Renderer *swrenderer;
+         SDL_RenderKernel *kernel;
+         SDL_Texture *texture;
+         SDL_bool mismatch;
+
+         swrenderer = _createSoftwareRenderer(300, 50, formats[i], SDL_FALSE, &target);
+         if (swrenderer == NULL) {
+            SDL_FreeSurface(output);
+            return TEST_ABORTED;
+         }
+         reference = SDL_CreateRGBSurfaceWithFormat(0, 300, 50, SDL_BITSPERPIXEL(formats[i]), formats[i]);
+         texture = SDL_CreateTexture(swrenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 4, 4);
+         kernel = SDL_CreateRenderKernel(swrenderer, _positionKernel, NULL, NULL, 0);
+         SDLTest_AssertCheck(reference != NULL && texture != NULL && kernel != NULL, "Verify the reference, texture and kernel are not NULL");
+         if (reference != NULL && texture != NULL && kernel != NULL) {
+            if (target->format->palette) {
+               SDL_Color colors[256];
+               for (x = 0; x < 256; x++) {
+                  colors[x].r = (Uint8)((x >> 5) * 255 / 7);
+                  colors[x].g = (Uint8)(((x >> 2) & 7) * 255 / 7);
+                  colors[x].b = (Uint8)((x & 3) * 255 / 3);
+                  colors[x].a = 255;
+               }
+               SDL_SetPaletteColors(target->format->palette, colors, 0, 256);
+               SDL_SetPaletteColors(reference->format->palette, colors, 0, 256);
+            }
+
+            SDL_SetTextureBlendMode(texture, modes[j]);
+            SDL_SetSurfaceBlendMode(output, modes[j]);
+            SDL_SetTextureColorMod(texture, 255, modulate ? 150 : 255, modulate ? 100 : 255);
+            SDL_SetSurfaceColorMod(output, 255, modulate ? 150 : 255, modulate ? 100 : 255);
+            SDL_SetTextureAlphaMod(texture, modulate ? 180 : 255);
+            SDL_SetSurfaceAlphaMod(output, modulate ? 180 : 255);
+
+            SDL_SetRenderDrawColor(swrenderer, 40, 80, 120, 255);
+            SDL_RenderClear(swrenderer);
+            SDL_RenderSetClipRect(swrenderer, &cliprect);
+            ret = SDL_RenderSetKernel(swrenderer, kernel);
+            SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderSetKernel, expected: 0, got: %i", ret);
+            ret = SDL_RenderSetKernelConstants(swrenderer, constants, SDL_arraysize(constants));
+            SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderSetKernelConstants, expected: 0, got: %i", ret);
+            ret = SDL_RenderCopy(swrenderer, texture, NULL, &dstrect);
+            SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopy, expected: 0, got: %i", ret);
+            SDL_RenderPresent(swrenderer);
+
+            SDL_FillRect(reference, NULL, SDL_MapRGBA(reference->format, 40, 80, 120, 255));
+            SDL_SetClipRect(reference, &cliprect);
+            SDL_BlitSurface(output, NULL, reference, (SDL_Rect *)&dstrect);
+
+            mismatch = _findMismatch(reference, target, &x, &y);
+            SDLTest_AssertCheck(!mismatch,
+               "Validate kernel output on %s with blend mode %i, expected: no mismatch, got: %s at (%i,%i)",
+               SDL_GetPixelFormatName(formats[i]), modes[j], mismatch ? "a mismatch" : "none", x, y);
+         }
+
+         SDL_DestroyRenderKernel(kernel);
+         SDL_DestroyTexture(texture);
+         SDL_DestroyRenderer(swrenderer);
+         SDL_FreeSurface(reference);
+         SDL_FreeSurface(target);
+      }
+   }
+
+   SDL_FreeSurface(output);
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief A render kernel writing how many constants it got, the last one and the first one.
+ */
+static void SDLCALL
+_constantsKernel(void *userdata, const SDL_RenderKernelTile *tile)
+{
+   const int n = tile->num_constants;
+   const Uint32 pixel = 0xFF000000 | ((Uint32)n << 16) |
+                        ((n > 0) ? (((Uint32)tile->constants[n - 1] & 0xFF) << 8) | ((Uint32)tile->constants[0] & 0xFF) : 0);
+   int x, y;
+
+   for (y = 0; y < tile->h; y++) {
+      Uint32 *row = (Uint32 *)((Uint8 *)tile->pixels + y * tile->pitch);
+      for (x = 0; x < tile->w; x++) {
+         row[x] = pixel;
+      }
+   }
+}
+
+/**
+ * @brief Tests that kernel constants are checked, and reach exactly the copies queued after them.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateSoftwareRenderer
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderCopy
+ */
+int
+render_testKernelConstants(void *arg)
+{
+   const SDL_Rect rects[] = { { 0, 0, 4, 4 }, { 4, 0, 4, 4 }, { 8, 0, 4, 4 } };
+   float constants[SDL_RENDER_KERNEL_MAX_CONSTANTS + 1];
+   SDL_Surface *target;
+   SDL_Renderer *swrenderer;
+   SDL_RenderKernel *kernel;
+   SDL_Texture *texture;
+   SDL_RenderStats stats;
+   int i, ret;
+
+   swrenderer = _createSoftwareRenderer(16, 4, SDL_PIXELFORMAT_ARGB8888, SDL_TRUE, &target);
+   if (swrenderer == NULL) {
+      return TEST_ABORTED;
+   }
+   texture = SDL_CreateTexture(swrenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 4, 4);
+   kernel = SDL_CreateRenderKernel(swrenderer, _constantsKernel, NULL, NULL, 0);
+   SDLTest_AssertCheck(texture != NULL && kernel != NULL, "Verify the texture and kernel are not NULL");
+   if (texture == NULL || kernel == NULL) {
+      SDL_DestroyRenderKernel(kernel);
+      SDL_DestroyTexture(texture);
+      SDL_DestroyRenderer(swrenderer);
+      SDL_FreeSurface(target);
+      return TEST_ABORTED;
+   }
+   ret = SDL_RenderSetKernel(swrenderer, kernel);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderSetKernel, expected: 0, got: %i", ret);
+
+   /* At most SDL_RENDER_KERNEL_MAX_CONSTANTS, and errors leave the constants alone */
+   for (i = 0; i < SDL_arraysize(constants); i++) {
+      constants[i] = (float)(i + 1);
+   }
+   ret = SDL_RenderSetKernelConstants(swrenderer, constants, SDL_RENDER_KERNEL_MAX_CONSTANTS);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderSetKernelConstants with %i constants, expected: 0, got: %i", SDL_RENDER_KERNEL_MAX_CONSTANTS, ret);
+   ret = SDL_RenderSetKernelConstants(swrenderer, constants, SDL_RENDER_KERNEL_MAX_CONSTANTS + 1);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_RenderSetKernelConstants with %i constants, expected: -1, got: %i", SDL_RENDER_KERNEL_MAX_CONSTANTS + 1, ret);
+   ret = SDL_RenderSetKernelConstants(swrenderer, constants, -1);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_RenderSetKernelConstants with -1 constants, expected: -1, got: %i", ret);
+   ret = SDL_RenderSetKernelConstants(swrenderer, NULL, 2);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_RenderSetKernelConstants with NULL constants, expected: -1, got: %i", ret);
+   ret = SDL_RenderSetKernelConstants(NULL, constants, 2);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_RenderSetKernelConstants with NULL renderer, expected: -1, got: %i", ret);
+   SDL_RenderCopy(swrenderer, texture, NULL, &rects[0]);
+   SDL_RenderPresent(swrenderer);
+   _checkPixel(target, 0, 0, 0xFF404001, "copy with the maximum number of constants");
+
+   /* Constants changed between copies only reach the copies after them, and only the last change is queued */
+   constants[0] = 10.0f;
+   SDL_RenderSetKernelConstants(swrenderer, constants, 1);
+   SDL_RenderCopy(swrenderer, texture, NULL, &rects[0]);
+   constants[0] = 20.0f;
+   SDL_RenderSetKernelConstants(swrenderer, constants, 1);
+   constants[0] = 30.0f;
+   SDL_RenderSetKernelConstants(swrenderer, constants, 1);
+   SDL_RenderCopy(swrenderer, texture, NULL, &rects[1]);
+   SDL_RenderSetKernelConstants(swrenderer, constants, 1);
+   SDL_RenderCopy(swrenderer, texture, NULL, &rects[2]);
+   constants[0] = 40.0f;
+   SDL_RenderSetKernelConstants(swrenderer, constants, 1);
+   SDL_RenderPresent(swrenderer);
+   _checkPixel(target, 0, 0, 0xFF010A0A, "copy before the constants changed");
+   _checkPixel(target, 4, 0, 0xFF011E1E, "copy after the constants changed");
+   _checkPixel(target, 8, 0, 0xFF011E1E, "copy after the same constants were set again");
+   SDL_RenderGetStats(swrenderer, &stats);
+   SDLTest_AssertCheck(stats.set_kernel_constants == 2, "Validate queued kernel constant changes, expected: 2, got: %u", stats.set_kernel_constants);
+
+   /* Copies with the same constants merge, a change of constants in between keeps them apart */
+   constants[0] = 50.0f;
+   SDL_RenderSetKernelConstants(swrenderer, constants, 1);
+   SDL_RenderCopy(swrenderer, texture, NULL, &rects[0]);
+   SDL_RenderCopy(swrenderer, texture, NULL, &rects[1]);
+   constants[0] = 60.0f;
+   SDL_RenderSetKernelConstants(swrenderer, constants, 1);
+   SDL_RenderCopy(swrenderer, texture, NULL, &rects[2]);
+   SDL_RenderPresent(swrenderer);
+   _checkPixel(target, 0, 0, 0xFF013232, "first merged copy");
+   _checkPixel(target, 4, 0, 0xFF013232, "second merged copy");
+   _checkPixel(target, 8, 0, 0xFF013C3C, "copy after the constants changed");
+   SDL_RenderGetStats(swrenderer, &stats);
+   SDLTest_AssertCheck(stats.copies == 2 && stats.copy_rects == 3,
+      "Validate copy commands, expected: 2 with 3 rects, got: %u with %u rects", stats.copies, stats.copy_rects);
+   SDLTest_AssertCheck(stats.set_kernel_constants == 2, "Validate queued kernel constant changes, expected: 2, got: %u", stats.set_kernel_constants);
+
+   SDL_DestroyRenderKernel(kernel);
+   SDL_DestroyTexture(texture);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(target);
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Queues fills, points, clip rect changes and modulated copies, all taken from values.
+ */
+static void
+_drawRandomQueue(SDL_Renderer *swrenderer, SDL_Texture *texture, const Uint32 *values, int count)
+{
+   const SDL_BlendMode modes[] = { SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD };
+   int w, h, i;
+
+   SDL_GetRendererOutputSize(swrenderer, &w, &h);
+   for (i = 0; i + 8 <= count; i += 8) {
+      const Uint32 *v = &values[i];
+      SDL_Rect rect;
+
+      rect.x = (int)(v[1] % (w + 16)) - 8;
+      rect.y = (int)(v[2] % (h + 16)) - 8;
+      rect.w = (int)(v[3] % 64) + 1;
+      rect.h = (int)(v[4] % 64) + 1;
+      switch (v[0] % 4) {
+      case 0:
+         SDL_SetRenderDrawBlendMode(swrenderer, modes[v[5] % SDL_arraysize(modes)]);
+         SDL_SetRenderDrawColor(swrenderer, (Uint8)v[6], (Uint8)(v[6] >> 8), (Uint8)(v[6] >> 16), (Uint8)(v[6] >> 24));
+         SDL_RenderFillRect(swrenderer, &rect);
+         break;
+      case 1: {
+         SDL_Rect srcrect;
+         int tw, th;
+
+         SDL_QueryTexture(texture, NULL, NULL, &tw, &th);
+         srcrect.w = SDL_min(rect.w, tw);
+         srcrect.h = SDL_min(rect.h, th);
+         srcrect.x = (int)(v[7] % (tw - srcrect.w + 1));
+         srcrect.y = (int)((v[7] >> 16) % (th - srcrect.h + 1));
+         rect.w = srcrect.w;
+         rect.h = srcrect.h;
+         SDL_SetTextureBlendMode(texture, modes[v[5] % SDL_arraysize(modes)]);
+         SDL_SetTextureColorMod(texture, (Uint8)v[6], (Uint8)(v[6] >> 8), (Uint8)(v[6] >> 16));
+         SDL_SetTextureAlphaMod(texture, (Uint8)(v[6] >> 24));
+         SDL_RenderCopy(swrenderer, texture, &srcrect, &rect);
+         break;
+      }
+      case 2:
+         SDL_RenderSetClipRect(swrenderer, (v[5] % 4 == 0) ? NULL : &rect);
+         break;
+      default: {
+         SDL_Point points[4];
+         int j;
+
+         for (j = 0; j < SDL_arraysize(points); j++) {
+            points[j].x = rect.x + j * 3;
+            points[j].y = rect.y + (int)((v[7] >> (j * 8)) % 16);
+         }
+         SDL_SetRenderDrawBlendMode(swrenderer, modes[v[5] % SDL_arraysize(modes)]);
+         SDL_SetRenderDrawColor(swrenderer, (Uint8)v[6], (Uint8)(v[6] >> 8), (Uint8)(v[6] >> 16), (Uint8)(v[6] >> 24));
+         SDL_RenderDrawPoints(swrenderer, points, SDL_arraysize(points));
+         break;
+      }
+      }
+   }
+   SDL_RenderSetClipRect(swrenderer, NULL);
+}
+
+/**
+ * @brief Tests that the software renderer draws the same pixels with and without SDL_HINT_RENDER_SOFTWARE_BANDS.
+ *
+ * The queue is drawn in one batch, with rects that straddle the band edges. Bands are
+ * only used with several worker threads, see SDL_HINT_WORKER_THREADS.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateSoftwareRenderer
+ */
+int
+render_testSoftwareBands(void *arg)
+{
+   const Uint32 formats[] = { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565 };
+   Uint32 values[8 * 200];
+   Uint32 pixels[64 * 64];
+   SDL_Surface *targets[2];
+   int i, j, x, y;
+
+   for (i = 0; i < SDL_arraysize(pixels); i++) {
+      pixels[i] = SDLTest_RandomUint32();
+   }
+   for (i = 0; i < SDL_arraysize(values); i++) {
+      values[i] = SDLTest_RandomUint32();
+   }
+
+   for (i = 0; i < SDL_arraysize(formats); i++) {
+      SDL_bool mismatch;
+
+      /* Without bands, then with them */
+      for (j = 0; j < 2; j++) {
+         SDL_Renderer *swrenderer;
+         SDL_Texture *texture;
+
+         SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_BANDS, j ? "1" : "0");
+         swrenderer = _createSoftwareRenderer(200, 130, formats[i], SDL_TRUE, &targets[j]);
+         SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_BANDS, "");
+         if (swrenderer == NULL) {
+            if (j) {
+               SDL_FreeSurface(targets[0]);
+            }
+            return TEST_ABORTED;
+         }
+         texture = SDL_CreateTexture(swrenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, 64, 64);
+         SDLTest_AssertCheck(texture != NULL, "Verify result from SDL_CreateTexture is not NULL");
+         if (texture != NULL) {
+            SDL_UpdateTexture(texture, NULL, pixels, 64 * 4);
+            SDL_SetRenderDrawColor(swrenderer, 30, 60, 90, 255);
+            SDL_RenderClear(swrenderer);
+            _drawRandomQueue(swrenderer, texture, values, SDL_arraysize(values));
+            SDL_RenderPresent(swrenderer);
+            SDL_DestroyTexture(texture);
+         }
+         SDL_DestroyRenderer(swrenderer);
+      }
+
+      mismatch = _findMismatch(targets[0], targets[1], &x, &y);
+      SDLTest_AssertCheck(!mismatch, "Validate %s pixels drawn in bands, expected: no mismatch, got: %s at (%i,%i)",
+         SDL_GetPixelFormatName(formats[i]), mismatch ? "a mismatch" : "none", x, y);
+      SDL_FreeSurface(targets[0]);
+      SDL_FreeSurface(targets[1]);
+   }
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that SDL_RenderCopyBatch draws the same pixels as one SDL_RenderCopyF per copy.
+ *
+ * The batches are drawn both as a single command and one copy at a time, the way renderers
+ * without batch support queue them.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateSoftwareRenderer
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderCopy
+ */
+int
+render_testCopyBatch(void *arg)
+{
+   /* The fourth source is outside of the texture and the last one is clipped to it, the last copy is clipped to the target */
+   const SDL_Rect srcrects[] = { { 0, 0, 8, 8 }, { 4, 2, 12, 6 }, { 2, 2, 4, 4 }, { 20, 20, 4, 4 }, { 10, 10, 12, 12 } };
+   const SDL_FRect dstrects[] = { { 2, 2, 8, 8 }, { 8, 6, 24, 12 }, { 30, 20, 4, 4 }, { 40, 4, 8, 8 }, { 56, 40, 16, 16 } };
+   const SDL_FRect offscreen = { 100, 100, 8, 8 };
+   SDL_Color colors[SDL_arraysize(dstrects)];
+   Uint32 pixels[16 * 16];
+   SDL_Surface *targets[3];
+   SDL_Renderer *renderers[3];
+   SDL_Texture *textures[3];
+   SDL_RenderStats stats;
+   int i, j, x, y, ret;
+
+   for (i = 0; i < SDL_arraysize(pixels); i++) {
+      pixels[i] = SDLTest_RandomUint32();
+   }
+   for (i = 0; i < SDL_arraysize(colors); i++) {
+      colors[i].r = SDLTest_RandomUint8();
+      colors[i].g = SDLTest_RandomUint8();
+      colors[i].b = SDLTest_RandomUint8();
+      colors[i].a = SDLTest_RandomUint8();
+   }
+
+   /* One renderer for the single copies, one for batches and one queueing batches a copy at a time */
+   for (i = 0; i < 3; i++) {
+      SDL_SetHint("SDL_RENDER_SOFTWARE_COPY_BATCH", (i == 2) ? "0" : "1");
+      renderers[i] = _createSoftwareRenderer(64, 48, SDL_PIXELFORMAT_ARGB8888, SDL_TRUE, &targets[i]);
+      SDL_SetHint("SDL_RENDER_SOFTWARE_COPY_BATCH", "");
+      textures[i] = renderers[i] ? SDL_CreateTexture(renderers[i], SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, 16, 16) : NULL;
+      if (textures[i] == NULL) {
+         SDLTest_AssertCheck(textures[i] != NULL, "Verify the renderer and texture are not NULL");
+         for (j = 0; j <= i; j++) {
+            SDL_DestroyRenderer(renderers[j]);
+            SDL_FreeSurface(targets[j]);
+         }
+         return TEST_ABORTED;
+      }
+      SDL_UpdateTexture(textures[i], NULL, pixels, 16 * 4);
+      SDL_SetTextureBlendMode(textures[i], SDL_BLENDMODE_BLEND);
+      SDL_SetTextureColorMod(textures[i], 200, 220, 240);
+      SDL_SetTextureAlphaMod(textures[i], 180);
+   }
+
+   /* Errors, and empty batches that draw nothing */
+   ret = SDL_RenderCopyBatch(NULL, textures[1], srcrects, dstrects, NULL, 1);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_RenderCopyBatch with NULL renderer, expected: -1, got: %i", ret);
+   ret = SDL_RenderCopyBatch(renderers[1], NULL, srcrects, dstrects, NULL, 1);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_RenderCopyBatch with NULL texture, expected: -1, got: %i", ret);
+   ret = SDL_RenderCopyBatch(renderers[1], textures[0], srcrects, dstrects, NULL, 1);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_RenderCopyBatch with another renderer's texture, expected: -1, got: %i", ret);
+   ret = SDL_RenderCopyBatch(renderers[1], textures[1], srcrects, NULL, NULL, 1);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_RenderCopyBatch with NULL dstrects, expected: -1, got: %i", ret);
+   for (i = 0; i < 3; i++) {
+      SDL_SetRenderDrawColor(renderers[i], 0, 0, 0, 255);
+      SDL_RenderClear(renderers[i]);
+      SDL_RenderPresent(renderers[i]);
+   }
+   ret = SDL_RenderCopyBatch(renderers[1], textures[1], srcrects, dstrects, NULL, 0);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopyBatch with count 0, expected: 0, got: %i", ret);
+   ret = SDL_RenderCopyBatch(renderers[1], textures[1], srcrects, &offscreen, NULL, 1);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopyBatch off the target, expected: 0, got: %i", ret);
+   SDL_RenderPresent(renderers[1]);
+   SDL_RenderGetStats(renderers[1], &stats);
+   SDLTest_AssertCheck(stats.copies == 0, "Validate copy commands of empty batches, expected: 0, got: %u", stats.copies);
+   _checkPixel(targets[1], 0, 0, 0xFF000000, "target after empty batches");
+
+   /* With and without source rects and per copy colors */
+   for (j = 0; j < 4; j++) {
+      const SDL_bool use_srcrects = (j & 1) ? SDL_TRUE : SDL_FALSE;
+      const SDL_bool use_colors = (j & 2) ? SDL_TRUE : SDL_FALSE;
+      SDL_bool mismatch;
+
+      for (i = 0; i < 3; i++) {
+         SDL_SetRenderDrawColor(renderers[i], 20, 40, 60, 255);
+         SDL_RenderClear(renderers[i]);
+      }
+      for (i = 0; i < SDL_arraysize(dstrects); i++) {
+         if (use_colors) {
+            SDL_SetTextureColorMod(textures[0], colors[i].r, colors[i].g, colors[i].b);
+            SDL_SetTextureAlphaMod(textures[0], colors[i].a);
+         }
+         SDL_RenderCopyF(renderers[0], textures[0], use_srcrects ? &srcrects[i] : NULL, &dstrects[i]);
+      }
+      SDL_SetTextureColorMod(textures[0], 200, 220, 240);
+      SDL_SetTextureAlphaMod(textures[0], 180);
+      for (i = 1; i < 3; i++) {
+         ret = SDL_RenderCopyBatch(renderers[i], textures[i], use_srcrects ? srcrects : NULL, dstrects,
+                                   use_colors ? colors : NULL, SDL_arraysize(dstrects));
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopyBatch, expected: 0, got: %i", ret);
+      }
+      for (i = 0; i < 3; i++) {
+         SDL_RenderPresent(renderers[i]);
+      }
+
+      SDL_RenderGetStats(renderers[1], &stats);
+      SDLTest_AssertCheck(stats.copies == 1 && stats.copy_rects == (use_srcrects ? 4 : 5),
+         "Validate copy commands of a batch, expected: 1 with %i rects, got: %u with %u rects",
+         use_srcrects ? 4 : 5, stats.copies, stats.copy_rects);
+      for (i = 1; i < 3; i++) {
+         mismatch = _findMismatch(targets[0], targets[i], &x, &y);
+         SDLTest_AssertCheck(!mismatch,
+            "Validate %s with%s source rects and with%s colors, expected: no mismatch, got: %s at (%i,%i)",
+            (i == 1) ? "batch" : "batch queued a copy at a time", use_srcrects ? "" : "out", use_colors ? "" : "out",
+            mismatch ? "a mismatch" : "none", x, y);
+      }
+   }
+
+   for (i = 0; i < 3; i++) {
+      SDL_DestroyTexture(textures[i]);
+      SDL_DestroyRenderer(renderers[i]);
+      SDL_FreeSurface(targets[i]);
+   }
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that clipped linear copies sample the texture where unclipped ones do.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateSoftwareRenderer
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderCopy
+ */
+int
+render_testCopyLinearClipped(void *arg)
+{
+   const SDL_Rect dstrect = { 5, 4, 50, 37 };
+   const SDL_Rect offtarget = { -20, -10, 50, 37 };
+   const SDL_Rect cliprect = { 17, 11, 20, 15 };
+   Uint32 pixels[13 * 9];
+   SDL_Surface *targets[3];
+   SDL_Renderer *renderers[3];
+   SDL_Texture *texture;
+   int i, x, y;
+
+   for (i = 0; i < SDL_arraysize(pixels); i++) {
+      pixels[i] = SDLTest_RandomUint32();
+   }
+
+   /* Unclipped, clipped by the clip rect and clipped by the edges of the target */
+   for (i = 0; i < 3; i++) {
+      renderers[i] = _createSoftwareRenderer(64, 48, SDL_PIXELFORMAT_ARGB8888, SDL_FALSE, &targets[i]);
+      texture = renderers[i] ? SDL_CreateTexture(renderers[i], SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, 13, 9) : NULL;
+      if (texture == NULL) {
+         SDLTest_AssertCheck(texture != NULL, "Verify the renderer and texture are not NULL");
+         while (i >= 0) {
+            SDL_DestroyRenderer(renderers[i]);
+            SDL_FreeSurface(targets[i]);
+            i--;
+         }
+         return TEST_ABORTED;
+      }
+      SDL_UpdateTexture(texture, NULL, pixels, 13 * 4);
+      SDL_SetTextureScaleMode(texture, SDL_ScaleModeLinear);
+      SDL_SetRenderDrawColor(renderers[i], 0, 0, 0, 255);
+      SDL_RenderClear(renderers[i]);
+      if (i == 1) {
+         SDL_RenderSetClipRect(renderers[i], &cliprect);
+      }
+      SDL_RenderCopy(renderers[i], texture, NULL, (i == 2) ? &offtarget : &dstrect);
+      SDL_RenderPresent(renderers[i]);
+      SDL_DestroyTexture(texture);
+   }
+
+   for (i = 1; i < 3; i++) {
+      const int dx = (i == 2) ? dstrect.x - offtarget.x : 0;
+      const int dy = (i == 2) ? dstrect.y - offtarget.y : 0;
+      int mismatches = 0;
+      Uint32 expected = 0, pixel = 0;
+
+      for (y = 0; y < 48; y++) {
+         for (x = 0; x < 64; x++) {
+            const SDL_Point p = { x, y };
+            const SDL_bool drawn = (i == 2) ? (x + dx < 64 && y + dy < 48 && x < offtarget.x + offtarget.w && y < offtarget.y + offtarget.h)
+                                            : SDL_PointInRect(&p, &cliprect);
+            const Uint32 p1 = ((Uint32 *)((Uint8 *)targets[i]->pixels + y * targets[i]->pitch))[x];
+            const Uint32 e = drawn ? ((Uint32 *)((Uint8 *)targets[0]->pixels + (y + dy) * targets[0]->pitch))[x + dx] : 0xFF000000;
+            if (p1 != e) {
+               expected = e;
+               pixel = p1;
+               mismatches++;
+            }
+         }
+      }
+      SDLTest_AssertCheck(mismatches == 0,
+         "Validate linear copy clipped by the %s, expected: 0 mismatches, got: %i (last expected 0x%08x, got 0x%08x)",
+         (i == 1) ? "clip rect" : "target", mismatches, expected, pixel);
+   }
+
+   for (i = 0; i < 3; i++) {
+      SDL_DestroyRenderer(renderers[i]);
+      SDL_FreeSurface(targets[i]);
+   }
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that flipped and rotated copies blend like plain copies of pre-transformed textures.
+ *
+ * Rotated and flipped copies round their divisions by 255 where plain copies
+ * truncate them, so the channels may differ by up to three steps.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateSoftwareRenderer
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderCopyEx
+ */
+int
+render_testCopyExBlendModes(void *arg)
+{
+   const SDL_BlendMode modes[] = {
+      SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD, SDL_BLENDMODE_MUL
+   };
+   const SDL_RendererFlip flips[] = { SDL_FLIP_HORIZONTAL, SDL_FLIP_VERTICAL, SDL_FLIP_NONE };
+   const SDL_Rect plain = { 0, 0, 8, 8 };
+   const SDL_Rect transformed = { 16, 0, 8, 8 };
+   Uint32 pixels[8 * 8], reference[8 * 8], background[8 * 8];
+   SDL_Surface *target;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture, *pretransformed, *backdrop;
+   int i, m, f, mod, x, y, shift;
+
+   swrenderer = _createSoftwareRenderer(24, 8, SDL_PIXELFORMAT_ARGB8888, SDL_FALSE, &target);
+   if (swrenderer == NULL) {
+      return TEST_ABORTED;
+   }
+   texture = SDL_CreateTexture(swrenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 8, 8);
+   pretransformed = SDL_CreateTexture(swrenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 8, 8);
+   backdrop = SDL_CreateTexture(swrenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 8, 8);
+   SDLTest_AssertCheck(texture != NULL && pretransformed != NULL && backdrop != NULL, "Verify results from SDL_CreateTexture are not NULL");
+   if (texture == NULL || pretransformed == NULL || backdrop == NULL) {
+      SDL_DestroyRenderer(swrenderer);
+      SDL_FreeSurface(target);
+      return TEST_ABORTED;
+   }
+
+   /* Every alpha from transparent to opaque, over a background with alpha too */
+   for (i = 0; i < SDL_arraysize(pixels); i++) {
+      pixels[i] = SDLTest_RandomUint32();
+      background[i] = SDLTest_RandomUint32();
+   }
+   pixels[0] &= 0x00FFFFFF;
+   pixels[1] |= 0xFF000000;
+   SDL_UpdateTexture(texture, NULL, pixels, 8 * 4);
+   SDL_UpdateTexture(backdrop, NULL, background, 8 * 4);
+   SDL_SetTextureBlendMode(backdrop, SDL_BLENDMODE_NONE);
+
+   for (f = 0; f < SDL_arraysize(flips); f++) {
+      const double angle = (flips[f] == SDL_FLIP_NONE) ? 90.0 : 0.0;
+
+      for (y = 0; y < 8; y++) {
+         for (x = 0; x < 8; x++) {
+            int sx = x, sy = y;
+            if (flips[f] == SDL_FLIP_HORIZONTAL) {
+               sx = 7 - x;
+            } else if (flips[f] == SDL_FLIP_VERTICAL) {
+               sy = 7 - y;
+            } else {
+               /* A quarter turn clockwise */
+               sx = y;
+               sy = 7 - x;
+            }
+            reference[y * 8 + x] = pixels[sy * 8 + sx];
+         }
+      }
+      SDL_UpdateTexture(pretransformed, NULL, reference, 8 * 4);
+
+      for (m = 0; m < SDL_arraysize(modes); m++) {
+         for (mod = 0; mod < 2; mod++) {
+            const Uint8 r = mod ? 200 : 255, g = mod ? 100 : 255, b = mod ? 50 : 255, a = mod ? 160 : 255;
+            int maxdiff = 0, atx = 0, aty = 0;
+
+            SDL_RenderCopy(swrenderer, backdrop, NULL, &plain);
+            SDL_RenderCopy(swrenderer, backdrop, NULL, &transformed);
+            SDL_SetTextureBlendMode(pretransformed, modes[m]);
+            SDL_SetTextureBlendMode(texture, modes[m]);
+            SDL_SetTextureColorMod(pretransformed, r, g, b);
+            SDL_SetTextureColorMod(texture, r, g, b);
+            SDL_SetTextureAlphaMod(pretransformed, a);
+            SDL_SetTextureAlphaMod(texture, a);
+            SDL_RenderCopy(swrenderer, pretransformed, NULL, &plain);
+            SDL_RenderCopyEx(swrenderer, texture, NULL, &transformed, angle, NULL, flips[f]);
+            SDL_RenderPresent(swrenderer);
+
+            for (y = 0; y < 8; y++) {
+               const Uint32 *row = (const Uint32 *)((const Uint8 *)target->pixels + y * target->pitch);
+               for (x = 0; x < 8; x++) {
+                  for (shift = 0; shift < 32; shift += 8) {
+                     const int diff = SDL_abs((int)((row[x] >> shift) & 0xFF) - (int)((row[x + 16] >> shift) & 0xFF));
+                     if (diff > maxdiff) {
+                        maxdiff = diff;
+                        atx = x;
+                        aty = y;
+                     }
+                  }
+               }
+            }
+            SDLTest_AssertCheck(maxdiff <= 3,
+               "Validate %s copy with blend mode 0x%x and%s color mod, expected: channels within 3 of a plain copy, got: %i at (%i,%i)",
+               (flips[f] == SDL_FLIP_HORIZONTAL) ? "flipped horizontally" : (flips[f] == SDL_FLIP_VERTICAL) ? "flipped vertically" : "rotated",
+               modes[m], mod ? "" : " no", maxdiff, atx, aty);
+         }
+      }
+   }
+
+   SDL_DestroyTexture(texture);
+   SDL_DestroyTexture(pretransformed);
+   SDL_DestroyTexture(backdrop);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(target);
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Queues frame number `frame` of render_testMergeCopies(), which copies
+ *        the first texture and changes one thing between some of the copies.
+ */
+static void
+_drawMergeFrame(SDL_Renderer *renderer, SDL_Texture **textures, SDL_RenderKernel *kernel, int frame)
+{
+   const SDL_Rect rects[] = { { 0, 0, 8, 8 }, { 6, 2, 8, 8 }, { 12, 4, 8, 8 }, { 18, 6, 8, 8 } };
+   const SDL_Rect fill = { 4, 4, 20, 4 };
+   int i;
+
+   SDL_SetRenderDrawColor(renderer, 0, 0, 64, 255);
+   SDL_RenderClear(renderer);
+   SDL_SetTextureBlendMode(textures[0], SDL_BLENDMODE_BLEND);
+   SDL_SetTextureColorMod(textures[0], 255, 255, 255);
+   for (i = 0; i < SDL_arraysize(rects); i++) {
+      SDL_Texture *texture = textures[0];
+
+      if (i == 2) {
+         switch (frame) {
+            case 1: texture = textures[1]; break;
+            case 2: SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_ADD); break;
+            case 3: SDL_SetTextureColorMod(texture, 255, 128, 0); break;
+            case 4: SDL_RenderSetKernel(renderer, kernel); break;
+            case 5: SDL_RenderFillRect(renderer, &fill); break;
+         }
+      }
+      SDL_RenderCopy(renderer, texture, NULL, &rects[i]);
+      if (frame == 4 && i == 2) {
+         SDL_RenderSetKernel(renderer, NULL);
+      }
+   }
+   SDL_RenderPresent(renderer);
+}
+
+/**
+ * @brief Tests that consecutive copies with the same state are merged, and draw what separate copies would.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateSoftwareRenderer
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderCopy
+ */
+int
+render_testMergeCopies(void *arg)
+{
+   /* How many copy commands the batching renderer ends up with in each frame */
+   const Uint32 merged[] = { 1, 3, 2, 2, 3, 2 };
+   const char *changes[] = {
+      "nothing", "the texture", "the blend mode", "the color mod", "the kernel", "a fill queued in between"
+   };
+   Uint32 pixels[8 * 8];
+   SDL_Surface *targets[2];
+   SDL_Renderer *renderers[2];
+   SDL_Texture *textures[2][2];
+   SDL_RenderKernel *kernels[2];
+   SDL_RenderStats stats[2];
+   SDL_bool mismatch;
+   int i, j, frame, x, y;
+
+   for (i = 0; i < SDL_arraysize(pixels); i++) {
+      pixels[i] = SDLTest_RandomUint32();
+   }
+
+   /* The first renderer batches and merges, the second draws every copy on its own */
+   for (i = 0; i < 2; i++) {
+      renderers[i] = _createSoftwareRenderer(32, 16, SDL_PIXELFORMAT_ARGB8888, (i == 0) ? SDL_TRUE : SDL_FALSE, &targets[i]);
+      if (renderers[i] == NULL) {
+         if (i == 1) {
+            SDL_DestroyRenderer(renderers[0]);
+            SDL_FreeSurface(targets[0]);
+         }
+         return TEST_ABORTED;
+      }
+      for (j = 0; j < 2; j++) {
+         textures[i][j] = SDL_CreateTexture(renderers[i], SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 8, 8);
+         SDLTest_AssertCheck(textures[i][j] != NULL, "Verify result from SDL_CreateTexture is not NULL");
+         SDL_UpdateTexture(textures[i][j], NULL, pixels, 8 * 4);
+         SDL_SetTextureBlendMode(textures[i][j], SDL_BLENDMODE_BLEND);
+      }
+      kernels[i] = SDL_CreateRenderKernel(renderers[i], _positionKernel, NULL, NULL, 0);
+      SDLTest_AssertCheck(kernels[i] != NULL, "Verify result from SDL_CreateRenderKernel is not NULL");
+   }
+
+   for (frame = 0; frame < SDL_arraysize(merged); frame++) {
+      for (i = 0; i < 2; i++) {
+         _drawMergeFrame(renderers[i], textures[i], kernels[i], frame);
+         SDL_RenderGetStats(renderers[i], &stats[i]);
+      }
+      SDLTest_AssertCheck(stats[0].copies == merged[frame] && stats[0].copy_rects == 4,
+         "Validate merged copies when changing %s, expected: %u with 4 rects, got: %u with %u rects",
+         changes[frame], merged[frame], stats[0].copies, stats[0].copy_rects);
+      SDLTest_AssertCheck(stats[1].copies == 4 && stats[1].copy_rects == 4,
+         "Validate unmerged copies when changing %s, expected: 4 with 4 rects, got: %u with %u rects",
+         changes[frame], stats[1].copies, stats[1].copy_rects);
+      mismatch = _findMismatch(targets[1], targets[0], &x, &y);
+      SDLTest_AssertCheck(!mismatch, "Validate merged copies when changing %s draw like separate ones, expected: no mismatch, got: %s at (%i,%i)",
+         changes[frame], mismatch ? "a mismatch" : "none", x, y);
+   }
+
+   for (i = 0; i < 2; i++) {
+      SDL_DestroyRenderKernel(kernels[i]);
+      SDL_DestroyTexture(textures[i][0]);
+      SDL_DestroyTexture(textures[i][1]);
+      SDL_DestroyRenderer(renderers[i]);
+      SDL_FreeSurface(targets[i]);
+   }
+   return TEST_COMPLETED;
+}
+
+static SDL_Rect _updatedRects[16];
+static int _numUpdatedRects;
+static SDL_LogOutputFunction _savedLogOutput;
+static void *_savedLogUserdata;
+
+/**
+ * @brief Collects the rects the dummy video driver logs when a window surface is updated.
+ *
+ * Other messages, like the results of the asserts, go where they went before,
+ * except for the rest of the video debug output turned on to get the rects.
+ */
+static void SDLCALL
+_captureUpdatedRects(void *userdata, int category, SDL_LogPriority priority, const char *message)
+{
+   unsigned int id;
+   int i, n;
+   SDL_Rect rect;
+
+   if (category == SDL_LOG_CATEGORY_VIDEO && priority == SDL_LOG_PRIORITY_DEBUG &&
+       SDL_sscanf(message, "Update window %u rect %d of %d: %d,%d %dx%d", &id, &i, &n, &rect.x, &rect.y, &rect.w, &rect.h) == 7) {
+      if (_numUpdatedRects < SDL_arraysize(_updatedRects)) {
+         _updatedRects[_numUpdatedRects] = rect;
+      }
+      _numUpdatedRects++;
+   } else if (_savedLogOutput && !(category == SDL_LOG_CATEGORY_VIDEO && priority == SDL_LOG_PRIORITY_DEBUG)) {
+      _savedLogOutput(_savedLogUserdata, category, priority, message);
+   }
+}
+
+/**
+ * @brief Presents and returns how many rects of the window that updated.
+ */
+static int
+_presentDamage(SDL_Renderer *renderer)
+{
+   _numUpdatedRects = 0;
+   SDL_RenderPresent(renderer);
+   return _numUpdatedRects;
+}
+
+/**
+ * @brief Whether one of the updated rects is exactly rect.
+ */
+static SDL_bool
+_hasUpdatedRect(const SDL_Rect *rect)
+{
+   int i;
+
+   for (i = 0; i < _numUpdatedRects; i++) {
+      if (SDL_RectEquals(&_updatedRects[i], rect)) {
+         return SDL_TRUE;
+      }
+   }
+   return SDL_FALSE;
+}
+
+/**
+ * @brief Whether one of the updated rects contains the pixel at (x, y).
+ */
+static SDL_bool
+_isUpdated(int x, int y)
+{
+   const SDL_Point p = { x, y };
+   int i;
+
+   for (i = 0; i < _numUpdatedRects; i++) {
+      if (SDL_PointInRect(&p, &_updatedRects[i])) {
+         return SDL_TRUE;
+      }
+   }
+   return SDL_FALSE;
+}
+
+/**
+ * @brief Tests that presenting a software rendered window updates only what was drawn.
+ *
+ * Needs the dummy video driver, which logs the rects it updates.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateRenderer
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderPresent
+ */
+int
+render_testSoftwareDamage(void *arg)
+{
+   const SDL_Rect everything = { 0, 0, 64, 48 };
+   const SDL_Rect fill = { 2, 2, 6, 6 };
+   const SDL_Rect copy = { 30, 20, 8, 8 };
+   const SDL_Rect left = { 0, 0, 4, 4 };
+   const SDL_Rect right = { 4, 0, 4, 4 };
+   const SDL_Rect touching = { 0, 0, 8, 4 };
+   const SDL_Rect clip = { 10, 10, 10, 10 };
+   const SDL_Rect clipped = { 5, 5, 20, 20 };
+   const SDL_Rect rotated = { 24, 18, 16, 10 };
+   const double angles[] = { 15.0, 30.0, 45.0, 90.0, 137.0, 200.0, 333.0 };
+   const char *driver = SDL_GetCurrentVideoDriver();
+   const SDL_LogPriority saved_priority = SDL_LogGetPriority(SDL_LOG_CATEGORY_VIDEO);
+   Uint32 pixels[64 * 48];
+   SDL_Window *swwindow;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture;
+   int i, n, x, y, outside;
+
+   if (driver == NULL || SDL_strcmp(driver, "dummy") != 0) {
+      SDLTest_Log("Skipping test, it needs the dummy video driver");
+      return TEST_SKIPPED;
+   }
+
+   swwindow = SDL_CreateWindow("render_testSoftwareDamage", 0, 0, 64, 48, 0);
+   SDLTest_AssertCheck(swwindow != NULL, "Verify result from SDL_CreateWindow is not NULL");
+   if (swwindow == NULL) {
+      return TEST_ABORTED;
+   }
+   swrenderer = SDL_CreateRenderer(swwindow, -1, SDL_RENDERER_SOFTWARE);
+   texture = swrenderer ? SDL_CreateTexture(swrenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 8, 8) : NULL;
+   SDLTest_AssertCheck(swrenderer != NULL && texture != NULL, "Verify the renderer and texture are not NULL");
+   if (texture == NULL) {
+      SDL_DestroyRenderer(swrenderer);
+      SDL_DestroyWindow(swwindow);
+      return TEST_ABORTED;
+   }
+   for (i = 0; i < 8 * 8; i++) {
+      pixels[i] = 0xFFFFFFFF;
+   }
+   SDL_UpdateTexture(texture, NULL, pixels, 8 * 4);
+   SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+   SDL_SetRenderDrawColor(swrenderer, 255, 255, 255, 255);
+
+   SDL_LogGetOutputFunction(&_savedLogOutput, &_savedLogUserdata);
+   SDL_LogSetOutputFunction(_captureUpdatedRects, NULL);
+   SDL_LogSetPriority(SDL_LOG_CATEGORY_VIDEO, SDL_LOG_PRIORITY_DEBUG);
+
+   /* Clearing changes everything */
+   SDL_RenderClear(swrenderer);
+   n = _presentDamage(swrenderer);
+   SDLTest_AssertCheck(n == 1 && _hasUpdatedRect(&everything), "Validate updated rects after a clear, expected: 1, the whole window, got: %i", n);
+
+   /* Areas apart from each other are updated on their own */
+   SDL_RenderFillRect(swrenderer, &fill);
+   SDL_RenderCopy(swrenderer, texture, NULL, &copy);
+   n = _presentDamage(swrenderer);
+   SDLTest_AssertCheck(n == 2 && _hasUpdatedRect(&fill) && _hasUpdatedRect(&copy),
+      "Validate updated rects after a fill and a copy, expected: 2, the fill and the copy, got: %i", n);
+
+   /* Nothing drawn, nothing updated */
+   n = _presentDamage(swrenderer);
+   SDLTest_AssertCheck(n == 0, "Validate updated rects without drawing, expected: 0, got: %i", n);
+
+   /* Touching areas become one */
+   SDL_RenderFillRect(swrenderer, &left);
+   SDL_RenderFillRect(swrenderer, &right);
+   n = _presentDamage(swrenderer);
+   SDLTest_AssertCheck(n == 1 && _hasUpdatedRect(&touching), "Validate updated rects after touching fills, expected: 1, their union, got: %i", n);
+
+   /* Only the part inside the clip rect changes */
+   SDL_RenderSetClipRect(swrenderer, &clip);
+   SDL_RenderFillRect(swrenderer, &clipped);
+   SDL_RenderSetClipRect(swrenderer, NULL);
+   n = _presentDamage(swrenderer);
+   SDLTest_AssertCheck(n == 1 && _hasUpdatedRect(&clip), "Validate updated rects after a clipped fill, expected: 1, the clip rect, got: %i", n);
+
+   /* Past 8 areas they are merged, and still cover everything drawn */
+   SDL_RenderClear(swrenderer);
+   SDL_RenderPresent(swrenderer);
+   SDL_SetRenderDrawColor(swrenderer, 0, 0, 0, 255);
+   for (i = 0; i < 12; i++) {
+      SDL_RenderDrawPoint(swrenderer, (i % 6) * 10 + 2, (i / 6) * 40 + 3);
+   }
+   n = _presentDamage(swrenderer);
+   SDL_RenderReadPixels(swrenderer, NULL, SDL_PIXELFORMAT_ARGB8888, pixels, 64 * 4);
+   outside = 0;
+   for (y = 0; y < 48; y++) {
+      for (x = 0; x < 64; x++) {
+         if (pixels[y * 64 + x] != 0xFFFFFFFF && !_isUpdated(x, y)) {
+            outside++;
+         }
+      }
+   }
+   SDLTest_AssertCheck(n >= 1 && n <= 8, "Validate updated rects after 12 points, expected: 1 to 8, got: %i", n);
+   SDLTest_AssertCheck(outside == 0, "Validate points outside the updated rects, expected: 0, got: %i", outside);
+
+   /* Rotated copies stay inside their bounds, which are at most 2 pixels
+      bigger than the rotated rect on each side, plus one for rounding */
+   for (i = 0; i < SDL_arraysize(angles); i++) {
+      SDL_Rect drawn = { 64, 48, 0, 0 };
+      int right_edge = 0, bottom_edge = 0;
+
+      SDL_SetRenderDrawColor(swrenderer, 0, 0, 0, 255);
+      SDL_RenderClear(swrenderer);
+      SDL_RenderPresent(swrenderer);
+      SDL_RenderCopyEx(swrenderer, texture, NULL, &rotated, angles[i], NULL, SDL_FLIP_NONE);
+      n = _presentDamage(swrenderer);
+      SDL_RenderReadPixels(swrenderer, NULL, SDL_PIXELFORMAT_ARGB8888, pixels, 64 * 4);
+
+      outside = 0;
+      for (y = 0; y < 48; y++) {
+         for (x = 0; x < 64; x++) {
+            if (pixels[y * 64 + x] != 0xFF000000) {
+               if (!_isUpdated(x, y)) {
+                  outside++;
+               }
+               drawn.x = SDL_min(drawn.x, x);
+               drawn.y = SDL_min(drawn.y, y);
+               right_edge = SDL_max(right_edge, x + 1);
+               bottom_edge = SDL_max(bottom_edge, y + 1);
+            }
+         }
+      }
+      drawn.w = right_edge - drawn.x;
+      drawn.h = bottom_edge - drawn.y;
+      SDLTest_AssertCheck(n == 1 && outside == 0,
+         "Validate rotated copy by %g degrees inside the updated rects, expected: 1 rect and 0 pixels outside, got: %i and %i",
+         angles[i], n, outside);
+      if (n == 1) {
+         const SDL_Rect *updated = &_updatedRects[0];
+         SDLTest_AssertCheck(updated->x >= drawn.x - 3 && updated->y >= drawn.y - 3 &&
+                             updated->x + updated->w <= drawn.x + drawn.w + 3 && updated->y + updated->h <= drawn.y + drawn.h + 3,
+            "Validate updated rect of rotated copy by %g degrees, expected: within 3 pixels of %i,%i %ix%i, got: %i,%i %ix%i",
+            angles[i], drawn.x, drawn.y, drawn.w, drawn.h, updated->x, updated->y, updated->w, updated->h);
+      }
+   }
+
+   SDL_LogSetOutputFunction(_savedLogOutput, _savedLogUserdata);
+   SDL_LogSetPriority(SDL_LOG_CATEGORY_VIDEO, saved_priority);
+
+   SDL_DestroyTexture(texture);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_DestroyWindow(swwindow);
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that SDL_RenderGetStats() counts what the last frame queued.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateSoftwareRenderer
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderPresent
+ */
+int
+render_testRenderStats(void *arg)
+{
+   const SDL_Rect rects[] = { { 0, 0, 4, 4 }, { 4, 0, 4, 4 }, { 8, 8, 4, 4 } };
+   const SDL_Point points[] = { { 1, 1 }, { 20, 10 }, { 30, 2 } };
+   Uint32 pixels[4 * 4];
+   SDL_Surface *target;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture;
+   SDL_RenderStats stats;
+   int frame, ret;
+
+   swrenderer = _createSoftwareRenderer(32, 16, SDL_PIXELFORMAT_ARGB8888, SDL_TRUE, &target);
+   if (swrenderer == NULL) {
+      return TEST_ABORTED;
+   }
+   texture = SDL_CreateTexture(swrenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 4, 4);
+   SDLTest_AssertCheck(texture != NULL, "Verify result from SDL_CreateTexture is not NULL");
+   if (texture == NULL) {
+      SDL_DestroyRenderer(swrenderer);
+      SDL_FreeSurface(target);
+      return TEST_ABORTED;
+   }
+   SDL_memset(pixels, 0xFF, sizeof(pixels));
+
+   ret = SDL_RenderGetStats(swrenderer, NULL);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_RenderGetStats with NULL stats, expected: -1, got: %i", ret);
+   ret = SDL_RenderGetStats(NULL, &stats);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_RenderGetStats with NULL renderer, expected: -1, got: %i", ret);
+   ret = SDL_RenderGetStats(swrenderer, &stats);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGetStats, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(stats.copies == 0 && stats.flushes == 0 && stats.present_us == 0,
+      "Validate stats before the first frame, expected: 0 copies, flushes and microseconds presenting, got: %u, %u and %u",
+      stats.copies, stats.flushes, (unsigned int)stats.present_us);
+
+   /* The same draws twice, both frames count only their own */
+   for (frame = 0; frame < 2; frame++) {
+      SDL_UpdateTexture(texture, NULL, pixels, 4 * 4);
+      SDL_SetRenderDrawColor(swrenderer, 0, 0, 0, 255);
+      SDL_RenderClear(swrenderer);
+      SDL_SetRenderDrawColor(swrenderer, 255, 0, 0, 255);
+      SDL_RenderFillRects(swrenderer, rects, 2);
+      SDL_RenderDrawPoints(swrenderer, points, SDL_arraysize(points));
+      SDL_RenderDrawLines(swrenderer, points, SDL_arraysize(points));
+      SDL_RenderSetClipRect(swrenderer, &rects[2]);
+      SDL_RenderCopy(swrenderer, texture, NULL, &rects[0]);
+      SDL_RenderCopy(swrenderer, texture, NULL, &rects[1]);
+      SDL_RenderCopy(swrenderer, texture, NULL, &rects[2]);
+      SDL_RenderSetClipRect(swrenderer, NULL);
+      SDL_RenderCopyEx(swrenderer, texture, NULL, &rects[2], 45.0, NULL, SDL_FLIP_NONE);
+      SDL_RenderPresent(swrenderer);
+
+      ret = SDL_RenderGetStats(swrenderer, &stats);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGetStats, expected: 0, got: %i", ret);
+      SDLTest_AssertCheck(stats.clears == 1 && stats.fill_rects == 1 && stats.draw_points == 1 && stats.draw_lines == 1,
+         "Validate frame %i draw commands, expected: 1 clear, fill, points and lines, got: %u, %u, %u and %u",
+         frame, stats.clears, stats.fill_rects, stats.draw_points, stats.draw_lines);
+      SDLTest_AssertCheck(stats.copies == 1 && stats.copy_rects == 3 && stats.copies_ex == 1,
+         "Validate frame %i copies, expected: 1 with 3 rects and 1 rotated, got: %u with %u rects and %u rotated",
+         frame, stats.copies, stats.copy_rects, stats.copies_ex);
+      /* Clears carry their own color, so only the red draws and the copies set one.
+         The clip rect is queued before the first draw, then set and unset. */
+      SDLTest_AssertCheck(stats.set_draw_color == 2 && stats.set_cliprect == 3 && stats.set_viewport == 1,
+         "Validate frame %i state changes, expected: 2 colors, 3 clip rects and 1 viewport, got: %u, %u and %u",
+         frame, stats.set_draw_color, stats.set_cliprect, stats.set_viewport);
+      SDLTest_AssertCheck(stats.flushes == 1 && stats.forced_flushes == 0 && stats.texture_uploads == 1 && stats.vertex_bytes > 0,
+         "Validate frame %i flushes and uploads, expected: 1 flush, none forced, 1 upload and some vertex bytes, got: %u, %u, %u and %u bytes",
+         frame, stats.flushes, stats.forced_flushes, stats.texture_uploads, (unsigned int)stats.vertex_bytes);
+      SDLTest_AssertCheck(stats.run_queue_us < 10000000 && stats.present_us < 10000000,
+         "Validate frame %i times, expected: under 10 seconds each, got: %u and %u microseconds",
+         frame, (unsigned int)stats.run_queue_us, (unsigned int)stats.present_us);
+   }
+
+   /* An empty frame starts from zero again */
+   SDL_RenderPresent(swrenderer);
+   SDL_RenderGetStats(swrenderer, &stats);
+   SDLTest_AssertCheck(stats.clears == 0 && stats.copies == 0 && stats.copy_rects == 0 && stats.flushes == 0 &&
+                       stats.texture_uploads == 0 && stats.vertex_bytes == 0 && stats.run_queue_us == 0,
+      "Validate an empty frame, expected: nothing counted, got: %u clears, %u copies with %u rects, %u flushes, %u uploads, %u vertex bytes and %u microseconds drawing",
+      stats.clears, stats.copies, stats.copy_rects, stats.flushes, stats.texture_uploads, (unsigned int)stats.vertex_bytes, (unsigned int)stats.run_queue_us);
+
+   SDL_DestroyTexture(texture);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(target);
+   return TEST_COMPLETED;
+}
+
 /**
  * @brief Clears the screen. Helper function.
  *
@@ -1085,9 +2467,42 @@ static const SDLTest_TestCaseReference renderTest6 =
 static const SDLTest_TestCaseReference renderTest7 =
         {  (SDLTest_TestCaseFp)render_testBlitBlend, "render_testBlitBlend", "Tests blitting with blending", TEST_DISABLED };
 
+static const SDLTest_TestCaseReference renderTest8 =
+        { (SDLTest_TestCaseFp)render_testCopyExPremultiplied, "render_testCopyExPremultiplied", "Tests rotated and flipped copies with premultiplied blending", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest9 =
+        { (SDLTest_TestCaseFp)render_testCopyMipmapped, "render_testCopyMipmapped", "Tests minified copies with software mipmaps", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest10 =
+        { (SDLTest_TestCaseFp)render_testKernel, "render_testKernel", "Tests copies with a render kernel", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest11 =
+        { (SDLTest_TestCaseFp)render_testKernelConstants, "render_testKernelConstants", "Tests queueing render kernel constants", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest12 =
+        { (SDLTest_TestCaseFp)render_testSoftwareBands, "render_testSoftwareBands", "Tests that software rendering in bands gives the same pixels", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest13 =
+        { (SDLTest_TestCaseFp)render_testCopyBatch, "render_testCopyBatch", "Tests batches of copies", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest14 =
+        { (SDLTest_TestCaseFp)render_testCopyLinearClipped, "render_testCopyLinearClipped", "Tests that clipping linear copies keeps their sample positions", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest15 =
+        { (SDLTest_TestCaseFp)render_testCopyExBlendModes, "render_testCopyExBlendModes", "Tests that flipped and rotated copies blend like plain copies", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest16 =
+        { (SDLTest_TestCaseFp)render_testMergeCopies, "render_testMergeCopies", "Tests merging consecutive copies with the same state", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest17 =
+        { (SDLTest_TestCaseFp)render_testSoftwareDamage, "render_testSoftwareDamage", "Tests that software rendered windows update only what was drawn", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest18 =
+        { (SDLTest_TestCaseFp)render_testRenderStats, "render_testRenderStats", "Tests the per-frame render stats", TEST_ENABLED };
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] =  {
-    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, NULL
+    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, &renderTest8, &renderTest9, &renderTest10, &renderTest11, &renderTest12, &renderTest13, &renderTest14, &renderTest15, &renderTest16, &renderTest17, &renderTest18, NULL
 };
 
 /* Render test suite (global) */
@@ -589,6 +589,1115 @@ surface_testBlitBlendLoop(void *arg) {
 
 }
 
+/**
+ * @brief Tests modulated and blended blits between the common 32-bit formats and RGB565.
+ *
+ * The surfaces are wide enough for every SIMD stride and its scalar tail, and
+ * each combination is also blitted scaled.
+ */
+int
+surface_testBlitFormatCoverage(void *arg)
+{
+    const Uint32 src_formats[] = {
+        SDL_PIXELFORMAT_RGB888,
+        SDL_PIXELFORMAT_BGR888,
+        SDL_PIXELFORMAT_ARGB8888,
+        SDL_PIXELFORMAT_RGBA8888,
+        SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_BGRA8888,
+    };
+    const Uint32 dst_formats[] = {
+        SDL_PIXELFORMAT_RGB888,
+        SDL_PIXELFORMAT_BGR888,
+        SDL_PIXELFORMAT_ARGB8888,
+        SDL_PIXELFORMAT_RGBA8888,
+        SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_BGRA8888,
+        SDL_PIXELFORMAT_RGB565,
+    };
+    const SDL_BlendMode modes[] = {
+        SDL_BLENDMODE_BLEND,
+        SDL_BLENDMODE_ADD,
+        SDL_BLENDMODE_MOD,
+        SDL_BLENDMODE_MUL,
+    };
+    const Uint8 mr = 200, mg = 150, mb = 100, ma = 180;
+    const int w = 37, h = 5;
+    int i, j, k, scaled, x, y, ret;
+
+    for (i = 0; i < SDL_arraysize(src_formats); ++i) {
+        for (j = 0; j < SDL_arraysize(dst_formats); ++j) {
+            for (k = 0; k < SDL_arraysize(modes) * 2; ++k) {
+                const SDL_BlendMode mode = modes[k / 2];
+                SDL_Surface *src, *dst;
+                Uint32 sR, sG, sB, sA, dR, dG, dB, dA;
+                Uint8 r, g, b, a, er, eg, eb, ea;
+
+                /* Scaled blits stretch a narrower source over the whole destination */
+                scaled = k % 2;
+                src = SDL_CreateRGBSurfaceWithFormat(0, scaled ? 23 : w, scaled ? 3 : h, 32, src_formats[i]);
+                dst = SDL_CreateRGBSurfaceWithFormat(0, w, h, SDL_BITSPERPIXEL(dst_formats[j]), dst_formats[j]);
+
+                SDLTest_AssertCheck(src != NULL && dst != NULL, "Verify surfaces are not NULL");
+                if (src == NULL || dst == NULL) {
+                    SDL_FreeSurface(src);
+                    SDL_FreeSurface(dst);
+                    return TEST_ABORTED;
+                }
+
+                /* The source and destination colors as the blitter sees them */
+                SDL_FillRect(src, NULL, SDL_MapRGBA(src->format, 240, 120, 60, 160));
+                SDL_FillRect(dst, NULL, SDL_MapRGBA(dst->format, 30, 90, 210, 100));
+                SDL_GetRGBA(*(Uint32 *) src->pixels, src->format, &r, &g, &b, &a);
+                sR = r; sG = g; sB = b; sA = a;
+                SDL_GetRGBA(dst->format->BytesPerPixel == 2 ? *(Uint16 *) dst->pixels : *(Uint32 *) dst->pixels, dst->format, &r, &g, &b, &a);
+                dR = r; dG = g; dB = b; dA = a;
+
+                /* The expected result, following the blend mode documentation */
+                sR = (sR * mr) / 255;
+                sG = (sG * mg) / 255;
+                sB = (sB * mb) / 255;
+                sA = (sA * ma) / 255;
+                if (mode == SDL_BLENDMODE_BLEND || mode == SDL_BLENDMODE_ADD) {
+                    sR = (sR * sA) / 255;
+                    sG = (sG * sA) / 255;
+                    sB = (sB * sA) / 255;
+                }
+                switch (mode) {
+                case SDL_BLENDMODE_BLEND:
+                    dR = sR + ((255 - sA) * dR) / 255;
+                    dG = sG + ((255 - sA) * dG) / 255;
+                    dB = sB + ((255 - sA) * dB) / 255;
+                    dA = sA + ((255 - sA) * dA) / 255;
+                    break;
+                case SDL_BLENDMODE_ADD:
+                    dR = SDL_min(sR + dR, 255);
+                    dG = SDL_min(sG + dG, 255);
+                    dB = SDL_min(sB + dB, 255);
+                    break;
+                case SDL_BLENDMODE_MUL:
+                    dR = SDL_min((sR * dR + dR * (255 - sA)) / 255, 255);
+                    dG = SDL_min((sG * dG + dG * (255 - sA)) / 255, 255);
+                    dB = SDL_min((sB * dB + dB * (255 - sA)) / 255, 255);
+                    dA = SDL_min((sA * dA + dA * (255 - sA)) / 255, 255);
+                    break;
+                default:
+                    dR = (sR * dR) / 255;
+                    dG = (sG * dG) / 255;
+                    dB = (sB * dB) / 255;
+                    break;
+                }
+                SDL_GetRGBA(SDL_MapRGBA(dst->format, (Uint8) dR, (Uint8) dG, (Uint8) dB, (Uint8) dA), dst->format, &er, &eg, &eb, &ea);
+
+                SDL_SetSurfaceColorMod(src, mr, mg, mb);
+                SDL_SetSurfaceAlphaMod(src, ma);
+                SDL_SetSurfaceBlendMode(src, mode);
+                if (scaled) {
+                    ret = SDL_BlitScaled(src, NULL, dst, NULL);
+                    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitScaled, expected: 0, got: %i", ret);
+                } else {
+                    ret = SDL_BlitSurface(src, NULL, dst, NULL);
+                    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+                }
+
+                /* Report only the first wrong pixel of each blit */
+                for (y = 0; y < h; ++y) {
+                    const Uint8 *row = (const Uint8 *) dst->pixels + y * dst->pitch;
+                    for (x = 0; x < w; ++x) {
+                        SDL_GetRGBA(dst->format->BytesPerPixel == 2 ? ((const Uint16 *) row)[x] : ((const Uint32 *) row)[x], dst->format, &r, &g, &b, &a);
+                        if (r != er || g != eg || b != eb || a != ea) {
+                            break;
+                        }
+                    }
+                    if (x < w) {
+                        break;
+                    }
+                }
+                SDLTest_AssertCheck(y == h,
+                                    "Verify %s to %s with blend mode %d%s, expected: %u,%u,%u,%u, got: %u,%u,%u,%u at %d,%d",
+                                    SDL_GetPixelFormatName(src_formats[i]), SDL_GetPixelFormatName(dst_formats[j]), mode,
+                                    scaled ? " scaled" : "", er, eg, eb, ea, r, g, b, a, x, y);
+
+                SDL_FreeSurface(src);
+                SDL_FreeSurface(dst);
+            }
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests conversions and blits to and from ARGB2101010.
+ */
+int
+surface_testBlit10Bit(void *arg)
+{
+    const Uint32 formats[] = {
+        SDL_PIXELFORMAT_RGB888,
+        SDL_PIXELFORMAT_ARGB8888,
+        SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_BGRA8888,
+    };
+    const Uint32 colors[] = {
+        0xFF000000, 0xFFFFFFFF, 0x80102030, 0x00A0B0C0, 0x55FF7F01, 0xAA0180FE, 0xFF123456,
+    };
+    const int count = SDL_arraysize(colors);
+    Uint32 src[SDL_arraysize(colors)], ten[SDL_arraysize(colors)], dst[SDL_arraysize(colors)];
+    SDL_PixelFormat *fmt, *fmt10;
+    Uint8 r, g, b, a;
+    int i, j, ret;
+
+    fmt10 = SDL_AllocFormat(SDL_PIXELFORMAT_ARGB2101010);
+    SDLTest_AssertCheck(fmt10 != NULL, "Verify ARGB2101010 format is not NULL");
+    if (fmt10 == NULL) {
+        return TEST_ABORTED;
+    }
+
+    ret = SDL_MapRGBA(fmt10, 0x10, 0x20, 0x30, 0xFF);
+    SDLTest_AssertCheck(ret == 0xC4320CC3, "Verify result from SDL_MapRGBA, expected: 0xC4320CC3, got: 0x%.8X", ret);
+    SDL_GetRGBA(0xC4320CC3, fmt10, &r, &g, &b, &a);
+    SDLTest_AssertCheck(r == 0x10 && g == 0x20 && b == 0x30 && a == 0xFF,
+                        "Verify result from SDL_GetRGBA, expected: 16,32,48,255, got: %u,%u,%u,%u", r, g, b, a);
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        fmt = SDL_AllocFormat(formats[i]);
+        SDL_assert(fmt != NULL);
+        for (j = 0; j < count; ++j) {
+            src[j] = SDL_MapRGBA(fmt, (Uint8) (colors[j] >> 16), (Uint8) (colors[j] >> 8), (Uint8) colors[j], (Uint8) (colors[j] >> 24));
+        }
+
+        ret = SDL_ConvertPixels(count, 1, formats[i], src, sizeof (src), SDL_PIXELFORMAT_ARGB2101010, ten, sizeof (ten));
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels to ARGB2101010, expected: 0, got: %i", ret);
+        ret = SDL_ConvertPixels(count, 1, SDL_PIXELFORMAT_ARGB2101010, ten, sizeof (ten), formats[i], dst, sizeof (dst));
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels from ARGB2101010, expected: 0, got: %i", ret);
+
+        for (j = 0; j < count; ++j) {
+            Uint8 er, eg, eb, ea;
+
+            /* Color survives the round trip, alpha is cut to 2 bits */
+            SDL_GetRGBA(src[j], fmt, &er, &eg, &eb, &ea);
+            SDL_GetRGBA(ten[j], fmt10, &r, &g, &b, &a);
+            SDLTest_AssertCheck(r == er && g == eg && b == eb && a == ((ea * 3) / 255) * 0x55,
+                                "Verify %s pixel %d in ARGB2101010, expected: %u,%u,%u,%u, got: %u,%u,%u,%u",
+                                SDL_GetPixelFormatName(formats[i]), j, er, eg, eb, ((ea * 3) / 255) * 0x55, r, g, b, a);
+            SDL_GetRGBA(dst[j], fmt, &r, &g, &b, &a);
+            SDLTest_AssertCheck(r == er && g == eg && b == eb,
+                                "Verify %s pixel %d after round trip, expected: %u,%u,%u, got: %u,%u,%u",
+                                SDL_GetPixelFormatName(formats[i]), j, er, eg, eb, r, g, b);
+        }
+        SDL_FreeFormat(fmt);
+    }
+    SDL_FreeFormat(fmt10);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests SDL_PremultiplyAlpha() and blits with SDL_BLENDMODE_BLEND_PREMULTIPLIED.
+ */
+int
+surface_testBlitPremultiplied(void *arg)
+{
+    const Uint32 formats[] = {
+        SDL_PIXELFORMAT_ARGB8888,
+        SDL_PIXELFORMAT_RGB888,
+        SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_RGB565,
+    };
+    const int w = 67;
+    Uint32 straight[67], premultiplied[67];
+    SDL_Surface *src, *dst;
+    SDL_PixelFormat *fmt;
+    SDL_BlendMode blendMode;
+    Uint8 r, g, b, dr, dg, db, da;
+    int i, j, ret;
+
+    /* Opaque, transparent and everything in between, longer than any SIMD stride */
+    for (i = 0; i < w; ++i) {
+        Uint32 alpha = (i % 5 == 0) ? 0xFF : (i % 7 == 0) ? 0x00 : (Uint32) (i * 37) & 0xFF;
+        straight[i] = (alpha << 24) | ((Uint32) (i * 53 + 11) & 0xFF) << 16 | ((Uint32) (i * 97) & 0xFF) << 8 | 0xC0;
+    }
+    ret = SDL_PremultiplyAlpha(w, 1, SDL_PIXELFORMAT_ARGB8888, straight, sizeof (straight), SDL_PIXELFORMAT_ARGB8888, premultiplied, sizeof (premultiplied));
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_PremultiplyAlpha, expected: 0, got: %i", ret);
+    for (i = 0; i < w; ++i) {
+        const Uint32 alpha = straight[i] >> 24;
+        Uint32 expected = straight[i] & 0xFF000000;
+        for (j = 0; j < 24; j += 8) {
+            expected |= ((((straight[i] >> j) & 0xFF) * alpha) / 255) << j;
+        }
+        SDLTest_AssertCheck(premultiplied[i] == expected, "Verify premultiplied pixel %d, expected: 0x%.8X, got: 0x%.8X", i, expected, premultiplied[i]);
+    }
+    ret = SDL_PremultiplyAlpha(w, 1, SDL_PIXELFORMAT_ARGB8888, straight, sizeof (straight), SDL_PIXELFORMAT_RGB888, premultiplied, sizeof (premultiplied));
+    SDLTest_AssertCheck(ret == -1, "Verify SDL_PremultiplyAlpha rejects a format without alpha, expected: -1, got: %i", ret);
+
+    src = SDL_CreateRGBSurfaceWithFormatFrom(premultiplied, w, 1, 32, sizeof (premultiplied), SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(src != NULL, "Verify source surface is not NULL");
+    if (src == NULL) {
+        return TEST_ABORTED;
+    }
+    ret = SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_SetSurfaceBlendMode, expected: 0, got: %i", ret);
+    ret = SDL_GetSurfaceBlendMode(src, &blendMode);
+    SDLTest_AssertCheck(ret == 0 && blendMode == SDL_BLENDMODE_BLEND_PREMULTIPLIED,
+                        "Verify result from SDL_GetSurfaceBlendMode, expected: %i, got: %i", SDL_BLENDMODE_BLEND_PREMULTIPLIED, blendMode);
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        dst = SDL_CreateRGBSurfaceWithFormat(0, w, 1, 0, formats[i]);
+        SDL_assert(dst != NULL);
+        fmt = dst->format;
+        SDL_FillRect(dst, NULL, SDL_MapRGBA(fmt, 0x40, 0xFF, 0x99, 0xFF));
+        SDL_GetRGBA(SDL_MapRGBA(fmt, 0x40, 0xFF, 0x99, 0xFF), fmt, &dr, &dg, &db, &da);
+        ret = SDL_BlitSurface(src, NULL, dst, NULL);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+
+        for (j = 0; j < w; ++j) {
+            Uint32 inva = 0xFF - (premultiplied[j] >> 24), expected, actual;
+
+            r = (Uint8) SDL_min(((premultiplied[j] >> 16) & 0xFF) + (dr * inva) / 255, 255);
+            g = (Uint8) SDL_min(((premultiplied[j] >> 8) & 0xFF) + (dg * inva) / 255, 255);
+            b = (Uint8) SDL_min((premultiplied[j] & 0xFF) + (db * inva) / 255, 255);
+            expected = SDL_MapRGB(fmt, r, g, b) & ~fmt->Amask;
+            actual = (fmt->BytesPerPixel == 4 ? ((Uint32 *) dst->pixels)[j] : ((Uint16 *) dst->pixels)[j]) & (fmt->Rmask | fmt->Gmask | fmt->Bmask);
+            SDLTest_AssertCheck(actual == expected, "Verify %s pixel %d, expected: 0x%.8X, got: 0x%.8X",
+                                SDL_GetPixelFormatName(formats[i]), j, expected, actual);
+        }
+        SDL_FreeSurface(dst);
+    }
+    SDL_FreeSurface(src);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Helper that converts one row of w pixels with SDL_ConvertSurfaceFormat(), as a reference for SDL_ConvertPixels().
+ */
+static int
+_convertRowReference(int w, Uint32 src_format, void *src, Uint32 dst_format, void *dst)
+{
+    SDL_Surface *surface, *converted;
+
+    surface = SDL_CreateRGBSurfaceWithFormatFrom(src, w, 1, 0, w * SDL_BYTESPERPIXEL(src_format), src_format);
+    if (surface == NULL) {
+        return -1;
+    }
+    converted = SDL_ConvertSurfaceFormat(surface, dst_format, 0);
+    SDL_FreeSurface(surface);
+    if (converted == NULL) {
+        return -1;
+    }
+    SDL_memcpy(dst, converted->pixels, w * SDL_BYTESPERPIXEL(dst_format));
+    SDL_FreeSurface(converted);
+    return 0;
+}
+
+/**
+ * Helper that returns the index of the first pixel of a and b that differs in format, or -1.
+ * The padding byte of 32-bit formats without alpha can be anything.
+ */
+static int
+_comparePixelRows(int w, Uint32 format, const Uint8 *a, const Uint8 *b, Uint32 *expected, Uint32 *actual)
+{
+    const int bpp = SDL_BYTESPERPIXEL(format);
+    Uint32 mask = 0xFFFFFFFF;
+    int Rbpp, i;
+    Uint32 Rmask, Gmask, Bmask, Amask;
+
+    if (bpp == 4 && SDL_PixelFormatEnumToMasks(format, &Rbpp, &Rmask, &Gmask, &Bmask, &Amask)) {
+        mask = Rmask | Gmask | Bmask | Amask;
+    }
+    for (i = 0; i < w; ++i) {
+        *expected = *actual = 0;
+        SDL_memcpy(expected, a + i * bpp, bpp);
+        SDL_memcpy(actual, b + i * bpp, bpp);
+        if ((*expected & mask) != (*actual & mask)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Tests converting pixels between the RGB formats, also in place.
+ *
+ * Both directions between ARGB8888 and each format are compared with the
+ * SDL_ConvertSurfaceFormat() result.
+ */
+int
+surface_testConvertPixels(void *arg)
+{
+    const Uint32 formats[] = {
+        SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_RGBA8888,
+        SDL_PIXELFORMAT_BGRX8888,
+        SDL_PIXELFORMAT_RGB24,
+        SDL_PIXELFORMAT_BGR24,
+        SDL_PIXELFORMAT_RGB565,
+        SDL_PIXELFORMAT_BGR565,
+    };
+    const int w = 67;
+    Uint32 pixels[67], inplace[67], back[67], back_reference[67];
+    Uint8 converted[67 * 4], reference[67 * 4];
+    Uint32 expected, actual;
+    int i, j, ret;
+
+    /* Longer than any SIMD stride */
+    for (i = 0; i < w; ++i) {
+        pixels[i] = (Uint32) (i * 37) << 24 | ((Uint32) (i * 53 + 11) & 0xFF) << 16 | ((Uint32) (i * 97) & 0xFF) << 8 | 0xC0;
+    }
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        const char *name = SDL_GetPixelFormatName(formats[i]);
+        const int bpp = SDL_BYTESPERPIXEL(formats[i]);
+
+        ret = SDL_ConvertPixels(w, 1, SDL_PIXELFORMAT_ARGB8888, pixels, sizeof (pixels), formats[i], converted, sizeof (converted));
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels to %s, expected: 0, got: %i", name, ret);
+        ret = _convertRowReference(w, SDL_PIXELFORMAT_ARGB8888, pixels, formats[i], reference);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertSurfaceFormat to %s, expected: 0, got: %i", name, ret);
+        j = _comparePixelRows(w, formats[i], reference, converted, &expected, &actual);
+        SDLTest_AssertCheck(j < 0, "Verify pixels converted to %s, expected: 0x%.8X, got: 0x%.8X at %d", name, expected, actual, j);
+
+        SDL_memcpy(inplace, pixels, sizeof (pixels));
+        ret = SDL_ConvertPixels(w, 1, SDL_PIXELFORMAT_ARGB8888, inplace, sizeof (inplace), formats[i], inplace, sizeof (inplace));
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels in place, expected: 0, got: %i", ret);
+        SDLTest_AssertCheck(SDL_memcmp(converted, inplace, w * bpp) == 0, "Verify %s pixels converted in place match", name);
+
+        ret = SDL_ConvertPixels(w, 1, formats[i], converted, sizeof (converted), SDL_PIXELFORMAT_ARGB8888, back, sizeof (back));
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels from %s, expected: 0, got: %i", name, ret);
+        ret = _convertRowReference(w, formats[i], converted, SDL_PIXELFORMAT_ARGB8888, back_reference);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertSurfaceFormat from %s, expected: 0, got: %i", name, ret);
+        j = _comparePixelRows(w, SDL_PIXELFORMAT_ARGB8888, (const Uint8 *) back_reference, (const Uint8 *) back, &expected, &actual);
+        SDLTest_AssertCheck(j < 0, "Verify pixels converted from %s, expected: 0x%.8X, got: 0x%.8X at %d", name, expected, actual, j);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Helper that sets SDL_BLIT_CPU_FEATURES, NULL for the ones the CPU has, and returns the old value.
+ */
+static char *
+_setBlitFeatures(const char *features)
+{
+    char *saved = SDL_GetHint("SDL_BLIT_CPU_FEATURES") ? SDL_strdup(SDL_GetHint("SDL_BLIT_CPU_FEATURES")) : NULL;
+
+    if (features) {
+        SDL_SetHintWithPriority("SDL_BLIT_CPU_FEATURES", features, SDL_HINT_OVERRIDE);
+    }
+    return saved;
+}
+
+/**
+ * Helper that undoes _setBlitFeatures(features) and frees saved.
+ */
+static void
+_restoreBlitFeatures(const char *features, char *saved)
+{
+    if (features) {
+        SDL_SetHintWithPriority("SDL_BLIT_CPU_FEATURES", saved ? saved : "", SDL_HINT_OVERRIDE);
+    }
+    SDL_free(saved);
+}
+
+/**
+ * Helper that blits with the given SDL_BLIT_CPU_FEATURES, NULL for the ones the CPU has.
+ * The blitter is only chosen for new mappings, so src must not have been blitted to dst before.
+ */
+static int
+_blitWithFeatures(const char *features, SDL_Surface *src, SDL_Surface *dst, SDL_bool scaled)
+{
+    char *saved = _setBlitFeatures(features);
+    int ret;
+
+    if (scaled) {
+        ret = SDL_BlitScaled(src, NULL, dst, NULL);
+    } else {
+        ret = SDL_BlitSurface(src, NULL, dst, NULL);
+    }
+    _restoreBlitFeatures(features, saved);
+    return ret;
+}
+
+/**
+ * Helper that finds the first pixel where two 32-bit surfaces of the same size differ in mask.
+ * Returns SDL_TRUE and fills in the position and both pixels if there is one.
+ */
+static SDL_bool
+_findPixelMismatch(SDL_Surface *expected, SDL_Surface *actual, Uint32 mask, int *x, int *y, Uint32 *expected_pixel, Uint32 *actual_pixel)
+{
+    int i, j;
+
+    for (j = 0; j < expected->h; ++j) {
+        const Uint32 *e = (const Uint32 *) ((const Uint8 *) expected->pixels + j * expected->pitch);
+        const Uint32 *a = (const Uint32 *) ((const Uint8 *) actual->pixels + j * actual->pitch);
+        for (i = 0; i < expected->w; ++i) {
+            if ((e[i] & mask) != (a[i] & mask)) {
+                *x = i;
+                *y = j;
+                *expected_pixel = e[i] & mask;
+                *actual_pixel = a[i] & mask;
+                return SDL_TRUE;
+            }
+        }
+    }
+    *x = *y = 0;
+    *expected_pixel = *actual_pixel = 0;
+    return SDL_FALSE;
+}
+
+/**
+ * @brief Compares the SIMD blitters with the scalar ones on random pixels.
+ *
+ * Every blend mode is blitted with and without modulation and scaling. The
+ * widths are random, so the SIMD blitters run their main loops and their tails.
+ */
+int
+surface_testBlitSIMDMatchesScalar(void *arg)
+{
+    const Uint32 src_formats[] = {
+        SDL_PIXELFORMAT_ARGB8888,
+        SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_RGBA8888,
+        SDL_PIXELFORMAT_BGRA8888,
+        SDL_PIXELFORMAT_RGB888,
+    };
+    const Uint32 dst_formats[] = {
+        SDL_PIXELFORMAT_ARGB8888,
+        SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_RGB888,
+        SDL_PIXELFORMAT_BGR888,
+    };
+    const SDL_BlendMode modes[] = {
+        SDL_BLENDMODE_NONE,
+        SDL_BLENDMODE_BLEND,
+        SDL_BLENDMODE_BLEND_PREMULTIPLIED,
+        SDL_BLENDMODE_ADD,
+        SDL_BLENDMODE_MOD,
+        SDL_BLENDMODE_MUL,
+    };
+    int i, j, k, variant, x, y, ret;
+
+    for (i = 0; i < SDL_arraysize(src_formats); ++i) {
+        for (j = 0; j < SDL_arraysize(dst_formats); ++j) {
+            for (k = 0; k < SDL_arraysize(modes); ++k) {
+                /* Bit 0 of the variant modulates, bit 1 scales */
+                for (variant = 0; variant < 4; ++variant) {
+                    const SDL_bool modulate = (variant & 1) ? SDL_TRUE : SDL_FALSE;
+                    const SDL_bool scaled = (variant & 2) ? SDL_TRUE : SDL_FALSE;
+                    const int w = SDLTest_RandomIntegerInRange(17, 100);
+                    const int h = SDLTest_RandomIntegerInRange(1, 4);
+                    const int src_w = scaled ? SDLTest_RandomIntegerInRange(5, 150) : w;
+                    const int src_h = scaled ? SDLTest_RandomIntegerInRange(1, 6) : h;
+                    SDL_Surface *src = SDL_CreateRGBSurfaceWithFormat(0, src_w, src_h, 32, src_formats[i]);
+                    SDL_Surface *src_scalar = SDL_CreateRGBSurfaceWithFormat(0, src_w, src_h, 32, src_formats[i]);
+                    SDL_Surface *simd = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, dst_formats[j]);
+                    SDL_Surface *scalar = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, dst_formats[j]);
+                    Uint32 mask, expected, actual;
+                    SDL_bool mismatch;
+
+                    SDLTest_AssertCheck(src != NULL && src_scalar != NULL && simd != NULL && scalar != NULL, "Verify surfaces are not NULL");
+                    if (src == NULL || src_scalar == NULL || simd == NULL || scalar == NULL) {
+                        SDL_FreeSurface(src);
+                        SDL_FreeSurface(src_scalar);
+                        SDL_FreeSurface(simd);
+                        SDL_FreeSurface(scalar);
+                        return TEST_ABORTED;
+                    }
+                    for (y = 0; y < src_h; ++y) {
+                        for (x = 0; x < src_w; ++x) {
+                            ((Uint32 *) ((Uint8 *) src->pixels + y * src->pitch))[x] = SDLTest_RandomUint32();
+                        }
+                    }
+                    for (y = 0; y < h; ++y) {
+                        for (x = 0; x < w; ++x) {
+                            ((Uint32 *) ((Uint8 *) simd->pixels + y * simd->pitch))[x] = SDLTest_RandomUint32();
+                        }
+                    }
+                    SDL_memcpy(src_scalar->pixels, src->pixels, src_h * src->pitch);
+                    SDL_memcpy(scalar->pixels, simd->pixels, h * simd->pitch);
+
+                    /* Each source keeps its own blitter, so they need the same state */
+                    if (modulate) {
+                        const Uint8 r = SDLTest_RandomUint8(), g = SDLTest_RandomUint8(), b = SDLTest_RandomUint8(), a = SDLTest_RandomUint8();
+                        SDL_SetSurfaceColorMod(src, r, g, b);
+                        SDL_SetSurfaceColorMod(src_scalar, r, g, b);
+                        SDL_SetSurfaceAlphaMod(src, a);
+                        SDL_SetSurfaceAlphaMod(src_scalar, a);
+                    }
+                    SDL_SetSurfaceBlendMode(src, modes[k]);
+                    SDL_SetSurfaceBlendMode(src_scalar, modes[k]);
+                    ret = _blitWithFeatures("0", src_scalar, scalar, scaled);
+                    SDLTest_AssertCheck(ret == 0, "Verify result from the scalar blit, expected: 0, got: %i", ret);
+                    ret = _blitWithFeatures(NULL, src, simd, scaled);
+                    SDLTest_AssertCheck(ret == 0, "Verify result from the SIMD blit, expected: 0, got: %i", ret);
+
+                    /* The unused byte of the destination can be anything */
+                    mask = simd->format->Rmask | simd->format->Gmask | simd->format->Bmask | simd->format->Amask;
+                    mismatch = _findPixelMismatch(scalar, simd, mask, &x, &y, &expected, &actual);
+                    SDLTest_AssertCheck(!mismatch,
+                                        "Verify %s to %s %dx%d with blend mode %d%s%s, expected: 0x%.8X, got: 0x%.8X at %d,%d",
+                                        SDL_GetPixelFormatName(src_formats[i]), SDL_GetPixelFormatName(dst_formats[j]), w, h, modes[k],
+                                        modulate ? " modulated" : "", scaled ? " scaled" : "", expected, actual, x, y);
+
+                    SDL_FreeSurface(src);
+                    SDL_FreeSurface(src_scalar);
+                    SDL_FreeSurface(simd);
+                    SDL_FreeSurface(scalar);
+                }
+            }
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests 8-bit indexed to 16, 24 and 32 bpp blits, with and without a colorkey.
+ *
+ * The rows are wider than the 8 and 16 pixel steps of the SIMD expansion, and
+ * every pixel is checked against the palette color mapped to the destination.
+ */
+int
+surface_testBlitIndexed(void *arg)
+{
+    const Uint32 dst_formats[] = {
+        SDL_PIXELFORMAT_RGB565,
+        SDL_PIXELFORMAT_RGB24,
+        SDL_PIXELFORMAT_ARGB8888,
+        SDL_PIXELFORMAT_RGB888,
+    };
+    SDL_Color colors[256];
+    SDL_Surface *src, *dst;
+    Uint32 background, expected = 0, actual = 0;
+    int i, x, y, keyed, ret;
+
+    for (i = 0; i < SDL_arraysize(colors); ++i) {
+        colors[i].r = SDLTest_RandomUint8();
+        colors[i].g = SDLTest_RandomUint8();
+        colors[i].b = SDLTest_RandomUint8();
+        colors[i].a = SDL_ALPHA_OPAQUE;
+    }
+
+    for (i = 0; i < SDL_arraysize(dst_formats); ++i) {
+        for (keyed = 0; keyed < 2; ++keyed) {
+            const int w = SDLTest_RandomIntegerInRange(33, 100);
+            const int h = 3;
+            const Uint8 key = SDLTest_RandomUint8();
+
+            src = SDL_CreateRGBSurfaceWithFormat(0, w, h, 8, SDL_PIXELFORMAT_INDEX8);
+            dst = SDL_CreateRGBSurfaceWithFormat(0, w, h, 0, dst_formats[i]);
+            SDLTest_AssertCheck(src != NULL && dst != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+            if (src == NULL || dst == NULL) {
+                SDL_FreeSurface(src);
+                SDL_FreeSurface(dst);
+                return TEST_ABORTED;
+            }
+            SDL_SetPaletteColors(src->format->palette, colors, 0, SDL_arraysize(colors));
+
+            /* Every third pixel is the colorkey, so keyed runs split the SIMD steps */
+            for (y = 0; y < h; ++y) {
+                Uint8 *row = (Uint8 *) src->pixels + y * src->pitch;
+                for (x = 0; x < w; ++x) {
+                    row[x] = (x % 3 == 0) ? key : SDLTest_RandomUint8();
+                }
+            }
+            if (keyed) {
+                SDL_SetColorKey(src, SDL_TRUE, key);
+            }
+            background = SDL_MapRGB(dst->format, 1, 2, 3);
+            SDL_FillRect(dst, NULL, background);
+
+            ret = SDL_BlitSurface(src, NULL, dst, NULL);
+            SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+
+            for (y = 0; y < h; ++y) {
+                const Uint8 *srcrow = (const Uint8 *) src->pixels + y * src->pitch;
+                const Uint8 *dstrow = (const Uint8 *) dst->pixels + y * dst->pitch;
+                for (x = 0; x < w; ++x) {
+                    const SDL_Color *c = &colors[srcrow[x]];
+                    const Uint8 *p = dstrow + x * dst->format->BytesPerPixel;
+
+                    expected = (keyed && srcrow[x] == key) ? background : SDL_MapRGB(dst->format, c->r, c->g, c->b);
+                    switch (dst->format->BytesPerPixel) {
+                    case 2:
+                        actual = *(const Uint16 *) p;
+                        break;
+                    case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+                        actual = p[0] | (p[1] << 8) | (p[2] << 16);
+#else
+                        actual = (p[0] << 16) | (p[1] << 8) | p[2];
+#endif
+                        break;
+                    default:
+                        actual = *(const Uint32 *) p;
+                        break;
+                    }
+                    if (actual != expected) {
+                        break;
+                    }
+                }
+                if (x < w) {
+                    break;
+                }
+            }
+            SDLTest_AssertCheck(y == h, "Verify INDEX8 to %s %dx%d%s, expected: 0x%.8X, got: 0x%.8X at %d,%d",
+                                SDL_GetPixelFormatName(dst_formats[i]), w, h, keyed ? " with colorkey" : "",
+                                expected, actual, x, y);
+
+            SDL_FreeSurface(src);
+            SDL_FreeSurface(dst);
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests SDL_FillRects with adjacent, overlapping and clipped rects.
+ *
+ * The merging of rects that share their columns or rows must fill exactly
+ * the union of the rects inside the clip rect.
+ */
+int
+surface_testFillRects(void *arg)
+{
+    const Uint32 formats[] = { SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ARGB8888 };
+    const SDL_Rect fixed[] = {
+        { 4, 1, 10, 4 }, { 4, 5, 10, 3 },     /* adjacent, same columns */
+        { 20, 6, 6, 5 }, { 26, 6, 9, 5 },     /* adjacent, same rows */
+        { 56, 2, 4, 3 }, { 56, 7, 4, 3 },     /* same columns with a gap */
+        { 20, 14, 5, 2 }, { 27, 14, 5, 2 },   /* same rows with a gap */
+        { 40, 2, 8, 8 }, { 40, 6, 8, 8 },     /* overlapping, same columns */
+        { 44, 12, 10, 4 }, { 50, 12, 20, 4 }, /* overlapping, same rows, clipped on the right */
+        { 10, 10, 12, 6 }, { 14, 8, 4, 12 },  /* overlapping crosswise */
+        { 0, 0, 3, 30 }, { 2, 17, 40, 6 },    /* clipped on the left and at the bottom */
+        { 70, 0, 5, 5 }, { 30, 3, 0, 5 },     /* outside the clip rect, and empty */
+        { 4, 1, 10, 4 },                      /* a duplicate */
+    };
+    const SDL_Rect clip = { 2, 1, 62, 17 };
+    const int w = 67, h = 20;
+    SDL_Rect rects[24];
+    SDL_Surface *dst;
+    Uint32 background, color;
+    int i, j, k, n, x, y, ret;
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        for (k = 0; k < 2; ++k) {
+            dst = SDL_CreateRGBSurfaceWithFormat(0, w, h, 0, formats[i]);
+            SDLTest_AssertCheck(dst != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+            if (dst == NULL) {
+                return TEST_ABORTED;
+            }
+            background = SDL_MapRGB(dst->format, 0x10, 0x20, 0x30);
+            color = SDL_MapRGB(dst->format, SDLTest_RandomUint8(), SDLTest_RandomUint8(), SDLTest_RandomUint8());
+            if (color == background) {
+                color ^= dst->format->Rmask;
+            }
+            SDL_FillRect(dst, NULL, background);
+            SDL_SetClipRect(dst, &clip);
+
+            /* The fixed cases, then random ones on a grid so many share their columns or rows */
+            if (k == 0) {
+                n = SDL_arraysize(fixed);
+                SDL_memcpy(rects, fixed, sizeof (fixed));
+            } else {
+                n = SDL_arraysize(rects);
+                for (j = 0; j < n; ++j) {
+                    rects[j].x = SDLTest_RandomIntegerInRange(-1, 16) * 4;
+                    rects[j].y = SDLTest_RandomIntegerInRange(-1, 5) * 4;
+                    rects[j].w = SDLTest_RandomIntegerInRange(1, 3) * 4;
+                    rects[j].h = SDLTest_RandomIntegerInRange(1, 3) * 4;
+                }
+            }
+            ret = SDL_FillRects(dst, rects, n, color);
+            SDLTest_AssertCheck(ret == 0, "Verify result from SDL_FillRects, expected: 0, got: %i", ret);
+
+            for (y = 0; y < h; ++y) {
+                for (x = 0; x < w; ++x) {
+                    const SDL_Point p = { x, y };
+                    const Uint8 *pixel = (const Uint8 *) dst->pixels + y * dst->pitch + x * dst->format->BytesPerPixel;
+                    Uint32 expected = background, actual = 0;
+
+                    if (SDL_PointInRect(&p, &clip)) {
+                        for (j = 0; j < n; ++j) {
+                            if (SDL_PointInRect(&p, &rects[j])) {
+                                expected = color;
+                                break;
+                            }
+                        }
+                    }
+                    SDL_memcpy(&actual, pixel, dst->format->BytesPerPixel);
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+                    actual >>= 8 * (4 - dst->format->BytesPerPixel);
+#endif
+                    if (actual != expected) {
+                        SDLTest_AssertCheck(actual == expected, "Verify %s pixel at %d,%d with %d rects, expected: 0x%.8X, got: 0x%.8X",
+                                            SDL_GetPixelFormatName(formats[i]), x, y, n, expected, actual);
+                        y = h;
+                        break;
+                    }
+                }
+            }
+            SDLTest_AssertPass("Checked %s fill of %d rects", SDL_GetPixelFormatName(formats[i]), n);
+
+            SDL_FreeSurface(dst);
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Helper that returns channel shift of the exactly filtered pixel (x, y) of a bilinear
+ * stretch of the whole of src to w x h, sampling at the pixel centers.
+ */
+static double
+_linearReference(SDL_Surface *src, int w, int h, int x, int y, int shift)
+{
+    double fx = (x + 0.5) * src->w / w - 0.5;
+    double fy = (y + 0.5) * src->h / h - 0.5;
+    double value = 0.0;
+    int x0, y0, i, j;
+
+    fx = SDL_max(0.0, SDL_min(fx, src->w - 1.0));
+    fy = SDL_max(0.0, SDL_min(fy, src->h - 1.0));
+    x0 = (int) fx;
+    y0 = (int) fy;
+    for (j = 0; j < 2; ++j) {
+        for (i = 0; i < 2; ++i) {
+            const int sx = SDL_min(x0 + i, src->w - 1), sy = SDL_min(y0 + j, src->h - 1);
+            const Uint32 pixel = ((const Uint32 *) ((const Uint8 *) src->pixels + sy * src->pitch))[sx];
+            const double weight = (i ? fx - x0 : 1.0 - (fx - x0)) * (j ? fy - y0 : 1.0 - (fy - y0));
+            value += weight * ((pixel >> shift) & 0xFF);
+        }
+    }
+    return value;
+}
+
+/**
+ * @brief Compares the SIMD linear stretching with the scalar one, and both with exact filtering.
+ *
+ * The sizes are random and often odd, so the SIMD code runs its main loops and its tails,
+ * and the row blending runs whenever the rows aren't sampled at a pixel center.
+ */
+int
+surface_testStretchLinearSIMDMatchesScalar(void *arg)
+{
+    /* SSE2, AVX2 and NEON, each alone as far as the stretcher is concerned */
+    const char *features[] = { "8", "136", "256" };
+    int i, j, x, y, shift, ret;
+
+    for (i = 0; i < 60; ++i) {
+        const int src_w = SDLTest_RandomIntegerInRange(1, 70), src_h = SDLTest_RandomIntegerInRange(1, 12);
+        const int w = SDLTest_RandomIntegerInRange(1, 140), h = SDLTest_RandomIntegerInRange(1, 24);
+        SDL_Surface *src = SDL_CreateRGBSurfaceWithFormat(0, src_w, src_h, 32, SDL_PIXELFORMAT_ARGB8888);
+        SDL_Surface *simd = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+        SDL_Surface *scalar = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+        Uint32 expected, actual;
+        double error = 0.0;
+        SDL_bool mismatch;
+        char *saved;
+
+        SDLTest_AssertCheck(src != NULL && simd != NULL && scalar != NULL, "Verify surfaces are not NULL");
+        if (src == NULL || simd == NULL || scalar == NULL) {
+            SDL_FreeSurface(src);
+            SDL_FreeSurface(simd);
+            SDL_FreeSurface(scalar);
+            return TEST_ABORTED;
+        }
+        for (y = 0; y < src_h; ++y) {
+            for (x = 0; x < src_w; ++x) {
+                ((Uint32 *) ((Uint8 *) src->pixels + y * src->pitch))[x] = SDLTest_RandomUint32();
+            }
+        }
+
+        saved = _setBlitFeatures("0");
+        ret = SDL_SoftStretchLinear(src, NULL, scalar, NULL);
+        _restoreBlitFeatures("0", saved);
+        SDLTest_AssertCheck(ret == 0, "Verify result from the scalar SDL_SoftStretchLinear, expected: 0, got: %i", ret);
+
+        /* CPUs without a feature get the scalar code again */
+        for (j = 0; j < SDL_arraysize(features); ++j) {
+            saved = _setBlitFeatures(features[j]);
+            ret = SDL_SoftStretchLinear(src, NULL, simd, NULL);
+            _restoreBlitFeatures(features[j], saved);
+            SDLTest_AssertCheck(ret == 0, "Verify result from SDL_SoftStretchLinear with features %s, expected: 0, got: %i", features[j], ret);
+
+            mismatch = _findPixelMismatch(scalar, simd, 0xFFFFFFFF, &x, &y, &expected, &actual);
+            SDLTest_AssertCheck(!mismatch, "Verify %dx%d stretched to %dx%d with features %s, expected: 0x%.8X, got: 0x%.8X at %d,%d",
+                                src_w, src_h, w, h, features[j], expected, actual, x, y);
+        }
+
+        /* Weights have 8 bits, and each of the two passes rounds */
+        for (y = 0; y < h; ++y) {
+            for (x = 0; x < w; ++x) {
+                const Uint32 pixel = ((const Uint32 *) ((const Uint8 *) scalar->pixels + y * scalar->pitch))[x];
+                for (shift = 0; shift < 32; shift += 8) {
+                    const double diff = SDL_fabs(((pixel >> shift) & 0xFF) - _linearReference(src, w, h, x, y, shift));
+                    error = SDL_max(error, diff);
+                }
+            }
+        }
+        SDLTest_AssertCheck(error <= 2.0, "Verify %dx%d stretched to %dx%d against exact filtering, expected: error <= 2, got: %f",
+                            src_w, src_h, w, h, error);
+
+        SDL_FreeSurface(src);
+        SDL_FreeSurface(simd);
+        SDL_FreeSurface(scalar);
+    }
+
+    return TEST_COMPLETED;
+}
+
+static int _blitCalculations;
+static SDL_LogOutputFunction _savedLogOutput;
+static void *_savedLogUserdata;
+
+/**
+ * Counts the blitters SDL_CalculateBlit() picks, which it logs at debug priority.
+ * Blits that reuse a cached mapping don't log anything. Other messages, like the
+ * results of the asserts, go where they went before.
+ */
+static void SDLCALL
+_countBlitCalculations(void *userdata, int category, SDL_LogPriority priority, const char *message)
+{
+    if (category == SDL_LOG_CATEGORY_VIDEO && priority == SDL_LOG_PRIORITY_DEBUG &&
+        SDL_strncmp(message, "Blit ", 5) == 0 && SDL_strstr(message, " uses ") != NULL) {
+        ++_blitCalculations;
+    } else if (_savedLogOutput) {
+        _savedLogOutput(_savedLogUserdata, category, priority, message);
+    }
+}
+
+/**
+ * Blits src to dst and checks how many blitters that calculated, and that the
+ * pixels are those of a blit from a new surface with the same pixels and state.
+ */
+static void
+_checkCachedBlit(SDL_Surface *src, SDL_Surface *dst, int calculations, const char *what)
+{
+    SDL_Surface *fresh = SDL_CreateRGBSurfaceWithFormatFrom(src->pixels, src->w, src->h, 0, src->pitch, src->format->format);
+    SDL_Surface *expected = SDL_CreateRGBSurfaceWithFormat(0, dst->w, dst->h, 0, dst->format->format);
+    const int before = _blitCalculations;
+    Uint32 expected_pixel, actual_pixel;
+    SDL_BlendMode mode;
+    Uint8 r, g, b, a;
+    SDL_bool mismatch;
+    int x, y, ret;
+
+    SDLTest_AssertCheck(fresh != NULL && expected != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+    if (fresh == NULL || expected == NULL) {
+        SDL_FreeSurface(fresh);
+        SDL_FreeSurface(expected);
+        return;
+    }
+    if (src->format->palette) {
+        SDL_SetSurfacePalette(fresh, src->format->palette);
+    }
+    SDL_GetSurfaceBlendMode(src, &mode);
+    SDL_GetSurfaceColorMod(src, &r, &g, &b);
+    SDL_GetSurfaceAlphaMod(src, &a);
+    SDL_SetSurfaceBlendMode(fresh, mode);
+    SDL_SetSurfaceColorMod(fresh, r, g, b);
+    SDL_SetSurfaceAlphaMod(fresh, a);
+
+    SDL_FillRect(dst, NULL, 0x80402010);
+    ret = SDL_BlitSurface(src, NULL, dst, NULL);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(_blitCalculations - before == calculations,
+                        "Verify blitters calculated for %s, expected: %i, got: %i", what, calculations, _blitCalculations - before);
+
+    SDL_FillRect(expected, NULL, 0x80402010);
+    SDL_BlitSurface(fresh, NULL, expected, NULL);
+    mismatch = _findPixelMismatch(expected, dst, 0xFFFFFFFF, &x, &y, &expected_pixel, &actual_pixel);
+    SDLTest_AssertCheck(!mismatch, "Verify pixels of %s, expected: 0x%.8X, got: 0x%.8X at %d,%d",
+                        what, expected_pixel, actual_pixel, x, y);
+
+    SDL_FreeSurface(fresh);
+    SDL_FreeSurface(expected);
+}
+
+/**
+ * @brief Tests that surfaces reuse the blit mappings they cached, and only while they are still right.
+ */
+int
+surface_testBlitMapCache(void *arg)
+{
+    const SDL_LogPriority saved_priority = SDL_LogGetPriority(SDL_LOG_CATEGORY_VIDEO);
+    SDL_Color colors[256];
+    SDL_Surface *src, *indexed, *first, *second;
+    int i;
+
+    src = SDL_CreateRGBSurfaceWithFormat(0, 13, 5, 32, SDL_PIXELFORMAT_ARGB8888);
+    indexed = SDL_CreateRGBSurfaceWithFormat(0, 13, 5, 8, SDL_PIXELFORMAT_INDEX8);
+    first = SDL_CreateRGBSurfaceWithFormat(0, 13, 5, 32, SDL_PIXELFORMAT_ARGB8888);
+    second = SDL_CreateRGBSurfaceWithFormat(0, 13, 5, 32, SDL_PIXELFORMAT_ABGR8888);
+    SDLTest_AssertCheck(src != NULL && indexed != NULL && first != NULL && second != NULL,
+                        "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+    if (src == NULL || indexed == NULL || first == NULL || second == NULL) {
+        SDL_FreeSurface(src);
+        SDL_FreeSurface(indexed);
+        SDL_FreeSurface(first);
+        SDL_FreeSurface(second);
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < src->h * src->pitch; ++i) {
+        ((Uint8 *) src->pixels)[i] = SDLTest_RandomUint8();
+    }
+    for (i = 0; i < indexed->h * indexed->pitch; ++i) {
+        ((Uint8 *) indexed->pixels)[i] = SDLTest_RandomUint8();
+    }
+    for (i = 0; i < SDL_arraysize(colors); ++i) {
+        colors[i].r = SDLTest_RandomUint8();
+        colors[i].g = SDLTest_RandomUint8();
+        colors[i].b = SDLTest_RandomUint8();
+        colors[i].a = SDLTest_RandomUint8();
+    }
+    SDL_SetPaletteColors(indexed->format->palette, colors, 0, SDL_arraysize(colors));
+
+    SDL_LogGetOutputFunction(&_savedLogOutput, &_savedLogUserdata);
+    SDL_LogSetOutputFunction(_countBlitCalculations, NULL);
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_VIDEO, SDL_LOG_PRIORITY_DEBUG);
+    _blitCalculations = 0;
+
+    /* Going back and forth between two destinations calculates each mapping once */
+    SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+    _checkCachedBlit(src, first, 1, "the first blit to the first destination");
+    _checkCachedBlit(src, second, 1, "the first blit to the second destination");
+    _checkCachedBlit(src, first, 0, "the second blit to the first destination");
+    _checkCachedBlit(src, second, 0, "the second blit to the second destination");
+
+    /* The destination a mapping was made for going away doesn't leave it
+       pointing at freed memory, and the next one of that format reuses it */
+    _checkCachedBlit(src, first, 0, "a blit to the destination about to be freed");
+    SDL_FreeSurface(first);
+    first = SDL_CreateRGBSurfaceWithFormat(0, 7, 9, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(first != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+    if (first != NULL) {
+        _checkCachedBlit(src, first, 0, "a blit to a new destination of the same format");
+
+        /* Blend modes and modulation change the blitter, and changing them back finds it again */
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+        _checkCachedBlit(src, first, 1, "a blended blit");
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+        _checkCachedBlit(src, first, 0, "an unblended blit again");
+        SDL_SetSurfaceColorMod(src, 200, 100, 50);
+        _checkCachedBlit(src, first, 1, "a color modulated blit");
+        SDL_SetSurfaceColorMod(src, 10, 20, 30);
+        _checkCachedBlit(src, first, 0, "a blit with another color modulation");
+        SDL_SetSurfaceColorMod(src, 255, 255, 255);
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+        _checkCachedBlit(src, first, 0, "a blended blit again");
+
+        /* The color tables of indexed sources depend on the palette and the
+           alpha modulation. Indexed sources can't be color modulated. */
+        _checkCachedBlit(indexed, first, 1, "the first blit of an indexed surface");
+        _checkCachedBlit(indexed, second, 1, "a blit of an indexed surface to the second destination");
+        _checkCachedBlit(indexed, first, 0, "a blit of an indexed surface back to the first destination");
+        colors[0].r ^= 0xFF;
+        SDL_SetPaletteColors(indexed->format->palette, colors, 0, 1);
+        _checkCachedBlit(indexed, first, 1, "a blit after the palette changed");
+        SDL_SetSurfaceBlendMode(indexed, SDL_BLENDMODE_BLEND);
+        SDL_SetSurfaceAlphaMod(indexed, 128);
+        _checkCachedBlit(indexed, first, 1, "an alpha modulated indexed blit");
+        SDL_SetSurfaceAlphaMod(indexed, 64);
+        _checkCachedBlit(indexed, second, 1, "an indexed blit to the second destination with another alpha modulation");
+        _checkCachedBlit(indexed, first, 1, "an indexed blit back to the first destination with another alpha modulation");
+        SDL_SetSurfaceAlphaMod(indexed, 128);
+        _checkCachedBlit(indexed, second, 1, "an indexed blit to the second destination with the first alpha modulation again");
+        _checkCachedBlit(indexed, first, 0, "an indexed blit back to the first destination with the first alpha modulation again");
+    }
+
+    SDL_LogSetOutputFunction(_savedLogOutput, _savedLogUserdata);
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_VIDEO, saved_priority);
+
+    SDL_FreeSurface(src);
+    SDL_FreeSurface(indexed);
+    SDL_FreeSurface(first);
+    SDL_FreeSurface(second);
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Compares blits split into row stripes by SDL_HINT_PARALLEL_BLITS with serial ones.
+ *
+ * The heights are odd, so the stripes differ in height, and the destinations are
+ * clipped at odd offsets. Stripes only run in parallel with more than one worker
+ * thread, see SDL_HINT_WORKER_THREADS.
+ */
+int
+surface_testParallelBlits(void *arg)
+{
+    const Uint32 formats[][2] = {
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888 },
+        { SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_RGB888 },
+    };
+    const SDL_BlendMode modes[] = {
+        SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD, SDL_BLENDMODE_MUL
+    };
+    const char *hint = SDL_GetHint(SDL_HINT_PARALLEL_BLITS);
+    char *saved = hint ? SDL_strdup(hint) : NULL;
+    int i, j, k, x, y;
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        for (j = 0; j < SDL_arraysize(modes); ++j) {
+            const int w = SDLTest_RandomIntegerInRange(270, 330);
+            const int h = SDLTest_RandomIntegerInRange(140, 170) * 2 + 1;
+            const SDL_Rect clip = { 3, 5, w - 10, h - 12 };
+            SDL_Surface *src = SDL_CreateRGBSurfaceWithFormat(0, w, h, 0, formats[i][0]);
+            SDL_Surface *dst[2];
+            Uint32 expected, actual;
+            SDL_bool mismatch;
+            int ret;
+
+            dst[0] = SDL_CreateRGBSurfaceWithFormat(0, w, h, 0, formats[i][1]);
+            dst[1] = SDL_CreateRGBSurfaceWithFormat(0, w, h, 0, formats[i][1]);
+            SDLTest_AssertCheck(src != NULL && dst[0] != NULL && dst[1] != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+            if (src == NULL || dst[0] == NULL || dst[1] == NULL) {
+                SDL_FreeSurface(src);
+                SDL_FreeSurface(dst[0]);
+                SDL_FreeSurface(dst[1]);
+                SDL_free(saved);
+                return TEST_ABORTED;
+            }
+            for (y = 0; y < h * src->pitch; ++y) {
+                ((Uint8 *) src->pixels)[y] = SDLTest_RandomUint8();
+            }
+            for (y = 0; y < h * dst[0]->pitch; ++y) {
+                ((Uint8 *) dst[0]->pixels)[y] = ((Uint8 *) dst[1]->pixels)[y] = SDLTest_RandomUint8();
+            }
+            SDL_SetSurfaceBlendMode(src, modes[j]);
+            if (j % 2) {
+                SDL_SetSurfaceColorMod(src, 200, 100, 50);
+                SDL_SetSurfaceAlphaMod(src, 160);
+            }
+
+            /* Serially, then in stripes */
+            for (k = 0; k < 2; ++k) {
+                SDL_SetHint(SDL_HINT_PARALLEL_BLITS, k ? "1" : "0");
+                SDL_SetClipRect(dst[k], &clip);
+                ret = SDL_BlitSurface(src, NULL, dst[k], NULL);
+                SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %d", ret);
+            }
+            mismatch = _findPixelMismatch(dst[0], dst[1], 0xFFFFFFFF, &x, &y, &expected, &actual);
+            SDLTest_AssertCheck(!mismatch,
+                                "Verify %s to %s %dx%d with blend mode %d%s in stripes, expected: 0x%.8X, got: 0x%.8X at %d,%d",
+                                SDL_GetPixelFormatName(formats[i][0]), SDL_GetPixelFormatName(formats[i][1]), w, h, modes[j],
+                                (j % 2) ? " modulated" : "", expected, actual, x, y);
+
+            SDL_FreeSurface(src);
+            SDL_FreeSurface(dst[0]);
+            SDL_FreeSurface(dst[1]);
+        }
+    }
+
+    SDL_SetHint(SDL_HINT_PARALLEL_BLITS, saved ? saved : "");
+    SDL_free(saved);
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Surface test cases */
@@ -631,11 +1740,42 @@ static const SDLTest_TestCaseReference surfaceTest11 =
 static const SDLTest_TestCaseReference surfaceTest12 =
         { (SDLTest_TestCaseFp)surface_testBlitBlendMod, "surface_testBlitBlendMod", "Tests blitting routines with mod blending mode.", TEST_ENABLED};
 
+static const SDLTest_TestCaseReference surfaceTest13 =
+        { (SDLTest_TestCaseFp)surface_testBlitFormatCoverage, "surface_testBlitFormatCoverage", "Tests modulated and blended blits across the common pixel formats.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest14 =
+        { (SDLTest_TestCaseFp)surface_testBlit10Bit, "surface_testBlit10Bit", "Tests conversions and blits to and from ARGB2101010.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest15 =
+        { (SDLTest_TestCaseFp)surface_testBlitPremultiplied, "surface_testBlitPremultiplied", "Tests premultiplying alpha and blitting with the premultiplied blend mode.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest16 =
+        { (SDLTest_TestCaseFp)surface_testConvertPixels, "surface_testConvertPixels", "Tests converting pixels between the RGB formats, also in place.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest17 =
+        { (SDLTest_TestCaseFp)surface_testBlitSIMDMatchesScalar, "surface_testBlitSIMDMatchesScalar", "Compares the SIMD blitters with the scalar ones on random pixels.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest18 =
+        { (SDLTest_TestCaseFp)surface_testBlitIndexed, "surface_testBlitIndexed", "Tests wide 8-bit indexed blits to 16, 24 and 32 bpp, with and without a colorkey.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest19 =
+        { (SDLTest_TestCaseFp)surface_testFillRects, "surface_testFillRects", "Tests filling adjacent, overlapping and clipped rects.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest20 =
+        { (SDLTest_TestCaseFp)surface_testStretchLinearSIMDMatchesScalar, "surface_testStretchLinearSIMDMatchesScalar", "Compares the SIMD linear stretching with the scalar one and exact filtering.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest21 =
+        { (SDLTest_TestCaseFp)surface_testBlitMapCache, "surface_testBlitMapCache", "Tests reusing and invalidating cached blit mappings.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest22 =
+        { (SDLTest_TestCaseFp)surface_testParallelBlits, "surface_testParallelBlits", "Compares blits in parallel row stripes with serial ones.", TEST_ENABLED};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] =  {
     &surfaceTest1, &surfaceTest2, &surfaceTest3, &surfaceTest4, &surfaceTest5,
     &surfaceTest6, &surfaceTest7, &surfaceTest8, &surfaceTest9, &surfaceTest10,
-    &surfaceTest11, &surfaceTest12, NULL
+    &surfaceTest11, &surfaceTest12, &surfaceTest13, &surfaceTest14,
+    &surfaceTest15, &surfaceTest16, &surfaceTest17, &surfaceTest18, &surfaceTest19, &surfaceTest20, &surfaceTest21, &surfaceTest22, NULL
 };
 
 /* Surface test suite (global) */
@@ -0,0 +1,354 @@
+/*
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures every software blitter: pixel formats x copy flags x sizes.
+   For each combination it records which family of blitters SDL chose
+   (copy, 0, 1, A, N, auto, slow, rle or stretch) and the speed in megapixels per
+   second, with the data in cache (warm) and after flushing it (cold).
+   The results are written as JSON, so they can be compared between
+   builds and CPUs. */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define DEFAULT_RUN_MS  20
+#define COLD_RUNS       3
+#define FLUSH_SIZE      (64 * 1024 * 1024)
+
+static const Uint32 formats[] = {
+    SDL_PIXELFORMAT_INDEX8,
+    SDL_PIXELFORMAT_RGB332,
+    SDL_PIXELFORMAT_RGB555,
+    SDL_PIXELFORMAT_RGB565,
+    SDL_PIXELFORMAT_ARGB4444,
+    SDL_PIXELFORMAT_ARGB1555,
+    SDL_PIXELFORMAT_RGB24,
+    SDL_PIXELFORMAT_BGR24,
+    SDL_PIXELFORMAT_RGB888,
+    SDL_PIXELFORMAT_BGR888,
+    SDL_PIXELFORMAT_ARGB8888,
+    SDL_PIXELFORMAT_RGBA8888,
+    SDL_PIXELFORMAT_ABGR8888,
+    SDL_PIXELFORMAT_BGRA8888,
+    SDL_PIXELFORMAT_ARGB2101010,
+};
+
+/* The copy flags, as set through the public surface API */
+#define FLAG_COLORKEY   0x01
+#define FLAG_RLE        0x02
+#define FLAG_MODULATE   0x04
+#define FLAG_BLEND      0x08
+#define FLAG_ADD        0x10
+#define FLAG_MOD        0x20
+#define FLAG_MUL        0x40
+#define FLAG_SCALE      0x80
+
+typedef struct
+{
+    const char *name;
+    int flags;
+} BlitCase;
+
+static const BlitCase cases[] = {
+    { "copy", 0 },
+    { "colorkey", FLAG_COLORKEY },
+    { "colorkey|rle", FLAG_COLORKEY | FLAG_RLE },
+    { "modulate", FLAG_MODULATE },
+    { "blend", FLAG_BLEND },
+    { "blend|rle", FLAG_BLEND | FLAG_RLE },
+    { "add", FLAG_ADD },
+    { "mod", FLAG_MOD },
+    { "mul", FLAG_MUL },
+    { "modulate|blend", FLAG_MODULATE | FLAG_BLEND },
+    { "colorkey|blend", FLAG_COLORKEY | FLAG_BLEND },
+    { "nearest", FLAG_SCALE },
+    { "modulate|blend|nearest", FLAG_MODULATE | FLAG_BLEND | FLAG_SCALE },
+};
+
+static char blitter[128];
+static Uint8 *flush_buffer;
+
+/* SDL_CalculateBlit() logs the blitter it picks at debug priority, as
+   "Blit <src> to <dst> with flags <flags> uses <kind>". The kind is kept in
+   the blit map, which the public API doesn't show, so this is how to get it. */
+static void SDLCALL
+CaptureBlitter(void *userdata, int category, SDL_LogPriority priority, const char *message)
+{
+    const char *kind = SDL_strrchr(message, ' ');
+
+    if (category == SDL_LOG_CATEGORY_VIDEO && priority == SDL_LOG_PRIORITY_DEBUG &&
+        SDL_strncmp(message, "Blit ", 5) == 0 && kind && kind - message >= 5 &&
+        SDL_strncmp(kind - 5, " uses", 5) == 0) {
+        SDL_strlcpy(blitter, kind + 1, sizeof (blitter));
+    } else if (priority > SDL_LOG_PRIORITY_DEBUG) {
+        fprintf(stderr, "%s\n", message);
+    }
+}
+
+static void
+FillRandom(SDL_Surface *surface)
+{
+    Uint8 *pixels = (Uint8 *) surface->pixels;
+    int i;
+
+    for (i = 0; i < surface->h * surface->pitch; ++i) {
+        pixels[i] = (Uint8) rand();
+    }
+}
+
+static SDL_Surface *
+CreateSurface(Uint32 format, int w, int h)
+{
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, w, h, SDL_BITSPERPIXEL(format), format);
+
+    if (surface) {
+        if (surface->format->palette) {
+            SDL_Color colors[256];
+            int i;
+
+            for (i = 0; i < SDL_arraysize(colors); ++i) {
+                colors[i].r = (Uint8) i;
+                colors[i].g = (Uint8) (255 - i);
+                colors[i].b = (Uint8) (i * 7);
+                colors[i].a = (Uint8) (i | 0x80);
+            }
+            SDL_SetPaletteColors(surface->format->palette, colors, 0, surface->format->palette->ncolors);
+        }
+        FillRandom(surface);
+    }
+    return surface;
+}
+
+static void
+SetupSource(SDL_Surface *src, int flags)
+{
+    SDL_BlendMode mode = SDL_BLENDMODE_NONE;
+
+    if (flags & FLAG_COLORKEY) {
+        SDL_SetColorKey(src, SDL_TRUE, SDL_MapRGB(src->format, 0, 0, 0));
+    }
+    if (flags & FLAG_MODULATE) {
+        SDL_SetSurfaceColorMod(src, 200, 150, 100);
+        SDL_SetSurfaceAlphaMod(src, 180);
+    }
+    if (flags & FLAG_BLEND) {
+        mode = SDL_BLENDMODE_BLEND;
+    } else if (flags & FLAG_ADD) {
+        mode = SDL_BLENDMODE_ADD;
+    } else if (flags & FLAG_MOD) {
+        mode = SDL_BLENDMODE_MOD;
+    } else if (flags & FLAG_MUL) {
+        mode = SDL_BLENDMODE_MUL;
+    }
+    SDL_SetSurfaceBlendMode(src, mode);
+    SDL_SetSurfaceRLE(src, (flags & FLAG_RLE) ? 1 : 0);
+}
+
+static int
+Blit(SDL_Surface *src, SDL_Surface *dst, int flags)
+{
+    if (flags & FLAG_SCALE) {
+        SDL_Rect rect;
+
+        rect.x = 0;
+        rect.y = 0;
+        rect.w = dst->w;
+        rect.h = dst->h;
+        return SDL_BlitScaled(src, NULL, dst, &rect);
+    }
+    return SDL_BlitSurface(src, NULL, dst, NULL);
+}
+
+/* Evicts the source and destination from the CPU caches */
+static void
+FlushCaches(void)
+{
+    int i;
+
+    for (i = 0; i < FLUSH_SIZE; i += 64) {
+        flush_buffer[i]++;
+    }
+}
+
+static double
+Seconds(Uint64 start)
+{
+    return (double) (SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+}
+
+static void
+RunCase(FILE *out, SDL_bool *first, Uint32 src_format, Uint32 dst_format,
+        const BlitCase *blitcase, int w, int h, int run_ms)
+{
+    const double pixels = (double) w * h;
+    SDL_Surface *src, *dst;
+    double warm = 0.0, cold = 0.0, elapsed;
+    int iterations, i;
+    Uint64 start;
+
+    /* Scaled blits stretch a source of half the size */
+    src = CreateSurface(src_format, (blitcase->flags & FLAG_SCALE) ? w / 2 : w,
+                        (blitcase->flags & FLAG_SCALE) ? h / 2 : h);
+    dst = CreateSurface(dst_format, w, h);
+    if (!src || !dst) {
+        SDL_FreeSurface(src);
+        SDL_FreeSurface(dst);
+        return;
+    }
+    SetupSource(src, blitcase->flags);
+
+    /* Same format scaled blits go straight to SDL_SoftStretch() */
+    SDL_strlcpy(blitter, (blitcase->flags & FLAG_SCALE) ? "stretch" : "none", sizeof (blitter));
+    if (Blit(src, dst, blitcase->flags) < 0) {
+        SDL_strlcpy(blitter, "unsupported", sizeof (blitter));
+    } else {
+        /* Warm: keep going over the same pixels until enough time has passed */
+        iterations = 0;
+        start = SDL_GetPerformanceCounter();
+        do {
+            Blit(src, dst, blitcase->flags);
+            ++iterations;
+            elapsed = Seconds(start);
+        } while (elapsed * 1000.0 < run_ms);
+        warm = (pixels * iterations) / elapsed / 1000000.0;
+
+        /* Cold: time single blits after flushing the caches */
+        elapsed = 0.0;
+        for (i = 0; i < COLD_RUNS; ++i) {
+            FlushCaches();
+            start = SDL_GetPerformanceCounter();
+            Blit(src, dst, blitcase->flags);
+            elapsed += Seconds(start);
+        }
+        cold = (pixels * COLD_RUNS) / elapsed / 1000000.0;
+    }
+
+    fprintf(out, "%s    { \"src\": \"%s\", \"dst\": \"%s\", \"flags\": \"%s\", \"width\": %d, \"height\": %d, "
+                 "\"blitter\": \"%s\", \"warm_mpixels_per_second\": %.2f, \"cold_mpixels_per_second\": %.2f }",
+            *first ? "" : ",\n",
+            SDL_GetPixelFormatName(src_format) + 16, SDL_GetPixelFormatName(dst_format) + 16,
+            blitcase->name, w, h, blitter, warm, cold);
+    fflush(out);
+    *first = SDL_FALSE;
+
+    SDL_FreeSurface(src);
+    SDL_FreeSurface(dst);
+}
+
+static SDL_bool
+MatchFormat(const char *filter, Uint32 format)
+{
+    /* Names are matched without the SDL_PIXELFORMAT_ prefix */
+    return (!filter || SDL_strcasecmp(filter, SDL_GetPixelFormatName(format) + 16) == 0) ? SDL_TRUE : SDL_FALSE;
+}
+
+int
+main(int argc, char *argv[])
+{
+    static const int default_sizes[] = { 64, 64, 512, 512, 1920, 1080 };
+    int sizes[2 * 16];
+    int num_sizes = 0;
+    int run_ms = DEFAULT_RUN_MS;
+    const char *src_filter = NULL;
+    const char *dst_filter = NULL;
+    const char *flags_filter = NULL;
+    const char *output = NULL;
+    FILE *out = stdout;
+    SDL_bool first = SDL_TRUE;
+    int i, j, k, s;
+
+    for (i = 1; i < argc; ++i) {
+        if (SDL_strcmp(argv[i], "--size") == 0 && i + 1 < argc && num_sizes < SDL_arraysize(sizes) / 2) {
+            if (SDL_sscanf(argv[++i], "%dx%d", &sizes[2 * num_sizes], &sizes[2 * num_sizes + 1]) == 2 &&
+                sizes[2 * num_sizes] > 1 && sizes[2 * num_sizes + 1] > 1) {
+                ++num_sizes;
+                continue;
+            }
+        } else if (SDL_strcmp(argv[i], "--time") == 0 && i + 1 < argc) {
+            run_ms = SDL_atoi(argv[++i]);
+            continue;
+        } else if (SDL_strcmp(argv[i], "--src") == 0 && i + 1 < argc) {
+            src_filter = argv[++i];
+            continue;
+        } else if (SDL_strcmp(argv[i], "--dst") == 0 && i + 1 < argc) {
+            dst_filter = argv[++i];
+            continue;
+        } else if (SDL_strcmp(argv[i], "--flags") == 0 && i + 1 < argc) {
+            flags_filter = argv[++i];
+            continue;
+        } else if (SDL_strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output = argv[++i];
+            continue;
+        }
+        fprintf(stderr, "Usage: %s [--size WxH]... [--time ms] [--src format] [--dst format] [--flags name] [--output file.json]\n", argv[0]);
+        return 1;
+    }
+    if (num_sizes == 0) {
+        SDL_memcpy(sizes, default_sizes, sizeof (default_sizes));
+        num_sizes = SDL_arraysize(default_sizes) / 2;
+    }
+
+    if (output) {
+        out = fopen(output, "w");
+        if (!out) {
+            fprintf(stderr, "Couldn't open %s\n", output);
+            return 1;
+        }
+    }
+
+    flush_buffer = (Uint8 *) SDL_calloc(1, FLUSH_SIZE);
+    if (!flush_buffer) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    SDL_LogSetOutputFunction(CaptureBlitter, NULL);
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_VIDEO, SDL_LOG_PRIORITY_DEBUG);
+    srand(0);
+
+    fprintf(out, "{\n  \"platform\": \"%s\",\n  \"revision\": \"%s\",\n  \"cpu\": { \"count\": %d, "
+                 "\"sse2\": %s, \"sse41\": %s, \"avx2\": %s, \"neon\": %s },\n  \"results\": [\n",
+            SDL_GetPlatform(), SDL_GetRevision(), SDL_GetCPUCount(),
+            SDL_HasSSE2() ? "true" : "false", SDL_HasSSE41() ? "true" : "false",
+            SDL_HasAVX2() ? "true" : "false", SDL_HasNEON() ? "true" : "false");
+
+    for (s = 0; s < num_sizes; ++s) {
+        for (i = 0; i < SDL_arraysize(formats); ++i) {
+            if (!MatchFormat(src_filter, formats[i])) {
+                continue;
+            }
+            for (j = 0; j < SDL_arraysize(formats); ++j) {
+                if (!MatchFormat(dst_filter, formats[j]) || SDL_BITSPERPIXEL(formats[j]) < 8) {
+                    continue;
+                }
+                for (k = 0; k < SDL_arraysize(cases); ++k) {
+                    if (flags_filter && SDL_strcmp(flags_filter, cases[k].name) != 0) {
+                        continue;
+                    }
+                    RunCase(out, &first, formats[i], formats[j], &cases[k], sizes[2 * s], sizes[2 * s + 1], run_ms);
+                }
+            }
+        }
+    }
+
+    fprintf(out, "\n  ]\n}\n");
+    if (out != stdout) {
+        fclose(out);
+    }
+    SDL_free(flush_buffer);
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
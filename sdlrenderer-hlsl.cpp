@@ -1,55 +1,17 @@
 #include <cassert>
 #include <cstdint>
 
-// This has the full definition for SDL_Renderer, which allows us to reference
-// private fields inside it. Needs to be imported before SDL.h so we dont
-// redefine anything in there, which would break the build.
-#include <SDL_sysrender.h>
-
-// Well, if it's SDL + Direct3d HLSL we are going to need those
 #include <SDL.h>
-#include <d3d9.h>
 
-// This includes the binary for the compiled pixel shader.
+// The compiled HLSL pixel shader is only useful (and only compiles, since it
+// uses DWORD) on Windows, where SDL can use Direct3D 9.
+#ifdef _WIN32
+#include <windows.h>
 #include "fractal.h"
+#endif
 
-// These are from SDL_render_d3d.c (inside SDL)
-// We need to copy them here because they are not included by the header files.
-typedef struct
-{
-    SDL_Rect viewport;
-    SDL_bool viewport_dirty;
-    SDL_Texture *texture;
-    SDL_BlendMode blend;
-    SDL_bool cliprect_enabled;
-    SDL_bool cliprect_enabled_dirty;
-    SDL_Rect cliprect;
-    SDL_bool cliprect_dirty;
-    SDL_bool is_copy_ex;
-    LPDIRECT3DPIXELSHADER9 shader;
-} D3D_DrawStateCache;
-
-typedef struct
-{
-    void* d3dDLL;
-    IDirect3D9 *d3d;
-    IDirect3DDevice9 *device;
-    UINT adapter;
-    D3DPRESENT_PARAMETERS pparams;
-    SDL_bool updateSize;
-    SDL_bool beginScene;
-    SDL_bool enableSeparateAlphaBlend;
-    D3DTEXTUREFILTERTYPE scaleMode[8];
-    IDirect3DSurface9 *defaultRenderTarget;
-    IDirect3DSurface9 *currentRenderTarget;
-    void* d3dxDLL;
-    LPDIRECT3DPIXELSHADER9 shaders[3];
-    LPDIRECT3DVERTEXBUFFER9 vertexBuffers[8];
-    size_t vertexBufferSize[8];
-    int currentVertexBuffer;
-    SDL_bool reportedVboProblem;
-    D3D_DrawStateCache drawstate;
-} D3D_RenderData;
+// The same shader, ported to C++, for renderers without pixel shaders.
+#include "fractal_kernel.h"
 
 // Constants for the window
 const static char window_title[] = "SDL_Renderer + HLSL";
@@ -71,103 +33,89 @@ bool should_quit() {
   return false;
 }
 
-// Builds a render that's guaranteed to be direct3d
-SDL_Renderer* direct3d9_renderer(SDL_Window* window) {
-  SDL_SetHint(SDL_HINT_RENDER_DRIVER, "direct3d9");
+// Creates the fractal kernel for the given renderer. SDL picks whichever
+// implementation the renderer can run: the HLSL bytecode on Direct3D 9 or the
+// CPU port on the software renderer.
+SDL_RenderKernel* fractal_render_kernel(SDL_Renderer* renderer) {
+#ifdef _WIN32
+  return SDL_CreateRenderKernel(renderer, fractal_kernel, nullptr,
+                                g_ps21_main, sizeof(g_ps21_main));
+#else
+  return SDL_CreateRenderKernel(renderer, fractal_kernel, nullptr, nullptr, 0);
+#endif
+}
+
+// Builds a renderer that can run our kernel. We prefer Direct3D 9 (where the
+// kernel is the HLSL shader), but any renderer that accepts the kernel will do,
+// and the software renderer always does.
+SDL_Renderer* kernel_renderer(SDL_Window* window, SDL_RenderKernel** kernel) {
+  SDL_SetHint(SDL_HINT_RENDER_DRIVER, "direct3d");
   const static int use_first_renderer_supporting_flags = -1;
   SDL_Renderer* renderer = SDL_CreateRenderer(window,
                                               use_first_renderer_supporting_flags,
                                               SDL_RENDERER_ACCELERATED);
 
-  SDL_RendererInfo renderer_details;
-  SDL_GetRendererInfo(renderer, &renderer_details);
-
-  // Since we are relying on a hint to provide a Direct3D9 renderer, we may get
-  // an OpenGL one still, if Direct3D9 is not supported. To avoid hard bugs
-  // down the line, we make sure that we are returning a direct3d renderer.
-  //
-  // In a real application we would select the shading language (HLSL or GLSL)
-  // based on the renderer we get instead of forcing it to be direct3d.
-  assert(!strcmp(renderer_details.name, "direct3d"));
-
-  return renderer;
-}
-
-// This fetches the Direct3D device from inside the opaque SDL_Renderer field
-// "driverdata". We copied its definition for the Direct3D renderer from the SDL
-// source code to the top of this file so that works fine.
-//
-// After fetching the device we jsut need to call SetPixelShader and we are
-// golden.
-IDirect3DPixelShader9* apply_hlsl_pixel_shader(SDL_Renderer* renderer, IDirect3DPixelShader9* shader) {
-    IDirect3DDevice9* device = reinterpret_cast<D3D_RenderData*>(renderer->driverdata)->device;
-    IDirect3DPixelShader9* current_shader;
+  *kernel = renderer ? fractal_render_kernel(renderer) : nullptr;
 
-    assert(D3D_OK == IDirect3DDevice9_GetPixelShader(device, &current_shader));
+  if (!*kernel) {
+    // Probably an OpenGL renderer, which has no way to run our kernel.
+    if (renderer) SDL_DestroyRenderer(renderer);
 
-    assert(D3D_OK == IDirect3DDevice9_SetPixelShader(device, shader));
+    renderer = SDL_CreateRenderer(window,
+                                  use_first_renderer_supporting_flags,
+                                  SDL_RENDERER_SOFTWARE);
+    assert(renderer);
 
-    return current_shader;
-}
-
-// Creates a shader doing the same thing as the above function to get the device
-// and then calling CreatePixelShader with the binary array we imported from
-// "fractal.h".
-IDirect3DPixelShader9* hlsl_pixel_shader(SDL_Renderer* renderer) {
-  IDirect3DDevice9* device = reinterpret_cast<D3D_RenderData*>(renderer->driverdata)->device;
-  IDirect3DPixelShader9 *shader;
+    *kernel = fractal_render_kernel(renderer);
+  }
 
-  assert(D3D_OK == IDirect3DDevice9_CreatePixelShader(device, g_ps21_main, &shader));
+  assert(*kernel);
 
-  return shader;
+  return renderer;
 }
 
-// Writes a byte to the first byte of a SDL texture.
-void send_byte_using_texture(SDL_Texture *texture, uint8_t byte) {
-  uint32_t *pixels;
-  int pitch;
+// Passes the animation frame to the kernel, as a value between 0 and 1.
+// It is queued along with the draws, so no flush or texture upload is needed.
+void send_frame_using_constants(SDL_Renderer *renderer, uint8_t frame) {
+  const float constants[] = { frame/255.0f };
 
-  SDL_LockTexture(texture, nullptr, reinterpret_cast<void**>(&pixels), &pitch);
-
-  pixels[0] = byte;
-
-  SDL_UnlockTexture(texture);
+  SDL_RenderSetKernelConstants(renderer, constants, SDL_arraysize(constants));
 }
 
 int main(int arg_count, char** arg_vector) {
-  // 1. Create a window, renderer, texture and shader
+  // 1. Create a window, renderer, texture and kernel
   SDL_Window* window = SDL_CreateWindow(window_title,
                                         SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
                                         window_width, window_height,
                                         SDL_WINDOW_SHOWN);
-  SDL_Renderer* renderer = direct3d9_renderer(window);
+  SDL_RenderKernel* kernel;
+  SDL_Renderer* renderer = kernel_renderer(window, &kernel);
+  // The kernel draws every pixel, this only gives SDL_RenderCopy a source
   SDL_Texture* texture = SDL_CreateTexture(renderer,
                                            SDL_PIXELFORMAT_RGBA8888,
-                                           SDL_TEXTUREACCESS_STREAMING,
+                                           SDL_TEXTUREACCESS_STATIC,
                                            1, 1);
-  IDirect3DPixelShader9* shader = hlsl_pixel_shader(renderer);
   uint8_t frame_counter = 0;
 
+  // Every copy from now on is drawn by the kernel
+  SDL_RenderSetKernel(renderer, kernel);
+
   // 2. Loop until the window is closed
   while (true) {
     if (should_quit()) break;
 
-    // Allow the shader to do effects that change with time by writting to the
-    // texture that the shader can read.
-    send_byte_using_texture(texture, frame_counter++);
+    // Allow the kernel to do effects that change with time
+    send_frame_using_constants(renderer, frame_counter++);
 
-    // Do the drawing using our HLSL shader
-    const auto previous_shader = apply_hlsl_pixel_shader(renderer, shader); {
-      SDL_RenderCopy(renderer, texture, nullptr, nullptr);
-      SDL_RenderFlush(renderer);
-    } apply_hlsl_pixel_shader(renderer, previous_shader);
+    // Do the drawing using our kernel...
+    SDL_RenderCopy(renderer, texture, nullptr, nullptr);
 
     // ... show the drawing
     SDL_RenderPresent(renderer);
   }
 
   // 3. Clear everything we allocated
-  IDirect3DPixelShader9_Release(shader);
+  SDL_DestroyRenderKernel(kernel);
 
   SDL_DestroyTexture(texture);
   SDL_DestroyRenderer(renderer);